@@ -0,0 +1,114 @@
+#ifndef BANDEDBENCH_HPP
+#define BANDEDBENCH_HPP
+
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+#include "LU.hpp"
+#include "Banded.hpp"
+#include "LUBench.hpp"
+
+/**
+ * @brief Fill range of diagonally dominant tridiagonal systems by deterministic values
+ */
+template<typename T, unsigned SIZE>
+inline void benchFillTridiagonal ( std::vector<TridiagonalMatrix<T, SIZE>>& matrices, std::vector<Vector<T, SIZE>>& rhs )
+	{
+	for ( unsigned n = 0; n < matrices.size(); ++n )
+		for ( unsigned i = 0; i < SIZE; ++i )
+			{
+			matrices[n].lower.x[i] = T ( ( n + i ) % 5 ) * T ( 0.25 ) - T ( 0.5 );
+			matrices[n].upper.x[i] = T ( ( n*3 + i ) % 7 ) * T ( 0.125 ) - T ( 0.375 );
+			matrices[n].diagonal.x[i] = T ( 2 ) + T ( ( n + 2*i ) % 3 );
+			rhs[n].x[i] = T ( ( n*i ) % 11 ) - T ( 5 );
+			}
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_TridiagonalSolve ( benchmark::State& state )
+	{
+	std::vector<TridiagonalMatrix<T, SIZE>> matrices ( 4096 );
+	std::vector<Vector<T, SIZE>> rhs ( matrices.size() );
+	std::vector<Vector<T, SIZE>> out ( matrices.size() );
+	benchFillTridiagonal ( matrices, rhs );
+
+	for ( auto _ : state )
+		{
+		for ( unsigned n = 0; n < matrices.size(); ++n )
+			tridiagonalSolve ( matrices[n], rhs[n], out[n] );
+
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * matrices.size() );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_TridiagonalSolveBatch ( benchmark::State& state )
+	{
+	std::vector<TridiagonalMatrix<T, SIZE>> matrices ( 4096 );
+	std::vector<Vector<T, SIZE>> rhs ( matrices.size() );
+	std::vector<Vector<T, SIZE>> out ( matrices.size() );
+	std::vector<bool> regular ( matrices.size() );
+	benchFillTridiagonal ( matrices, rhs );
+
+	for ( auto _ : state )
+		{
+		tridiagonalSolveBatch ( matrices.begin(), matrices.end(), rhs.begin(), out.begin(), regular.begin() );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * matrices.size() );
+	}
+
+template<typename T, unsigned SIZE, unsigned LOWER, unsigned UPPER>
+static void BM_BandedLUSolve ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	Vector<T, SIZE> b;
+	benchFillDiagonallyDominant ( *M );
+	benchFill ( b );
+	std::unique_ptr<BandedMatrix<T, SIZE, LOWER, UPPER>> B ( new BandedMatrix<T, SIZE, LOWER, UPPER> ( *M ) );
+
+	for ( auto _ : state )
+		{
+		std::unique_ptr<BandedLUDecomposition<T, SIZE, LOWER, UPPER>> lu ( new BandedLUDecomposition<T, SIZE, LOWER, UPPER> ( *B ) );
+		Vector<T, SIZE> x = lu->solve ( b );
+		benchmark::DoNotOptimize ( x );
+		}
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_DenseLUSolve ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	Vector<T, SIZE> b;
+	benchFillDiagonallyDominant ( *M );
+	benchFill ( b );
+
+	// keep only tridiagonal band, dense algorithm does not profit from it
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < SIZE; ++j )
+			if ( i > j+1 || j > i+1 )
+				( *M ) ( i, j ) = T ( 0 );
+
+	for ( auto _ : state )
+		{
+		std::unique_ptr<LUDecomposition<T, SIZE>> lu ( new LUDecomposition<T, SIZE> ( *M ) );
+		Vector<T, SIZE> x = lu->solve ( b );
+		benchmark::DoNotOptimize ( x );
+		}
+	}
+
+BENCHMARK_TEMPLATE ( BM_TridiagonalSolve, float, 16 );
+BENCHMARK_TEMPLATE ( BM_TridiagonalSolveBatch, float, 16 );
+BENCHMARK_TEMPLATE ( BM_TridiagonalSolve, double, 16 );
+BENCHMARK_TEMPLATE ( BM_TridiagonalSolveBatch, double, 16 );
+BENCHMARK_TEMPLATE ( BM_TridiagonalSolve, double, 128 );
+BENCHMARK_TEMPLATE ( BM_TridiagonalSolveBatch, double, 128 );
+BENCHMARK_TEMPLATE ( BM_BandedLUSolve, double, 256, 1, 1 );
+BENCHMARK_TEMPLATE ( BM_BandedLUSolve, double, 256, 4, 4 );
+BENCHMARK_TEMPLATE ( BM_DenseLUSolve, double, 256 );
+
+#endif // BANDEDBENCH_HPP
@@ -0,0 +1,108 @@
+#ifndef BINARYIOBENCH_HPP
+#define BINARYIOBENCH_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Vector.hpp"
+#include "BinaryIO.hpp"
+
+/**
+ * @brief Write COUNT points to binary container, return path
+ */
+template<typename T, unsigned COUNT>
+inline std::string benchBinaryFile()
+	{
+	const std::string path = "vecmatlib_bench.vmlb";
+	std::vector<Vector<T, 3>> points ( COUNT );
+
+	for ( auto& p : points )
+		benchFill ( p );
+
+	writeBinary ( path, points.data(), points.data() + points.size() );
+
+	return path;
+	}
+
+/**
+ * @brief Bulk write of COUNT points with checksum
+ */
+template<typename T, unsigned COUNT>
+static void BM_BinaryWrite ( benchmark::State& state )
+	{
+	const std::string path = "vecmatlib_bench.vmlb";
+	std::vector<Vector<T, 3>> points ( COUNT );
+
+	for ( auto& p : points )
+		benchFill ( p );
+
+	for ( auto _ : state )
+		writeBinary ( path, points.data(), points.data() + points.size() );
+
+	std::remove ( path.c_str() );
+	state.SetBytesProcessed ( state.iterations() * COUNT * sizeof ( Vector<T, 3> ) );
+	}
+
+/**
+ * @brief Read of COUNT points into memory as done by deserialization
+ */
+template<typename T, unsigned COUNT>
+static void BM_BinaryRead ( benchmark::State& state )
+	{
+	const std::string path = benchBinaryFile<T, COUNT>();
+
+	for ( auto _ : state )
+		{
+		std::vector<Vector<T, 3>> points ( COUNT );
+		std::FILE* file = std::fopen ( path.c_str(), "rb" );
+		std::fseek ( file, 64, SEEK_SET );
+		benchmark::DoNotOptimize ( std::fread ( points.data(), sizeof ( Vector<T, 3> ), COUNT, file ) );
+		std::fclose ( file );
+		benchmark::DoNotOptimize ( points.data() );
+		}
+
+	std::remove ( path.c_str() );
+	state.SetBytesProcessed ( state.iterations() * COUNT * sizeof ( Vector<T, 3> ) );
+	}
+
+/**
+ * @brief Opening of COUNT points mapped into memory and access of last one
+ */
+template<typename T, unsigned COUNT>
+static void BM_BinaryMap ( benchmark::State& state )
+	{
+	const std::string path = benchBinaryFile<T, COUNT>();
+
+	for ( auto _ : state )
+		{
+		MappedArray<Vector<T, 3>> points ( path );
+		benchmark::DoNotOptimize ( points[COUNT - 1].x[2] );
+		}
+
+	std::remove ( path.c_str() );
+	state.SetBytesProcessed ( state.iterations() * COUNT * sizeof ( Vector<T, 3> ) );
+	}
+
+/**
+ * @brief Checksum verification of COUNT mapped points
+ */
+template<typename T, unsigned COUNT>
+static void BM_BinaryVerify ( benchmark::State& state )
+	{
+	const std::string path = benchBinaryFile<T, COUNT>();
+	MappedArray<Vector<T, 3>> points ( path );
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize ( points.verify() );
+
+	std::remove ( path.c_str() );
+	state.SetBytesProcessed ( state.iterations() * COUNT * sizeof ( Vector<T, 3> ) );
+	}
+
+BENCHMARK_TEMPLATE ( BM_BinaryWrite, float, 1 << 20 );
+BENCHMARK_TEMPLATE ( BM_BinaryRead, float, 1 << 20 );
+BENCHMARK_TEMPLATE ( BM_BinaryMap, float, 1 << 20 );
+BENCHMARK_TEMPLATE ( BM_BinaryVerify, float, 1 << 20 );
+
+#endif // BINARYIOBENCH_HPP
@@ -0,0 +1,102 @@
+#ifndef CHOLESKYBENCH_HPP
+#define CHOLESKYBENCH_HPP
+
+#include <memory>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+#include "Cholesky.hpp"
+
+/**
+ * @brief Fill symmetric Matrix by deterministic values with dominant diagonal
+ */
+template<typename T, unsigned SIZE>
+inline void benchFillSymmetricPositiveDefinite ( Matrix<T, SIZE, SIZE>& m )
+	{
+	benchFillDiagonallyDominant ( m );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < i; ++j )
+			m ( j, i ) = m ( i, j );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_CholeskyDecomposition ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	benchFillSymmetricPositiveDefinite ( *M );
+
+	for ( auto _ : state )
+		{
+		std::unique_ptr<CholeskyDecomposition<T, SIZE>> llt ( new CholeskyDecomposition<T, SIZE> ( *M ) );
+		benchmark::DoNotOptimize ( llt->l.x );
+		}
+
+	state.counters["FLOPS"] = benchmark::Counter ( 1.0/3.0 * SIZE * SIZE * SIZE * state.iterations(),
+							  benchmark::Counter::kIsRate );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_LDLTDecomposition ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	benchFillSymmetricPositiveDefinite ( *M );
+
+	for ( auto _ : state )
+		{
+		std::unique_ptr<LDLTDecomposition<T, SIZE>> ldlt ( new LDLTDecomposition<T, SIZE> ( *M ) );
+		benchmark::DoNotOptimize ( ldlt->l.x );
+		}
+
+	state.counters["FLOPS"] = benchmark::Counter ( 1.0/3.0 * SIZE * SIZE * SIZE * state.iterations(),
+							  benchmark::Counter::kIsRate );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_CholeskySolve ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	benchFillSymmetricPositiveDefinite ( *M );
+	std::unique_ptr<CholeskyDecomposition<T, SIZE>> llt ( new CholeskyDecomposition<T, SIZE> ( *M ) );
+	Vector<T, SIZE> b;
+	benchFill ( b );
+
+	for ( auto _ : state )
+		{
+		Vector<T, SIZE> x = llt->solve ( b );
+		benchmark::DoNotOptimize ( x.x );
+		}
+
+	state.counters["FLOPS"] = benchmark::Counter ( 2.0 * SIZE * SIZE * state.iterations(),
+							  benchmark::Counter::kIsRate );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_CholeskyRankOneUpdate ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	benchFillSymmetricPositiveDefinite ( *M );
+	std::unique_ptr<CholeskyDecomposition<T, SIZE>> llt ( new CholeskyDecomposition<T, SIZE> ( *M ) );
+	Vector<T, SIZE> v;
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		// update followed by downdate keeps decomposition bounded
+		benchmark::DoNotOptimize ( llt->rankOneUpdate ( v, T ( 1 ) ) );
+		benchmark::DoNotOptimize ( llt->rankOneUpdate ( v, T ( -1 ) ) );
+		}
+	}
+
+#define CHOLESKY_BENCHMARKS(T, SIZE) \
+	BENCHMARK_TEMPLATE ( BM_CholeskyDecomposition, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_LDLTDecomposition, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_CholeskySolve, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_CholeskyRankOneUpdate, T, SIZE );
+
+CHOLESKY_BENCHMARKS ( double, 3 )
+CHOLESKY_BENCHMARKS ( double, 6 )
+CHOLESKY_BENCHMARKS ( double, 12 )
+CHOLESKY_BENCHMARKS ( double, 64 )
+CHOLESKY_BENCHMARKS ( float, 6 )
+
+#endif // CHOLESKYBENCH_HPP
@@ -0,0 +1,80 @@
+#ifndef HALFBENCH_HPP
+#define HALFBENCH_HPP
+
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+#include "Half.hpp"
+
+template<typename T>
+static void BM_ConvertToFloat ( benchmark::State& state )
+	{
+	std::vector<T> in ( state.range ( 0 ), T ( 1.5f ) );
+	std::vector<float> out ( in.size() );
+
+	for ( auto _ : state )
+		{
+		convert ( in.data(), in.data() + in.size(), out.data() );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * in.size() );
+	}
+
+template<typename T>
+static void BM_ConvertFromFloat ( benchmark::State& state )
+	{
+	std::vector<float> in ( state.range ( 0 ) );
+	std::vector<T> out ( in.size() );
+	benchFill ( in );
+
+	for ( auto _ : state )
+		{
+		convert ( in.data(), in.data() + in.size(), out.data() );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * in.size() );
+	}
+
+/**
+ * @brief Matrix Vector product of 16-bit or float storage, computed in float
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_MatrixVectorMul_Storage ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, ROWS, COLS>> M ( new Matrix<T, ROWS, COLS> );
+	Vector<T, COLS> v;
+	Vector<float, ROWS> out;
+	unsigned n = 0;
+
+	for ( T& x : *M )
+		x = T ( float ( n++ % 17 ) * 0.25f - 2.0f );
+
+	for ( T& x : v )
+		x = T ( float ( n++ % 13 ) * 0.25f - 1.5f );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct ( *M, v, out );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * ROWS * COLS );
+	state.SetBytesProcessed ( state.iterations() * sizeof ( T ) * ROWS * COLS );
+	}
+
+BENCHMARK_TEMPLATE ( BM_ConvertToFloat, Half )->Arg ( 4096 );
+BENCHMARK_TEMPLATE ( BM_ConvertToFloat, BFloat16 )->Arg ( 4096 );
+BENCHMARK_TEMPLATE ( BM_ConvertFromFloat, Half )->Arg ( 4096 );
+BENCHMARK_TEMPLATE ( BM_ConvertFromFloat, BFloat16 )->Arg ( 4096 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Storage, float, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Storage, Half, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Storage, BFloat16, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Storage, float, 2048, 2048 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Storage, Half, 2048, 2048 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Storage, BFloat16, 2048, 2048 );
+
+#endif // HALFBENCH_HPP
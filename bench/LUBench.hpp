@@ -0,0 +1,143 @@
+#ifndef LUBENCH_HPP
+#define LUBENCH_HPP
+
+#include <memory>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+#include "LU.hpp"
+
+/**
+ * @brief Fill Matrix by deterministic values with dominant diagonal
+ */
+template<typename T, unsigned SIZE>
+inline void benchFillDiagonallyDominant ( Matrix<T, SIZE, SIZE>& m )
+	{
+	benchFill ( m );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		m ( i, i ) += T ( 4*SIZE );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_LUDecomposition ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	benchFillDiagonallyDominant ( *M );
+
+	for ( auto _ : state )
+		{
+		std::unique_ptr<LUDecomposition<T, SIZE>> lu ( new LUDecomposition<T, SIZE> ( *M ) );
+		benchmark::DoNotOptimize ( lu->lu.x );
+		}
+
+	state.counters["FLOPS"] = benchmark::Counter ( 2.0/3.0 * SIZE * SIZE * SIZE * state.iterations(),
+							  benchmark::Counter::kIsRate );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_LUSolve ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	benchFillDiagonallyDominant ( *M );
+	std::unique_ptr<LUDecomposition<T, SIZE>> lu ( new LUDecomposition<T, SIZE> ( *M ) );
+	Vector<T, SIZE> b;
+	benchFill ( b );
+
+	for ( auto _ : state )
+		{
+		Vector<T, SIZE> x = lu->solve ( b );
+		benchmark::DoNotOptimize ( x.x );
+		}
+
+	state.counters["FLOPS"] = benchmark::Counter ( 2.0 * SIZE * SIZE * state.iterations(),
+							  benchmark::Counter::kIsRate );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_LUInverse ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> inv ( new Matrix<T, SIZE, SIZE> );
+	benchFillDiagonallyDominant ( *M );
+
+	for ( auto _ : state )
+		{
+		*inv = inverse ( *M );
+		benchmark::DoNotOptimize ( inv->x );
+		}
+
+	state.counters["FLOPS"] = benchmark::Counter ( 2.0 * SIZE * SIZE * SIZE * state.iterations(),
+							  benchmark::Counter::kIsRate );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_LURcond ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	benchFillDiagonallyDominant ( *M );
+	std::unique_ptr<LUDecomposition<T, SIZE>> lu ( new LUDecomposition<T, SIZE> ( *M ) );
+
+	for ( auto _ : state )
+		benchmark::DoNotOptimize ( lu->rcond() );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_ClosedFormInverse ( benchmark::State& state )
+	{
+	Matrix<T, SIZE, SIZE> M;
+	Matrix<T, SIZE, SIZE> inv;
+	benchFillDiagonallyDominant ( M );
+
+	for ( auto _ : state )
+		{
+		benchmark::DoNotOptimize ( inverse ( M, inv ) );
+		benchmark::DoNotOptimize ( inv.x );
+		}
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_ClosedFormInverseBatch ( benchmark::State& state )
+	{
+	const unsigned count = 1024;
+	std::unique_ptr<Matrix<T, SIZE, SIZE>[]> M ( new Matrix<T, SIZE, SIZE>[count] );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>[]> inv ( new Matrix<T, SIZE, SIZE>[count] );
+	std::unique_ptr<bool[]> regular ( new bool[count] );
+
+	for ( unsigned i = 0; i < count; ++i )
+		{
+		benchFillDiagonallyDominant ( M[i] );
+		M[i] ( 0, 0 ) += T ( i % 7 );
+		}
+
+	for ( auto _ : state )
+		{
+		benchmark::DoNotOptimize ( inverseBatch ( M.get(), M.get() + count, inv.get(), regular.get() ) );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * count );
+	}
+
+BENCHMARK_TEMPLATE ( BM_ClosedFormInverse, float, 3 );
+BENCHMARK_TEMPLATE ( BM_ClosedFormInverse, double, 3 );
+BENCHMARK_TEMPLATE ( BM_ClosedFormInverse, float, 4 );
+BENCHMARK_TEMPLATE ( BM_ClosedFormInverse, double, 4 );
+BENCHMARK_TEMPLATE ( BM_ClosedFormInverseBatch, float, 3 );
+BENCHMARK_TEMPLATE ( BM_ClosedFormInverseBatch, float, 4 );
+
+#define LU_BENCHMARKS(T, SIZE) \
+	BENCHMARK_TEMPLATE ( BM_LUDecomposition, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_LUSolve, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_LUInverse, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_LURcond, T, SIZE );
+
+LU_BENCHMARKS ( double, 3 )
+LU_BENCHMARKS ( double, 4 )
+LU_BENCHMARKS ( double, 6 )
+LU_BENCHMARKS ( double, 12 )
+LU_BENCHMARKS ( double, 64 )
+LU_BENCHMARKS ( double, 256 )
+LU_BENCHMARKS ( float, 6 )
+LU_BENCHMARKS ( float, 64 )
+
+#endif // LUBENCH_HPP
@@ -0,0 +1,261 @@
+#ifndef MATRIXVECTORBENCH_HPP
+#define MATRIXVECTORBENCH_HPP
+
+#include <memory>
+#include <benchmark/benchmark.h>
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+/**
+ * @brief Fill container by deterministic, non trivial values
+ *
+ * @tparam C container type
+ * @param c container to fill
+ */
+template<class C>
+inline void benchFill ( C& c )
+	{
+	using T = Container::ret_type<decltype ( c.begin() )>;
+	unsigned i = 0;
+
+	for ( auto& x : c )
+		x = T ( ( i++ % 17 ) * 0.25 - 2 );
+	}
+
+/**
+ * @brief Reference transposed product walking columns of first with stride COLS,
+ * as done before row streaming kernel was introduced.
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+static void stridedTransposedCauchyProduct ( const Matrix<T, ROWS, COLS>& first,
+											 const Vector<T, ROWS>& second,
+											 Vector<T, COLS>& output )
+	{
+	for ( unsigned j=0; j < COLS; ++j )
+		{
+		T* it_first_beg = first.begin() + j;
+		T* it_second_beg = second.begin();
+		T* it_second_end = second.end();
+		T value = T ( 0 );
+
+		while ( it_second_beg != it_second_end )
+			{
+			value += *it_first_beg * *it_second_beg++;
+			it_first_beg += COLS;
+			}
+
+		output.x[j] = value;
+		}
+	}
+
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_TransposedMul_Strided ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, ROWS, COLS>> M ( new Matrix<T, ROWS, COLS> );
+	Vector<T, ROWS> v;
+	Vector<T, COLS> out;
+	benchFill ( *M );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		stridedTransposedCauchyProduct ( *M, v, out );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * ROWS * COLS );
+	state.SetBytesProcessed ( state.iterations() * sizeof ( T ) * ROWS * COLS );
+	}
+
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_TransposedMul ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, ROWS, COLS>> M ( new Matrix<T, ROWS, COLS> );
+	Vector<T, ROWS> v;
+	Vector<T, COLS> out;
+	benchFill ( *M );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		transposedCauchyProduct<T, T, T> ( *M, v, out );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * ROWS * COLS );
+	state.SetBytesProcessed ( state.iterations() * sizeof ( T ) * ROWS * COLS );
+	}
+
+/**
+ * @brief Reference Matrix Vector product reducing one row at a time
+ * with scalar accumulator, as done before register blocked kernel was introduced.
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+static void rowwiseCauchyProduct ( const Matrix<T, ROWS, COLS>& first,
+								   const Vector<T, COLS>& second,
+								   Vector<T, ROWS>& output )
+	{
+	for ( unsigned i=0; i < ROWS; ++i )
+		{
+		T* it_first_beg = first.begin ( i );
+		T* it_first_end = first.end ( i );
+		T* it_second_beg = second.begin();
+		T value = T ( 0 );
+
+		while ( it_first_beg != it_first_end )
+			value += *it_first_beg++ * *it_second_beg++;
+
+		output.x[i] = value;
+		}
+	}
+
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_MatrixVectorMul_Rowwise ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, ROWS, COLS>> M ( new Matrix<T, ROWS, COLS> );
+	Vector<T, COLS> v;
+	Vector<T, ROWS> out;
+	benchFill ( *M );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		rowwiseCauchyProduct ( *M, v, out );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * ROWS * COLS );
+	state.SetBytesProcessed ( state.iterations() * sizeof ( T ) * ROWS * COLS );
+	}
+
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_MatrixVectorMul ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, ROWS, COLS>> M ( new Matrix<T, ROWS, COLS> );
+	Vector<T, COLS> v;
+	Vector<T, ROWS> out;
+	benchFill ( *M );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct<T, T, T> ( *M, v, out );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * ROWS * COLS );
+	state.SetBytesProcessed ( state.iterations() * sizeof ( T ) * ROWS * COLS );
+	}
+
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_MatrixVectorMul_Scaled ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, ROWS, COLS>> M ( new Matrix<T, ROWS, COLS> );
+	Vector<T, COLS> v;
+	Vector<T, ROWS> out ( T ( 0 ) );
+	benchFill ( *M );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		scaledCauchyProduct ( T ( 0.5 ), *M, v, T ( 0.5 ), out );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * ROWS * COLS );
+	state.SetBytesProcessed ( state.iterations() * sizeof ( T ) * ROWS * COLS );
+	}
+
+/**
+ * @brief Matrix Vector product of T storage accumulated in ACC
+ */
+template<typename T, typename ACC, unsigned ROWS, unsigned COLS>
+static void BM_MatrixVectorMul_Wide ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, ROWS, COLS>> M ( new Matrix<T, ROWS, COLS> );
+	Vector<T, COLS> v;
+	Vector<ACC, ROWS> out;
+	benchFill ( *M );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		wideCauchyProduct<ACC> ( *M, v, out );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * ROWS * COLS );
+	state.SetBytesProcessed ( state.iterations() * sizeof ( T ) * ROWS * COLS );
+	}
+
+/**
+ * @brief Matrix product of T storage accumulated in ACC
+ */
+template<typename T, typename ACC, unsigned SIZE>
+static void BM_MatrixMul_Wide ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> A ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> B ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<ACC, SIZE, SIZE>> C ( new Matrix<ACC, SIZE, SIZE> );
+	benchFill ( *A );
+	benchFill ( *B );
+
+	for ( auto _ : state )
+		{
+		wideCauchyProduct<ACC> ( *A, *B, *C );
+		benchmark::DoNotOptimize ( C->x );
+		}
+
+	state.SetItemsProcessed ( state.iterations() * SIZE * SIZE * SIZE );
+	}
+
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Rowwise, float, 6, 6 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul, float, 6, 6 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Rowwise, float, 64, 64 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul, float, 64, 64 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Rowwise, double, 64, 64 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul, double, 64, 64 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Rowwise, float, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul, float, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Scaled, float, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Rowwise, double, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul, double, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Rowwise, float, 16, 1024 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul, float, 16, 1024 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Rowwise, float, 1024, 16 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul, float, 1024, 16 );
+
+// tall
+BENCHMARK_TEMPLATE ( BM_TransposedMul_Strided, float, 1024, 16 );
+BENCHMARK_TEMPLATE ( BM_TransposedMul, float, 1024, 16 );
+BENCHMARK_TEMPLATE ( BM_TransposedMul_Strided, double, 1024, 16 );
+BENCHMARK_TEMPLATE ( BM_TransposedMul, double, 1024, 16 );
+// wide
+BENCHMARK_TEMPLATE ( BM_TransposedMul_Strided, float, 16, 1024 );
+BENCHMARK_TEMPLATE ( BM_TransposedMul, float, 16, 1024 );
+BENCHMARK_TEMPLATE ( BM_TransposedMul_Strided, double, 16, 1024 );
+BENCHMARK_TEMPLATE ( BM_TransposedMul, double, 16, 1024 );
+// square
+BENCHMARK_TEMPLATE ( BM_TransposedMul_Strided, float, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_TransposedMul, float, 256, 256 );
+// mixed precision, in cache and in memory
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul, double, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Wide, double, double, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Wide, float, double, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Wide, std::int16_t, std::int32_t, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Wide, std::int32_t, std::int64_t, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul, double, 2048, 2048 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Wide, float, double, 2048, 2048 );
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Wide, std::int16_t, std::int32_t, 2048, 2048 );
+BENCHMARK_TEMPLATE ( BM_MatrixMul_Wide, double, double, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixMul_Wide, float, double, 256 );
+BENCHMARK_TEMPLATE ( BM_MatrixMul_Wide, std::int16_t, std::int32_t, 256 );
+
+#endif // MATRIXVECTORBENCH_HPP
@@ -0,0 +1,126 @@
+#ifndef NPYBENCH_HPP
+#define NPYBENCH_HPP
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Vector.hpp"
+#include "TextIO.hpp"
+#include "BinaryIO.hpp"
+#include "Npy.hpp"
+
+/**
+ * @brief COUNT points written as CSV text, as exchanged with numpy before npy arrays
+ */
+template<typename T, unsigned COUNT>
+static void BM_NpySave_Text ( benchmark::State& state )
+	{
+	const std::string path = "vecmatlib_bench_points.csv";
+	std::vector<Vector<T, 3>> points ( COUNT );
+
+	for ( auto& p : points )
+		benchFill ( p );
+
+	for ( auto _ : state )
+		{
+		std::ofstream out ( path, std::ios::binary );
+		writeText ( out, points.begin(), points.end(), TextIO::Format ( TextIO::CSV ) );
+		}
+
+	std::remove ( path.c_str() );
+	state.SetBytesProcessed ( state.iterations() * COUNT * sizeof ( Vector<T, 3> ) );
+	}
+
+/**
+ * @brief COUNT points written as npy array
+ */
+template<typename T, unsigned COUNT>
+static void BM_NpySave ( benchmark::State& state )
+	{
+	const std::string path = "vecmatlib_bench_points.npy";
+	std::vector<Vector<T, 3>> points ( COUNT );
+
+	for ( auto& p : points )
+		benchFill ( p );
+
+	for ( auto _ : state )
+		writeNpy ( path, points.data(), points.data() + points.size() );
+
+	std::remove ( path.c_str() );
+	state.SetBytesProcessed ( state.iterations() * COUNT * sizeof ( Vector<T, 3> ) );
+	}
+
+/**
+ * @brief COUNT points parsed from mapped CSV text
+ */
+template<typename T, unsigned COUNT>
+static void BM_NpyLoad_Text ( benchmark::State& state )
+	{
+	const std::string path = "vecmatlib_bench_points.csv";
+	std::vector<Vector<T, 3>> points ( COUNT );
+
+	for ( auto& p : points )
+		benchFill ( p );
+
+	std::ofstream out ( path, std::ios::binary );
+	writeText ( out, points.begin(), points.end(), TextIO::Format ( TextIO::CSV ) );
+	out.close();
+
+	for ( auto _ : state )
+		{
+		std::vector<Vector<T, 3>> loaded = readText<Vector<T, 3>> ( path );
+		benchmark::DoNotOptimize ( loaded.data() );
+		}
+
+	std::remove ( path.c_str() );
+	state.SetBytesProcessed ( state.iterations() * COUNT * sizeof ( Vector<T, 3> ) );
+	}
+
+/**
+ * @brief COUNT points of npy array loaded and summed, in place of mapping
+ * or converted from other byte order
+ */
+template<typename T, unsigned COUNT, bool SWAPPED>
+static void BM_NpyLoad ( benchmark::State& state )
+	{
+	const std::string path = "vecmatlib_bench_points.npy";
+	std::vector<Vector<T, 3>> points ( COUNT );
+
+	for ( auto& p : points )
+		benchFill ( p );
+
+	writeNpy ( path, points.data(), points.data() + points.size() );
+
+	if ( SWAPPED )
+		{
+		// flip byte order character of dtype, data are read as swapped
+		std::FILE* file = std::fopen ( path.c_str(), "r+b" );
+		std::fseek ( file, 21, SEEK_SET );
+		std::fputc ( BinaryIO::byteOrder() == BinaryIO::LITTLE_ENDIAN_ORDER ? '>' : '<', file );
+		std::fclose ( file );
+		}
+
+	for ( auto _ : state )
+		{
+		NpyArray<Vector<T, 3>> loaded ( path );
+		Vector<T, 3> sum ( T ( 0 ) );
+
+		for ( const Vector<T, 3>& p : loaded )
+			sum += p;
+
+		benchmark::DoNotOptimize ( sum );
+		}
+
+	std::remove ( path.c_str() );
+	state.SetBytesProcessed ( state.iterations() * COUNT * sizeof ( Vector<T, 3> ) );
+	}
+
+BENCHMARK_TEMPLATE ( BM_NpySave_Text, double, 1 << 16 );
+BENCHMARK_TEMPLATE ( BM_NpySave, double, 1 << 16 );
+BENCHMARK_TEMPLATE ( BM_NpyLoad_Text, double, 1 << 16 );
+BENCHMARK_TEMPLATE ( BM_NpyLoad, double, 1 << 16, false );
+BENCHMARK_TEMPLATE ( BM_NpyLoad, double, 1 << 16, true );
+
+#endif // NPYBENCH_HPP
@@ -0,0 +1,105 @@
+#ifndef QRBENCH_HPP
+#define QRBENCH_HPP
+
+#include <memory>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+#include "Cholesky.hpp"
+#include "QR.hpp"
+
+/**
+ * @brief Fill Matrix by deterministic values of full column rank
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+inline void benchFillFullRank ( Matrix<T, ROWS, COLS>& m )
+	{
+	benchFill ( m );
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		m ( i, i % COLS ) += T ( 4 );
+	}
+
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_QRDecomposition ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, ROWS, COLS>> A ( new Matrix<T, ROWS, COLS> );
+	benchFillFullRank ( *A );
+
+	for ( auto _ : state )
+		{
+		std::unique_ptr<QRDecomposition<T, ROWS, COLS>> qr ( new QRDecomposition<T, ROWS, COLS> ( *A ) );
+		benchmark::DoNotOptimize ( qr->qr.x );
+		}
+
+	state.counters["FLOPS"] = benchmark::Counter ( 2.0 * COLS * COLS * ( ROWS - COLS/3.0 ) * state.iterations(),
+							  benchmark::Counter::kIsRate );
+	}
+
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_QRLeastSquares ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, ROWS, COLS>> A ( new Matrix<T, ROWS, COLS> );
+	Vector<T, ROWS> b;
+	benchFillFullRank ( *A );
+	benchFill ( b );
+
+	for ( auto _ : state )
+		{
+		Vector<T, COLS> x = leastSquares ( *A, b );
+		benchmark::DoNotOptimize ( x.x );
+		}
+	}
+
+/**
+ * @brief Reference least squares by normal equations transpose(A)*A*x = transpose(A)*b
+ * solved by Cholesky decomposition, squares condition number of A.
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_NormalEquationsLeastSquares ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, ROWS, COLS>> A ( new Matrix<T, ROWS, COLS> );
+	std::unique_ptr<Matrix<T, COLS, COLS>> AtA ( new Matrix<T, COLS, COLS> );
+	Vector<T, ROWS> b;
+	benchFillFullRank ( *A );
+	benchFill ( b );
+
+	for ( auto _ : state )
+		{
+		AtA->fill ( T ( 0 ) );
+		Vector<T, COLS> Atb ( T ( 0 ) );
+
+		// lower triangle of transpose(A)*A, streaming rows of A
+		for ( unsigned r = 0; r < ROWS; ++r )
+			{
+			const T* it_row = A->begin ( r );
+
+			for ( unsigned i = 0; i < COLS; ++i )
+				{
+				T* it_out = AtA->begin ( i );
+
+				for ( unsigned j = 0; j <= i; ++j )
+					it_out[j] += it_row[i] * it_row[j];
+
+				Atb.x[i] += it_row[i] * b.x[r];
+				}
+			}
+
+		std::unique_ptr<CholeskyDecomposition<T, COLS>> llt ( new CholeskyDecomposition<T, COLS> ( *AtA ) );
+		Vector<T, COLS> x = llt->solve ( Atb );
+		benchmark::DoNotOptimize ( x.x );
+		}
+	}
+
+#define QR_BENCHMARKS(T, ROWS, COLS) \
+	BENCHMARK_TEMPLATE ( BM_QRDecomposition, T, ROWS, COLS ); \
+	BENCHMARK_TEMPLATE ( BM_QRLeastSquares, T, ROWS, COLS ); \
+	BENCHMARK_TEMPLATE ( BM_NormalEquationsLeastSquares, T, ROWS, COLS );
+
+QR_BENCHMARKS ( double, 100, 3 )
+QR_BENCHMARKS ( double, 1000, 6 )
+QR_BENCHMARKS ( double, 256, 16 )
+QR_BENCHMARKS ( double, 512, 64 )
+QR_BENCHMARKS ( double, 256, 256 )
+QR_BENCHMARKS ( float, 1000, 6 )
+
+#endif // QRBENCH_HPP
@@ -0,0 +1,77 @@
+#ifndef QUANTIZEDBENCH_HPP
+#define QUANTIZEDBENCH_HPP
+
+#include <cstdint>
+#include <memory>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+#include "Quantized.hpp"
+
+/**
+ * @brief Fill container of bytes with values covering whole range of T
+ */
+template<class C>
+inline void benchFillBytes ( C& c )
+	{
+	using T = Container::ret_type<decltype ( c.begin() )>;
+	unsigned i = 0;
+
+	for ( auto& x : c )
+		x = T ( ( i++ * 37 ) % 256 );
+	}
+
+/**
+ * @brief Quantized Matrix Vector product of int8 weights and T activations
+ * requantized to int8, per row quantization of weights
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_QuantizedMatrixVectorMul ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<std::int8_t, ROWS, COLS>> M ( new Matrix<std::int8_t, ROWS, COLS> );
+	Vector<Quantization, ROWS> weights ( Quantization { 0.01f, 0 } );
+	Vector<T, COLS> v;
+	Vector<std::int8_t, ROWS> out;
+	benchFillBytes ( *M );
+	benchFillBytes ( v );
+
+	for ( auto _ : state )
+		{
+		quantizedCauchyProduct ( *M, weights, v, Quantization { 0.02f, 3 }, out, Quantization { 0.5f, 0 } );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * ROWS * COLS );
+	state.SetBytesProcessed ( state.iterations() * ROWS * COLS );
+	}
+
+/**
+ * @brief Quantized Matrix product of int8 weights and T activations accumulated in int32
+ */
+template<typename T, unsigned SIZE>
+static void BM_QuantizedMatrixMul ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<std::int8_t, SIZE, SIZE>> A ( new Matrix<std::int8_t, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> B ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<std::int32_t, SIZE, SIZE>> C ( new Matrix<std::int32_t, SIZE, SIZE> );
+	benchFillBytes ( *A );
+	benchFillBytes ( *B );
+
+	for ( auto _ : state )
+		{
+		quantizedCauchyProduct ( *A, Quantization { 0.01f, 0 }, *B, Quantization { 0.02f, 3 }, *C );
+		benchmark::DoNotOptimize ( C->x );
+		}
+
+	state.SetItemsProcessed ( state.iterations() * SIZE * SIZE * SIZE );
+	}
+
+BENCHMARK_TEMPLATE ( BM_MatrixVectorMul_Wide, std::int8_t, std::int32_t, 1024, 1024 );
+BENCHMARK_TEMPLATE ( BM_QuantizedMatrixVectorMul, std::uint8_t, 1024, 1024 );
+BENCHMARK_TEMPLATE ( BM_QuantizedMatrixVectorMul, std::int8_t, 1024, 1024 );
+BENCHMARK_TEMPLATE ( BM_MatrixMul_Wide, std::int8_t, std::int32_t, 256 );
+BENCHMARK_TEMPLATE ( BM_QuantizedMatrixMul, std::uint8_t, 256 );
+BENCHMARK_TEMPLATE ( BM_QuantizedMatrixMul, std::int8_t, 256 );
+BENCHMARK_TEMPLATE ( BM_QuantizedMatrixMul, std::int8_t, 1024 );
+
+#endif // QUANTIZEDBENCH_HPP
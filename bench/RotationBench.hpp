@@ -0,0 +1,90 @@
+#ifndef ROTATIONBENCH_HPP
+#define ROTATIONBENCH_HPP
+
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+
+/**
+ * @brief Fill range of angular increments like gyroscope rate times IMU period
+ */
+template<typename T>
+inline void benchFillAngularIncrements ( std::vector<Vector<T, 3>>& increments )
+	{
+	unsigned seed = 1;
+
+	for ( Vector<T, 3>& w : increments )
+		for ( T& x : w )
+			{
+			seed = seed * 1664525u + 1013904223u;
+			x = ( T ( seed >> 8 ) / T ( 1u << 24 ) - T ( 0.5 ) ) * T ( 0.02 );
+			}
+	}
+
+template<typename T>
+static void BM_RotationMatrix ( benchmark::State& state )
+	{
+	std::vector<Vector<T, 3>> increments ( 4096 );
+	std::vector<Matrix<T, 3, 3>> rotations ( increments.size() );
+	benchFillAngularIncrements ( increments );
+
+	for ( auto _ : state )
+		{
+		for ( unsigned n = 0; n < increments.size(); ++n )
+			rotations[n] = rotationMatrix ( increments[n] );
+
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * increments.size() );
+	}
+
+template<typename T>
+static void BM_ExpSO3Batch ( benchmark::State& state )
+	{
+	std::vector<Vector<T, 3>> increments ( 4096 );
+	std::vector<Matrix<T, 3, 3>> rotations ( increments.size() );
+	benchFillAngularIncrements ( increments );
+	// half of increments above Taylor branch threshold
+	for ( unsigned n = 0; n < increments.size(); n += 2 )
+		increments[n] = increments[n] * Vector<T, 3> ( T ( 50 ) );
+
+	for ( auto _ : state )
+		{
+		expSO3Batch ( increments.begin(), increments.end(), rotations.begin() );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * increments.size() );
+	}
+
+template<typename T>
+static void BM_LogSO3Batch ( benchmark::State& state )
+	{
+	std::vector<Vector<T, 3>> increments ( 4096 );
+	std::vector<Matrix<T, 3, 3>> rotations ( increments.size() );
+	std::vector<Vector<T, 3>> logs ( increments.size() );
+	benchFillAngularIncrements ( increments );
+
+	for ( unsigned n = 0; n < increments.size(); n += 2 )
+		increments[n] = increments[n] * Vector<T, 3> ( T ( 200 ) );
+
+	expSO3Batch ( increments.begin(), increments.end(), rotations.begin() );
+
+	for ( auto _ : state )
+		{
+		logSO3Batch ( rotations.begin(), rotations.end(), logs.begin() );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * increments.size() );
+	}
+
+BENCHMARK_TEMPLATE ( BM_RotationMatrix, float );
+BENCHMARK_TEMPLATE ( BM_ExpSO3Batch, float );
+BENCHMARK_TEMPLATE ( BM_LogSO3Batch, float );
+BENCHMARK_TEMPLATE ( BM_RotationMatrix, double );
+BENCHMARK_TEMPLATE ( BM_ExpSO3Batch, double );
+BENCHMARK_TEMPLATE ( BM_LogSO3Batch, double );
+
+#endif // ROTATIONBENCH_HPP
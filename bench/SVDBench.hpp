@@ -0,0 +1,65 @@
+#ifndef SVDBENCH_HPP
+#define SVDBENCH_HPP
+
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+#include "SVD.hpp"
+#include "SymmetricEigenBench.hpp"
+
+template<typename T>
+static void BM_SVD ( benchmark::State& state )
+	{
+	std::vector<Matrix<T, 3, 3>> matrices ( 4096 );
+	std::vector<Matrix<T, 3, 3>> u ( matrices.size() );
+	std::vector<Vector<T, 3>> s ( matrices.size() );
+	std::vector<Matrix<T, 3, 3>> v ( matrices.size() );
+	benchFillCovariances ( matrices );
+
+	for ( auto _ : state )
+		{
+		for ( unsigned n = 0; n < matrices.size(); ++n )
+			svd ( matrices[n], u[n], s[n], v[n] );
+
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * matrices.size() );
+	}
+
+template<typename T>
+static void BM_Kabsch ( benchmark::State& state )
+	{
+	std::vector<Vector<T, 3>> source ( state.range ( 0 ) );
+	std::vector<Vector<T, 3>> target ( source.size() );
+	Matrix<T, 3, 3> r = rotationMatrix ( Vector<T, 3>{T ( 0.3 ), T ( -0.5 ), T ( 1.2 )} );
+	unsigned seed = 1;
+
+	for ( unsigned n = 0; n < source.size(); ++n )
+		{
+		for ( unsigned i = 0; i < 3; ++i )
+			{
+			seed = seed * 1664525u + 1013904223u;
+			source[n].x[i] = T ( seed >> 8 ) / T ( 1u << 24 ) - T ( 0.5 );
+			}
+
+		target[n] = r * source[n];
+		}
+
+	Vector<T, 3> translation;
+
+	for ( auto _ : state )
+		{
+		Matrix<T, 3, 3> rotation = kabsch ( source.begin(), source.end(), target.begin(), translation );
+		benchmark::DoNotOptimize ( rotation );
+		}
+
+	state.SetItemsProcessed ( state.iterations() * source.size() );
+	}
+
+BENCHMARK_TEMPLATE ( BM_SVD, float );
+BENCHMARK_TEMPLATE ( BM_SVD, double );
+BENCHMARK_TEMPLATE ( BM_Kabsch, float )->Arg ( 16 )->Arg ( 1024 )->Arg ( 65536 );
+BENCHMARK_TEMPLATE ( BM_Kabsch, double )->Arg ( 16 )->Arg ( 1024 )->Arg ( 65536 );
+
+#endif // SVDBENCH_HPP
@@ -0,0 +1,122 @@
+#ifndef SPARSEMATRIXBENCH_HPP
+#define SPARSEMATRIXBENCH_HPP
+
+#include <memory>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+#include "SparseMatrix.hpp"
+#include "MatrixVectorBench.hpp"
+
+/**
+ * @brief Fill dense Matrix with deterministic random pattern of given density in permille
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+inline void benchFillSparse ( Matrix<T, ROWS, COLS>& m, unsigned permille )
+	{
+	unsigned seed = 1;
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		for ( unsigned j = 0; j < COLS; ++j )
+			{
+			seed = seed * 1664525u + 1013904223u;
+			m ( i, j ) = ( seed >> 8 ) % 1000 < permille ? T ( ( seed >> 4 ) % 17 ) * T ( 0.25 ) - T ( 2 ) : T ( 0 );
+			}
+	}
+
+// range(0) density in permille, range(1) number of threads
+template<typename T, unsigned SIZE>
+static void BM_SparseMatrixVector ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	Vector<T, SIZE> v;
+	Vector<T, SIZE> out;
+	benchFillSparse ( *M, state.range ( 0 ) );
+	benchFill ( v );
+	SparseMatrix<T, SIZE, SIZE> S ( *M );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct ( S, v, out, state.range ( 1 ) );
+		benchmark::ClobberMemory();
+		}
+
+	state.counters["nnz"] = S.nonZeros();
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_DenseMatrixVector ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	Vector<T, SIZE> v;
+	Vector<T, SIZE> out;
+	benchFillSparse ( *M, state.range ( 0 ) );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct ( *M, v, out );
+		benchmark::ClobberMemory();
+		}
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_SparseTransposedMatrixVector ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	Vector<T, SIZE> v;
+	Vector<T, SIZE> out;
+	benchFillSparse ( *M, state.range ( 0 ) );
+	benchFill ( v );
+	SparseMatrix<T, SIZE, SIZE> S ( *M );
+
+	for ( auto _ : state )
+		{
+		transposedCauchyProduct ( S, v, out, state.range ( 1 ) );
+		benchmark::ClobberMemory();
+		}
+	}
+
+template<typename T, unsigned SIZE, unsigned COLS>
+static void BM_SparseMatrixMatrix ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, COLS>> X ( new Matrix<T, SIZE, COLS> );
+	std::unique_ptr<Matrix<T, SIZE, COLS>> out ( new Matrix<T, SIZE, COLS> );
+	benchFillSparse ( *M, state.range ( 0 ) );
+	benchFill ( *X );
+	SparseMatrix<T, SIZE, SIZE> S ( *M );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct ( S, *X, *out, state.range ( 1 ) );
+		benchmark::ClobberMemory();
+		}
+	}
+
+template<typename T, unsigned SIZE, unsigned COLS>
+static void BM_DenseMatrixMatrix ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, COLS>> X ( new Matrix<T, SIZE, COLS> );
+	std::unique_ptr<Matrix<T, SIZE, COLS>> out ( new Matrix<T, SIZE, COLS> );
+	benchFillSparse ( *M, state.range ( 0 ) );
+	benchFill ( *X );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct ( *M, *X, *out );
+		benchmark::ClobberMemory();
+		}
+	}
+
+#define SPARSE_BENCHMARKS(T, SIZE) \
+	BENCHMARK_TEMPLATE ( BM_SparseMatrixVector, T, SIZE )->ArgsProduct ( { { 10, 50, 250 }, { 1, 4 } } ); \
+	BENCHMARK_TEMPLATE ( BM_DenseMatrixVector, T, SIZE )->Arg ( 10 ); \
+	BENCHMARK_TEMPLATE ( BM_SparseTransposedMatrixVector, T, SIZE )->ArgsProduct ( { { 10, 50, 250 }, { 1, 4 } } ); \
+	BENCHMARK_TEMPLATE ( BM_SparseMatrixMatrix, T, SIZE, 16 )->ArgsProduct ( { { 10, 50, 250 }, { 1, 4 } } ); \
+	BENCHMARK_TEMPLATE ( BM_DenseMatrixMatrix, T, SIZE, 16 )->Arg ( 10 );
+
+SPARSE_BENCHMARKS ( double, 1024 )
+SPARSE_BENCHMARKS ( float, 1024 )
+
+#endif // SPARSEMATRIXBENCH_HPP
@@ -0,0 +1,64 @@
+#ifndef STRASSENBENCH_HPP
+#define STRASSENBENCH_HPP
+
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+#include "Strassen.hpp"
+
+template<typename T, unsigned SIZE>
+static void BM_CauchyProduct ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> A ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> B ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> C ( new Matrix<T, SIZE, SIZE> );
+	benchFill ( *A );
+	benchFill ( *B );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct ( *A, *B, *C );
+		benchmark::DoNotOptimize ( C->x );
+		}
+
+	state.counters["FLOPS"] = benchmark::Counter ( 2.0 * SIZE * SIZE * SIZE * state.iterations(),
+							  benchmark::Counter::kIsRate );
+	}
+
+/**
+ * @brief Strassen product with crossover given by argument,
+ * crossover >= SIZE is blocked kernel only. Fastest argument is the crossover
+ * to use for STRASSEN_CROSSOVER on the build machine.
+ */
+template<typename T, unsigned SIZE>
+static void BM_StrassenProduct ( benchmark::State& state )
+	{
+	const unsigned crossover = state.range ( 0 );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> A ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> B ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> C ( new Matrix<T, SIZE, SIZE> );
+	std::vector<T> workspace ( strassenWorkspaceSize ( SIZE, crossover ) );
+	benchFill ( *A );
+	benchFill ( *B );
+
+	for ( auto _ : state )
+		{
+		strassenProduct ( *A, *B, *C, workspace.data(), workspace.size(), crossover );
+		benchmark::DoNotOptimize ( C->x );
+		}
+
+	// classical flop count, so rates are comparable with cauchyProduct
+	state.counters["FLOPS"] = benchmark::Counter ( 2.0 * SIZE * SIZE * SIZE * state.iterations(),
+							  benchmark::Counter::kIsRate );
+	}
+
+BENCHMARK_TEMPLATE ( BM_CauchyProduct, double, 512 )->Unit ( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE ( BM_StrassenProduct, double, 512 )->Arg ( 32 )->Arg ( 64 )->Arg ( 128 )->Arg ( 256 )->Arg ( 512 )
+->Unit ( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE ( BM_StrassenProduct, double, 1024 )->Arg ( 64 )->Arg ( 128 )->Arg ( 256 )->Arg ( 512 )->Arg ( 1024 )
+->Unit ( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE ( BM_StrassenProduct, float, 1024 )->Arg ( 64 )->Arg ( 128 )->Arg ( 256 )->Arg ( 512 )->Arg ( 1024 )
+->Unit ( benchmark::kMillisecond );
+
+#endif // STRASSENBENCH_HPP
@@ -0,0 +1,109 @@
+#ifndef STREAMIOBENCH_HPP
+#define STREAMIOBENCH_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "BinaryIO.hpp"
+#include "StreamIO.hpp"
+
+/**
+ * @brief Rotation of chunk of points
+ */
+template<typename T>
+inline void benchRotateChunk ( const Matrix<T, 3, 3>& R, const Vector<T, 3>* it_beg, const Vector<T, 3>* it_end, Vector<T, 3>* out_beg )
+	{
+	while ( it_beg != it_end )
+		cauchyProduct ( R, *it_beg++, *out_beg++ );
+	}
+
+/**
+ * @brief Rotation of stream of COUNT points by chunks read, verified, rotated
+ * and written one after another
+ */
+template<typename T, unsigned COUNT, unsigned CHUNK>
+static void BM_StreamTransform_Sequential ( benchmark::State& state )
+	{
+	const std::string input_path = "vecmatlib_bench_input.vmlb";
+	const std::string output_path = "vecmatlib_bench_output.vmlb";
+	std::vector<Vector<T, 3>> points ( COUNT );
+	std::vector<Vector<T, 3>> in ( CHUNK );
+	std::vector<Vector<T, 3>> out ( CHUNK );
+	Matrix<T, 3, 3> R;
+	benchFill ( R );
+
+	for ( auto& p : points )
+		benchFill ( p );
+
+	writeBinary ( input_path, points.data(), points.data() + points.size() );
+
+	for ( auto _ : state )
+		{
+		std::FILE* input = std::fopen ( input_path.c_str(), "rb" );
+		std::FILE* output = std::fopen ( output_path.c_str(), "wb" );
+		std::fseek ( input, 64, SEEK_SET );
+		std::fseek ( output, 64, SEEK_SET );
+		std::size_t count;
+		std::uint64_t input_hash = BinaryIO::checksum ( nullptr, 0 );
+		std::uint64_t output_hash = input_hash;
+
+		while ( ( count = std::fread ( in.data(), sizeof ( Vector<T, 3> ), CHUNK, input ) ) != 0 )
+			{
+			input_hash = BinaryIO::checksum ( in.data(), count * sizeof ( Vector<T, 3> ), input_hash );
+			benchRotateChunk ( R, in.data(), in.data() + count, out.data() );
+			output_hash = BinaryIO::checksum ( out.data(), count * sizeof ( Vector<T, 3> ), output_hash );
+			std::fwrite ( out.data(), sizeof ( Vector<T, 3> ), count, output );
+			}
+
+		benchmark::DoNotOptimize ( input_hash );
+		benchmark::DoNotOptimize ( output_hash );
+
+		std::fclose ( input );
+		std::fclose ( output );
+		}
+
+	std::remove ( input_path.c_str() );
+	std::remove ( output_path.c_str() );
+	state.SetBytesProcessed ( state.iterations() * COUNT * sizeof ( Vector<T, 3> ) );
+	}
+
+/**
+ * @brief Rotation of stream of COUNT points by transformStream,
+ * reading and writing overlap rotation
+ */
+template<typename T, unsigned COUNT, unsigned CHUNK>
+static void BM_StreamTransform ( benchmark::State& state )
+	{
+	const std::string input_path = "vecmatlib_bench_input.vmlb";
+	const std::string output_path = "vecmatlib_bench_output.vmlb";
+	std::vector<Vector<T, 3>> points ( COUNT );
+	Matrix<T, 3, 3> R;
+	benchFill ( R );
+
+	for ( auto& p : points )
+		benchFill ( p );
+
+	writeBinary ( input_path, points.data(), points.data() + points.size() );
+
+	for ( auto _ : state )
+		transformStream<Vector<T, 3>> ( input_path, output_path, [&R] ( const Vector<T, 3>* it_beg,
+										const Vector<T, 3>* it_end, Vector<T, 3>* out_beg )
+			{
+			benchRotateChunk ( R, it_beg, it_end, out_beg );
+			}, CHUNK );
+
+	std::remove ( input_path.c_str() );
+	std::remove ( output_path.c_str() );
+	state.SetBytesProcessed ( state.iterations() * COUNT * sizeof ( Vector<T, 3> ) );
+	}
+
+// I/O runs in background tasks, real time is measured
+BENCHMARK_TEMPLATE ( BM_StreamTransform_Sequential, double, 1 << 21, 1 << 16 )->UseRealTime();
+BENCHMARK_TEMPLATE ( BM_StreamTransform, double, 1 << 21, 1 << 16 )->UseRealTime();
+BENCHMARK_TEMPLATE ( BM_StreamTransform, double, 1 << 21, 1 << 12 )->UseRealTime();
+
+#endif // STREAMIOBENCH_HPP
@@ -0,0 +1,282 @@
+#ifndef SUITEBENCH_HPP
+#define SUITEBENCH_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+/*
+ * Suite of basic operations over element types int, float, double and sizes
+ * 2 to 512 with uniform counters: ns/op, GFLOP/s (integer operations for int)
+ * and bytes_per_second. Run with
+ *
+ *   bench --benchmark_filter=BM_Suite --benchmark_out=current.json --benchmark_out_format=json
+ *
+ * and compare with stored baseline by bench/compare.py baseline.json current.json
+ * (tasks TASK_BenchBaseline and TASK_BenchCompare rebuild bench before the run).
+ */
+
+/**
+ * @brief Set counters of benchmark with ops operations per iteration,
+ * flops arithmetic operations and bytes of memory traffic per iteration
+ *
+ * @param state state of benchmark
+ * @param ops number of operations per iteration
+ * @param flops number of arithmetic operations per iteration, 0 when not countable
+ * @param bytes number of bytes read and written per iteration
+ */
+inline void benchSuiteCounters ( benchmark::State& state, double ops, double flops, double bytes )
+	{
+	// inverted rate of 1e-9 * ops is nanoseconds per operation
+	state.counters["ns/op"] = benchmark::Counter ( ops * 1e-9, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert );
+
+	if ( flops > 0 )
+		state.counters["GFLOP/s"] = benchmark::Counter ( flops * 1e-9, benchmark::Counter::kIsIterationInvariantRate );
+
+	state.SetItemsProcessed ( std::int64_t ( state.iterations() * ops ) );
+	state.SetBytesProcessed ( std::int64_t ( state.iterations() * bytes ) );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_Suite_Dot ( benchmark::State& state )
+	{
+	Vector<T, SIZE> a, b;
+	benchFill ( a );
+	benchFill ( b );
+
+	for ( auto _ : state )
+		{
+		benchmark::DoNotOptimize ( a );
+		T value = a.dot ( b );
+		benchmark::DoNotOptimize ( value );
+		}
+
+	benchSuiteCounters ( state, 1, 2.0 * SIZE, 2.0 * SIZE * sizeof ( T ) );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_Suite_Add ( benchmark::State& state )
+	{
+	Vector<T, SIZE> a, b, out;
+	benchFill ( a );
+	benchFill ( b );
+
+	for ( auto _ : state )
+		{
+		benchmark::DoNotOptimize ( a );
+		out = a + b;
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	benchSuiteCounters ( state, 1, SIZE, 3.0 * SIZE * sizeof ( T ) );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_Suite_Scale ( benchmark::State& state )
+	{
+	Vector<T, SIZE> a, out;
+	T value = T ( 3 );
+	benchFill ( a );
+
+	for ( auto _ : state )
+		{
+		benchmark::DoNotOptimize ( value );
+		out = a * value;
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	benchSuiteCounters ( state, 1, SIZE, 2.0 * SIZE * sizeof ( T ) );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_Suite_MatrixVector ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	Vector<T, SIZE> v, out;
+	benchFill ( *M );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		benchmark::DoNotOptimize ( v );
+		cauchyProduct ( *M, v, out );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	benchSuiteCounters ( state, 1, 2.0 * SIZE * SIZE, ( double ( SIZE ) * SIZE + 2.0 * SIZE ) * sizeof ( T ) );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_Suite_TransposedMatrixVector ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	Vector<T, SIZE> v, out;
+	benchFill ( *M );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		benchmark::DoNotOptimize ( v );
+		transposedCauchyProduct ( *M, v, out );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	benchSuiteCounters ( state, 1, 2.0 * SIZE * SIZE, ( double ( SIZE ) * SIZE + 2.0 * SIZE ) * sizeof ( T ) );
+	}
+
+template<typename T, unsigned SIZE>
+static void BM_Suite_MatrixMatrix ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> A ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> B ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> out ( new Matrix<T, SIZE, SIZE> );
+	benchFill ( *A );
+	benchFill ( *B );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct ( *A, *B, *out );
+		benchmark::ClobberMemory();
+		}
+
+	benchSuiteCounters ( state, 1, 2.0 * SIZE * SIZE * SIZE, 3.0 * SIZE * SIZE * sizeof ( T ) );
+	}
+
+/**
+ * @brief Batch of 4096 Vectors of 3 elements
+ */
+template<typename T>
+inline std::vector<Vector<T, 3>> benchSuiteBatch()
+	{
+	std::vector<Vector<T, 3>> batch ( 4096 );
+	unsigned i = 0;
+
+	for ( Vector<T, 3>& v : batch )
+		for ( T& x : v )
+			x = T ( ( i++ % 23 ) * 0.125 + 0.5 );
+
+	return batch;
+	}
+
+template<typename T>
+static void BM_Suite_Cross ( benchmark::State& state )
+	{
+	const std::vector<Vector<T, 3>> a = benchSuiteBatch<T>();
+	std::vector<Vector<T, 3>> out ( a.size() );
+	Vector<T, 3> b { T ( 1 ), T ( -2 ), T ( 3 ) };
+
+	for ( auto _ : state )
+		{
+		for ( std::size_t n = 0; n < a.size(); ++n )
+			crossProduct ( a[n], b, out[n] );
+
+		benchmark::ClobberMemory();
+		}
+
+	benchSuiteCounters ( state, double ( a.size() ), 9.0 * a.size(), 6.0 * a.size() * sizeof ( T ) );
+	}
+
+template<typename T>
+static void BM_Suite_Rotate ( benchmark::State& state )
+	{
+	const std::vector<Vector<T, 3>> a = benchSuiteBatch<T>();
+	std::vector<Vector<T, 3>> out ( a.size() );
+	const Matrix<T, 3, 3> R = rotationMatrix ( Vector<T, 3> { T ( 0.1 ), T ( 0.2 ), T ( 0.3 ) } );
+
+	for ( auto _ : state )
+		{
+		for ( std::size_t n = 0; n < a.size(); ++n )
+			cauchyProduct ( R, a[n], out[n] );
+
+		benchmark::ClobberMemory();
+		}
+
+	benchSuiteCounters ( state, double ( a.size() ), 15.0 * a.size(), 6.0 * a.size() * sizeof ( T ) );
+	}
+
+template<typename T>
+static void BM_Suite_RotationMatrix ( benchmark::State& state )
+	{
+	const std::vector<Vector<T, 3>> angles = benchSuiteBatch<T>();
+	std::vector<Matrix<T, 3, 3>> out ( angles.size() );
+
+	for ( auto _ : state )
+		{
+		for ( std::size_t n = 0; n < angles.size(); ++n )
+			out[n] = rotationMatrix ( angles[n] );
+
+		benchmark::ClobberMemory();
+		}
+
+	benchSuiteCounters ( state, double ( angles.size() ), 0, 12.0 * angles.size() * sizeof ( T ) );
+	}
+
+/**
+ * @brief Conversion of batch of coordinates by CONVERSION,
+ * operations are dominated by trigonometric functions and not counted as flops
+ */
+template<typename T, Vector<T, 3> ( *CONVERSION ) ( const Vector<T, 3>& )>
+static void BM_Suite_Convert ( benchmark::State& state )
+	{
+	const std::vector<Vector<T, 3>> a = benchSuiteBatch<T>();
+	std::vector<Vector<T, 3>> out ( a.size() );
+
+	for ( auto _ : state )
+		{
+		for ( std::size_t n = 0; n < a.size(); ++n )
+			out[n] = CONVERSION ( a[n] );
+
+		benchmark::ClobberMemory();
+		}
+
+	benchSuiteCounters ( state, double ( a.size() ), 0, 6.0 * a.size() * sizeof ( T ) );
+	}
+
+#define SUITE_BENCHMARKS(T, SIZE) \
+	BENCHMARK_TEMPLATE ( BM_Suite_Dot, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_Add, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_Scale, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_MatrixVector, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_TransposedMatrixVector, T, SIZE ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_MatrixMatrix, T, SIZE );
+
+#define SUITE_SIZES(T) \
+	SUITE_BENCHMARKS ( T, 2 ) \
+	SUITE_BENCHMARKS ( T, 3 ) \
+	SUITE_BENCHMARKS ( T, 4 ) \
+	SUITE_BENCHMARKS ( T, 8 ) \
+	SUITE_BENCHMARKS ( T, 16 ) \
+	SUITE_BENCHMARKS ( T, 32 ) \
+	SUITE_BENCHMARKS ( T, 64 ) \
+	SUITE_BENCHMARKS ( T, 128 ) \
+	SUITE_BENCHMARKS ( T, 256 ) \
+	SUITE_BENCHMARKS ( T, 512 )
+
+#define SUITE_CONVERSIONS(T) \
+	BENCHMARK_TEMPLATE ( BM_Suite_Rotate, T ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_RotationMatrix, T ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_Convert, T, sphericalToCartesian<T> ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_Convert, T, cartesianToSpherical<T> ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_Convert, T, cylindricalToCartesian<T> ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_Convert, T, cartesianToCylindrical<T> ); \
+	BENCHMARK_TEMPLATE ( BM_Suite_Convert, T, cartesianToAngles<T> );
+
+SUITE_SIZES ( int )
+SUITE_SIZES ( float )
+SUITE_SIZES ( double )
+
+BENCHMARK_TEMPLATE ( BM_Suite_Cross, int );
+BENCHMARK_TEMPLATE ( BM_Suite_Cross, float );
+BENCHMARK_TEMPLATE ( BM_Suite_Cross, double );
+// rotations and conversions of coordinates are defined for floating point
+SUITE_CONVERSIONS ( float )
+SUITE_CONVERSIONS ( double )
+
+#endif // SUITEBENCH_HPP
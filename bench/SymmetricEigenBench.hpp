@@ -0,0 +1,103 @@
+#ifndef SYMMETRICEIGENBENCH_HPP
+#define SYMMETRICEIGENBENCH_HPP
+
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Matrix.hpp"
+#include "SymmetricEigen.hpp"
+
+/**
+ * @brief Fill range of covariance matrices of deterministic point sets
+ */
+template<typename T>
+inline void benchFillCovariances ( std::vector<Matrix<T, 3, 3>>& matrices )
+	{
+	unsigned seed = 1;
+
+	for ( Matrix<T, 3, 3>& m : matrices )
+		{
+		m.fill ( T ( 0 ) );
+
+		for ( unsigned n = 0; n < 8; ++n )
+			{
+			T p[3];
+
+			for ( T& x : p )
+				{
+				seed = seed * 1664525u + 1013904223u;
+				x = T ( seed >> 8 ) / T ( 1u << 24 ) - T ( 0.5 );
+				}
+
+			// flattened point sets like surface patches
+			p[2] *= T ( 0.05 );
+
+			for ( unsigned i = 0; i < 3; ++i )
+				for ( unsigned j = 0; j < 3; ++j )
+					m ( i, j ) += p[i] * p[j];
+			}
+		}
+	}
+
+template<typename T>
+static void BM_SymmetricEigen ( benchmark::State& state )
+	{
+	std::vector<Matrix<T, 3, 3>> matrices ( 4096 );
+	std::vector<Vector<T, 3>> values ( matrices.size() );
+	std::vector<Matrix<T, 3, 3>> vectors ( matrices.size() );
+	benchFillCovariances ( matrices );
+
+	for ( auto _ : state )
+		{
+		for ( unsigned n = 0; n < matrices.size(); ++n )
+			symmetricEigen ( matrices[n], values[n], vectors[n] );
+
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * matrices.size() );
+	}
+
+template<typename T>
+static void BM_SymmetricEigenJacobi ( benchmark::State& state )
+	{
+	std::vector<Matrix<T, 3, 3>> matrices ( 4096 );
+	std::vector<Vector<T, 3>> values ( matrices.size() );
+	std::vector<Matrix<T, 3, 3>> vectors ( matrices.size() );
+	benchFillCovariances ( matrices );
+
+	for ( auto _ : state )
+		{
+		for ( unsigned n = 0; n < matrices.size(); ++n )
+			symmetricEigenJacobi ( matrices[n], values[n], vectors[n] );
+
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * matrices.size() );
+	}
+
+template<typename T>
+static void BM_SymmetricEigenBatch ( benchmark::State& state )
+	{
+	std::vector<Matrix<T, 3, 3>> matrices ( 4096 );
+	std::vector<Vector<T, 3>> values ( matrices.size() );
+	std::vector<Matrix<T, 3, 3>> vectors ( matrices.size() );
+	benchFillCovariances ( matrices );
+
+	for ( auto _ : state )
+		{
+		symmetricEigenBatch ( matrices.begin(), matrices.end(), values.begin(), vectors.begin() );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * matrices.size() );
+	}
+
+BENCHMARK_TEMPLATE ( BM_SymmetricEigen, float );
+BENCHMARK_TEMPLATE ( BM_SymmetricEigen, double );
+BENCHMARK_TEMPLATE ( BM_SymmetricEigenJacobi, float );
+BENCHMARK_TEMPLATE ( BM_SymmetricEigenJacobi, double );
+BENCHMARK_TEMPLATE ( BM_SymmetricEigenBatch, float );
+BENCHMARK_TEMPLATE ( BM_SymmetricEigenBatch, double );
+
+#endif // SYMMETRICEIGENBENCH_HPP
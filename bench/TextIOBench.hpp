@@ -0,0 +1,142 @@
+#ifndef TEXTIOBENCH_HPP
+#define TEXTIOBENCH_HPP
+
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Vector.hpp"
+#include "TextIO.hpp"
+
+/**
+ * @brief Points with coordinates of full precision
+ */
+template<typename T>
+inline std::vector<Vector<T, 3>> benchTextPoints ( unsigned count )
+	{
+	std::vector<Vector<T, 3>> points ( count );
+
+	for ( unsigned i = 0; i < count; ++i )
+		points[i] = Vector<T, 3> { T ( i ) / T ( 7 ), T ( -1 ) / T ( i + 3 ), T ( i ) * T ( 1e5 ) };
+
+	return points;
+	}
+
+/**
+ * @brief Points written by stream element by element with round trip precision,
+ * as done before formatting by TextIO
+ */
+template<typename T, unsigned COUNT>
+static void BM_TextDump_Stream ( benchmark::State& state )
+	{
+	const std::vector<Vector<T, 3>> points = benchTextPoints<T> ( COUNT );
+	std::size_t size = 0;
+
+	for ( auto _ : state )
+		{
+		std::ostringstream out;
+		out.precision ( std::numeric_limits<T>::max_digits10 );
+
+		for ( const Vector<T, 3>& p : points )
+			out << p.x[0] << ',' << p.x[1] << ',' << p.x[2] << '\n';
+
+		size = out.str().size();
+		benchmark::DoNotOptimize ( size );
+		}
+
+	state.SetItemsProcessed ( state.iterations() * COUNT );
+	state.SetBytesProcessed ( state.iterations() * size );
+	}
+
+/**
+ * @brief Points written as CSV by writeText with shortest round trip text
+ */
+template<typename T, unsigned COUNT>
+static void BM_TextDump_Format ( benchmark::State& state )
+	{
+	const std::vector<Vector<T, 3>> points = benchTextPoints<T> ( COUNT );
+	std::size_t size = 0;
+
+	for ( auto _ : state )
+		{
+		std::ostringstream out;
+		writeText ( out, points.begin(), points.end(), TextIO::Format ( TextIO::CSV ) );
+		size = out.str().size();
+		benchmark::DoNotOptimize ( size );
+		}
+
+	state.SetItemsProcessed ( state.iterations() * COUNT );
+	state.SetBytesProcessed ( state.iterations() * size );
+	}
+
+/**
+ * @brief CSV text of COUNT points
+ */
+template<typename T>
+inline std::string benchTextCSV ( unsigned count )
+	{
+	const std::vector<Vector<T, 3>> points = benchTextPoints<T> ( count );
+	std::ostringstream out;
+	writeText ( out, points.begin(), points.end(), TextIO::Format ( TextIO::CSV ) );
+
+	return out.str();
+	}
+
+/**
+ * @brief CSV points parsed line by line by std::stod into initializer list
+ * of Vector, as done before parsing by TextIO
+ */
+template<typename T, unsigned COUNT>
+static void BM_TextParse_Stod ( benchmark::State& state )
+	{
+	const std::string text = benchTextCSV<T> ( COUNT );
+
+	for ( auto _ : state )
+		{
+		std::istringstream in ( text );
+		std::vector<Vector<T, 3>> points;
+		std::string line;
+
+		while ( std::getline ( in, line ) )
+			{
+			std::size_t first, second;
+			const T x = T ( std::stod ( line, &first ) );
+			const T y = T ( std::stod ( line.substr ( first + 1 ), &second ) );
+			const T z = T ( std::stod ( line.substr ( first + second + 2 ) ) );
+			points.push_back ( Vector<T, 3> { x, y, z } );
+			}
+
+		benchmark::DoNotOptimize ( points.data() );
+		}
+
+	state.SetBytesProcessed ( state.iterations() * text.size() );
+	}
+
+/**
+ * @brief CSV points parsed by parseText in THREADS parts
+ */
+template<typename T, unsigned COUNT, unsigned THREADS>
+static void BM_TextParse ( benchmark::State& state )
+	{
+	const std::string text = benchTextCSV<T> ( COUNT );
+
+	for ( auto _ : state )
+		{
+		std::vector<Vector<T, 3>> points = parseText<Vector<T, 3>> ( text.data(), text.data() + text.size(), THREADS );
+		benchmark::DoNotOptimize ( points.data() );
+		}
+
+	state.SetBytesProcessed ( state.iterations() * text.size() );
+	}
+
+BENCHMARK_TEMPLATE ( BM_TextDump_Stream, double, 1 << 16 );
+BENCHMARK_TEMPLATE ( BM_TextDump_Format, double, 1 << 16 );
+BENCHMARK_TEMPLATE ( BM_TextDump_Stream, float, 1 << 16 );
+BENCHMARK_TEMPLATE ( BM_TextDump_Format, float, 1 << 16 );
+BENCHMARK_TEMPLATE ( BM_TextParse_Stod, double, 1 << 16 );
+BENCHMARK_TEMPLATE ( BM_TextParse, double, 1 << 16, 1 );
+// parts in threads, real time is measured
+BENCHMARK_TEMPLATE ( BM_TextParse, double, 1 << 16, 4 )->UseRealTime();
+
+#endif // TEXTIOBENCH_HPP
@@ -0,0 +1,180 @@
+#ifndef VIEWBENCH_HPP
+#define VIEWBENCH_HPP
+
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "View.hpp"
+
+/**
+ * @brief Matrix Vector product of external buffer with padded rows
+ * copied into Matrix before multiplication
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_ExternalMatrixVectorMul_Copy ( benchmark::State& state )
+	{
+	const unsigned STRIDE = COLS + 16;
+	std::vector<T> buffer ( ROWS * std::size_t ( STRIDE ) );
+	std::unique_ptr<Matrix<T, ROWS, COLS>> M ( new Matrix<T, ROWS, COLS> );
+	Vector<T, COLS> v;
+	Vector<T, ROWS> out;
+	benchFill ( buffer );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		for ( unsigned i = 0; i < ROWS; ++i )
+			Container::copy ( M->begin ( i ), M->end ( i ), buffer.data() + std::size_t ( i ) * STRIDE );
+
+		out = *M * v;
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * ROWS * COLS );
+	}
+
+/**
+ * @brief Matrix Vector product of external buffer with padded rows through view
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+static void BM_ExternalMatrixVectorMul_View ( benchmark::State& state )
+	{
+	const unsigned STRIDE = COLS + 16;
+	std::vector<T> buffer ( ROWS * std::size_t ( STRIDE ) );
+	Vector<T, COLS> v;
+	Vector<T, ROWS> out;
+	benchFill ( buffer );
+	benchFill ( v );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct ( MatrixView<const T, ROWS, COLS> ( buffer.data(), STRIDE ), v, out );
+		benchmark::DoNotOptimize ( out.x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * ROWS * COLS );
+	}
+
+/**
+ * @brief Block update D -= C B of Matrix [ A B; C D ] with blocks copied
+ * into Matrices by loops over rows and copied back, row streaming product
+ * of Matrices as for views
+ */
+template<typename T, unsigned SIZE>
+static void BM_BlockUpdate_Copy ( benchmark::State& state )
+	{
+	const unsigned HALF = SIZE / 2;
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, HALF, HALF>> B ( new Matrix<T, HALF, HALF> );
+	std::unique_ptr<Matrix<T, HALF, HALF>> C ( new Matrix<T, HALF, HALF> );
+	std::unique_ptr<Matrix<T, HALF, HALF>> D ( new Matrix<T, HALF, HALF> );
+	std::unique_ptr<Matrix<T, HALF, HALF>> CB ( new Matrix<T, HALF, HALF> );
+	benchFill ( *M );
+
+	for ( auto _ : state )
+		{
+		for ( unsigned i = 0; i < HALF; ++i )
+			{
+			Container::copy ( B->begin ( i ), B->end ( i ), M->begin ( i ) + HALF );
+			Container::copy ( C->begin ( i ), C->end ( i ), M->begin ( i + HALF ) );
+			Container::copy ( D->begin ( i ), D->end ( i ), M->begin ( i + HALF ) + HALF );
+			}
+
+		wideCauchyProduct ( *C, *B, *CB );
+		*D -= *CB;
+
+		for ( unsigned i = 0; i < HALF; ++i )
+			Container::copy ( M->begin ( i + HALF ) + HALF, M->end ( i + HALF ), D->begin ( i ) );
+
+		benchmark::DoNotOptimize ( M->x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * HALF * HALF * HALF );
+	}
+
+/**
+ * @brief Block update D -= C B of Matrix [ A B; C D ] through block views
+ */
+template<typename T, unsigned SIZE>
+static void BM_BlockUpdate_View ( benchmark::State& state )
+	{
+	const unsigned HALF = SIZE / 2;
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> M ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, HALF, HALF>> CB ( new Matrix<T, HALF, HALF> );
+	benchFill ( *M );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct ( M->template block<HALF, HALF> ( HALF, 0 ), M->template block<HALF, HALF> ( 0, HALF ), *CB );
+		M->template block<HALF, HALF> ( HALF, HALF ) -= *CB;
+		benchmark::DoNotOptimize ( M->x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * HALF * HALF * HALF );
+	}
+
+/**
+ * @brief Outer product of Vectors with second copied into single row Matrix
+ */
+template<typename T, unsigned SIZE>
+static void BM_OuterProduct_Copy ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> out ( new Matrix<T, SIZE, SIZE> );
+	Matrix<T, 1, SIZE> r;
+	Vector<T, SIZE> v;
+	Vector<T, SIZE> w;
+	benchFill ( v );
+	benchFill ( w );
+
+	for ( auto _ : state )
+		{
+		Container::copy ( r.begin(), r.end(), w.begin() );
+		cauchyProduct ( v, r, *out );
+		benchmark::DoNotOptimize ( out->x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * SIZE * SIZE );
+	}
+
+/**
+ * @brief Outer product of Vector and other Vector viewed as row
+ */
+template<typename T, unsigned SIZE>
+static void BM_OuterProduct_View ( benchmark::State& state )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> out ( new Matrix<T, SIZE, SIZE> );
+	Vector<T, SIZE> v;
+	Vector<T, SIZE> w;
+	benchFill ( v );
+	benchFill ( w );
+
+	for ( auto _ : state )
+		{
+		cauchyProduct ( v, w.asRow(), *out );
+		benchmark::DoNotOptimize ( out->x );
+		benchmark::ClobberMemory();
+		}
+
+	state.SetItemsProcessed ( state.iterations() * SIZE * SIZE );
+	}
+
+BENCHMARK_TEMPLATE ( BM_ExternalMatrixVectorMul_Copy, float, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_ExternalMatrixVectorMul_View, float, 256, 256 );
+BENCHMARK_TEMPLATE ( BM_ExternalMatrixVectorMul_Copy, double, 1024, 1024 );
+BENCHMARK_TEMPLATE ( BM_ExternalMatrixVectorMul_View, double, 1024, 1024 );
+
+BENCHMARK_TEMPLATE ( BM_BlockUpdate_Copy, float, 256 );
+BENCHMARK_TEMPLATE ( BM_BlockUpdate_View, float, 256 );
+BENCHMARK_TEMPLATE ( BM_BlockUpdate_Copy, double, 512 );
+BENCHMARK_TEMPLATE ( BM_BlockUpdate_View, double, 512 );
+BENCHMARK_TEMPLATE ( BM_OuterProduct_Copy, float, 256 );
+BENCHMARK_TEMPLATE ( BM_OuterProduct_View, float, 256 );
+
+#endif // VIEWBENCH_HPP
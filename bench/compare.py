@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""
+Compare JSON output of Google Benchmark with stored baseline.
+
+    bench --benchmark_filter=BM_Suite --benchmark_out=baseline.json --benchmark_out_format=json
+    ... change code, rebuild ...
+    bench --benchmark_filter=BM_Suite --benchmark_out=current.json --benchmark_out_format=json
+    python3 compare.py baseline.json current.json [--metric ns/op] [--threshold 5] [--fail]
+
+Benchmarks are matched by name, with repetitions the mean aggregate is used.
+Change is relative difference of metric, positive change is always improvement:
+lower time or higher rate. Benchmarks slower by more than threshold percent
+are marked as regressions, --fail exits with status 1 when there is any.
+"""
+
+import argparse
+import json
+import sys
+
+# metrics where lower value is better, times are normalized to nanoseconds
+TIMES = ( "cpu_time", "real_time", "ns/op" )
+UNITS = { "ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9 }
+
+
+def load ( path ):
+    """Map of benchmark name to its entry, mean of repetitions when present."""
+    with open ( path ) as file:
+        benchmarks = json.load ( file )[ "benchmarks" ]
+
+    result = {}
+
+    for entry in benchmarks:
+        name = entry.get ( "run_name", entry[ "name" ] )
+
+        if entry.get ( "run_type" ) == "aggregate":
+            if entry.get ( "aggregate_name" ) == "mean":
+                result[ name ] = entry
+        elif name not in result:
+            result[ name ] = entry
+
+    return result
+
+
+def value ( entry, metric ):
+    """Value of metric of entry, None when entry has no such metric."""
+    if metric not in entry:
+        return None
+
+    if metric in ( "cpu_time", "real_time" ):
+        return entry[ metric ] * UNITS[ entry.get ( "time_unit", "ns" ) ]
+
+    return entry[ metric ]
+
+
+def main():
+    parser = argparse.ArgumentParser ( description = "Compare Google Benchmark JSON output with baseline." )
+    parser.add_argument ( "baseline", help = "JSON output of baseline run" )
+    parser.add_argument ( "current", help = "JSON output of current run" )
+    parser.add_argument ( "--metric", default = "cpu_time",
+                          help = "cpu_time, real_time, ns/op, GFLOP/s, bytes_per_second or other counter" )
+    parser.add_argument ( "--threshold", type = float, default = 5.0, help = "regression threshold in percent" )
+    parser.add_argument ( "--fail", action = "store_true", help = "exit with status 1 on regression" )
+    args = parser.parse_args()
+
+    baseline = load ( args.baseline )
+    current = load ( args.current )
+    lower_better = args.metric in TIMES
+    regressions = 0
+    rows = []
+
+    for name, entry in current.items():
+        if name not in baseline:
+            rows.append ( ( name, None, value ( entry, args.metric ), None, "new" ) )
+            continue
+
+        old = value ( baseline[ name ], args.metric )
+        new = value ( entry, args.metric )
+
+        if old is None or new is None or old == 0 or new == 0:
+            rows.append ( ( name, old, new, None, "" ) )
+            continue
+
+        change = ( old / new - 1.0 if lower_better else new / old - 1.0 ) * 100.0
+        mark = ""
+
+        if change < -args.threshold:
+            mark = "REGRESSION"
+            regressions += 1
+        elif change > args.threshold:
+            mark = "improved"
+
+        rows.append ( ( name, old, new, change, mark ) )
+
+    for name in baseline:
+        if name not in current:
+            rows.append ( ( name, value ( baseline[ name ], args.metric ), None, None, "missing" ) )
+
+    width = max ( [ len ( row[ 0 ] ) for row in rows ] + [ 9 ] )
+    print ( "%-*s %14s %14s %9s" % ( width, "Benchmark", "baseline", "current", "change" ) )
+
+    def number ( x ):
+        return "%14s" % ( "-" if x is None else "%.4g" % x )
+
+    for name, old, new, change, mark in rows:
+        print ( "%-*s %s %s %9s %s" % ( width, name, number ( old ), number ( new ),
+                                          "-" if change is None else "%+.1f%%" % change, mark ) )
+
+    print ( "%d benchmarks, %d regressions by more than %g%% of %s" % ( len ( rows ), regressions, args.threshold, args.metric ) )
+
+    return 1 if args.fail and regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit ( main() )
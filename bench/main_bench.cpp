@@ -0,0 +1,31 @@
+#include <benchmark/benchmark.h>
+
+#include "MatrixVectorBench.hpp"
+#include "LUBench.hpp"
+#include "CholeskyBench.hpp"
+#include "QRBench.hpp"
+#include "SymmetricEigenBench.hpp"
+#include "SVDBench.hpp"
+#include "SparseMatrixBench.hpp"
+#include "BandedBench.hpp"
+#include "RotationBench.hpp"
+#include "StrassenBench.hpp"
+#include "HalfBench.hpp"
+#include "QuantizedBench.hpp"
+#include "ViewBench.hpp"
+#include "BinaryIOBench.hpp"
+#include "StreamIOBench.hpp"
+#include "TextIOBench.hpp"
+#include "NpyBench.hpp"
+#include "SuiteBench.hpp"
+
+int main ( int argn, char* args[] )
+	{
+	// initialize Google Benchmark
+	benchmark::Initialize ( &argn, args );
+	// execute benchmarks
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+	}
@@ -0,0 +1,637 @@
+#ifndef BANDED_HPP
+#define BANDED_HPP
+
+#include <type_traits>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+
+/**
+ * @brief Tridiagonal square Matrix stored by its three diagonals.
+ * lower(i) = a(i, i-1) with lower(0) unused, diagonal(i) = a(i, i),
+ * upper(i) = a(i, i+1) with upper(SIZE-1) unused.
+ *
+ * @tparam T type of elements
+ * @tparam SIZE number of rows and cols
+ */
+template<typename T, unsigned SIZE>
+class TridiagonalMatrix
+	{
+		static_assert ( SIZE > 0, "Tridiagonal matrix must not be empty." );
+
+	public:
+		Vector<T, SIZE> lower;
+		Vector<T, SIZE> diagonal;
+		Vector<T, SIZE> upper;
+
+	public:
+		/**
+		 * @brief Tridiagonal Matrix default constructor
+		 *
+		 */
+		TridiagonalMatrix()
+			{
+			}
+
+		/**
+		 * @brief Tridiagonal Matrix with constant diagonals, like {-1, 2, -1} of 1D Laplacian
+		 *
+		 * @param lower_value value below diagonal
+		 * @param diagonal_value value on diagonal
+		 * @param upper_value value above diagonal
+		 */
+		TridiagonalMatrix ( T lower_value, T diagonal_value, T upper_value )
+			: lower ( lower_value ), diagonal ( diagonal_value ), upper ( upper_value )
+			{
+			}
+
+		/**
+		 * @brief Element at position (i, j), zero outside of diagonals
+		 *
+		 * @param i row
+		 * @param j col
+		 * @return T
+		 */
+		T operator() ( unsigned i, unsigned j ) const
+			{
+			if ( i == j )
+				return diagonal.x[i];
+
+			if ( i == j+1 )
+				return lower.x[i];
+
+			if ( i+1 == j )
+				return upper.x[i];
+
+			return T ( 0 );
+			}
+
+		/**
+		 * @brief Dense copy of tridiagonal Matrix
+		 *
+		 * @tparam U type of dense Matrix
+		 * @param m dense Matrix
+		 */
+		template<typename U>
+		void toDense ( Matrix<U, SIZE, SIZE>& m ) const
+			{
+			m.fill ( U ( 0 ) );
+
+			for ( unsigned i = 0; i < SIZE; ++i )
+				{
+				m.x[i][i] = U ( diagonal.x[i] );
+
+				if ( i > 0 )
+					m.x[i][i-1] = U ( lower.x[i] );
+
+				if ( i+1 < SIZE )
+					m.x[i][i+1] = U ( upper.x[i] );
+				}
+			}
+	};
+
+/**
+ * @brief Computing tridiagonal Matrix Vector multiplication
+ *
+ * @tparam Tt type of tridiagonal Matrix
+ * @tparam U type of Vector
+ * @tparam T_U type of output Vector
+ * @tparam SIZE size of Matrix and Vectors
+ * @param first tridiagonal Matrix
+ * @param second Vector
+ * @param output Vector result of multiplication
+ */
+template<typename Tt,
+		 typename U,
+		 typename T_U,
+		 unsigned SIZE>
+void cauchyProduct ( const TridiagonalMatrix<Tt, SIZE>& first,
+					 const Vector<U, SIZE>& second,
+					 Vector<T_U, SIZE>& output )
+	{
+	output.x[0] = first.diagonal.x[0] * second.x[0];
+
+	for ( unsigned i = 1; i < SIZE; ++i )
+		output.x[i] = first.lower.x[i] * second.x[i-1] + first.diagonal.x[i] * second.x[i];
+
+	for ( unsigned i = 0; i+1 < SIZE; ++i )
+		output.x[i] += first.upper.x[i] * second.x[i+1];
+	}
+
+/**
+ * @brief Solve tridiagonal system m*x = b by Thomas algorithm,
+ * Gaussian elimination without pivoting in O(SIZE) operations.
+ * Stable for diagonally dominant or symmetric positive definite Matrix.
+ * Solution of system with zero pivot is not written.
+ *
+ * @tparam T type of Matrix
+ * @tparam U type of right side
+ * @tparam T_U type of solution
+ * @tparam SIZE size of system
+ * @param m tridiagonal Matrix
+ * @param b right side
+ * @param x solution, can be the same object as b
+ * @return bool false if zero pivot occured
+ */
+template<typename T,
+		 typename U,
+		 typename T_U,
+		 unsigned SIZE>
+bool tridiagonalSolve ( const TridiagonalMatrix<T, SIZE>& m, const Vector<U, SIZE>& b, Vector<T_U, SIZE>& x )
+	{
+	// modified upper diagonal c' and right side d'
+	T_U c[SIZE];
+	T_U d[SIZE];
+	T_U pivot = m.diagonal.x[0];
+
+	if ( pivot == T_U ( 0 ) )
+		return false;
+
+	c[0] = m.upper.x[0] / pivot;
+	d[0] = b.x[0] / pivot;
+
+	for ( unsigned i = 1; i < SIZE; ++i )
+		{
+		pivot = m.diagonal.x[i] - m.lower.x[i] * c[i-1];
+
+		if ( pivot == T_U ( 0 ) )
+			return false;
+
+		const T_U inverse_pivot = T_U ( 1 ) / pivot;
+
+		c[i] = m.upper.x[i] * inverse_pivot;
+		d[i] = ( b.x[i] - m.lower.x[i] * d[i-1] ) * inverse_pivot;
+		}
+
+	x.x[SIZE-1] = d[SIZE-1];
+
+	for ( unsigned i = SIZE-1; i-- > 0; )
+		x.x[i] = d[i] - c[i] * x.x[i+1];
+
+	return true;
+	}
+
+/**
+ * @brief Solve range of independent small tridiagonal systems by Thomas algorithm.
+ * Systems are processed in groups of 32, transposed to structure of arrays on stack,
+ * so elimination is vectorized over systems.
+ * Containers pointered by rhs_beg, out_beg and regular_beg must be the same size
+ * as container pointered by it_beg.
+ * Solution of system with zero pivot is not defined, it is reported
+ * by false at corresponding position of regular_beg.
+ *
+ * @tparam Iterator Forward Iterator to TridiagonalMatrix<T, SIZE>
+ * @tparam ConstIterator Const Forward Iterator to TridiagonalMatrix<T, SIZE>
+ * @tparam Iterator2 Forward Iterator to Vector<T, SIZE> right side
+ * @tparam Iterator3 Forward Iterator to Vector<T, SIZE> solution
+ * @tparam Iterator4 Forward Iterator to bool
+ * @param it_beg iterator at beginning of range of matrices
+ * @param it_end iterator after end of range of matrices
+ * @param rhs_beg iterator at beginning of range of right sides
+ * @param out_beg iterator at beginning of range of solutions
+ * @param regular_beg iterator at beginning of range of flags
+ * @return unsigned number of systems with zero pivot
+ */
+template<typename Iterator,
+		 typename ConstIterator,
+		 typename Iterator2,
+		 typename Iterator3,
+		 typename Iterator4>
+unsigned tridiagonalSolveBatch ( Iterator it_beg, ConstIterator it_end, Iterator2 rhs_beg, Iterator3 out_beg, Iterator4 regular_beg )
+	{
+	using T = std::remove_cv_t<std::remove_reference_t<decltype ( it_beg->diagonal.x[0] )>>;
+	static const unsigned SIZE = sizeof ( it_beg->diagonal.x ) / sizeof ( T );
+	static const unsigned LANES = 32;
+	static const TridiagonalMatrix<T, SIZE> identity ( T ( 0 ), T ( 1 ), T ( 0 ) );
+	static const Vector<T, SIZE> zero ( T ( 0 ) );
+	unsigned singular = 0;
+
+	while ( it_beg != it_end )
+		{
+		// lower, diagonal, upper and right side, upper and right side are overwritten by c' and d'
+		T a[SIZE][LANES];
+		T b[SIZE][LANES];
+		T c[SIZE][LANES];
+		T d[SIZE][LANES];
+		// unused lanes get identity system
+		const TridiagonalMatrix<T, SIZE>* systems[LANES];
+		const Vector<T, SIZE>* rhs[LANES];
+		unsigned count = 0;
+
+		for ( ; count < LANES && it_beg != it_end; ++count, ++it_beg, ++rhs_beg )
+			{
+			systems[count] = &*it_beg;
+			rhs[count] = &*rhs_beg;
+			}
+
+		for ( unsigned l = count; l < LANES; ++l )
+			{
+			systems[l] = &identity;
+			rhs[l] = &zero;
+			}
+
+		// transposition row by row, stores into lanes are contiguous
+		for ( unsigned i = 0; i < SIZE; ++i )
+			for ( unsigned l = 0; l < LANES; ++l )
+				{
+				a[i][l] = systems[l]->lower.x[i];
+				b[i][l] = systems[l]->diagonal.x[i];
+				c[i][l] = systems[l]->upper.x[i];
+				d[i][l] = rhs[l]->x[i];
+				}
+
+		// smallest absolute pivot, zero for singular system
+		T min_pivot[LANES];
+
+		for ( unsigned l = 0; l < LANES; ++l )
+			{
+			const T inverse_pivot = T ( 1 ) / b[0][l];
+
+			min_pivot[l] = std::abs ( b[0][l] );
+			c[0][l] *= inverse_pivot;
+			d[0][l] *= inverse_pivot;
+			}
+
+		for ( unsigned i = 0; i+1 < SIZE; ++i )
+			for ( unsigned l = 0; l < LANES; ++l )
+				{
+				const T pivot = b[i+1][l] - a[i+1][l] * c[i][l];
+				const T inverse_pivot = T ( 1 ) / pivot;
+
+				min_pivot[l] = std::min ( min_pivot[l], std::abs ( pivot ) );
+				c[i+1][l] *= inverse_pivot;
+				d[i+1][l] = ( d[i+1][l] - a[i+1][l] * d[i][l] ) * inverse_pivot;
+				}
+
+		// back substitution into d
+		for ( unsigned i = SIZE-1; i-- > 0; )
+			for ( unsigned l = 0; l < LANES; ++l )
+				d[i][l] -= c[i][l] * d[i+1][l];
+
+		for ( unsigned l = 0; l < count; ++l, ++out_beg, ++regular_beg )
+			{
+			for ( unsigned i = 0; i < SIZE; ++i )
+				out_beg->x[i] = d[i][l];
+
+			const bool regular = min_pivot[l] != T ( 0 );
+
+			singular += regular ? 0 : 1;
+			*regular_beg = regular;
+			}
+		}
+
+	return singular;
+	}
+
+/**
+ * @brief Square band Matrix with LOWER diagonals below and UPPER diagonals above main diagonal.
+ * Row i is stored contiguously, element (i, j) for i-LOWER <= j <= i+UPPER in band(i, j - i + LOWER),
+ * positions outside of Matrix are kept zero. Memory is O(SIZE*(LOWER+UPPER+1)).
+ *
+ * @tparam T type of elements
+ * @tparam SIZE number of rows and cols
+ * @tparam LOWER number of diagonals below main diagonal
+ * @tparam UPPER number of diagonals above main diagonal
+ */
+template<typename T, unsigned SIZE, unsigned LOWER, unsigned UPPER>
+class BandedMatrix
+	{
+	public:
+		static const unsigned width = LOWER + UPPER + 1;
+
+	public:
+		Matrix<T, SIZE, LOWER + UPPER + 1> band;
+
+	public:
+		/**
+		 * @brief Zero band Matrix
+		 *
+		 */
+		BandedMatrix() : band ( T ( 0 ) )
+			{
+			}
+
+		/**
+		 * @brief Band Matrix from band of dense Matrix, elements outside of band are ignored
+		 *
+		 * @tparam U type of dense Matrix
+		 * @param m dense Matrix
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		explicit BandedMatrix ( const Matrix<U, SIZE, SIZE>& m ) : band ( T ( 0 ) )
+			{
+			for ( unsigned i = 0; i < SIZE; ++i )
+				for ( unsigned j = colBegin ( i ); j < colEnd ( i ); ++j )
+					band.x[i][j + LOWER - i] = T ( m.x[i][j] );
+			}
+
+		/**
+		 * @brief First column of band in row i
+		 *
+		 * @param i row
+		 * @return unsigned
+		 */
+		static inline unsigned colBegin ( unsigned i )
+			{
+			return i > LOWER ? i - LOWER : 0;
+			}
+
+		/**
+		 * @brief Column after last column of band in row i
+		 *
+		 * @param i row
+		 * @return unsigned
+		 */
+		static inline unsigned colEnd ( unsigned i )
+			{
+			return std::min ( i + UPPER + 1, SIZE );
+			}
+
+		/**
+		 * @brief Reference to element (i, j) inside of band
+		 *
+		 * @param i row
+		 * @param j col, i-LOWER <= j <= i+UPPER
+		 * @return T&
+		 */
+		inline T& at ( unsigned i, unsigned j )
+			{
+			return band.x[i][j + LOWER - i];
+			}
+
+		/**
+		 * @brief Element at position (i, j), zero outside of band
+		 *
+		 * @param i row
+		 * @param j col
+		 * @return T
+		 */
+		T operator() ( unsigned i, unsigned j ) const
+			{
+			return j >= colBegin ( i ) && j < colEnd ( i ) ? band.x[i][j + LOWER - i] : T ( 0 );
+			}
+
+		/**
+		 * @brief Dense copy of band Matrix
+		 *
+		 * @tparam U type of dense Matrix
+		 * @param m dense Matrix
+		 */
+		template<typename U>
+		void toDense ( Matrix<U, SIZE, SIZE>& m ) const
+			{
+			m.fill ( U ( 0 ) );
+
+			for ( unsigned i = 0; i < SIZE; ++i )
+				for ( unsigned j = colBegin ( i ); j < colEnd ( i ); ++j )
+					m.x[i][j] = U ( band.x[i][j + LOWER - i] );
+			}
+	};
+
+/**
+ * @brief Computing band Matrix Vector multiplication in O(SIZE*(LOWER+UPPER+1)) operations
+ *
+ * @tparam Tt type of band Matrix
+ * @tparam U type of Vector
+ * @tparam T_U type of output Vector
+ * @tparam SIZE size of Matrix and Vectors
+ * @tparam LOWER number of diagonals below main diagonal
+ * @tparam UPPER number of diagonals above main diagonal
+ * @param first band Matrix
+ * @param second Vector
+ * @param output Vector result of multiplication
+ */
+template<typename Tt,
+		 typename U,
+		 typename T_U,
+		 unsigned SIZE,
+		 unsigned LOWER,
+		 unsigned UPPER>
+void cauchyProduct ( const BandedMatrix<Tt, SIZE, LOWER, UPPER>& first,
+					 const Vector<U, SIZE>& second,
+					 Vector<T_U, SIZE>& output )
+	{
+	using B = BandedMatrix<Tt, SIZE, LOWER, UPPER>;
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		{
+		const unsigned j_beg = B::colBegin ( i );
+		const unsigned j_end = B::colEnd ( i );
+		// element (i, j) is at band.x[i][j + LOWER - i]
+		const Tt* it_band = first.band.x[i];
+		T_U value = T_U ( 0 );
+
+		for ( unsigned j = j_beg; j < j_end; ++j )
+			value += it_band[j + LOWER - i] * second.x[j];
+
+		output.x[i] = value;
+		}
+	}
+
+/**
+ * @brief LU decomposition of band Matrix without pivoting, A = L*U,
+ * L is unit lower triangular with LOWER subdiagonals, U upper triangular
+ * with UPPER superdiagonals, both are stored in band of the decomposed Matrix.
+ * Without pivoting the band does not grow, decomposition takes O(SIZE*LOWER*UPPER)
+ * operations and is stable for diagonally dominant or symmetric positive definite Matrix.
+ *
+ * Decomposition with zero pivot does not throw, it is reported by isSingular()
+ * and solving with it throws runtime_error.
+ *
+ * @tparam T floating point type
+ * @tparam SIZE number of rows and cols
+ * @tparam LOWER number of diagonals below main diagonal
+ * @tparam UPPER number of diagonals above main diagonal
+ */
+template<typename T, unsigned SIZE, unsigned LOWER, unsigned UPPER>
+class BandedLUDecomposition
+	{
+		static_assert ( std::is_floating_point<T>::value, "LU decomposition requires floating point type." );
+
+	public:
+		// L below diagonal, U on and above diagonal
+		BandedMatrix<T, SIZE, LOWER, UPPER> lu;
+		// zero pivot occured
+		bool singular;
+
+	public:
+		/**
+		 * @brief Decompose band Matrix
+		 *
+		 * @tparam U type of decomposed Matrix
+		 * @param m band Matrix to decompose
+		 */
+		template<typename U>
+		explicit BandedLUDecomposition ( const BandedMatrix<U, SIZE, LOWER, UPPER>& m ) : singular ( false )
+			{
+			for ( unsigned i = 0; i < SIZE; ++i )
+				for ( unsigned k = 0; k < lu.width; ++k )
+					lu.band.x[i][k] = T ( m.band.x[i][k] );
+
+			decompose();
+			}
+
+		/**
+		 * @brief Check if zero pivot occured
+		 *
+		 * @return bool
+		 */
+		inline bool isSingular() const
+			{
+			return singular;
+			}
+
+		/**
+		 * @brief Determinant of decomposed Matrix, product of diagonal of U
+		 *
+		 * @return T
+		 */
+		T determinant() const
+			{
+			T value = T ( 1 );
+
+			for ( unsigned i = 0; i < SIZE; ++i )
+				value *= lu.band.x[i][LOWER];
+
+			return value;
+			}
+
+		/**
+		 * @brief Solve m*x = b
+		 *
+		 * @tparam U type of right side
+		 * @param b right side
+		 * @return Vector<T, SIZE> solution
+		 */
+		template<typename U>
+		Vector<T, SIZE> solve ( const Vector<U, SIZE>& b ) const
+			{
+			using B = BandedMatrix<T, SIZE, LOWER, UPPER>;
+
+			if ( singular )
+				throw std::runtime_error ( "Singular matrix" );
+
+			Vector<T, SIZE> x ( b );
+
+			// L*y = b, unit diagonal
+			for ( unsigned i = 1; i < SIZE; ++i )
+				{
+				const T* it_band = lu.band.x[i];
+				T value = x.x[i];
+
+				for ( unsigned j = B::colBegin ( i ); j < i; ++j )
+					value -= it_band[j + LOWER - i] * x.x[j];
+
+				x.x[i] = value;
+				}
+
+			// U*x = y
+			for ( unsigned i = SIZE; i-- > 0; )
+				{
+				const T* it_band = lu.band.x[i];
+				T value = x.x[i];
+
+				for ( unsigned j = i+1; j < B::colEnd ( i ); ++j )
+					value -= it_band[j + LOWER - i] * x.x[j];
+
+				x.x[i] = value / it_band[LOWER];
+				}
+
+			return x;
+			}
+
+	private:
+		/**
+		 * @brief Eliminate column k from at most LOWER rows below it,
+		 * updates of row i and pivot row k are contiguous and UPPER long.
+		 *
+		 */
+		void decompose()
+			{
+			for ( unsigned k = 0; k < SIZE; ++k )
+				{
+				const T pivot = lu.band.x[k][LOWER];
+
+				if ( pivot == T ( 0 ) )
+					{
+					singular = true;
+					return;
+					}
+
+				const T inverse_pivot = T ( 1 ) / pivot;
+				const unsigned i_end = std::min ( k + LOWER + 1, SIZE );
+				const unsigned j_end = std::min ( k + UPPER + 1, SIZE );
+				const T* it_pivot_row = lu.band.x[k];
+
+				// element (i, j) is at band.x[i][j + LOWER - i]
+				for ( unsigned i = k+1; i < i_end; ++i )
+					{
+					T* it_row = lu.band.x[i];
+					const T l = it_row[k + LOWER - i] * inverse_pivot;
+
+					it_row[k + LOWER - i] = l;
+
+					for ( unsigned j = k+1; j < j_end; ++j )
+						it_row[j + LOWER - i] -= l * it_pivot_row[j + LOWER - k];
+					}
+				}
+			}
+	};
+
+/**
+ * @brief Tridiagonal Matrix Vector multiplication
+ *
+ * @tparam Tt type of tridiagonal Matrix
+ * @tparam U type of Vector
+ * @tparam T_U = ( Tt()*U() ) type of output Vector
+ * @tparam SIZE size of Matrix and Vector
+ * @param first tridiagonal Matrix
+ * @param second Vector
+ * @return Vector<T_U, SIZE>
+ */
+template<typename Tt,
+		 typename U,
+		 typename T_U = decltype ( Tt()*U() ),
+		 unsigned SIZE>
+inline Vector<T_U, SIZE> operator* ( const TridiagonalMatrix<Tt, SIZE>& first, const Vector<U, SIZE>& second )
+	{
+	Vector<T_U, SIZE> ans;
+	cauchyProduct ( first, second, ans );
+
+	return ans;
+	}
+
+/**
+ * @brief Band Matrix Vector multiplication
+ *
+ * @tparam Tt type of band Matrix
+ * @tparam U type of Vector
+ * @tparam T_U = ( Tt()*U() ) type of output Vector
+ * @tparam SIZE size of Matrix and Vector
+ * @tparam LOWER number of diagonals below main diagonal
+ * @tparam UPPER number of diagonals above main diagonal
+ * @param first band Matrix
+ * @param second Vector
+ * @return Vector<T_U, SIZE>
+ */
+template<typename Tt,
+		 typename U,
+		 typename T_U = decltype ( Tt()*U() ),
+		 unsigned SIZE,
+		 unsigned LOWER,
+		 unsigned UPPER>
+inline Vector<T_U, SIZE> operator* ( const BandedMatrix<Tt, SIZE, LOWER, UPPER>& first, const Vector<U, SIZE>& second )
+	{
+	Vector<T_U, SIZE> ans;
+	cauchyProduct ( first, second, ans );
+
+	return ans;
+	}
+
+#endif // BANDED_HPP
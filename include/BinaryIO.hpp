@@ -0,0 +1,738 @@
+#ifndef BINARYIO_HPP
+#define BINARYIO_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined ( _WIN32 )
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+/*
+ * Versioned binary container of Vector, Matrix or scalar records.
+ * File is 64 bytes header followed by records stored as in memory,
+ * data start at offset aligned to 64 bytes:
+ *
+ *  offset  size  field
+ *       0     4  magic "VMLB"
+ *       4     2  version
+ *       6     2  header size
+ *       8     1  element type code
+ *       9     1  element size in bytes
+ *      10     1  byte order, 1 little endian, 2 big endian
+ *      11     1  reserved
+ *      12     4  rows of record, size for Vector
+ *      16     4  cols of record, 1 for Vector
+ *      20     4  alignment of data
+ *      24     8  number of records
+ *      32     8  offset of data
+ *      40     8  checksum of data
+ *      48    16  reserved
+ *
+ * Header fields are stored in byte order of writer. MappedArray maps file
+ * read only and records are used in place without deserialization,
+ * so opening does not depend on data size. Checksum is verified on demand.
+ * Text files of records are parsed from the same read only mapping by readText.
+ */
+
+namespace BinaryIO
+	{
+	const std::uint16_t VERSION = 1;
+	const std::uint32_t ALIGNMENT = 64;
+	const std::uint8_t LITTLE_ENDIAN_ORDER = 1;
+	const std::uint8_t BIG_ENDIAN_ORDER = 2;
+
+	// element type codes
+	enum Type : std::uint8_t
+		{
+		INT8 = 1, UINT8, INT16, UINT16, INT32, UINT32, INT64, UINT64, FLOAT32, FLOAT64
+		};
+
+	/**
+	 * @brief Header of binary container, 64 bytes
+	 */
+	struct Header
+		{
+		char magic[4];
+		std::uint16_t version;
+		std::uint16_t header_size;
+		std::uint8_t type;
+		std::uint8_t type_size;
+		std::uint8_t byte_order;
+		std::uint8_t reserved0;
+		std::uint32_t rows;
+		std::uint32_t cols;
+		std::uint32_t alignment;
+		std::uint64_t count;
+		std::uint64_t data_offset;
+		std::uint64_t checksum;
+		std::uint8_t reserved[16];
+		};
+
+	static_assert ( sizeof ( Header ) == 64, "Header of binary container must be 64 bytes." );
+
+	/**
+	 * @brief Type code of element type
+	 */
+	template<typename T>
+	struct TypeCode;
+
+	template<> struct TypeCode<std::int8_t> { static const std::uint8_t value = INT8; };
+	template<> struct TypeCode<std::uint8_t> { static const std::uint8_t value = UINT8; };
+	template<> struct TypeCode<std::int16_t> { static const std::uint8_t value = INT16; };
+	template<> struct TypeCode<std::uint16_t> { static const std::uint8_t value = UINT16; };
+	template<> struct TypeCode<std::int32_t> { static const std::uint8_t value = INT32; };
+	template<> struct TypeCode<std::uint32_t> { static const std::uint8_t value = UINT32; };
+	template<> struct TypeCode<std::int64_t> { static const std::uint8_t value = INT64; };
+	template<> struct TypeCode<std::uint64_t> { static const std::uint8_t value = UINT64; };
+	template<> struct TypeCode<float> { static const std::uint8_t value = FLOAT32; };
+	template<> struct TypeCode<double> { static const std::uint8_t value = FLOAT64; };
+
+	/**
+	 * @brief Element type and dimensions of record, scalar, Vector or Matrix
+	 */
+	template<class E>
+	struct Record
+		{
+		using type = E;
+		static const std::uint32_t rows = 1;
+		static const std::uint32_t cols = 1;
+		};
+
+	template<typename T, unsigned SIZE>
+	struct Record<Vector<T, SIZE>>
+		{
+		using type = T;
+		static const std::uint32_t rows = SIZE;
+		static const std::uint32_t cols = 1;
+		};
+
+	template<typename T, unsigned ROWS, unsigned COLS>
+	struct Record<Matrix<T, ROWS, COLS>>
+		{
+		using type = T;
+		static const std::uint32_t rows = ROWS;
+		static const std::uint32_t cols = COLS;
+		};
+
+	/**
+	 * @brief Check that records are stored as arrays of elements without padding
+	 */
+	template<class E>
+	inline void checkRecord()
+		{
+		using T = typename Record<E>::type;
+
+		static_assert ( std::is_standard_layout<E>::value && std::is_trivially_copyable<T>::value,
+						"Record must be standard layout of trivially copyable elements." );
+		static_assert ( sizeof ( E ) == sizeof ( T ) * Record<E>::rows * Record<E>::cols,
+						"Record must be stored without padding." );
+		}
+
+	/**
+	 * @brief Byte order of this machine
+	 *
+	 * @return std::uint8_t LITTLE_ENDIAN_ORDER or BIG_ENDIAN_ORDER
+	 */
+	inline std::uint8_t byteOrder()
+		{
+		const std::uint16_t value = 1;
+		std::uint8_t first;
+		std::memcpy ( &first, &value, 1 );
+
+		return first == 1 ? LITTLE_ENDIAN_ORDER : BIG_ENDIAN_ORDER;
+		}
+
+	/**
+	 * @brief Checksum of bytes, FNV-1a over 64 bit words and bytes of tail.
+	 * Continued by passing previous checksum as seed, all parts except last
+	 * must have size multiple of 8.
+	 *
+	 * @param data pointer at first byte
+	 * @param size number of bytes
+	 * @param seed checksum of previous parts
+	 * @return std::uint64_t
+	 */
+	inline std::uint64_t checksum ( const void* data, std::size_t size, std::uint64_t seed = 0xcbf29ce484222325ull )
+		{
+		const std::uint64_t PRIME = 0x100000001b3ull;
+		const unsigned char* it = static_cast<const unsigned char*> ( data );
+		const unsigned char* const it_end = it + size;
+		std::uint64_t hash = seed;
+
+		while ( it_end - it >= 8 )
+			{
+			std::uint64_t word;
+			std::memcpy ( &word, it, 8 );
+			hash = ( hash ^ word ) * PRIME;
+			it += 8;
+			}
+
+		while ( it != it_end )
+			hash = ( hash ^ *it++ ) * PRIME;
+
+		return hash;
+		}
+
+	/**
+	 * @brief Incremental checksum of parts of any size, equal to checksum
+	 * of their concatenation. Up to 7 bytes of incomplete word are carried
+	 * to next part.
+	 */
+	struct Hasher
+		{
+		std::uint64_t hash;
+		unsigned char tail[8];
+		std::size_t tail_size;
+
+		Hasher()
+			: hash ( checksum ( nullptr, 0 ) ), tail_size ( 0 )
+			{
+			}
+
+		/**
+		 * @brief Continue checksum by bytes
+		 *
+		 * @param data pointer at first byte
+		 * @param size number of bytes
+		 */
+		void update ( const void* data, std::size_t size )
+			{
+			const unsigned char* it = static_cast<const unsigned char*> ( data );
+
+			// complete carried word
+			if ( tail_size != 0 )
+				{
+				const std::size_t taken = size < 8 - tail_size ? size : 8 - tail_size;
+				std::memcpy ( tail + tail_size, it, taken );
+				tail_size += taken;
+				it += taken;
+				size -= taken;
+
+				if ( tail_size < 8 )
+					return;
+
+				hash = checksum ( tail, 8, hash );
+				tail_size = 0;
+				}
+
+			const std::size_t words = size / 8 * 8;
+			hash = checksum ( it, words, hash );
+			tail_size = size - words;
+			std::memcpy ( tail, it + words, tail_size );
+			}
+
+		/**
+		 * @brief Checksum of all bytes passed to update
+		 *
+		 * @return std::uint64_t
+		 */
+		inline std::uint64_t value() const
+			{
+			return checksum ( tail, tail_size, hash );
+			}
+		};
+
+	/**
+	 * @brief Header of container of count records E
+	 */
+	template<class E>
+	inline Header header ( std::uint64_t count, std::uint64_t checksum )
+		{
+		Header h;
+		std::memset ( &h, 0, sizeof ( Header ) );
+		std::memcpy ( h.magic, "VMLB", 4 );
+		h.version = VERSION;
+		h.header_size = sizeof ( Header );
+		h.type = TypeCode<typename Record<E>::type>::value;
+		h.type_size = sizeof ( typename Record<E>::type );
+		h.byte_order = byteOrder();
+		h.rows = Record<E>::rows;
+		h.cols = Record<E>::cols;
+		h.alignment = ALIGNMENT;
+		h.count = count;
+		h.data_offset = ( sizeof ( Header ) + ALIGNMENT - 1 ) / ALIGNMENT * ALIGNMENT;
+		h.checksum = checksum;
+
+		return h;
+		}
+
+	/**
+	 * @brief Validate header of container of records E in file of file_size bytes.
+	 * Throw runtime_error describing first mismatch.
+	 */
+	template<class E>
+	inline void validate ( const Header& h, std::uint64_t file_size )
+		{
+		if ( file_size < sizeof ( Header ) || std::memcmp ( h.magic, "VMLB", 4 ) != 0 )
+			throw std::runtime_error ( "Not a binary container" );
+
+		if ( h.byte_order != byteOrder() )
+			throw std::runtime_error ( "Byte order of binary container differs" );
+
+		if ( h.version == 0 || h.version > VERSION || h.header_size < sizeof ( Header ) )
+			throw std::runtime_error ( "Unsupported version of binary container" );
+
+		if ( h.type != TypeCode<typename Record<E>::type>::value || h.type_size != sizeof ( typename Record<E>::type ) )
+			throw std::runtime_error ( "Element type of binary container differs" );
+
+		if ( h.rows != Record<E>::rows || h.cols != Record<E>::cols )
+			throw std::runtime_error ( "Dimensions of binary container differ" );
+
+		if ( h.data_offset < h.header_size || h.data_offset % alignof ( E ) != 0 || h.data_offset > file_size
+				|| h.count > ( file_size - h.data_offset ) / sizeof ( E ) )
+			throw std::runtime_error ( "Binary container is truncated" );
+		}
+
+	/**
+	 * @brief Write all bytes to file, throw runtime_error on failure
+	 */
+	inline void write ( std::FILE* file, const void* data, std::size_t size )
+		{
+		if ( size != 0 && std::fwrite ( data, 1, size, file ) != size )
+			throw std::runtime_error ( "Writing of binary container failed" );
+		}
+
+	/**
+	 * @brief Owner of open file, closed on destruction
+	 */
+	struct File
+		{
+		std::FILE* file;
+
+		File ( const std::string& path, const char* mode )
+			: file ( std::fopen ( path.c_str(), mode ) )
+			{
+			if ( !file )
+				throw std::runtime_error ( "Cannot open file " + path );
+			}
+
+		File ( const File& ) = delete;
+		File& operator= ( const File& ) = delete;
+
+		~File()
+			{
+			if ( file )
+				std::fclose ( file );
+			}
+
+		void close()
+			{
+			const int result = std::fclose ( file );
+			file = nullptr;
+
+			if ( result != 0 )
+				throw std::runtime_error ( "Writing of binary container failed" );
+			}
+		};
+
+	/**
+	 * @brief Move position in file to offset of any size,
+	 * throw runtime_error on failure
+	 */
+	inline void seek ( std::FILE* file, std::uint64_t offset )
+		{
+#if defined ( _WIN32 )
+		const int result = _fseeki64 ( file, static_cast<__int64> ( offset ), SEEK_SET );
+#else
+		const int result = fseeko ( file, static_cast<off_t> ( offset ), SEEK_SET );
+#endif
+
+		if ( result != 0 )
+			throw std::runtime_error ( "Seek in binary container failed" );
+		}
+
+	/**
+	 * @brief Size of open file of any size in bytes, position is moved to end
+	 */
+	inline std::uint64_t fileSize ( std::FILE* file )
+		{
+#if defined ( _WIN32 )
+		const bool moved = _fseeki64 ( file, 0, SEEK_END ) == 0;
+		const __int64 size = _ftelli64 ( file );
+#else
+		const bool moved = fseeko ( file, 0, SEEK_END ) == 0;
+		const off_t size = ftello ( file );
+#endif
+
+		if ( !moved || size < 0 )
+			throw std::runtime_error ( "Seek in binary container failed" );
+
+		return std::uint64_t ( size );
+		}
+
+	/**
+	 * @brief Read only mapping of whole file, empty file has no mapping.
+	 * Move only, file is unmapped on destruction.
+	 */
+	class MappedFile
+		{
+		private:
+			const unsigned char* mapping;
+			std::size_t mapping_size;
+
+		public:
+			/**
+			 * @brief Map file at path, throw runtime_error on failure
+			 *
+			 * @param path path of file
+			 */
+			explicit MappedFile ( const std::string& path )
+				: mapping ( nullptr ), mapping_size ( 0 )
+				{
+				map ( path );
+				}
+
+			MappedFile ( MappedFile&& other )
+				: mapping ( other.mapping ), mapping_size ( other.mapping_size )
+				{
+				other.mapping = nullptr;
+				other.mapping_size = 0;
+				}
+
+			MappedFile& operator= ( MappedFile&& other )
+				{
+				if ( this != &other )
+					{
+					unmap();
+					mapping = other.mapping;
+					mapping_size = other.mapping_size;
+					other.mapping = nullptr;
+					other.mapping_size = 0;
+					}
+
+				return *this;
+				}
+
+			MappedFile ( const MappedFile& ) = delete;
+			MappedFile& operator= ( const MappedFile& ) = delete;
+
+			~MappedFile()
+				{
+				unmap();
+				}
+
+			inline const unsigned char* data() const
+				{
+				return mapping;
+				}
+
+			/**
+			 * @brief Size of file in bytes
+			 *
+			 * @return std::size_t
+			 */
+			inline std::size_t size() const
+				{
+				return mapping_size;
+				}
+
+		private:
+#if defined ( _WIN32 )
+			void map ( const std::string& path )
+				{
+				HANDLE file = CreateFileA ( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+											OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+				if ( file == INVALID_HANDLE_VALUE )
+					throw std::runtime_error ( "Cannot open file " + path );
+
+				LARGE_INTEGER file_size;
+
+				if ( !GetFileSizeEx ( file, &file_size ) )
+					{
+					CloseHandle ( file );
+					throw std::runtime_error ( "Cannot open file " + path );
+					}
+
+				// empty file cannot be mapped
+				if ( file_size.QuadPart == 0 )
+					{
+					CloseHandle ( file );
+					return;
+					}
+
+				HANDLE mapping_handle = CreateFileMappingA ( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+				CloseHandle ( file );
+
+				if ( !mapping_handle )
+					throw std::runtime_error ( "Cannot map file " + path );
+
+				mapping = static_cast<const unsigned char*> ( MapViewOfFile ( mapping_handle, FILE_MAP_READ, 0, 0, 0 ) );
+				CloseHandle ( mapping_handle );
+
+				if ( !mapping )
+					throw std::runtime_error ( "Cannot map file " + path );
+
+				mapping_size = std::size_t ( file_size.QuadPart );
+				}
+
+			void unmap()
+				{
+				if ( mapping )
+					UnmapViewOfFile ( mapping );
+
+				mapping = nullptr;
+				}
+#else
+			void map ( const std::string& path )
+				{
+				const int file = ::open ( path.c_str(), O_RDONLY );
+
+				if ( file < 0 )
+					throw std::runtime_error ( "Cannot open file " + path );
+
+				struct stat status;
+
+				if ( ::fstat ( file, &status ) != 0 )
+					{
+					::close ( file );
+					throw std::runtime_error ( "Cannot open file " + path );
+					}
+
+				// empty file cannot be mapped
+				if ( status.st_size == 0 )
+					{
+					::close ( file );
+					return;
+					}
+
+				void* address = ::mmap ( nullptr, std::size_t ( status.st_size ), PROT_READ, MAP_SHARED, file, 0 );
+				::close ( file );
+
+				if ( address == MAP_FAILED )
+					throw std::runtime_error ( "Cannot map file " + path );
+
+				mapping = static_cast<const unsigned char*> ( address );
+				mapping_size = std::size_t ( status.st_size );
+				}
+
+			void unmap()
+				{
+				if ( mapping )
+					::munmap ( const_cast<unsigned char*> ( mapping ), mapping_size );
+
+				mapping = nullptr;
+				}
+#endif
+		};
+
+	/**
+	 * @brief Pass records of contiguous range to sink by one call
+	 *
+	 * @tparam Sink callable with ( const void* data, std::size_t size )
+	 * @return std::uint64_t number of written records
+	 */
+	template<class E, class Sink>
+	inline std::uint64_t writeRecords ( const E* it_beg, const E* it_end, Sink& sink, std::true_type )
+		{
+		sink ( static_cast<const void*> ( it_beg ), std::size_t ( it_end - it_beg ) * sizeof ( E ) );
+
+		return std::uint64_t ( it_end - it_beg );
+		}
+
+	/**
+	 * @brief Pass records of any forward range to sink through buffer of 4096 records
+	 *
+	 * @tparam Sink callable with ( const void* data, std::size_t size )
+	 * @return std::uint64_t number of written records
+	 */
+	template<class E, typename Iterator, typename ConstIterator, class Sink>
+	inline std::uint64_t writeRecords ( Iterator it_beg, ConstIterator it_end, Sink& sink, std::false_type )
+		{
+		const std::size_t BUFFER = 4096;
+		std::vector<E> buffer;
+		std::uint64_t count = 0;
+		buffer.reserve ( BUFFER );
+
+		while ( it_beg != it_end )
+			{
+			buffer.clear();
+
+			while ( it_beg != it_end && buffer.size() < BUFFER )
+				buffer.push_back ( *it_beg++ );
+
+			count += writeRecords<E> ( static_cast<const E*> ( buffer.data() ), buffer.data() + buffer.size(), sink, std::true_type() );
+			}
+
+		return count;
+		}
+	}
+
+/**
+ * @brief Write range of records, scalars, Vectors or Matrices of the same type,
+ * into binary container at path. Contiguous ranges are written by single write.
+ * Throw runtime_error on failure.
+ *
+ * @tparam Iterator Forward Iterator
+ * @tparam ConstIterator Const Forward Iterator
+ * @param path path of file
+ * @param it_beg iterator at first record
+ * @param it_end iterator after last record
+ */
+template<typename Iterator, typename ConstIterator>
+void writeBinary ( const std::string& path, Iterator it_beg, ConstIterator it_end )
+	{
+	using E = Container::ret_type<Iterator>;
+	using R = std::remove_const_t<E>;
+	BinaryIO::checkRecord<R>();
+
+	BinaryIO::File file ( path, "wb" );
+	BinaryIO::Header h = BinaryIO::header<R> ( 0, 0 );
+	BinaryIO::Hasher hasher;
+
+	// header is written again with count and checksum
+	BinaryIO::write ( file.file, &h, sizeof ( BinaryIO::Header ) );
+	const std::vector<char> padding ( h.data_offset - sizeof ( BinaryIO::Header ), 0 );
+	BinaryIO::write ( file.file, padding.data(), padding.size() );
+
+	auto sink = [&file, &hasher] ( const void* data, std::size_t size )
+		{
+		hasher.update ( data, size );
+		BinaryIO::write ( file.file, data, size );
+		};
+
+	const std::uint64_t count = BinaryIO::writeRecords<R> ( it_beg, it_end, sink,
+								std::integral_constant < bool, std::is_pointer<Iterator>::value && std::is_pointer<ConstIterator>::value > () );
+
+	h = BinaryIO::header<R> ( count, hasher.value() );
+
+	if ( std::fseek ( file.file, 0, SEEK_SET ) != 0 )
+		throw std::runtime_error ( "Writing of binary container failed" );
+
+	BinaryIO::write ( file.file, &h, sizeof ( BinaryIO::Header ) );
+	file.close();
+	}
+
+/**
+ * @brief Read only binary container mapped into memory. Records are used
+ * in place, opening costs the same for any size of data.
+ * Move only, file is unmapped on destruction.
+ *
+ * @tparam E type of record, scalar, Vector or Matrix
+ */
+template<class E>
+class MappedArray
+	{
+	public:
+		using value_type = E;
+		using iterator = const E*;
+
+	private:
+		BinaryIO::MappedFile file;
+		BinaryIO::Header h;
+
+	public:
+		/**
+		 * @brief Map binary container at path and validate its header.
+		 * Throw runtime_error when file cannot be mapped or header does not match E.
+		 *
+		 * @param path path of file
+		 */
+		explicit MappedArray ( const std::string& path )
+			: file ( path )
+			{
+			BinaryIO::checkRecord<E>();
+
+			if ( file.size() >= sizeof ( BinaryIO::Header ) )
+				std::memcpy ( &h, file.data(), sizeof ( BinaryIO::Header ) );
+			else
+				std::memset ( &h, 0, sizeof ( BinaryIO::Header ) );
+
+			BinaryIO::validate<E> ( h, file.size() );
+			}
+
+		MappedArray ( MappedArray&& ) = default;
+		MappedArray& operator= ( MappedArray&& ) = default;
+
+		/**
+		 * @brief Number of records
+		 *
+		 * @return std::size_t
+		 */
+		inline std::size_t size() const
+			{
+			return std::size_t ( h.count );
+			}
+
+		inline const E* begin() const
+			{
+			return reinterpret_cast<const E*> ( file.data() + h.data_offset );
+			}
+
+		inline const E* end() const
+			{
+			return begin() + size();
+			}
+
+		/**
+		 * @brief Record at position idx, not checked
+		 *
+		 * @param idx position index
+		 * @return const E&
+		 */
+		inline const E& operator[] ( std::size_t idx ) const
+			{
+			return begin() [idx];
+			}
+
+		/**
+		 * @brief Header of container
+		 *
+		 * @return const BinaryIO::Header&
+		 */
+		inline const BinaryIO::Header& header() const
+			{
+			return h;
+			}
+
+		/**
+		 * @brief Compare checksum of records with checksum stored in header,
+		 * reads whole data
+		 *
+		 * @return true data are intact
+		 */
+		bool verify() const
+			{
+			return BinaryIO::checksum ( begin(), size() * sizeof ( E ) ) == h.checksum;
+			}
+	};
+
+/**
+ * @brief Parse text file of records, one record per line, mapped into memory
+ * as parseText does. Throw runtime_error when file cannot be mapped
+ * and TextIO::ParseError with line and column of malformed text.
+ *
+ * @tparam E type of record, scalar, Vector or Matrix
+ * @param path path of file
+ * @param threads number of threads parsing consecutive parts of file
+ * @return std::vector<E> records
+ */
+template<class E>
+std::vector<E> readText ( const std::string& path, unsigned threads = 1 )
+	{
+	const BinaryIO::MappedFile file ( path );
+	const char* text = reinterpret_cast<const char*> ( file.data() );
+
+	return parseText<E> ( text, text + file.size(), threads );
+	}
+
+#endif // BINARYIO_HPP
@@ -0,0 +1,556 @@
+#ifndef CHOLESKY_HPP
+#define CHOLESKY_HPP
+
+#include <type_traits>
+#include <cmath>
+#include <stdexcept>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+
+/**
+ * @brief Row I of fully unrolled Cholesky decomposition A = L*transpose(L).
+ * All loop bounds are compile time constants, so for small SIZE
+ * whole decomposition is unrolled by compiler.
+ *
+ * @tparam T type of Matrix
+ * @tparam SIZE number of rows and cols of Matrix
+ * @tparam I number of computed row of L
+ */
+template<typename T, unsigned SIZE, unsigned I>
+struct CholeskyUnrolledStep
+	{
+	inline static bool apply ( T ( &l ) [SIZE][SIZE] )
+		{
+		// l(I, 0:I)
+		for ( unsigned j = 0; j < I; ++j )
+			{
+			T value = l[I][j];
+
+			for ( unsigned k = 0; k < j; ++k )
+				value -= l[I][k] * l[j][k];
+
+			l[I][j] = value / l[j][j];
+			}
+
+		// l(I, I)
+		T value = l[I][I];
+
+		for ( unsigned k = 0; k < I; ++k )
+			value -= l[I][k] * l[I][k];
+
+		if ( ! ( value > T ( 0 ) ) )
+			return false;
+
+		l[I][I] = std::sqrt ( value );
+
+		return CholeskyUnrolledStep<T, SIZE, I+1>::apply ( l );
+		}
+	};
+
+template<typename T, unsigned SIZE>
+struct CholeskyUnrolledStep<T, SIZE, SIZE>
+	{
+	inline static bool apply ( T ( & ) [SIZE][SIZE] )
+		{
+		return true;
+		}
+	};
+
+/**
+ * @brief Cholesky decomposition of symmetric positive definite Matrix:
+ * A = L*transpose(L), where L is lower triangular with positive diagonal.
+ * Only lower triangle of decomposed Matrix is read.
+ *
+ * Matrices up to 8x8 are decomposed by fully unrolled code,
+ * larger ones row by row, where each element is dot product
+ * of two contiguous row prefixes of L.
+ *
+ * Decomposition of Matrix which is not positive definite does not throw,
+ * it is reported by isPositiveDefinite() and solving with it throws runtime_error.
+ *
+ * @tparam T floating point type
+ * @tparam SIZE number of rows and cols of Matrix
+ */
+template<typename T, unsigned SIZE>
+class CholeskyDecomposition
+	{
+		static_assert ( std::is_floating_point<T>::value, "Cholesky decomposition requires floating point type." );
+
+	public:
+		static const unsigned UNROLLED_SIZE = 8;
+
+	public:
+		// L on and below diagonal, zeros above diagonal
+		Matrix<T, SIZE, SIZE> l;
+		// decomposition succeeded
+		bool positive_definite;
+
+	public:
+		/**
+		 * @brief Decompose Matrix
+		 *
+		 * @tparam U type of decomposed Matrix
+		 * @param m symmetric Matrix to decompose
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		explicit CholeskyDecomposition ( const Matrix<U, SIZE, SIZE>& m )
+			{
+			for ( unsigned i = 0; i < SIZE; ++i )
+				{
+				Container::copy ( l.begin ( i ), l.begin ( i ) + i + 1, m.begin ( i ) );
+				Container::fill ( l.begin ( i ) + i + 1, l.end ( i ), T ( 0 ) );
+				}
+
+			if ( SIZE <= UNROLLED_SIZE )
+				positive_definite = CholeskyUnrolledStep<T, SIZE, 0>::apply ( l.x );
+			else
+				positive_definite = decompose();
+			}
+
+		/**
+		 * @brief Check if decomposed Matrix is positive definite
+		 *
+		 * @return bool
+		 */
+		inline bool isPositiveDefinite() const
+			{
+			return positive_definite;
+			}
+
+		/**
+		 * @brief Natural logarithm of determinant of decomposed Matrix,
+		 * 2*sum(log(l(i, i))). Does not overflow for large matrices.
+		 *
+		 * @return T
+		 */
+		T logDeterminant() const
+			{
+			T value = T ( 0 );
+
+			for ( unsigned i = 0; i < SIZE; ++i )
+				value += std::log ( l.x[i][i] );
+
+			return T ( 2 ) * value;
+			}
+
+		/**
+		 * @brief Determinant of decomposed Matrix
+		 *
+		 * @return T
+		 */
+		T determinant() const
+			{
+			T value = T ( 1 );
+
+			for ( unsigned i = 0; i < SIZE; ++i )
+				value *= l.x[i][i];
+
+			return value * value;
+			}
+
+		/**
+		 * @brief Solve L*y = b
+		 * Throw runtime_error when Matrix is not positive definite.
+		 *
+		 * @tparam U type of b
+		 * @param b right hand side
+		 * @return Vector<T, SIZE> y
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Vector<T, SIZE> solveLower ( const Vector<U, SIZE>& b ) const
+			{
+			checkPositiveDefinite();
+
+			Vector<T, SIZE> y ( b );
+
+			for ( unsigned i = 0; i < SIZE; ++i )
+				{
+				T value = y.x[i];
+
+				for ( unsigned k = 0; k < i; ++k )
+					value -= l.x[i][k] * y.x[k];
+
+				y.x[i] = value / l.x[i][i];
+				}
+
+			return y;
+			}
+
+		/**
+		 * @brief Solve transpose(L)*x = y
+		 * Throw runtime_error when Matrix is not positive definite.
+		 *
+		 * @tparam U type of y
+		 * @param y right hand side
+		 * @return Vector<T, SIZE> x
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Vector<T, SIZE> solveUpper ( const Vector<U, SIZE>& y ) const
+			{
+			checkPositiveDefinite();
+
+			Vector<T, SIZE> x ( y );
+
+			// x(i) is final once all later rows were subtracted, rows of L are read contiguously
+			for ( unsigned i = SIZE; i-- > 0; )
+				{
+				const T value = x.x[i] /= l.x[i][i];
+				const T* it_row = l.begin ( i );
+
+				for ( unsigned k = 0; k < i; ++k )
+					x.x[k] -= it_row[k] * value;
+				}
+
+			return x;
+			}
+
+		/**
+		 * @brief Solve A*x = b
+		 * Throw runtime_error when Matrix is not positive definite.
+		 *
+		 * @tparam U type of b
+		 * @param b right hand side
+		 * @return Vector<T, SIZE> x
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Vector<T, SIZE> solve ( const Vector<U, SIZE>& b ) const
+			{
+			return solveUpper ( solveLower ( b ) );
+			}
+
+		/**
+		 * @brief Solve A*X = B for all columns of B at once
+		 * Throw runtime_error when Matrix is not positive definite.
+		 *
+		 * @tparam U type of B
+		 * @tparam COLS number of columns of B
+		 * @param b right hand sides
+		 * @return Matrix<T, SIZE, COLS> X
+		 */
+		template<typename U,
+				 unsigned COLS,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Matrix<T, SIZE, COLS> solve ( const Matrix<U, SIZE, COLS>& b ) const
+			{
+			checkPositiveDefinite();
+
+			Matrix<T, SIZE, COLS> x;
+			x = b;
+
+			// L*Y = B, rows are updated by whole rows of Y
+			for ( unsigned i = 0; i < SIZE; ++i )
+				{
+				T* it_row = x.begin ( i );
+
+				for ( unsigned k = 0; k < i; ++k )
+					{
+					const T factor = l.x[i][k];
+					const T* it_row_k = x.begin ( k );
+
+					for ( unsigned j = 0; j < COLS; ++j )
+						it_row[j] -= factor * it_row_k[j];
+					}
+
+				Container::rangeElemetsValueOperationAssign<Multiply> ( it_row, it_row + COLS, T ( 1 ) / l.x[i][i] );
+				}
+
+			// transpose(L)*X = Y
+			for ( unsigned i = SIZE; i-- > 0; )
+				{
+				T* it_row = x.begin ( i );
+
+				Container::rangeElemetsValueOperationAssign<Multiply> ( it_row, it_row + COLS, T ( 1 ) / l.x[i][i] );
+
+				for ( unsigned k = 0; k < i; ++k )
+					{
+					const T factor = l.x[i][k];
+					T* it_row_k = x.begin ( k );
+
+					for ( unsigned j = 0; j < COLS; ++j )
+						it_row_k[j] -= factor * it_row[j];
+					}
+				}
+
+			return x;
+			}
+
+		/**
+		 * @brief Update decomposition to decomposition of A + sigma*v*transpose(v).
+		 * sigma > 0 is update, sigma < 0 is downdate. Costs O(SIZE^2)
+		 * instead of O(SIZE^3) of new decomposition.
+		 * When downdated Matrix is not positive definite false is returned
+		 * and decomposition is not modified.
+		 *
+		 * @tparam U type of v
+		 * @param v update Vector
+		 * @param sigma update scale
+		 * @return bool false if result is not positive definite
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		bool rankOneUpdate ( const Vector<U, SIZE>& v, T sigma = T ( 1 ) )
+			{
+			checkPositiveDefinite();
+
+			if ( sigma == T ( 0 ) )
+				return true;
+
+			const T direction = sigma > T ( 0 ) ? T ( 1 ) : T ( -1 );
+			Vector<T, SIZE> w ( v );
+			Matrix<T, SIZE, SIZE> updated;
+			updated = l;
+
+			w *= std::sqrt ( std::abs ( sigma ) );
+
+			// column by column rotation of [L w]
+			for ( unsigned k = 0; k < SIZE; ++k )
+				{
+				const T l_kk = updated.x[k][k];
+				const T r_2 = l_kk*l_kk + direction*w.x[k]*w.x[k];
+
+				if ( ! ( r_2 > T ( 0 ) ) )
+					return false;
+
+				const T r = std::sqrt ( r_2 );
+				const T c = r / l_kk;
+				const T s = w.x[k] / l_kk;
+
+				updated.x[k][k] = r;
+
+				for ( unsigned i = k+1; i < SIZE; ++i )
+					{
+					updated.x[i][k] = ( updated.x[i][k] + direction*s*w.x[i] ) / c;
+					w.x[i] = c*w.x[i] - s*updated.x[i][k];
+					}
+				}
+
+			l = updated;
+
+			return true;
+			}
+
+	private:
+		inline void checkPositiveDefinite() const
+			{
+			if ( ! positive_definite )
+				throw std::runtime_error ( "Matrix is not positive definite" );
+			}
+
+		/**
+		 * @brief Row by row decomposition
+		 *
+		 * @return bool false if Matrix is not positive definite
+		 */
+		bool decompose()
+			{
+			for ( unsigned i = 0; i < SIZE; ++i )
+				{
+				T* it_row = l.begin ( i );
+
+				// l(i, 0:i)
+				for ( unsigned j = 0; j < i; ++j )
+					{
+					const T* it_row_j = l.begin ( j );
+					T value = it_row[j];
+
+					for ( unsigned k = 0; k < j; ++k )
+						value -= it_row[k] * it_row_j[k];
+
+					it_row[j] = value / it_row_j[j];
+					}
+
+				// l(i, i)
+				T value = it_row[i];
+
+				for ( unsigned k = 0; k < i; ++k )
+					value -= it_row[k] * it_row[k];
+
+				if ( ! ( value > T ( 0 ) ) )
+					return false;
+
+				it_row[i] = std::sqrt ( value );
+				}
+
+			return true;
+			}
+	};
+
+/**
+ * @brief LDLT decomposition of symmetric Matrix: A = L*D*transpose(L),
+ * where L is unit lower triangular and D diagonal.
+ * Does not need square roots and works for indefinite matrices
+ * with non zero leading minors. Only lower triangle of decomposed Matrix is read.
+ *
+ * Zero pivot is reported by isSingular() and solving with it throws runtime_error.
+ *
+ * @tparam T floating point type
+ * @tparam SIZE number of rows and cols of Matrix
+ */
+template<typename T, unsigned SIZE>
+class LDLTDecomposition
+	{
+		static_assert ( std::is_floating_point<T>::value, "LDLT decomposition requires floating point type." );
+
+	public:
+		// L below diagonal (unit diagonal is not stored), zeros on and above diagonal
+		Matrix<T, SIZE, SIZE> l;
+		// diagonal of D
+		Vector<T, SIZE> d;
+		// some pivot was equal to 0
+		bool singular;
+
+	public:
+		/**
+		 * @brief Decompose Matrix
+		 *
+		 * @tparam U type of decomposed Matrix
+		 * @param m symmetric Matrix to decompose
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		explicit LDLTDecomposition ( const Matrix<U, SIZE, SIZE>& m )
+			: d ( T ( 0 ) ), singular ( false )
+			{
+			// l(i, k)*d(k) products of current row
+			T ld[SIZE];
+
+			l.fill ( T ( 0 ) );
+
+			for ( unsigned i = 0; i < SIZE; ++i )
+				{
+				T* it_row = l.begin ( i );
+
+				for ( unsigned j = 0; j < i; ++j )
+					{
+					const T* it_row_j = l.begin ( j );
+					T value = T ( m.x[i][j] );
+
+					for ( unsigned k = 0; k < j; ++k )
+						value -= ld[k] * it_row_j[k];
+
+					ld[j] = value;
+					it_row[j] = value / d.x[j];
+					}
+
+				T value = T ( m.x[i][i] );
+
+				for ( unsigned k = 0; k < i; ++k )
+					value -= ld[k] * it_row[k];
+
+				if ( value == T ( 0 ) )
+					{
+					singular = true;
+					return;
+					}
+
+				d.x[i] = value;
+				}
+			}
+
+		/**
+		 * @brief Check if decomposition failed on zero pivot
+		 *
+		 * @return bool
+		 */
+		inline bool isSingular() const
+			{
+			return singular;
+			}
+
+		/**
+		 * @brief Check if decomposed Matrix is positive definite,
+		 * all elements of D are positive.
+		 *
+		 * @return bool
+		 */
+		bool isPositiveDefinite() const
+			{
+			if ( singular )
+				return false;
+
+			for ( T value : d.x )
+				if ( ! ( value > T ( 0 ) ) )
+					return false;
+
+			return true;
+			}
+
+		/**
+		 * @brief Determinant of decomposed Matrix
+		 *
+		 * @return T
+		 */
+		T determinant() const
+			{
+			return Container::mul ( d );
+			}
+
+		/**
+		 * @brief Natural logarithm of determinant of decomposed Matrix,
+		 * sum(log(d(i))). Is NaN when decomposed Matrix is not positive definite.
+		 *
+		 * @return T
+		 */
+		T logDeterminant() const
+			{
+			T value = T ( 0 );
+
+			for ( T d_i : d.x )
+				value += std::log ( d_i );
+
+			return value;
+			}
+
+		/**
+		 * @brief Solve A*x = b
+		 * Throw runtime_error when decomposition failed.
+		 *
+		 * @tparam U type of b
+		 * @param b right hand side
+		 * @return Vector<T, SIZE> x
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Vector<T, SIZE> solve ( const Vector<U, SIZE>& b ) const
+			{
+			if ( singular )
+				throw std::runtime_error ( "Singular matrix" );
+
+			Vector<T, SIZE> x ( b );
+
+			// L*y = b
+			for ( unsigned i = 1; i < SIZE; ++i )
+				{
+				T value = x.x[i];
+
+				for ( unsigned k = 0; k < i; ++k )
+					value -= l.x[i][k] * x.x[k];
+
+				x.x[i] = value;
+				}
+
+			// D*z = y
+			Container::executeContainersOperationAssign<Divide> ( x, d );
+
+			// transpose(L)*x = z
+			for ( unsigned i = SIZE; i-- > 0; )
+				{
+				const T value = x.x[i];
+				const T* it_row = l.begin ( i );
+
+				for ( unsigned k = 0; k < i; ++k )
+					x.x[k] -= it_row[k] * value;
+				}
+
+			return x;
+			}
+	};
+
+#endif // CHOLESKY_HPP
@@ -0,0 +1,570 @@
+#ifndef HALF_HPP
+#define HALF_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <ostream>
+
+#if defined ( __F16C__ ) || defined ( __AVX512F__ )
+#include <immintrin.h>
+#endif
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+/*
+ * 16-bit floating point element types for storage of large vectors and matrices.
+ * Half is IEEE binary16 (5 exponent, 10 mantissa bits), BFloat16 is upper half
+ * of float (8 exponent, 7 mantissa bits). Arithmetic is done in float: every
+ * operation converts operands to float and returns float (or double with double
+ * operand), so decltype ( T()*U() ) of cauchyProduct is float and products
+ * are accumulated in float. Conversion to float is branch free bit manipulation,
+ * so it is vectorized inside kernels. Conversions from float and double round
+ * to nearest even, bulk conversions and Matrix Vector products use F16C,
+ * AVX-512 and AVX-512 BF16 instructions where available.
+ */
+
+namespace Float16
+	{
+	/**
+	 * @brief Round IEEE binary floating point number given by bits to 16-bit format
+	 * with EXPONENT and MANTISSA bits, to nearest even. Directly from double,
+	 * so there is no double rounding through float.
+	 *
+	 * @tparam EXPONENT number of exponent bits of 16-bit format
+	 * @tparam MANTISSA number of mantissa bits of 16-bit format
+	 * @tparam SOURCE_EXPONENT number of exponent bits of source format
+	 * @tparam SOURCE_MANTISSA number of mantissa bits of source format
+	 * @tparam Bits unsigned integer type of source bits
+	 * @param x source bits
+	 * @return std::uint16_t bits of 16-bit number
+	 */
+	template<unsigned EXPONENT,
+			 unsigned MANTISSA,
+			 unsigned SOURCE_EXPONENT,
+			 unsigned SOURCE_MANTISSA,
+			 typename Bits>
+	inline std::uint16_t roundBits ( Bits x )
+		{
+		const int SOURCE_BIAS = ( 1 << ( SOURCE_EXPONENT - 1 ) ) - 1;
+		const int BIAS = ( 1 << ( EXPONENT - 1 ) ) - 1;
+		const int MAX_EXPONENT = ( 1 << EXPONENT ) - 1;
+		const std::uint16_t sign = std::uint16_t ( ( x >> ( SOURCE_EXPONENT + SOURCE_MANTISSA ) ) << 15 );
+		const int source_exponent = int ( ( x >> SOURCE_MANTISSA ) & ( ( Bits ( 1 ) << SOURCE_EXPONENT ) - 1 ) );
+		const Bits implicit = Bits ( 1 ) << SOURCE_MANTISSA;
+		Bits mantissa = x & ( implicit - 1 );
+
+		// infinity and NaN, NaN stays quiet NaN
+		if ( source_exponent == ( 1 << SOURCE_EXPONENT ) - 1 )
+			return std::uint16_t ( sign | ( MAX_EXPONENT << MANTISSA ) | ( mantissa != 0 ? 1u << ( MANTISSA - 1 ) : 0u ) );
+
+		// subnormal source has exponent of smallest normal number and no implicit bit
+		const int exponent = ( source_exponent == 0 ? 1 : source_exponent ) - SOURCE_BIAS + BIAS;
+		mantissa |= source_exponent == 0 ? Bits ( 0 ) : implicit;
+
+		if ( exponent >= MAX_EXPONENT )
+			return std::uint16_t ( sign | ( MAX_EXPONENT << MANTISSA ) );
+
+		// subnormal result is shifted more, below half of smallest subnormal it is zero
+		const unsigned shift = SOURCE_MANTISSA - MANTISSA + ( exponent > 0 ? 0 : unsigned ( 1 - exponent ) );
+
+		if ( shift > SOURCE_MANTISSA + 1 )
+			return sign;
+
+		// implicit bit of mantissa adds one to exponent of normal result, carry of rounding too
+		std::uint32_t result = std::uint32_t ( exponent > 0 ? exponent - 1 : 0 ) << MANTISSA;
+		result += std::uint32_t ( mantissa >> shift );
+
+		const Bits remainder = mantissa & ( ( Bits ( 1 ) << shift ) - 1 );
+		const Bits halfway = Bits ( 1 ) << ( shift - 1 );
+
+		if ( remainder > halfway || ( remainder == halfway && ( result & 1u ) ) )
+			++result;
+
+		return std::uint16_t ( sign | result );
+		}
+
+	inline std::uint32_t floatBits ( float value )
+		{
+		std::uint32_t bits;
+		std::memcpy ( &bits, &value, sizeof ( bits ) );
+
+		return bits;
+		}
+
+	inline float bitsFloat ( std::uint32_t bits )
+		{
+		float value;
+		std::memcpy ( &value, &bits, sizeof ( value ) );
+
+		return value;
+		}
+
+	inline std::uint64_t doubleBits ( double value )
+		{
+		std::uint64_t bits;
+		std::memcpy ( &bits, &value, sizeof ( bits ) );
+
+		return bits;
+		}
+
+	/**
+	 * @brief Convert binary16 bits to float without branches,
+	 * subnormal numbers are normalized by float subtraction.
+	 */
+	inline float halfToFloat ( std::uint16_t h )
+		{
+		const std::uint32_t EXPONENT_MASK = 0x0F800000u;
+		std::uint32_t bits = std::uint32_t ( h & 0x7FFFu ) << 13;
+		const std::uint32_t exponent = bits & EXPONENT_MASK;
+
+		// rebias exponent, infinity and NaN keep maximal exponent
+		bits += 0x38000000u;
+		bits = exponent == EXPONENT_MASK ? bits + 0x38000000u : bits;
+
+		// subnormal: implicit bit 2^-14 added and subtracted
+		const float subnormal = bitsFloat ( bits + 0x00800000u ) - 6.103515625e-05f;
+		const float magnitude = exponent == 0 ? subnormal : bitsFloat ( bits );
+
+		return bitsFloat ( floatBits ( magnitude ) | ( std::uint32_t ( h & 0x8000u ) << 16 ) );
+		}
+
+	inline std::uint16_t floatToHalf ( float value )
+		{
+#ifdef __F16C__
+		return std::uint16_t ( _cvtss_sh ( value, _MM_FROUND_TO_NEAREST_INT ) );
+#else
+		return roundBits<5, 10, 8, 23> ( floatBits ( value ) );
+#endif
+		}
+
+	inline float bfloat16ToFloat ( std::uint16_t b )
+		{
+		return bitsFloat ( std::uint32_t ( b ) << 16 );
+		}
+
+	/**
+	 * @brief Round float to bfloat16 by adding half of dropped part,
+	 * NaN is kept quiet NaN.
+	 */
+	inline std::uint16_t floatToBFloat16 ( float value )
+		{
+		const std::uint32_t bits = floatBits ( value );
+		const std::uint32_t rounded = ( bits + 0x7FFFu + ( ( bits >> 16 ) & 1u ) ) >> 16;
+
+		return std::uint16_t ( ( bits & 0x7FFFFFFFu ) > 0x7F800000u ? ( bits >> 16 ) | 0x40u : rounded );
+		}
+	}
+
+/**
+ * @brief IEEE binary16 floating point number, arithmetic is done in float
+ */
+struct Half
+	{
+	std::uint16_t bits;
+
+	Half() : bits ( 0 )
+		{
+		}
+
+	Half ( float value ) : bits ( Float16::floatToHalf ( value ) )
+		{
+		}
+
+	Half ( double value ) : bits ( Float16::roundBits<5, 10, 11, 52> ( Float16::doubleBits ( value ) ) )
+		{
+		}
+
+	template<typename U, std::enable_if_t<std::is_integral<U>::value, int> = 0>
+	Half ( U value ) : Half ( double ( value ) )
+		{
+		}
+
+	/**
+	 * @brief Half from its bits
+	 */
+	static Half fromBits ( std::uint16_t bits )
+		{
+		Half h;
+		h.bits = bits;
+
+		return h;
+		}
+
+	operator float() const
+		{
+		return Float16::halfToFloat ( bits );
+		}
+	};
+
+/**
+ * @brief bfloat16 floating point number (upper half of float), arithmetic is done in float
+ */
+struct BFloat16
+	{
+	std::uint16_t bits;
+
+	BFloat16() : bits ( 0 )
+		{
+		}
+
+	BFloat16 ( float value ) : bits ( Float16::floatToBFloat16 ( value ) )
+		{
+		}
+
+	BFloat16 ( double value ) : bits ( Float16::roundBits<8, 7, 11, 52> ( Float16::doubleBits ( value ) ) )
+		{
+		}
+
+	template<typename U, std::enable_if_t<std::is_integral<U>::value, int> = 0>
+	BFloat16 ( U value ) : BFloat16 ( double ( value ) )
+		{
+		}
+
+	/**
+	 * @brief BFloat16 from its bits
+	 */
+	static BFloat16 fromBits ( std::uint16_t bits )
+		{
+		BFloat16 b;
+		b.bits = bits;
+
+		return b;
+		}
+
+	operator float() const
+		{
+		return Float16::bfloat16ToFloat ( bits );
+		}
+	};
+
+namespace Float16
+	{
+	template<typename T>
+	struct is_float16 : std::integral_constant<bool, std::is_same<T, Half>::value || std::is_same<T, BFloat16>::value>
+		{
+		};
+
+	// operands of 16-bit arithmetic: 16-bit floats with other 16-bit floats or arithmetic types
+	template<typename T, typename U>
+	using enable_operands = std::enable_if_t < ( is_float16<T>::value || is_float16<U>::value ) &&
+							( is_float16<T>::value || std::is_arithmetic<T>::value ) &&
+							( is_float16<U>::value || std::is_arithmetic<U>::value ), int >;
+
+	// 16-bit floats are computed in float, other types are kept
+	inline float promote ( Half value )
+		{
+		return value;
+		}
+
+	inline float promote ( BFloat16 value )
+		{
+		return value;
+		}
+
+	template<typename T, std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+	inline T promote ( T value )
+		{
+		return value;
+		}
+	}
+
+#define FLOAT16_OPERATOR( op ) \
+	template<typename T, typename U, Float16::enable_operands<T, U> = 0> \
+	inline auto operator op ( T first, U second ) -> decltype ( Float16::promote ( first ) op Float16::promote ( second ) ) \
+		{ \
+		return Float16::promote ( first ) op Float16::promote ( second ); \
+		}
+
+FLOAT16_OPERATOR ( + )
+FLOAT16_OPERATOR ( - )
+FLOAT16_OPERATOR ( * )
+FLOAT16_OPERATOR ( / )
+FLOAT16_OPERATOR ( == )
+FLOAT16_OPERATOR ( != )
+FLOAT16_OPERATOR ( < )
+FLOAT16_OPERATOR ( <= )
+FLOAT16_OPERATOR ( > )
+FLOAT16_OPERATOR ( >= )
+
+#undef FLOAT16_OPERATOR
+
+#define FLOAT16_ASSIGN_OPERATOR( op ) \
+	template<typename T, typename U, Float16::enable_operands<T, U> = 0, \
+			 std::enable_if_t<Float16::is_float16<T>::value, int> = 0> \
+	inline T& operator op##= ( T& first, U second ) \
+		{ \
+		first = T ( Float16::promote ( first ) op Float16::promote ( second ) ); \
+		return first; \
+		}
+
+FLOAT16_ASSIGN_OPERATOR ( + )
+FLOAT16_ASSIGN_OPERATOR ( - )
+FLOAT16_ASSIGN_OPERATOR ( * )
+FLOAT16_ASSIGN_OPERATOR ( / )
+
+#undef FLOAT16_ASSIGN_OPERATOR
+
+inline Half operator- ( Half value )
+	{
+	return Half::fromBits ( std::uint16_t ( value.bits ^ 0x8000u ) );
+	}
+
+inline BFloat16 operator- ( BFloat16 value )
+	{
+	return BFloat16::fromBits ( std::uint16_t ( value.bits ^ 0x8000u ) );
+	}
+
+inline std::ostream& operator<< ( std::ostream& out, Half value )
+	{
+	return out << float ( value );
+	}
+
+inline std::ostream& operator<< ( std::ostream& out, BFloat16 value )
+	{
+	return out << float ( value );
+	}
+
+template<>
+struct WideAccumulator<Half>
+	{
+	using type = double;
+	};
+
+template<>
+struct WideAccumulator<BFloat16>
+	{
+	using type = double;
+	};
+
+/**
+ * @brief Convert range of Half to float, 16 (AVX-512) or 8 (F16C) elements per instruction
+ *
+ * @param it_beg pointer at beginning of range
+ * @param it_end pointer after end of range
+ * @param out_beg pointer at beginning of output range
+ */
+inline void convert ( const Half* it_beg, const Half* it_end, float* out_beg )
+	{
+	// masked forms with all lanes set, unmasked ones read undefined register
+#if defined ( __AVX512F__ )
+	for ( ; it_end - it_beg >= 16; it_beg += 16, out_beg += 16 )
+		_mm512_storeu_ps ( out_beg, _mm512_maskz_cvtph_ps ( 0xFFFF, _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( it_beg ) ) ) );
+#elif defined ( __F16C__ )
+	for ( ; it_end - it_beg >= 8; it_beg += 8, out_beg += 8 )
+		_mm256_storeu_ps ( out_beg, _mm256_cvtph_ps ( _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( it_beg ) ) ) );
+#endif
+
+	while ( it_beg != it_end )
+		*out_beg++ = *it_beg++;
+	}
+
+/**
+ * @brief Convert range of float to Half rounded to nearest even,
+ * 16 (AVX-512) or 8 (F16C) elements per instruction
+ *
+ * @param it_beg pointer at beginning of range
+ * @param it_end pointer after end of range
+ * @param out_beg pointer at beginning of output range
+ */
+inline void convert ( const float* it_beg, const float* it_end, Half* out_beg )
+	{
+#if defined ( __AVX512F__ )
+	for ( ; it_end - it_beg >= 16; it_beg += 16, out_beg += 16 )
+		_mm256_storeu_si256 ( reinterpret_cast<__m256i*> ( out_beg ),
+							  _mm512_maskz_cvtps_ph ( 0xFFFF, _mm512_loadu_ps ( it_beg ), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ) );
+#elif defined ( __F16C__ )
+	for ( ; it_end - it_beg >= 8; it_beg += 8, out_beg += 8 )
+		_mm_storeu_si128 ( reinterpret_cast<__m128i*> ( out_beg ),
+						   _mm256_cvtps_ph ( _mm256_loadu_ps ( it_beg ), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ) );
+#endif
+
+	while ( it_beg != it_end )
+		*out_beg++ = Half ( *it_beg++ );
+	}
+
+/**
+ * @brief Convert range of BFloat16 to float, vectorized by compiler
+ *
+ * @param it_beg pointer at beginning of range
+ * @param it_end pointer after end of range
+ * @param out_beg pointer at beginning of output range
+ */
+inline void convert ( const BFloat16* it_beg, const BFloat16* it_end, float* out_beg )
+	{
+	while ( it_beg != it_end )
+		*out_beg++ = *it_beg++;
+	}
+
+/**
+ * @brief Convert range of float to BFloat16 rounded to nearest even,
+ * 16 elements per instruction with AVX-512 BF16, which flushes subnormal
+ * numbers to zero, vectorized by compiler otherwise.
+ *
+ * @param it_beg pointer at beginning of range
+ * @param it_end pointer after end of range
+ * @param out_beg pointer at beginning of output range
+ */
+inline void convert ( const float* it_beg, const float* it_end, BFloat16* out_beg )
+	{
+#if defined ( __AVX512BF16__ )
+	for ( ; it_end - it_beg >= 16; it_beg += 16, out_beg += 16 )
+		_mm256_storeu_si256 ( reinterpret_cast<__m256i*> ( out_beg ),
+							  reinterpret_cast<__m256i> ( _mm512_cvtneps_pbh ( _mm512_loadu_ps ( it_beg ) ) ) );
+#endif
+
+	while ( it_beg != it_end )
+		*out_beg++ = BFloat16 ( *it_beg++ );
+	}
+
+/**
+ * @brief Convert range of Half or BFloat16 to double, exact
+ *
+ * @tparam T Half or BFloat16
+ * @param it_beg pointer at beginning of range
+ * @param it_end pointer after end of range
+ * @param out_beg pointer at beginning of output range
+ */
+template<typename T, std::enable_if_t<Float16::is_float16<T>::value, int> = 0>
+inline void convert ( const T* it_beg, const T* it_end, double* out_beg )
+	{
+	while ( it_beg != it_end )
+		*out_beg++ = double ( float ( *it_beg++ ) );
+	}
+
+/**
+ * @brief Convert range of double to Half or BFloat16 rounded to nearest even
+ * directly from double
+ *
+ * @tparam T Half or BFloat16
+ * @param it_beg pointer at beginning of range
+ * @param it_end pointer after end of range
+ * @param out_beg pointer at beginning of output range
+ */
+template<typename T, std::enable_if_t<Float16::is_float16<T>::value, int> = 0>
+inline void convert ( const double* it_beg, const double* it_end, T* out_beg )
+	{
+	while ( it_beg != it_end )
+		*out_beg++ = T ( *it_beg++ );
+	}
+
+namespace Float16
+	{
+	/**
+	 * @brief Dot product of Half ranges computed in float, 16-bit elements are
+	 * converted in registers by F16C (8) or AVX-512 (16 per instruction),
+	 * compiler does not vectorize the bit manipulation conversion well.
+	 *
+	 * @param first pointer at beginning of first range
+	 * @param second pointer at beginning of second range
+	 * @param size number of elements
+	 * @return float dot product
+	 */
+	inline float dot ( const Half* first, const Half* second, unsigned size )
+		{
+		float value = 0.0f;
+		unsigned j = 0;
+#if defined ( __AVX512F__ )
+		__m512 sum0 = _mm512_setzero_ps();
+		__m512 sum1 = _mm512_setzero_ps();
+
+		for ( ; j + 32 <= size; j += 32 )
+			{
+			const __m512 a0 = _mm512_maskz_cvtph_ps ( 0xFFFF, _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( first + j ) ) );
+			const __m512 a1 = _mm512_maskz_cvtph_ps ( 0xFFFF, _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( first + j + 16 ) ) );
+			const __m512 b0 = _mm512_maskz_cvtph_ps ( 0xFFFF, _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( second + j ) ) );
+			const __m512 b1 = _mm512_maskz_cvtph_ps ( 0xFFFF, _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( second + j + 16 ) ) );
+
+			sum0 = _mm512_fmadd_ps ( a0, b0, sum0 );
+			sum1 = _mm512_fmadd_ps ( a1, b1, sum1 );
+			}
+
+		// reduced through memory, reduce intrinsic reads undefined register
+		float lanes[16];
+		_mm512_storeu_ps ( lanes, _mm512_add_ps ( sum0, sum1 ) );
+		value = Container::sum ( lanes, lanes + 16 );
+#elif defined ( __F16C__ ) && defined ( __FMA__ )
+		__m256 sum0 = _mm256_setzero_ps();
+		__m256 sum1 = _mm256_setzero_ps();
+
+		for ( ; j + 16 <= size; j += 16 )
+			{
+			const __m256 a0 = _mm256_cvtph_ps ( _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( first + j ) ) );
+			const __m256 a1 = _mm256_cvtph_ps ( _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( first + j + 8 ) ) );
+			const __m256 b0 = _mm256_cvtph_ps ( _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( second + j ) ) );
+			const __m256 b1 = _mm256_cvtph_ps ( _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( second + j + 8 ) ) );
+
+			sum0 = _mm256_fmadd_ps ( a0, b0, sum0 );
+			sum1 = _mm256_fmadd_ps ( a1, b1, sum1 );
+			}
+
+		float lanes[8];
+		_mm256_storeu_ps ( lanes, _mm256_add_ps ( sum0, sum1 ) );
+		value = Container::sum ( lanes, lanes + 8 );
+#endif
+
+		return value + Container::dot<float> ( first + j, second + j, size - j );
+		}
+
+	/**
+	 * @brief Dot product of BFloat16 ranges computed in float, pairs of products
+	 * are summed by AVX-512 BF16 dot product instruction where available
+	 *
+	 * @param first pointer at beginning of first range
+	 * @param second pointer at beginning of second range
+	 * @param size number of elements
+	 * @return float dot product
+	 */
+	inline float dot ( const BFloat16* first, const BFloat16* second, unsigned size )
+		{
+		float value = 0.0f;
+		unsigned j = 0;
+#if defined ( __AVX512BF16__ )
+		__m512 sum = _mm512_setzero_ps();
+
+		for ( ; j + 32 <= size; j += 32 )
+			sum = _mm512_dpbf16_ps ( sum,
+									 reinterpret_cast<__m512bh> ( _mm512_loadu_si512 ( first + j ) ),
+									 reinterpret_cast<__m512bh> ( _mm512_loadu_si512 ( second + j ) ) );
+
+		float lanes[16];
+		_mm512_storeu_ps ( lanes, sum );
+		value = Container::sum ( lanes, lanes + 16 );
+#endif
+
+		return value + Container::dot<float> ( first + j, second + j, size - j );
+		}
+	}
+
+/**
+* @brief Computing Matrix Vector multiplication of 16-bit floating point
+* Matrix and Vector in float. Rows are reduced by Float16::dot, so elements
+* are converted in registers by hardware where available.
+* Must be fullfill assumption COLS1 == SIZE2
+*
+* @tparam T Half or BFloat16
+* @tparam ROWS1 number of rows of first Matrix
+* @tparam COLS1 number of cols of first Matrix
+* @tparam SIZE2 size of second Vector
+* @param first first Matrix
+* @param second second Vector
+* @param output Vector result of multiplication
+*/
+template<typename T,
+		 unsigned ROWS1,
+		 unsigned COLS1,
+		 unsigned SIZE2,
+		 std::enable_if_t<Float16::is_float16<T>::value, int> = 0>
+inline void cauchyProduct ( const Matrix<T, ROWS1, COLS1>& first,
+							const Vector<T, SIZE2>& second,
+							Vector<float, ROWS1>& output )
+	{
+	static_assert ( COLS1 == SIZE2, "First matrix columns number must be equal to vector size." );
+
+	for ( unsigned i = 0; i < ROWS1; ++i )
+		output.x[i] = Float16::dot ( first.x[i], second.x, COLS1 );
+	}
+
+#endif // HALF_HPP
@@ -0,0 +1,364 @@
+#ifndef INSTRUMENT_HPP
+#define INSTRUMENT_HPP
+
+#include <cstdint>
+#include <ostream>
+
+#if defined ( VECMATLIB_INSTRUMENT )
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+/*
+ * Instrumentation of kernels counting calls, arithmetic operations and bytes
+ * of operands and results per kernel. Counting policy is selected at compile
+ * time by defining VECMATLIB_INSTRUMENT before including any header of library,
+ * otherwise kernels call empty record of Disabled policy, which is compiled
+ * to nothing, and snapshots are zero.
+ *
+ * Counters are kept per thread without locking, snapshot sums counters
+ * of running threads and of finished threads since last reset.
+ */
+
+namespace Instrument
+	{
+	/**
+	 * @brief Instrumented kernels
+	 */
+	enum Kernel : unsigned
+		{
+		CAUCHY_PRODUCT,
+		TRANSPOSED_CAUCHY_PRODUCT,
+		ELEMENTS_OPERATION,
+		DOT,
+		CROSS_PRODUCT,
+		CONVERSION,
+		KERNELS
+		};
+
+	/**
+	 * @brief Name of kernel as used in JSON export
+	 *
+	 * @param kernel kernel
+	 * @return const char*
+	 */
+	inline const char* name ( Kernel kernel )
+		{
+		static const char* const names[KERNELS] = { "cauchyProduct", "transposedCauchyProduct",
+													"rangeElemetsOperation", "dot", "crossProduct", "conversion"
+												  };
+
+		return kernel < KERNELS ? names[kernel] : "unknown";
+		}
+
+	/**
+	 * @brief Counts of kernel, trigonometric functions and square roots
+	 * are counted as single operations
+	 */
+	struct Counter
+		{
+		std::uint64_t calls;
+		std::uint64_t flops;
+		std::uint64_t bytes;
+		};
+
+	/**
+	 * @brief Counts of all kernels at one moment
+	 */
+	struct Snapshot
+		{
+		Counter x[KERNELS] = {};
+
+		inline const Counter& operator[] ( Kernel kernel ) const
+			{
+			return x[kernel];
+			}
+
+		inline Snapshot& operator+= ( const Snapshot& other )
+			{
+			for ( unsigned k = 0; k < KERNELS; ++k )
+				{
+				x[k].calls += other.x[k].calls;
+				x[k].flops += other.x[k].flops;
+				x[k].bytes += other.x[k].bytes;
+				}
+
+			return *this;
+			}
+
+		/**
+		 * @brief Sum of counts of all kernels
+		 *
+		 * @return Counter
+		 */
+		Counter total() const
+			{
+			Counter sum = {};
+
+			for ( const Counter& counter : x )
+				{
+				sum.calls += counter.calls;
+				sum.flops += counter.flops;
+				sum.bytes += counter.bytes;
+				}
+
+			return sum;
+			}
+		};
+
+	/**
+	 * @brief Policy of disabled instrumentation
+	 */
+	struct Disabled
+		{
+		static inline void record ( Kernel, std::uint64_t, std::uint64_t )
+			{
+			}
+
+		static inline Snapshot snapshot()
+			{
+			return Snapshot();
+			}
+
+		static inline Snapshot threadSnapshot()
+			{
+			return Snapshot();
+			}
+
+		static inline void reset()
+			{
+			}
+		};
+
+#if defined ( VECMATLIB_INSTRUMENT )
+
+	/**
+	 * @brief Policy of counting instrumentation
+	 */
+	struct Counting
+		{
+		/**
+		 * @brief Counters of one thread, written by owning thread only,
+		 * so relaxed atomics are enough for consistent reads from other threads
+		 */
+		struct Counters
+			{
+			struct Value
+				{
+				std::atomic<std::uint64_t> calls;
+				std::atomic<std::uint64_t> flops;
+				std::atomic<std::uint64_t> bytes;
+				};
+
+			Value counts[KERNELS];
+			// counts at last reset
+			Value baseline[KERNELS];
+
+			Counters()
+				{
+				for ( unsigned k = 0; k < KERNELS; ++k )
+					{
+					store ( counts[k], 0, 0, 0 );
+					store ( baseline[k], 0, 0, 0 );
+					}
+
+				Registry& registry = Registry::instance();
+				std::lock_guard<std::mutex> lock ( registry.mutex );
+				registry.threads.push_back ( this );
+				}
+
+			Counters ( const Counters& ) = delete;
+			Counters& operator= ( const Counters& ) = delete;
+
+			// counts of finished thread are kept by registry
+			~Counters()
+				{
+				Registry& registry = Registry::instance();
+				std::lock_guard<std::mutex> lock ( registry.mutex );
+				registry.retired += snapshot();
+
+				for ( std::size_t i = 0; i < registry.threads.size(); ++i )
+					if ( registry.threads[i] == this )
+						{
+						registry.threads[i] = registry.threads.back();
+						registry.threads.pop_back();
+						break;
+						}
+				}
+
+			static inline void store ( Value& value, std::uint64_t calls, std::uint64_t flops, std::uint64_t bytes )
+				{
+				value.calls.store ( calls, std::memory_order_relaxed );
+				value.flops.store ( flops, std::memory_order_relaxed );
+				value.bytes.store ( bytes, std::memory_order_relaxed );
+				}
+
+			inline void add ( Kernel kernel, std::uint64_t flops, std::uint64_t bytes )
+				{
+				Value& value = counts[kernel];
+				store ( value, value.calls.load ( std::memory_order_relaxed ) + 1,
+						value.flops.load ( std::memory_order_relaxed ) + flops,
+						value.bytes.load ( std::memory_order_relaxed ) + bytes );
+				}
+
+			Snapshot snapshot() const
+				{
+				Snapshot result;
+
+				for ( unsigned k = 0; k < KERNELS; ++k )
+					{
+					result.x[k].calls = counts[k].calls.load ( std::memory_order_relaxed ) - baseline[k].calls.load ( std::memory_order_relaxed );
+					result.x[k].flops = counts[k].flops.load ( std::memory_order_relaxed ) - baseline[k].flops.load ( std::memory_order_relaxed );
+					result.x[k].bytes = counts[k].bytes.load ( std::memory_order_relaxed ) - baseline[k].bytes.load ( std::memory_order_relaxed );
+					}
+
+				return result;
+				}
+
+			void reset()
+				{
+				for ( unsigned k = 0; k < KERNELS; ++k )
+					store ( baseline[k], counts[k].calls.load ( std::memory_order_relaxed ),
+							counts[k].flops.load ( std::memory_order_relaxed ),
+							counts[k].bytes.load ( std::memory_order_relaxed ) );
+				}
+			};
+
+		/**
+		 * @brief Counters of running threads and counts of finished threads
+		 */
+		struct Registry
+			{
+			std::mutex mutex;
+			std::vector<Counters*> threads;
+			Snapshot retired;
+
+			static Registry& instance()
+				{
+				static Registry registry;
+
+				return registry;
+				}
+			};
+
+		static inline Counters& local()
+			{
+			thread_local Counters counters;
+
+			return counters;
+			}
+
+		static inline void record ( Kernel kernel, std::uint64_t flops, std::uint64_t bytes )
+			{
+			local().add ( kernel, flops, bytes );
+			}
+
+		static Snapshot snapshot()
+			{
+			// counters of calling thread are registered, even when it has not called any kernel
+			local();
+			Registry& registry = Registry::instance();
+			std::lock_guard<std::mutex> lock ( registry.mutex );
+			Snapshot result = registry.retired;
+
+			for ( const Counters* counters : registry.threads )
+				result += counters->snapshot();
+
+			return result;
+			}
+
+		static Snapshot threadSnapshot()
+			{
+			return local().snapshot();
+			}
+
+		static void reset()
+			{
+			local();
+			Registry& registry = Registry::instance();
+			std::lock_guard<std::mutex> lock ( registry.mutex );
+			registry.retired = Snapshot();
+
+			for ( Counters* counters : registry.threads )
+				counters->reset();
+			}
+		};
+
+	using Policy = Counting;
+#else
+	using Policy = Disabled;
+#endif
+
+	/**
+	 * @brief Count call of kernel by policy
+	 *
+	 * @param kernel kernel
+	 * @param flops number of arithmetic operations of call
+	 * @param bytes number of bytes of operands and result of call
+	 */
+	inline void record ( Kernel kernel, std::uint64_t flops, std::uint64_t bytes )
+		{
+		Policy::record ( kernel, flops, bytes );
+		}
+
+	/**
+	 * @brief Counts of all threads since last reset
+	 *
+	 * @return Snapshot
+	 */
+	inline Snapshot snapshot()
+		{
+		return Policy::snapshot();
+		}
+
+	/**
+	 * @brief Counts of calling thread since last reset
+	 *
+	 * @return Snapshot
+	 */
+	inline Snapshot threadSnapshot()
+		{
+		return Policy::threadSnapshot();
+		}
+
+	/**
+	 * @brief Start counting from zero in all threads.
+	 * Kernels running in other threads meanwhile may be counted before or after reset.
+	 */
+	inline void reset()
+		{
+		Policy::reset();
+		}
+
+	/**
+	 * @brief Write snapshot as JSON object of kernels and their total:
+	 * { "cauchyProduct": { "calls": 1, "flops": 18, "bytes": 96 }, ..., "total": { ... } }
+	 *
+	 * @param out output stream
+	 * @param snapshot counts of kernels
+	 * @return std::ostream&
+	 */
+	inline std::ostream& writeJson ( std::ostream& out, const Snapshot& snapshot )
+		{
+		const auto counter = [&out] ( const char* key, const Counter & value )
+			{
+			out << "\"" << key << "\": { \"calls\": " << value.calls << ", \"flops\": " << value.flops
+				<< ", \"bytes\": " << value.bytes << " }";
+			};
+
+		out << "{ ";
+
+		for ( unsigned k = 0; k < KERNELS; ++k )
+			{
+			counter ( name ( Kernel ( k ) ), snapshot.x[k] );
+			out << ", ";
+			}
+
+		counter ( "total", snapshot.total() );
+
+		return out << " }";
+		}
+	}
+
+#endif // INSTRUMENT_HPP
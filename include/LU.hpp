@@ -0,0 +1,581 @@
+#ifndef LU_HPP
+#define LU_HPP
+
+#include <type_traits>
+#include <cmath>
+#include <stdexcept>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+
+/**
+ * @brief Step K of fully unrolled LU decomposition with partial pivoting.
+ * All loop bounds are compile time constants, so for small SIZE
+ * whole decomposition is unrolled by compiler.
+ *
+ * @tparam T type of Matrix
+ * @tparam SIZE number of rows and cols of Matrix
+ * @tparam K number of column to eliminate
+ */
+template<typename T, unsigned SIZE, unsigned K>
+struct LUUnrolledStep
+	{
+	inline static void apply ( T ( &a ) [SIZE][SIZE], unsigned* permutation, int& sign, bool& singular )
+		{
+		// find pivot in column K
+		unsigned pivot = K;
+		T pivot_abs = std::abs ( a[K][K] );
+
+		for ( unsigned i = K+1; i < SIZE; ++i )
+			if ( std::abs ( a[i][K] ) > pivot_abs )
+				{
+				pivot = i;
+				pivot_abs = std::abs ( a[i][K] );
+				}
+
+		if ( pivot != K )
+			{
+			for ( unsigned j = 0; j < SIZE; ++j )
+				std::swap ( a[K][j], a[pivot][j] );
+
+			std::swap ( permutation[K], permutation[pivot] );
+			sign = -sign;
+			}
+
+		if ( pivot_abs == T ( 0 ) )
+			singular = true;
+		else
+			{
+			const T inverse_pivot = T ( 1 ) / a[K][K];
+
+			// eliminate column K below diagonal
+			for ( unsigned i = K+1; i < SIZE; ++i )
+				{
+				const T factor = a[i][K] *= inverse_pivot;
+
+				for ( unsigned j = K+1; j < SIZE; ++j )
+					a[i][j] -= factor * a[K][j];
+				}
+			}
+
+		LUUnrolledStep<T, SIZE, K+1>::apply ( a, permutation, sign, singular );
+		}
+	};
+
+template<typename T, unsigned SIZE>
+struct LUUnrolledStep<T, SIZE, SIZE>
+	{
+	inline static void apply ( T ( & ) [SIZE][SIZE], unsigned*, int&, bool& )
+		{
+		}
+	};
+
+/**
+ * @brief LU decomposition with partial pivoting of square Matrix: P*A = L*U
+ * L is unit lower triangular and U upper triangular, both stored in lu.
+ *
+ * Matrices up to 8x8 are decomposed by fully unrolled elimination,
+ * up to 63x63 by right-looking elimination and larger ones by blocked
+ * right-looking elimination, where trailing Matrix is updated
+ * once per block of 32 columns.
+ *
+ * Decomposition of singular Matrix does not throw, it is reported
+ * by isSingular() and solving with it throws runtime_error.
+ *
+ * @tparam T floating point type
+ * @tparam SIZE number of rows and cols of Matrix
+ */
+template<typename T, unsigned SIZE>
+class LUDecomposition
+	{
+		static_assert ( std::is_floating_point<T>::value, "LU decomposition requires floating point type." );
+
+	public:
+		static const unsigned UNROLLED_SIZE = 8;
+		static const unsigned BLOCKED_SIZE = 64;
+		static const unsigned BLOCK = 32;
+
+	public:
+		// L below diagonal (unit diagonal is not stored), U on and above diagonal
+		Matrix<T, SIZE, SIZE> lu;
+		// row i of lu comes from row permutation[i] of decomposed Matrix
+		unsigned permutation[SIZE];
+		// parity of permutation, +1 or -1
+		int sign;
+		// some pivot was equal to 0
+		bool singular;
+		// 1-norm of decomposed Matrix
+		T norm;
+		// largest absolute value of decomposed Matrix
+		T max_abs;
+
+	public:
+		/**
+		 * @brief Decompose Matrix
+		 *
+		 * @tparam U type of decomposed Matrix
+		 * @param m Matrix to decompose
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		explicit LUDecomposition ( const Matrix<U, SIZE, SIZE>& m )
+			: sign ( 1 ), singular ( false ), norm ( 0 ), max_abs ( 0 )
+			{
+			Container::copy ( lu.begin(), lu.end(), m.begin() );
+
+			for ( unsigned i = 0; i < SIZE; ++i )
+				permutation[i] = i;
+
+			// diagnostics of decomposed Matrix
+			for ( unsigned j = 0; j < SIZE; ++j )
+				{
+				T column_sum = T ( 0 );
+
+				for ( unsigned i = 0; i < SIZE; ++i )
+					{
+					T value = std::abs ( lu.x[i][j] );
+					column_sum += value;
+					max_abs = value > max_abs ? value : max_abs;
+					}
+
+				norm = column_sum > norm ? column_sum : norm;
+				}
+
+			if ( SIZE <= UNROLLED_SIZE )
+				LUUnrolledStep<T, SIZE, 0>::apply ( lu.x, permutation, sign, singular );
+			else if ( SIZE < BLOCKED_SIZE )
+				decompose ( SIZE );
+			else
+				decompose ( BLOCK );
+			}
+
+		/**
+		 * @brief Check if decomposed Matrix is singular
+		 *
+		 * @return bool
+		 */
+		inline bool isSingular() const
+			{
+			return singular;
+			}
+
+		/**
+		 * @brief Determinant of decomposed Matrix
+		 *
+		 * @return T
+		 */
+		T determinant() const
+			{
+			T det = T ( sign );
+
+			for ( unsigned i = 0; i < SIZE; ++i )
+				det *= lu.x[i][i];
+
+			return det;
+			}
+
+		/**
+		 * @brief Solve A*x = b
+		 * Throw runtime_error when A is singular.
+		 *
+		 * @tparam U type of b
+		 * @param b right hand side
+		 * @return Vector<T, SIZE> x
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Vector<T, SIZE> solve ( const Vector<U, SIZE>& b ) const
+			{
+			checkSingular();
+
+			Vector<T, SIZE> x;
+
+			// x = P*b
+			for ( unsigned i = 0; i < SIZE; ++i )
+				x.x[i] = T ( b.x[permutation[i]] );
+
+			// L*y = P*b
+			for ( unsigned i = 1; i < SIZE; ++i )
+				{
+				T value = x.x[i];
+
+				for ( unsigned k = 0; k < i; ++k )
+					value -= lu.x[i][k] * x.x[k];
+
+				x.x[i] = value;
+				}
+
+			// U*x = y
+			for ( unsigned i = SIZE; i-- > 0; )
+				{
+				T value = x.x[i];
+
+				for ( unsigned k = i+1; k < SIZE; ++k )
+					value -= lu.x[i][k] * x.x[k];
+
+				x.x[i] = value / lu.x[i][i];
+				}
+
+			return x;
+			}
+
+		/**
+		 * @brief Solve A*X = B for all columns of B at once
+		 * Throw runtime_error when A is singular.
+		 *
+		 * @tparam U type of B
+		 * @tparam COLS number of columns of B
+		 * @param b right hand sides
+		 * @return Matrix<T, SIZE, COLS> X
+		 */
+		template<typename U,
+				 unsigned COLS,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Matrix<T, SIZE, COLS> solve ( const Matrix<U, SIZE, COLS>& b ) const
+			{
+			checkSingular();
+
+			Matrix<T, SIZE, COLS> x;
+
+			// X = P*B
+			for ( unsigned i = 0; i < SIZE; ++i )
+				Container::copy ( x.begin ( i ), x.end ( i ), b.begin ( permutation[i] ) );
+
+			// L*Y = P*B, rows are updated by whole rows of Y
+			for ( unsigned i = 1; i < SIZE; ++i )
+				for ( unsigned k = 0; k < i; ++k )
+					{
+					const T factor = lu.x[i][k];
+					T* it_row = x.begin ( i );
+					const T* it_row_k = x.begin ( k );
+
+					for ( unsigned j = 0; j < COLS; ++j )
+						it_row[j] -= factor * it_row_k[j];
+					}
+
+			// U*X = Y
+			for ( unsigned i = SIZE; i-- > 0; )
+				{
+				T* it_row = x.begin ( i );
+
+				for ( unsigned k = i+1; k < SIZE; ++k )
+					{
+					const T factor = lu.x[i][k];
+					const T* it_row_k = x.begin ( k );
+
+					for ( unsigned j = 0; j < COLS; ++j )
+						it_row[j] -= factor * it_row_k[j];
+					}
+
+				Container::rangeElemetsValueOperationAssign<Multiply> ( it_row, it_row + COLS, T ( 1 ) / lu.x[i][i] );
+				}
+
+			return x;
+			}
+
+		/**
+		 * @brief Solve transpose(A)*x = b
+		 * Throw runtime_error when A is singular.
+		 *
+		 * @tparam U type of b
+		 * @param b right hand side
+		 * @return Vector<T, SIZE> x
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Vector<T, SIZE> solveTransposed ( const Vector<U, SIZE>& b ) const
+			{
+			checkSingular();
+
+			Vector<T, SIZE> y ( b );
+			Vector<T, SIZE> x;
+
+			// transpose(U)*w = b
+			for ( unsigned i = 0; i < SIZE; ++i )
+				{
+				T value = y.x[i];
+
+				for ( unsigned k = 0; k < i; ++k )
+					value -= lu.x[k][i] * y.x[k];
+
+				y.x[i] = value / lu.x[i][i];
+				}
+
+			// transpose(L)*v = w
+			for ( unsigned i = SIZE; i-- > 0; )
+				{
+				T value = y.x[i];
+
+				for ( unsigned k = i+1; k < SIZE; ++k )
+					value -= lu.x[k][i] * y.x[k];
+
+				y.x[i] = value;
+				}
+
+			// x = transpose(P)*v
+			for ( unsigned i = 0; i < SIZE; ++i )
+				x.x[permutation[i]] = y.x[i];
+
+			return x;
+			}
+
+		/**
+		 * @brief Inverse of decomposed Matrix
+		 * Throw runtime_error when A is singular.
+		 *
+		 * @return Matrix<T, SIZE, SIZE>
+		 */
+		Matrix<T, SIZE, SIZE> inverse() const
+			{
+			Matrix<T, SIZE, SIZE> identity;
+			eye ( identity );
+
+			return solve ( identity );
+			}
+
+		/**
+		 * @brief Ratio of largest absolute value of U to largest
+		 * absolute value of decomposed Matrix.
+		 * Large growth means lost precision of decomposition.
+		 *
+		 * @return T
+		 */
+		T pivotGrowth() const
+			{
+			T max_u = T ( 0 );
+
+			for ( unsigned i = 0; i < SIZE; ++i )
+				for ( unsigned j = i; j < SIZE; ++j )
+					{
+					T value = std::abs ( lu.x[i][j] );
+					max_u = value > max_u ? value : max_u;
+					}
+
+			return max_abs == T ( 0 ) ? T ( 0 ) : max_u / max_abs;
+			}
+
+		/**
+		 * @brief Estimate of reciprocal condition number in 1-norm,
+		 * 1 / ( |A| * |inverse(A)| ), where |inverse(A)| is estimated
+		 * by Hager's method with few solves instead of computing inverse.
+		 * Returns 0 for singular Matrix, values close to machine epsilon
+		 * mean solution can not be trusted.
+		 *
+		 * @return T
+		 */
+		T rcond() const
+			{
+			if ( singular || norm == T ( 0 ) )
+				return T ( 0 );
+
+			Vector<T, SIZE> x ( T ( 1 ) / T ( SIZE ) );
+			T inverse_norm = T ( 0 );
+
+			for ( unsigned iteration = 0; iteration < 5; ++iteration )
+				{
+				Vector<T, SIZE> y = solve ( x );
+				Vector<T, SIZE> xi;
+
+				inverse_norm = T ( 0 );
+				for ( unsigned i = 0; i < SIZE; ++i )
+					{
+					inverse_norm += std::abs ( y.x[i] );
+					xi.x[i] = y.x[i] < T ( 0 ) ? T ( -1 ) : T ( 1 );
+					}
+
+				Vector<T, SIZE> z = solveTransposed ( xi );
+				unsigned j_max = 0;
+
+				for ( unsigned j = 1; j < SIZE; ++j )
+					if ( std::abs ( z.x[j] ) > std::abs ( z.x[j_max] ) )
+						j_max = j;
+
+				// local maximum of |inverse(A)*x| reached
+				if ( std::abs ( z.x[j_max] ) <= z.dot ( x ) )
+					break;
+
+				x.fill ( T ( 0 ) );
+				x.x[j_max] = T ( 1 );
+				}
+
+			return T ( 1 ) / ( norm * inverse_norm );
+			}
+
+	private:
+		inline void checkSingular() const
+			{
+			if ( singular )
+				throw std::runtime_error ( "Singular matrix" );
+			}
+
+		/**
+		 * @brief Right-looking decomposition by panels of block columns.
+		 * For block == SIZE it is plain right-looking elimination.
+		 *
+		 * @param block number of columns of panel
+		 */
+		void decompose ( unsigned block )
+			{
+			for ( unsigned k0 = 0; k0 < SIZE; k0 += block )
+				{
+				const unsigned k1 = k0 + block < SIZE ? k0 + block : SIZE;
+
+				// decompose panel lu(k0:, k0:k1)
+				for ( unsigned k = k0; k < k1; ++k )
+					{
+					unsigned pivot = k;
+					T pivot_abs = std::abs ( lu.x[k][k] );
+
+					for ( unsigned i = k+1; i < SIZE; ++i )
+						if ( std::abs ( lu.x[i][k] ) > pivot_abs )
+							{
+							pivot = i;
+							pivot_abs = std::abs ( lu.x[i][k] );
+							}
+
+					if ( pivot != k )
+						{
+						for ( unsigned j = 0; j < SIZE; ++j )
+							std::swap ( lu.x[k][j], lu.x[pivot][j] );
+
+						std::swap ( permutation[k], permutation[pivot] );
+						sign = -sign;
+						}
+
+					if ( pivot_abs == T ( 0 ) )
+						{
+						singular = true;
+						continue;
+						}
+
+					const T inverse_pivot = T ( 1 ) / lu.x[k][k];
+					const T* it_row_k = lu.x[k];
+
+					for ( unsigned i = k+1; i < SIZE; ++i )
+						{
+						T* it_row = lu.x[i];
+						const T factor = it_row[k] *= inverse_pivot;
+
+						for ( unsigned j = k+1; j < k1; ++j )
+							it_row[j] -= factor * it_row_k[j];
+						}
+					}
+
+				if ( k1 == SIZE )
+					break;
+
+				// U12 = inverse(L11) * A12
+				for ( unsigned p = k0+1; p < k1; ++p )
+					{
+					T* it_row = lu.x[p];
+
+					for ( unsigned q = k0; q < p; ++q )
+						{
+						const T factor = it_row[q];
+						const T* it_row_q = lu.x[q];
+
+						for ( unsigned j = k1; j < SIZE; ++j )
+							it_row[j] -= factor * it_row_q[j];
+						}
+					}
+
+				// A22 -= L21 * U12, streaming rows of U12
+				for ( unsigned i = k1; i < SIZE; ++i )
+					{
+					T* it_row = lu.x[i];
+
+					for ( unsigned p = k0; p < k1; ++p )
+						{
+						const T factor = it_row[p];
+						const T* it_row_p = lu.x[p];
+
+						for ( unsigned j = k1; j < SIZE; ++j )
+							it_row[j] -= factor * it_row_p[j];
+						}
+					}
+				}
+			}
+	};
+
+/**
+ * @brief Determinant of square Matrix computed by LU decomposition.
+ * 2x2, 3x3 and 4x4 matrices are handled by closed form overloads.
+ *
+ * @tparam T type of Matrix
+ * @tparam SIZE number of rows and cols of Matrix
+ * @param m Matrix
+ * @return T determinant
+ */
+template<typename T, unsigned SIZE>
+T determinant ( const Matrix<T, SIZE, SIZE>& m )
+	{
+	return LUDecomposition<T, SIZE> ( m ).determinant();
+	}
+
+/**
+ * @brief Inverse of square Matrix computed by LU decomposition.
+ * Singular Matrix is reported by returned value, out is not modified then.
+ * 2x2, 3x3 and 4x4 matrices are inverted by closed form overloads.
+ *
+ * @tparam T type of Matrix
+ * @tparam SIZE number of rows and cols of Matrix
+ * @param m Matrix to invert
+ * @param out inverse of m
+ * @return bool false if m is singular
+ */
+template<typename T, unsigned SIZE>
+bool inverse ( const Matrix<T, SIZE, SIZE>& m, Matrix<T, SIZE, SIZE>& out )
+	{
+	LUDecomposition<T, SIZE> lu ( m );
+
+	if ( lu.isSingular() )
+		return false;
+
+	out = lu.inverse();
+
+	return true;
+	}
+
+/**
+ * @brief Inverse of square Matrix
+ * Throw runtime_error when Matrix is singular.
+ *
+ * @tparam T type of Matrix
+ * @tparam SIZE number of rows and cols of Matrix
+ * @param m Matrix
+ * @return Matrix<T, SIZE, SIZE> inverse
+ */
+template<typename T, unsigned SIZE>
+Matrix<T, SIZE, SIZE> inverse ( const Matrix<T, SIZE, SIZE>& m )
+	{
+	Matrix<T, SIZE, SIZE> ans;
+
+	if ( ! inverse ( m, ans ) )
+		throw std::runtime_error ( "Singular matrix" );
+
+	return ans;
+	}
+
+/**
+ * @brief Solve m*x = b by LU decomposition
+ * Throw runtime_error when Matrix is singular.
+ *
+ * @tparam T type of Matrix
+ * @tparam U type of b
+ * @tparam SIZE number of rows and cols of Matrix
+ * @param m Matrix
+ * @param b right hand side
+ * @return Vector<T, SIZE> x
+ */
+template<typename T,
+		 typename U,
+		 unsigned SIZE,
+		 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+Vector<T, SIZE> solve ( const Matrix<T, SIZE, SIZE>& m, const Vector<U, SIZE>& b )
+	{
+	return LUDecomposition<T, SIZE> ( m ).solve ( b );
+	}
+
+#endif // LU_HPP
@@ -6,8 +6,9 @@
 #include <cassert>
 #include <cmath>
 #include <ostream>
-#include <iomanip>
 #include <exception>
+#include <limits>
+#include <algorithm>
 
 #include "Utility.hpp"
 #include "Vector.hpp"
@@ -36,6 +37,20 @@ static void cauchyProduct ( const Matrix<Tt, ROWS1, COLS1>& first,
 							const Vector<U, SIZE2>& second,
 							Vector<T_U, ROWS1>& output );
 
+template<typename V,
+		 typename Tt,
+		 typename U,
+		 typename T_U,
+		 unsigned ROWS1,
+		 unsigned COLS1,
+		 unsigned SIZE2,
+		 std::enable_if_t<std::is_convertible<U, Tt>::value, int> = 0>
+static void scaledCauchyProduct ( V alpha,
+								  const Matrix<Tt, ROWS1, COLS1>& first,
+								  const Vector<U, SIZE2>& second,
+								  V beta,
+								  Vector<T_U, ROWS1>& output );
+
 template<typename Tt,
 		 typename U,
 		 typename T_U = decltype ( Tt()*U() ),
@@ -55,7 +70,7 @@ template<typename Tt,
 		 std::enable_if_t<std::is_convertible<U, Tt>::value, int> = 0>
 static void transposedCauchyProduct ( const Matrix<Tt, ROWS1, COLS1>& first,
 									  const Vector<U, SIZE2>& second,
-									  Vector<T_U, ROWS1>& output );
+									  Vector<T_U, COLS1>& output );
 
 template<typename T, unsigned ROWS=3, unsigned COLS=3>
 class Matrix
@@ -234,6 +249,93 @@ class Matrix
 			return * ( begin()+idx );
 			}
 
+		/* VIEWS */
+		/**
+		 * @brief View of R x C block with upper left element at (row, col),
+		 * elements are not copied. Throw runtime_error while out of range.
+		 *
+		 * @tparam R number of rows of block
+		 * @tparam C number of cols of block
+		 * @param row row of upper left element
+		 * @param col col of upper left element
+		 * @return MatrixView<T, R, C>
+		 */
+		template<unsigned R, unsigned C>
+		inline MatrixView<T, R, C> block ( unsigned row, unsigned col )
+			{
+			checkBlock<R, C> ( row, col );
+
+			return MatrixView<T, R, C> ( &x[row][col], COLS, 1 );
+			}
+
+		template<unsigned R, unsigned C>
+		inline MatrixView<const T, R, C> block ( unsigned row, unsigned col ) const
+			{
+			checkBlock<R, C> ( row, col );
+
+			return MatrixView<const T, R, C> ( &x[row][col], COLS, 1 );
+			}
+
+		/**
+		 * @brief View of row, elements are not copied.
+		 * Throw runtime_error while out of range.
+		 *
+		 * @param i row index
+		 * @return VectorView<T, COLS>
+		 */
+		inline VectorView<T, COLS> row ( unsigned i )
+			{
+			checkBlock<1, COLS> ( i, 0 );
+
+			return VectorView<T, COLS> ( x[i], 1 );
+			}
+
+		inline VectorView<const T, COLS> row ( unsigned i ) const
+			{
+			checkBlock<1, COLS> ( i, 0 );
+
+			return VectorView<const T, COLS> ( x[i], 1 );
+			}
+
+		/**
+		 * @brief View of col with stride COLS, elements are not copied.
+		 * Throw runtime_error while out of range.
+		 *
+		 * @param j col index
+		 * @return VectorView<T, ROWS>
+		 */
+		inline VectorView<T, ROWS> col ( unsigned j )
+			{
+			checkBlock<ROWS, 1> ( 0, j );
+
+			return VectorView<T, ROWS> ( &x[0][j], COLS );
+			}
+
+		inline VectorView<const T, ROWS> col ( unsigned j ) const
+			{
+			checkBlock<ROWS, 1> ( 0, j );
+
+			return VectorView<const T, ROWS> ( &x[0][j], COLS );
+			}
+
+		/**
+		 * @brief View of single row or single col Matrix as Vector,
+		 * elements are not copied
+		 *
+		 * @return VectorView<T, ROWS*COLS>
+		 */
+		template<unsigned R = ROWS, std::enable_if_t<R == 1 || COLS == 1, int> = 0>
+		inline VectorView<T, ROWS*COLS> asVector()
+			{
+			return VectorView<T, ROWS*COLS> ( *x, 1 );
+			}
+
+		template<unsigned R = ROWS, std::enable_if_t<R == 1 || COLS == 1, int> = 0>
+		inline VectorView<const T, ROWS*COLS> asVector() const
+			{
+			return VectorView<const T, ROWS*COLS> ( *x, 1 );
+			}
+
 		/* ARITHMETIC OPERATORS*/
 
 		/**
@@ -556,7 +658,7 @@ class Matrix
 		Vector<T_U, ROWS> operator* ( const Vector<U, SIZE2>& second ) const
 			{
 			Vector<T_U, ROWS> ans;
-			cauchyProduct<T, U, T_U> ( *this, second, ans );
+			cauchyProduct ( *this, second, ans );
 
 			return ans;
 			}
@@ -591,6 +693,16 @@ class Matrix
 		~Matrix()
 			{
 			}
+
+	private:
+		template<unsigned R, unsigned C>
+		static inline void checkBlock ( unsigned row, unsigned col )
+			{
+			static_assert ( R <= ROWS && C <= COLS, "Block must be inside Matrix." );
+
+			if ( row > ROWS - R || col > COLS - C )
+				throw std::runtime_error ( "Out of range!" );
+			}
 	};
 
 
@@ -669,7 +781,9 @@ inline Matrix<T_U, ROWS, COLS> operator* ( U value, const Matrix<T, ROWS, COLS>&
 	}
 
 /**
- * @brief Display matrix using std::ostream
+ * @brief Display matrix using std::ostream, rows as "[ x y z ]" on separate lines
+ * formatted by TextIO through one buffer on stack, precision of stream is number
+ * of significant digits, other flags of stream (width, fixed, scientific) are ignored
  *
  * @tparam T type of matrix
  * @tparam ROWS number of matrix rows
@@ -681,40 +795,18 @@ inline Matrix<T_U, ROWS, COLS> operator* ( U value, const Matrix<T, ROWS, COLS>&
 template<typename T, unsigned ROWS, unsigned COLS>
 std::ostream& operator<< ( std::ostream& out, const Matrix<T, ROWS, COLS>& m )
 	{
-	unsigned display_width = std::is_floating_point<T>::value ? 9 : 5;
-	unsigned width = COLS* ( display_width+1 );
-
-	out.width ( 1 );
-	// open parenthes top
-	out << char ( 218 ) << ' ';
-	for ( unsigned i = 0; i < width; ++i )
-		out << ' ';
-	// close parenthes top
-	out << char ( 191 ) << '\n';
+	char text[TextIO::PRINT_BUFFER];
+	TextIO::Writer writer ( out, text, text + TextIO::PRINT_BUFFER );
 
-
-	out.precision ( 4 );
 	for ( unsigned i = 0; i < ROWS; ++i )
 		{
-		// parenthes middle left
-		out << char ( 179 ) << ' ';
+		if ( i != 0 )
+			writer.put ( '\n' );
 
-		for ( unsigned j = 0; j < COLS; ++j )
-			{
-			out.width ( display_width );
-			out << m.x[i][j] << ' ';
-			}
-		// parenthes middle right
-		out.width ( 1 );
-		out << char ( 179 ) << '\n';
+		TextIO::printRow ( writer, m.x[i], m.x[i] + COLS, int ( out.precision() ) );
 		}
 
-	// open parenthes bottom
-	out << char ( 192 ) << ' ';
-	for ( unsigned i = 0; i < width; ++i )
-		out << ' ';
-	// close parenthes bottom
-	out << char ( 217 );
+	writer.flush();
 
 	return out;
 	}
@@ -737,17 +829,20 @@ std::ostream& operator<< ( std::ostream& out, const Matrix<T, ROWS, COLS>& m )
  */
 template<typename Tt,
 		 typename U,
-		 typename T_U = decltype ( Tt()*U() ),
+		 typename T_U,
 		 unsigned ROWS1,
 		 unsigned COLS1,
 		 unsigned ROWS2,
 		 unsigned COLS2,
-		 std::enable_if_t<std::is_convertible<U, Tt>::value, int> = 0>
+		 std::enable_if_t<std::is_convertible<U, Tt>::value, int>>
 static void cauchyProduct ( const Matrix<Tt, ROWS1, COLS1>& first,
 							const Matrix<U, ROWS2, COLS2>& second,
 							Matrix<T_U, ROWS1, COLS2>& output )
 	{
 	static_assert ( COLS1 == ROWS2, "First matrix columns number must be equal to second matrix rows number." );
+	Instrument::record ( Instrument::CAUCHY_PRODUCT, std::uint64_t ( 2 ) * ROWS1 * COLS1 * COLS2,
+						 std::uint64_t ( ROWS1 ) * COLS1 * sizeof ( Tt ) + std::uint64_t ( ROWS2 ) * COLS2 * sizeof ( U )
+						 + std::uint64_t ( ROWS1 ) * COLS2 * sizeof ( T_U ) );
 	// iterator to result beginning
 	T_U* it_output_beg = output.begin();
 
@@ -791,45 +886,247 @@ static void cauchyProduct ( const Matrix<Tt, ROWS1, COLS1>& first,
 */
 template<typename Tt,
 		 typename U,
-		 typename T_U = decltype ( Tt()*U() ),
+		 typename T_U,
 		 unsigned ROWS1,
 		 unsigned COLS1,
 		 unsigned SIZE2,
-		 std::enable_if_t<std::is_convertible<U, Tt>::value, int> = 0>
+		 std::enable_if_t<std::is_convertible<U, Tt>::value, int>>
 static void cauchyProduct ( const Matrix<Tt, ROWS1, COLS1>& first,
 							const Vector<U, SIZE2>& second,
 							Vector<T_U, ROWS1>& output )
 	{
+	scaledCauchyProduct ( T_U ( 1 ), first, second, T_U ( 0 ), output );
+	}
+
+/**
+* @brief Computing scaled Matrix Vector multiplication
+* with accumulation into output:
+* output = alpha * first * second + beta * output
+* Must be fullfill assumption COLS1 == SIZE2
+*
+* Rows of at least 32 elements are reduced four per pass, so each element
+* of second is loaded once for all of them, into 16 partial sums per row,
+* so the reduction is vectorized over columns. Narrow rows are reduced one by one.
+* When beta == 0 output is only written, never read.
+*
+* @tparam V type of alpha and beta
+* @tparam Tt type of first Matrix
+* @tparam U type of second Vector
+* @tparam T_U type of output Vector
+* @tparam ROWS1 number of rows of first Matrix
+* @tparam COLS1 number of cols of first Matrix
+* @tparam SIZE2 size of second Vector
+* @param alpha scale of product
+* @param first first Matrix
+* @param second second Vector
+* @param beta scale of output before accumulation
+* @param output Vector result of multiplication
+*/
+template<typename V,
+		 typename Tt,
+		 typename U,
+		 typename T_U,
+		 unsigned ROWS1,
+		 unsigned COLS1,
+		 unsigned SIZE2,
+		 std::enable_if_t<std::is_convertible<U, Tt>::value, int>>
+static void scaledCauchyProduct ( V alpha,
+								  const Matrix<Tt, ROWS1, COLS1>& first,
+								  const Vector<U, SIZE2>& second,
+								  V beta,
+								  Vector<T_U, ROWS1>& output )
+	{
 	static_assert ( COLS1 == SIZE2, "First matrix columns number must be equal to vector size." );
+	Instrument::record ( Instrument::CAUCHY_PRODUCT, std::uint64_t ( 2 ) * ROWS1 * COLS1,
+						 std::uint64_t ( ROWS1 ) * COLS1 * sizeof ( Tt ) + SIZE2 * sizeof ( U ) + ROWS1 * sizeof ( T_U ) );
+	// number of partial sums of row
+	const unsigned LANES = 16;
+	// columns reduced by partial sums, narrow rows are reduced directly
+	const unsigned COLS_LANES = COLS1 < 2*LANES ? 0 : COLS1 - COLS1 % LANES;
+	const U* it_second_beg = second.begin ();
 	// iterator to result beginning
 	T_U* it_output_beg = output.begin();
+	unsigned i=0;
 
-	// for each output vector element
-	for ( unsigned i=0; i < ROWS1; ++i )
+	// four rows per pass, narrow rows are reduced one by one
+	for ( ; COLS_LANES != 0 && i + 4 <= ROWS1; i += 4 )
+		{
+		const Tt* it_row0 = first.begin ( i );
+		const Tt* it_row1 = first.begin ( i+1 );
+		const Tt* it_row2 = first.begin ( i+2 );
+		const Tt* it_row3 = first.begin ( i+3 );
+		T_U partial[4][LANES];
+
+		Container::fill ( *partial, *partial + 4*LANES, T_U ( 0 ) );
+
+		// multiply and sum elements from first(i:i+4, j:j+LANES) and second(j:j+LANES)
+		for ( unsigned j=0; j < COLS_LANES; j += LANES )
+			for ( unsigned k=0; k < LANES; ++k )
+				{
+				const U x = it_second_beg[j+k];
+
+				partial[0][k] += it_row0[j+k]*x;
+				partial[1][k] += it_row1[j+k]*x;
+				partial[2][k] += it_row2[j+k]*x;
+				partial[3][k] += it_row3[j+k]*x;
+				}
+
+		// values for (i:i+4) positions
+		T_U value[4];
+
+		for ( unsigned r=0; r < 4; ++r )
+			value[r] = Container::sum ( partial[r], partial[r] + LANES );
+
+		// multiply and sum remaining elements
+		for ( unsigned j=COLS_LANES; j < COLS1; ++j )
+			{
+			const U x = it_second_beg[j];
+
+			value[0] += it_row0[j]*x;
+			value[1] += it_row1[j]*x;
+			value[2] += it_row2[j]*x;
+			value[3] += it_row3[j]*x;
+			}
+
+		// assign to result
+		for ( unsigned r=0; r < 4; ++r )
+			it_output_beg[i+r] = beta == V ( 0 ) ?
+								 T_U ( alpha*value[r] ) :
+								 T_U ( alpha*value[r] + beta*it_output_beg[i+r] );
+		}
+
+	// for each remaining row
+	for ( ; i < ROWS1; ++i )
 		{
 		Tt* it_first_beg = first.begin ( i );
 		Tt* it_first_end = first.end ( i );
-		// will be incremented by COLS2
-		U* it_second_beg = second.begin ();
+		const U* it_second = it_second_beg;
 		// value for (i) position
 		T_U value = T_U ( 0 );
 
 		// multiply and sum elements from first(i, :) and second(:)
 		while ( it_first_beg != it_first_end )
-			{
-			value += *it_first_beg++ * *it_second_beg++;
-			}
+			value += *it_first_beg++ * *it_second++;
 
 		// assign to result
-		*it_output_beg++ = value;
+		it_output_beg[i] = beta == V ( 0 ) ?
+						   T_U ( alpha*value ) :
+						   T_U ( alpha*value + beta*it_output_beg[i] );
 		}
 	}
 
 
 /**
-* @brief Computing standard Matrix Vector multiplication with transposition of first matrix.
+* @brief Computing Matrix Vector multiplication with accumulator type
+* chosen independently of storage and output, e.g. float Matrix accumulated
+* in double or int16 Matrix in int32. Products are computed in accumulator type.
 * Must be fullfill assumption COLS1 == SIZE2
 *
+* @tparam ACC accumulator type, void for wide_type of product
+* @tparam Tt type of first Matrix
+* @tparam U type of second Vector
+* @tparam T_U type of output Vector
+* @tparam ROWS1 number of rows of first Matrix
+* @tparam COLS1 number of cols of first Matrix
+* @tparam SIZE2 size of second Vector
+* @param first first Matrix
+* @param second second Vector
+* @param output Vector result of multiplication
+*/
+template<typename ACC = void,
+		 typename Tt,
+		 typename U,
+		 typename T_U,
+		 unsigned ROWS1,
+		 unsigned COLS1,
+		 unsigned SIZE2>
+static void wideCauchyProduct ( const Matrix<Tt, ROWS1, COLS1>& first,
+								const Vector<U, SIZE2>& second,
+								Vector<T_U, ROWS1>& output )
+	{
+	static_assert ( COLS1 == SIZE2, "First matrix columns number must be equal to vector size." );
+	using A = accumulator_type<ACC, Tt, U>;
+	Instrument::record ( Instrument::CAUCHY_PRODUCT, std::uint64_t ( 2 ) * ROWS1 * COLS1,
+						 std::uint64_t ( ROWS1 ) * COLS1 * sizeof ( Tt ) + SIZE2 * sizeof ( U ) + ROWS1 * sizeof ( T_U ) );
+
+	for ( unsigned i=0; i < ROWS1; ++i )
+		output.x[i] = T_U ( Container::dot<A> ( first.x[i], second.x, COLS1 ) );
+	}
+
+/**
+* @brief Computing Matrix multiplication with accumulator type
+* chosen independently of storage and output.
+* Rows of second are streamed into accumulator row of 64 columns at most,
+* so conversion and accumulation are vectorized over columns.
+* Must be fullfill assumption COLS1 == ROWS2
+*
+* @tparam ACC accumulator type, void for wide_type of product
+* @tparam Tt type of first Matrix
+* @tparam U type of second Matrix
+* @tparam T_U type of output Matrix
+* @tparam ROWS1 number of rows of first Matrix
+* @tparam COLS1 number of cols of first Matrix
+* @tparam ROWS2 number of rows of second Matrix
+* @tparam COLS2 number of cols of second Matrix
+* @param first first Matrix
+* @param second second Matrix
+* @param output Matrix result of multiplication
+*/
+template<typename ACC = void,
+		 typename Tt,
+		 typename U,
+		 typename T_U,
+		 unsigned ROWS1,
+		 unsigned COLS1,
+		 unsigned ROWS2,
+		 unsigned COLS2>
+static void wideCauchyProduct ( const Matrix<Tt, ROWS1, COLS1>& first,
+								const Matrix<U, ROWS2, COLS2>& second,
+								Matrix<T_U, ROWS1, COLS2>& output )
+	{
+	static_assert ( COLS1 == ROWS2, "First matrix columns number must be equal to second matrix rows number." );
+	using A = accumulator_type<ACC, Tt, U>;
+	Instrument::record ( Instrument::CAUCHY_PRODUCT, std::uint64_t ( 2 ) * ROWS1 * COLS1 * COLS2,
+						 std::uint64_t ( ROWS1 ) * COLS1 * sizeof ( Tt ) + std::uint64_t ( ROWS2 ) * COLS2 * sizeof ( U )
+						 + std::uint64_t ( ROWS1 ) * COLS2 * sizeof ( T_U ) );
+	// number of output elements accumulated in local block
+	const unsigned BLOCK = COLS2 < 64 ? COLS2 : 64;
+
+	// for each block of output columns
+	for ( unsigned j=0; j < COLS2; j += BLOCK )
+		{
+		const unsigned width = COLS2 - j < BLOCK ? COLS2 - j : BLOCK;
+
+		for ( unsigned i=0; i < ROWS1; ++i )
+			{
+			A accumulator[BLOCK] = {};
+
+			// accumulate first(i, k) * second(k, j:j+width)
+			for ( unsigned k=0; k < COLS1; ++k )
+				{
+				const A value = A ( first.x[i][k] );
+				const U* it_row = second.x[k] + j;
+
+				for ( unsigned w=0; w < width; ++w )
+					accumulator[w] += value * A ( it_row[w] );
+				}
+
+			for ( unsigned w=0; w < width; ++w )
+				output.x[i][j+w] = T_U ( accumulator[w] );
+			}
+		}
+	}
+
+/**
+* @brief Computing standard Matrix Vector multiplication with transposition of first matrix.
+* Must be fullfill assumption ROWS1 == SIZE2
+*
+* Output is accumulated row by row: output += first(i, :) * second(i),
+* so each row of first is streamed once in memory order (axpy) instead of
+* walking the columns with stride COLS1. Four rows are accumulated per pass
+* and wide matrices are processed in blocks of 64 columns,
+* so accumulators are kept in registers.
+*
 * @tparam Tt type of first Matrix
 * @tparam U type of second Vector
 * @tparam T_U = ( Tt()*U() ) type of output Vector
@@ -842,37 +1139,64 @@ static void cauchyProduct ( const Matrix<Tt, ROWS1, COLS1>& first,
 */
 template<typename Tt,
 		 typename U,
-		 typename T_U = decltype ( Tt()*U() ),
+		 typename T_U,
 		 unsigned ROWS1,
 		 unsigned COLS1,
 		 unsigned SIZE2,
-		 std::enable_if_t<std::is_convertible<U, Tt>::value, int> = 0>
+		 std::enable_if_t<std::is_convertible<U, Tt>::value, int>>
 static void transposedCauchyProduct ( const Matrix<Tt, ROWS1, COLS1>& first,
 									  const Vector<U, SIZE2>& second,
-									  Vector<T_U, ROWS1>& output )
+									  Vector<T_U, COLS1>& output )
 	{
 	static_assert ( ROWS1 == SIZE2, "First transposed matrix rows number must be equal to vector size." );
-	// iterator to result beginning
+	Instrument::record ( Instrument::TRANSPOSED_CAUCHY_PRODUCT, std::uint64_t ( 2 ) * ROWS1 * COLS1,
+						 std::uint64_t ( ROWS1 ) * COLS1 * sizeof ( Tt ) + SIZE2 * sizeof ( U ) + COLS1 * sizeof ( T_U ) );
+	// number of output elements accumulated in local block
+	const unsigned BLOCK = COLS1 < 64 ? COLS1 : 64;
+	const U* it_second_beg = second.begin ();
 	T_U* it_output_beg = output.begin();
 
-	// for each output vector element
-	for ( unsigned i=0; i < COLS1; ++i )
+	// for each block of output elements
+	for ( unsigned j=0; j < COLS1; j += BLOCK )
 		{
-		Tt* it_first_beg = first.end () -1 -i;
-		U* it_second_beg = second.begin ();
-		U* it_second_end = second.end ();
-		// value for (i) position
-		T_U value = T_U ( 0 );
+		const unsigned width = COLS1 - j < BLOCK ? COLS1 - j : BLOCK;
+		// local accumulator can not alias first, so it is kept in registers
+		T_U accumulator[BLOCK];
+		unsigned i=0;
+
+		Container::fill ( accumulator, accumulator + width, T_U ( 0 ) );
 
-		// multiply and sum elements from first(:, ROWS1 - i-1) and second(:)
-		while ( it_second_beg != it_second_end )
+		// accumulate first(i:i+4, j:j+width) * second(i:i+4), four rows per pass
+		for ( ; i + 4 <= ROWS1; i += 4 )
 			{
-			value += *it_first_beg * *it_second_beg++;
-			it_first_beg -= COLS1;
+			const Tt* it_row0 = first.begin ( i ) + j;
+			const Tt* it_row1 = first.begin ( i+1 ) + j;
+			const Tt* it_row2 = first.begin ( i+2 ) + j;
+			const Tt* it_row3 = first.begin ( i+3 ) + j;
+			const U value0 = it_second_beg[i];
+			const U value1 = it_second_beg[i+1];
+			const U value2 = it_second_beg[i+2];
+			const U value3 = it_second_beg[i+3];
+
+			// keep loop rolled, so it is vectorized over columns
+#pragma GCC unroll 1
+			for ( unsigned k=0; k < width; ++k )
+				accumulator[k] += it_row0[k]*value0 + it_row1[k]*value1 +
+								  it_row2[k]*value2 + it_row3[k]*value3;
+			}
+
+		// remaining rows
+		for ( ; i < ROWS1; ++i )
+			{
+			const Tt* it_row = first.begin ( i ) + j;
+			const U value = it_second_beg[i];
+
+			for ( unsigned k=0; k < width; ++k )
+				accumulator[k] += it_row[k]*value;
 			}
 
 		// assign to result
-		*it_output_beg++ = value;
+		Container::copy ( it_output_beg + j, it_output_beg + j + width, accumulator );
 		}
 	}
 
@@ -892,14 +1216,16 @@ static void transposedCauchyProduct ( const Matrix<Tt, ROWS1, COLS1>& first,
 */
 template<typename Tt,
 		 typename U,
-		 typename T_U = decltype ( Tt()*U() ),
+		 typename T_U,
 		 unsigned SIZE1,
 		 unsigned COLS2,
-		 std::enable_if_t<std::is_convertible<U, Tt>::value, int> = 0>
+		 std::enable_if_t<std::is_convertible<U, Tt>::value, int>>
 static void cauchyProduct ( const Vector<Tt, SIZE1>& first,
 							const Matrix<U, 1, COLS2>& second,
 							Matrix<T_U, SIZE1, COLS2>& output )
 	{
+	Instrument::record ( Instrument::CAUCHY_PRODUCT, std::uint64_t ( SIZE1 ) * COLS2,
+						 SIZE1 * sizeof ( Tt ) + COLS2 * sizeof ( U ) + std::uint64_t ( SIZE1 ) * COLS2 * sizeof ( T_U ) );
 	// iterator to result beginning
 	T_U* it_output_beg = output.begin();
 	Tt* it_first_beg = first.begin ();
@@ -971,6 +1297,260 @@ inline void eye ( Matrix<T, SIZE, SIZE>& m )
 		}
 	}
 
+/* CLOSED FORM DETERMINANT AND INVERSE */
+/**
+ * @brief Determinant of 2x2 Matrix
+ *
+ * @tparam T type of Matrix
+ * @param m Matrix
+ * @return T determinant
+ */
+template<typename T>
+inline T determinant ( const Matrix<T, 2, 2>& m )
+	{
+	return m.x[0][0]*m.x[1][1] - m.x[0][1]*m.x[1][0];
+	}
+
+/**
+ * @brief Determinant of 3x3 Matrix by cofactors of first row
+ *
+ * @tparam T type of Matrix
+ * @param m Matrix
+ * @return T determinant
+ */
+template<typename T>
+inline T determinant ( const Matrix<T, 3, 3>& m )
+	{
+	const T ( &a ) [3][3] = m.x;
+
+	return a[0][0] * ( a[1][1]*a[2][2] - a[1][2]*a[2][1] ) -
+		   a[0][1] * ( a[1][0]*a[2][2] - a[1][2]*a[2][0] ) +
+		   a[0][2] * ( a[1][0]*a[2][1] - a[1][1]*a[2][0] );
+	}
+
+/**
+ * @brief Determinant of 4x4 Matrix by Laplace expansion
+ * of 2x2 minors of two upper rows and two lower rows.
+ * All 12 minors are independent, so they are computed in parallel lanes.
+ *
+ * @tparam T type of Matrix
+ * @param m Matrix
+ * @return T determinant
+ */
+template<typename T>
+inline T determinant ( const Matrix<T, 4, 4>& m )
+	{
+	const T ( &a ) [4][4] = m.x;
+	// minors of rows 0 and 1
+	const T s0 = a[0][0]*a[1][1] - a[1][0]*a[0][1];
+	const T s1 = a[0][0]*a[1][2] - a[1][0]*a[0][2];
+	const T s2 = a[0][0]*a[1][3] - a[1][0]*a[0][3];
+	const T s3 = a[0][1]*a[1][2] - a[1][1]*a[0][2];
+	const T s4 = a[0][1]*a[1][3] - a[1][1]*a[0][3];
+	const T s5 = a[0][2]*a[1][3] - a[1][2]*a[0][3];
+	// minors of rows 2 and 3
+	const T c5 = a[2][2]*a[3][3] - a[3][2]*a[2][3];
+	const T c4 = a[2][1]*a[3][3] - a[3][1]*a[2][3];
+	const T c3 = a[2][1]*a[3][2] - a[3][1]*a[2][2];
+	const T c2 = a[2][0]*a[3][3] - a[3][0]*a[2][3];
+	const T c1 = a[2][0]*a[3][2] - a[3][0]*a[2][2];
+	const T c0 = a[2][0]*a[3][1] - a[3][0]*a[2][1];
+
+	return s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+	}
+
+/**
+ * @brief Inverse of 2x2 Matrix by adjugate.
+ * Singular Matrix is reported by returned value, out is not modified then.
+ *
+ * @tparam T floating point type of Matrix
+ * @param m Matrix to invert
+ * @param out inverse of m
+ * @return bool false if m is singular
+ */
+template<typename T>
+inline bool inverse ( const Matrix<T, 2, 2>& m, Matrix<T, 2, 2>& out )
+	{
+	const T det = determinant ( m );
+
+	if ( det == T ( 0 ) || ! std::isfinite ( det ) )
+		return false;
+
+	const T inverse_det = T ( 1 ) / det;
+	const T a00 = m.x[0][0], a01 = m.x[0][1], a10 = m.x[1][0], a11 = m.x[1][1];
+
+	out.x[0][0] = a11 * inverse_det;
+	out.x[0][1] = -a01 * inverse_det;
+	out.x[1][0] = -a10 * inverse_det;
+	out.x[1][1] = a00 * inverse_det;
+
+	return true;
+	}
+
+/**
+ * @brief Inverse of 3x3 Matrix by adjugate.
+ * Singular Matrix is reported by returned value, out is not modified then.
+ *
+ * @tparam T floating point type of Matrix
+ * @param m Matrix to invert
+ * @param out inverse of m
+ * @return bool false if m is singular
+ */
+template<typename T>
+inline bool inverse ( const Matrix<T, 3, 3>& m, Matrix<T, 3, 3>& out )
+	{
+	const T ( &a ) [3][3] = m.x;
+	// cofactors of first row
+	const T c00 = a[1][1]*a[2][2] - a[1][2]*a[2][1];
+	const T c01 = a[1][2]*a[2][0] - a[1][0]*a[2][2];
+	const T c02 = a[1][0]*a[2][1] - a[1][1]*a[2][0];
+	const T det = a[0][0]*c00 + a[0][1]*c01 + a[0][2]*c02;
+
+	if ( det == T ( 0 ) || ! std::isfinite ( det ) )
+		return false;
+
+	const T inverse_det = T ( 1 ) / det;
+	// m may be the same as out, so all cofactors are computed before writing
+	const T b01 = ( a[0][2]*a[2][1] - a[0][1]*a[2][2] ) * inverse_det;
+	const T b02 = ( a[0][1]*a[1][2] - a[0][2]*a[1][1] ) * inverse_det;
+	const T b11 = ( a[0][0]*a[2][2] - a[0][2]*a[2][0] ) * inverse_det;
+	const T b12 = ( a[0][2]*a[1][0] - a[0][0]*a[1][2] ) * inverse_det;
+	const T b21 = ( a[0][1]*a[2][0] - a[0][0]*a[2][1] ) * inverse_det;
+	const T b22 = ( a[0][0]*a[1][1] - a[0][1]*a[1][0] ) * inverse_det;
+
+	out.x[0][0] = c00 * inverse_det;
+	out.x[0][1] = b01;
+	out.x[0][2] = b02;
+	out.x[1][0] = c01 * inverse_det;
+	out.x[1][1] = b11;
+	out.x[1][2] = b12;
+	out.x[2][0] = c02 * inverse_det;
+	out.x[2][1] = b21;
+	out.x[2][2] = b22;
+
+	return true;
+	}
+
+/**
+ * @brief Inverse of 4x4 Matrix by adjugate built from 2x2 minors
+ * of two upper rows and two lower rows. The minors and all 16 cofactors
+ * are independent expressions of the same shape, so they are computed
+ * in parallel lanes by compiler.
+ * Singular Matrix is reported by returned value, out is not modified then.
+ *
+ * @tparam T floating point type of Matrix
+ * @param m Matrix to invert
+ * @param out inverse of m
+ * @return bool false if m is singular
+ */
+template<typename T>
+inline bool inverse ( const Matrix<T, 4, 4>& m, Matrix<T, 4, 4>& out )
+	{
+	const T ( &a ) [4][4] = m.x;
+	// minors of rows 0 and 1
+	const T s0 = a[0][0]*a[1][1] - a[1][0]*a[0][1];
+	const T s1 = a[0][0]*a[1][2] - a[1][0]*a[0][2];
+	const T s2 = a[0][0]*a[1][3] - a[1][0]*a[0][3];
+	const T s3 = a[0][1]*a[1][2] - a[1][1]*a[0][2];
+	const T s4 = a[0][1]*a[1][3] - a[1][1]*a[0][3];
+	const T s5 = a[0][2]*a[1][3] - a[1][2]*a[0][3];
+	// minors of rows 2 and 3
+	const T c5 = a[2][2]*a[3][3] - a[3][2]*a[2][3];
+	const T c4 = a[2][1]*a[3][3] - a[3][1]*a[2][3];
+	const T c3 = a[2][1]*a[3][2] - a[3][1]*a[2][2];
+	const T c2 = a[2][0]*a[3][3] - a[3][0]*a[2][3];
+	const T c1 = a[2][0]*a[3][2] - a[3][0]*a[2][2];
+	const T c0 = a[2][0]*a[3][1] - a[3][0]*a[2][1];
+	const T det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0;
+
+	if ( det == T ( 0 ) || ! std::isfinite ( det ) )
+		return false;
+
+	const T d = T ( 1 ) / det;
+	T b[4][4];
+
+	b[0][0] = (  a[1][1]*c5 - a[1][2]*c4 + a[1][3]*c3 ) * d;
+	b[0][1] = ( -a[0][1]*c5 + a[0][2]*c4 - a[0][3]*c3 ) * d;
+	b[0][2] = (  a[3][1]*s5 - a[3][2]*s4 + a[3][3]*s3 ) * d;
+	b[0][3] = ( -a[2][1]*s5 + a[2][2]*s4 - a[2][3]*s3 ) * d;
+
+	b[1][0] = ( -a[1][0]*c5 + a[1][2]*c2 - a[1][3]*c1 ) * d;
+	b[1][1] = (  a[0][0]*c5 - a[0][2]*c2 + a[0][3]*c1 ) * d;
+	b[1][2] = ( -a[3][0]*s5 + a[3][2]*s2 - a[3][3]*s1 ) * d;
+	b[1][3] = (  a[2][0]*s5 - a[2][2]*s2 + a[2][3]*s1 ) * d;
+
+	b[2][0] = (  a[1][0]*c4 - a[1][1]*c2 + a[1][3]*c0 ) * d;
+	b[2][1] = ( -a[0][0]*c4 + a[0][1]*c2 - a[0][3]*c0 ) * d;
+	b[2][2] = (  a[3][0]*s4 - a[3][1]*s2 + a[3][3]*s0 ) * d;
+	b[2][3] = ( -a[2][0]*s4 + a[2][1]*s2 - a[2][3]*s0 ) * d;
+
+	b[3][0] = ( -a[1][0]*c3 + a[1][1]*c1 - a[1][2]*c0 ) * d;
+	b[3][1] = (  a[0][0]*c3 - a[0][1]*c1 + a[0][2]*c0 ) * d;
+	b[3][2] = ( -a[3][0]*s3 + a[3][1]*s1 - a[3][2]*s0 ) * d;
+	b[3][3] = (  a[2][0]*s3 - a[2][1]*s1 + a[2][2]*s0 ) * d;
+
+	Container::copy ( out.begin(), out.end(), *b );
+
+	return true;
+	}
+
+/**
+ * @brief Determinants of range of square matrices
+ * Container pointered by out_beg must be the same size
+ * as container pointered by it_beg
+ *
+ * @tparam Iterator Forward Iterator to Matrix
+ * @tparam ConstIterator Const Forward Iterator to Matrix
+ * @tparam Iterator2 Forward Iterator to determinant
+ * @param it_beg iterator at beginning of range of matrices
+ * @param it_end iterator after end of range of matrices
+ * @param out_beg iterator at beginning of range of determinants
+ */
+template<typename Iterator,
+		 typename ConstIterator,
+		 typename Iterator2>
+inline void determinantBatch ( Iterator it_beg, ConstIterator it_end, Iterator2 out_beg )
+	{
+	while ( it_beg != it_end )
+		*out_beg++ = determinant ( *it_beg++ );
+	}
+
+/**
+ * @brief Inverses of range of square matrices
+ * Containers pointered by out_beg and regular_beg must be the same size
+ * as container pointered by it_beg.
+ * Inverse of singular Matrix is not written, it is reported
+ * by false at corresponding position of regular_beg.
+ *
+ * @tparam Iterator Forward Iterator to Matrix
+ * @tparam ConstIterator Const Forward Iterator to Matrix
+ * @tparam Iterator2 Forward Iterator to inverse Matrix
+ * @tparam Iterator3 Forward Iterator to bool
+ * @param it_beg iterator at beginning of range of matrices
+ * @param it_end iterator after end of range of matrices
+ * @param out_beg iterator at beginning of range of inverses
+ * @param regular_beg iterator at beginning of range of flags
+ * @return unsigned number of singular matrices
+ */
+template<typename Iterator,
+		 typename ConstIterator,
+		 typename Iterator2,
+		 typename Iterator3>
+inline unsigned inverseBatch ( Iterator it_beg, ConstIterator it_end, Iterator2 out_beg, Iterator3 regular_beg )
+	{
+	unsigned singular = 0;
+
+	while ( it_beg != it_end )
+		{
+		bool regular = inverse ( *it_beg++, *out_beg++ );
+
+		singular += regular ? 0 : 1;
+		*regular_beg++ = regular;
+		}
+
+	return singular;
+	}
+
 // x
 template<typename T>
 Matrix<T, 3, 3> rotationX ( T angle )
@@ -1018,4 +1598,160 @@ Matrix<T, 3, 3> rotationMatrix ( const Vector<T, 3>& angles )
 		   rotationX ( angles.x[0] );
 	}
 
+/**
+ * @brief Rotation Matrix of rotation vector by exponential map (Rodrigues' formula)
+ * R = I + sin(t)/t [w]x + (1-cos(t))/t^2 [w]x^2 where t = |w|.
+ * Coefficients are computed from half angle, so 1-cos(t) has no cancellation,
+ * and from Taylor series for angles whose square is below sqrt(epsilon),
+ * so small rotations like angular velocity times IMU period are exact to rounding.
+ *
+ * @tparam T floating point type
+ * @param omega rotation vector, axis scaled by angle in radians
+ * @return Matrix<T, 3, 3> rotation Matrix
+ */
+template<typename T>
+inline Matrix<T, 3, 3> expSO3 ( const Vector<T, 3>& omega )
+	{
+	const T ( &w ) [3] = omega.x;
+	const T theta2 = w[0]*w[0] + w[1]*w[1] + w[2]*w[2];
+	T a; // sin(t)/t
+	T b; // (1-cos(t))/t^2
+	T c; // cos(t)
+
+	if ( theta2 < std::sqrt ( std::numeric_limits<T>::epsilon() ) )
+		{
+		a = T ( 1 ) - theta2 * ( T ( 1 ) / T ( 6 ) - theta2 * ( T ( 1 ) / T ( 120 ) ) );
+		b = T ( 0.5 ) - theta2 * ( T ( 1 ) / T ( 24 ) - theta2 * ( T ( 1 ) / T ( 720 ) ) );
+		c = T ( 1 ) - theta2 * b;
+		}
+	else
+		{
+		const T theta = std::sqrt ( theta2 );
+		const T sin_half = std::sin ( T ( 0.5 ) * theta );
+		const T cos_half = std::cos ( T ( 0.5 ) * theta );
+		const T inverse_theta = T ( 1 ) / theta;
+
+		a = T ( 2 ) * sin_half * cos_half * inverse_theta;
+		b = T ( 2 ) * sin_half * sin_half * inverse_theta * inverse_theta;
+		c = cos_half * cos_half - sin_half * sin_half;
+		}
+
+	// R = cos(t) I + b w w^T + a [w]x
+	const T bxy = b * w[0] * w[1];
+	const T bxz = b * w[0] * w[2];
+	const T byz = b * w[1] * w[2];
+	const T ax = a * w[0];
+	const T ay = a * w[1];
+	const T az = a * w[2];
+
+	return Matrix<T, 3, 3> { c + b * w[0] * w[0], bxy - az, bxz + ay,
+							 bxy + az, c + b * w[1] * w[1], byz - ax,
+							 bxz - ay, byz + ax, c + b * w[2] * w[2]
+						   };
+	}
+
+/**
+ * @brief Rotation vector of rotation Matrix by logarithmic map, inverse of expSO3
+ * Angle is atan2 of sine and cosine parts of r, so it is accurate in whole range [0, pi].
+ * Small angles use Taylor series of t/sin(t). For angles above pi/2 the axis is taken
+ * from symmetric part of r, because the skew part vanishes at pi, its sign
+ * is kept from skew part.
+ *
+ * @tparam T floating point type
+ * @param r rotation Matrix
+ * @return Vector<T, 3> rotation vector, axis scaled by angle in radians
+ */
+template<typename T>
+inline Vector<T, 3> logSO3 ( const Matrix<T, 3, 3>& r )
+	{
+	const T ( &m ) [3][3] = r.x;
+	// sin(t) * axis
+	const T v[3] = { T ( 0.5 ) * ( m[2][1] - m[1][2] ),
+					 T ( 0.5 ) * ( m[0][2] - m[2][0] ),
+					 T ( 0.5 ) * ( m[1][0] - m[0][1] )
+				   };
+	const T sin_theta = std::sqrt ( v[0]*v[0] + v[1]*v[1] + v[2]*v[2] );
+	const T cos_theta = T ( 0.5 ) * ( m[0][0] + m[1][1] + m[2][2] - T ( 1 ) );
+	const T theta = std::atan2 ( sin_theta, cos_theta );
+
+	if ( cos_theta >= T ( 0 ) )
+		{
+		const T theta2 = theta * theta;
+		// t/sin(t)
+		const T scale = theta2 < std::sqrt ( std::numeric_limits<T>::epsilon() ) ?
+						T ( 1 ) + theta2 * ( T ( 1 ) / T ( 6 ) + theta2 * ( T ( 7 ) / T ( 360 ) ) ) :
+						theta / sin_theta;
+
+		return Vector<T, 3> { scale * v[0], scale * v[1], scale * v[2] };
+		}
+
+	// symmetric part is cos(t) I + (1-cos(t)) u u^T, use its largest diagonal element
+	const T one_minus_cos = T ( 1 ) - cos_theta;
+	unsigned k = m[1][1] > m[0][0] ? 1 : 0;
+	k = m[2][2] > m[k][k] ? 2 : k;
+
+	T u[3];
+
+	for ( unsigned i = 0; i < 3; ++i )
+		u[i] = T ( 0.5 ) * ( m[i][k] + m[k][i] );
+
+	u[k] = std::sqrt ( std::max ( ( m[k][k] - cos_theta ) / one_minus_cos, T ( 0 ) ) );
+
+	const T inverse_uk = T ( 1 ) / ( u[k] * one_minus_cos );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		if ( i != k )
+			u[i] *= inverse_uk;
+
+	// axis sign of skew part, both signs are valid at pi
+	const T scale = u[0]*v[0] + u[1]*v[1] + u[2]*v[2] < T ( 0 ) ? -theta : theta;
+
+	return Vector<T, 3> { scale * u[0], scale * u[1], scale * u[2] };
+	}
+
+/**
+ * @brief Rotation matrices of range of rotation vectors by expSO3
+ * Container pointered by out_beg must be the same size
+ * as container pointered by it_beg
+ *
+ * @tparam Iterator Forward Iterator to Vector<T, 3>
+ * @tparam ConstIterator Const Forward Iterator to Vector<T, 3>
+ * @tparam Iterator2 Forward Iterator to Matrix<T, 3, 3>
+ * @param it_beg iterator at beginning of range of rotation vectors
+ * @param it_end iterator after end of range of rotation vectors
+ * @param out_beg iterator at beginning of range of rotation matrices
+ */
+template<typename Iterator,
+		 typename ConstIterator,
+		 typename Iterator2>
+inline void expSO3Batch ( Iterator it_beg, ConstIterator it_end, Iterator2 out_beg )
+	{
+	while ( it_beg != it_end )
+		*out_beg++ = expSO3 ( *it_beg++ );
+	}
+
+/**
+ * @brief Rotation vectors of range of rotation matrices by logSO3
+ * Container pointered by out_beg must be the same size
+ * as container pointered by it_beg
+ *
+ * @tparam Iterator Forward Iterator to Matrix<T, 3, 3>
+ * @tparam ConstIterator Const Forward Iterator to Matrix<T, 3, 3>
+ * @tparam Iterator2 Forward Iterator to Vector<T, 3>
+ * @param it_beg iterator at beginning of range of rotation matrices
+ * @param it_end iterator after end of range of rotation matrices
+ * @param out_beg iterator at beginning of range of rotation vectors
+ */
+template<typename Iterator,
+		 typename ConstIterator,
+		 typename Iterator2>
+inline void logSO3Batch ( Iterator it_beg, ConstIterator it_end, Iterator2 out_beg )
+	{
+	while ( it_beg != it_end )
+		*out_beg++ = logSO3 ( *it_beg++ );
+	}
+
+// views returned by block, row and col
+#include "View.hpp"
+
 #endif //MATRIX_HPP
\ No newline at end of file
@@ -0,0 +1,1056 @@
+#ifndef NPY_HPP
+#define NPY_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "View.hpp"
+#include "BinaryIO.hpp"
+
+/*
+ * NumPy .npy arrays and uncompressed .npz archives of .npy arrays.
+ * npy file is magic "\x93NUMPY", version, length of header and header,
+ * Python dict literal of dtype, memory order and shape, padded so that
+ * data start at offset multiple of 64:
+ *
+ *   {'descr': '<f8', 'fortran_order': False, 'shape': (1000, 3), }
+ *
+ * Records map to shapes: scalar (count,), Vector (count, SIZE), Matrix
+ * (count, ROWS, COLS), file of single record may omit count. Arrays are
+ * loaded without copy from read only mapping when byte order is native,
+ * memory order is C and data are aligned, otherwise they are converted
+ * on load. npz is zip archive of stored (uncompressed) entries "name.npy",
+ * entries written by NpzWriter are aligned for loading without copy too.
+ */
+
+namespace Npy
+	{
+	/**
+	 * @brief Dimensions of record, empty for scalar
+	 */
+	template<class E>
+	struct Shape
+		{
+		static std::vector<std::uint64_t> dims()
+			{
+			return {};
+			}
+		};
+
+	template<typename T, unsigned SIZE>
+	struct Shape<Vector<T, SIZE>>
+		{
+		static std::vector<std::uint64_t> dims()
+			{
+			return { SIZE };
+			}
+		};
+
+	template<typename T, unsigned ROWS, unsigned COLS>
+	struct Shape<Matrix<T, ROWS, COLS>>
+		{
+		static std::vector<std::uint64_t> dims()
+			{
+			return { ROWS, COLS };
+			}
+		};
+
+	/**
+	 * @brief dtype of element, byte order, kind and size as '<f8'
+	 *
+	 * @tparam T type of element
+	 * @return std::string
+	 */
+	template<typename T>
+	inline std::string descr()
+		{
+		static_assert ( std::is_arithmetic<T>::value && !std::is_same<T, long double>::value,
+						"Element of npy array must be integer, float or double." );
+
+		const char order = sizeof ( T ) == 1 ? '|' : BinaryIO::byteOrder() == BinaryIO::LITTLE_ENDIAN_ORDER ? '<' : '>';
+		const char kind = std::is_same<T, bool>::value ? 'b' :
+						  std::is_floating_point<T>::value ? 'f' :
+						  std::is_signed<T>::value ? 'i' : 'u';
+
+		return std::string ( 1, order ) + kind + std::to_string ( sizeof ( T ) );
+		}
+
+	/**
+	 * @brief Number of elements of shape, throw runtime_error on overflow
+	 */
+	inline std::uint64_t elements ( const std::vector<std::uint64_t>& shape )
+		{
+		std::uint64_t count = 1;
+
+		for ( std::uint64_t dim : shape )
+			{
+			if ( dim != 0 && count > UINT64_MAX / dim )
+				throw std::runtime_error ( "Shape of npy array is too large" );
+
+			count *= dim;
+			}
+
+		return count;
+		}
+
+	/**
+	 * @brief Header of npy array
+	 */
+	struct Header
+		{
+		std::string descr;
+		bool fortran_order;
+		std::vector<std::uint64_t> shape;
+		// offset of data from beginning of npy array
+		std::size_t data_offset;
+		};
+
+	/**
+	 * @brief Magic, version, length and header of npy array in C order,
+	 * padded to multiple of 64 bytes
+	 *
+	 * @param descr dtype of elements
+	 * @param shape shape of array
+	 * @return std::string
+	 */
+	inline std::string header ( const std::string& descr, const std::vector<std::uint64_t>& shape )
+		{
+		std::string tuple;
+
+		for ( std::size_t i = 0; i < shape.size(); ++i )
+			tuple += ( i == 0 ? "" : ", " ) + std::to_string ( shape[i] );
+
+		if ( shape.size() == 1 )
+			tuple += ",";
+
+		std::string dict = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (" + tuple + "), }";
+
+		// version 1.0 stores length in 2 bytes, 2.0 in 4 bytes
+		const std::size_t preamble = dict.size() + 64 < 65536 ? 10 : 12;
+		const std::size_t length = ( preamble + dict.size() + 1 + 63 ) / 64 * 64 - preamble;
+		dict.append ( length - dict.size() - 1, ' ' );
+		dict += '\n';
+
+		std::string text ( "\x93NUMPY", 6 );
+		text += char ( preamble == 10 ? 1 : 2 );
+		text += char ( 0 );
+
+		for ( std::size_t i = 0; i < preamble - 8; ++i )
+			text += char ( ( length >> ( 8 * i ) ) & 0xff );
+
+		return text + dict;
+		}
+
+	/**
+	 * @brief Position of value of key in header dict
+	 */
+	inline std::size_t valueOf ( const std::string& dict, const char* key )
+		{
+		std::size_t position = dict.find ( std::string ( "'" ) + key + "'" );
+
+		if ( position == std::string::npos )
+			position = dict.find ( std::string ( "\"" ) + key + "\"" );
+
+		if ( position == std::string::npos || ( position = dict.find ( ':', position ) ) == std::string::npos )
+			throw std::runtime_error ( std::string ( "Header of npy array has no " ) + key );
+
+		return dict.find_first_not_of ( ' ', position + 1 );
+		}
+
+	/**
+	 * @brief Parse header of npy array in [data, data + size).
+	 * Throw runtime_error when header is malformed.
+	 *
+	 * @param data pointer at first byte of npy array
+	 * @param size number of bytes
+	 * @return Header
+	 */
+	inline Header parseHeader ( const unsigned char* data, std::size_t size )
+		{
+		if ( size < 10 || std::memcmp ( data, "\x93NUMPY", 6 ) != 0 )
+			throw std::runtime_error ( "Not a npy array" );
+
+		std::size_t preamble;
+		std::size_t length;
+
+		if ( data[6] == 1 )
+			{
+			preamble = 10;
+			length = std::size_t ( data[8] ) | std::size_t ( data[9] ) << 8;
+			}
+		else if ( ( data[6] == 2 || data[6] == 3 ) && size >= 12 )
+			{
+			preamble = 12;
+			length = std::size_t ( data[8] ) | std::size_t ( data[9] ) << 8 | std::size_t ( data[10] ) << 16 | std::size_t ( data[11] ) << 24;
+			}
+		else
+			throw std::runtime_error ( "Unsupported version of npy array" );
+
+		if ( length > size - preamble )
+			throw std::runtime_error ( "Npy array is truncated" );
+
+		const std::string dict ( reinterpret_cast<const char*> ( data ) + preamble, length );
+		Header h;
+		h.data_offset = preamble + length;
+
+		// dtype as string, structured dtypes are lists
+		std::size_t position = valueOf ( dict, "descr" );
+		const char quote = position < dict.size() ? dict[position] : '\0';
+		const std::size_t descr_end = quote == '\'' || quote == '"' ? dict.find ( quote, position + 1 ) : std::string::npos;
+
+		if ( descr_end == std::string::npos )
+			throw std::runtime_error ( "Unsupported dtype of npy array" );
+
+		h.descr = dict.substr ( position + 1, descr_end - position - 1 );
+
+		position = valueOf ( dict, "fortran_order" );
+		h.fortran_order = dict.compare ( position, 4, "True" ) == 0;
+
+		if ( !h.fortran_order && dict.compare ( position, 5, "False" ) != 0 )
+			throw std::runtime_error ( "Malformed header of npy array" );
+
+		// shape as tuple of integers
+		position = valueOf ( dict, "shape" );
+
+		if ( position == std::string::npos || dict[position] != '(' )
+			throw std::runtime_error ( "Malformed header of npy array" );
+
+		for ( ++position; position < dict.size() && dict[position] != ')'; )
+			{
+			if ( dict[position] == ' ' || dict[position] == ',' )
+				{
+				++position;
+				continue;
+				}
+
+			std::uint64_t dim = 0;
+			const std::size_t dim_beg = position;
+
+			for ( ; position < dict.size() && unsigned ( dict[position] - '0' ) < 10; ++position )
+				{
+				const unsigned digit = unsigned ( dict[position] - '0' );
+
+				if ( dim > ( UINT64_MAX - digit ) / 10 )
+					throw std::runtime_error ( "Dimension of npy array is out of range" );
+
+				dim = dim * 10 + digit;
+				}
+
+			// 'L' suffix of Python 2
+			if ( position < dict.size() && dict[position] == 'L' )
+				++position;
+
+			if ( position == dim_beg )
+				throw std::runtime_error ( "Malformed header of npy array" );
+
+			h.shape.push_back ( dim );
+			}
+
+		if ( position == dict.size() )
+			throw std::runtime_error ( "Malformed header of npy array" );
+
+		return h;
+		}
+
+	/**
+	 * @brief Number of records E of array, scalar records accept any shape.
+	 * Throw runtime_error when dtype or shape does not match E.
+	 *
+	 * @tparam E type of record, scalar, Vector or Matrix
+	 * @param h header of array
+	 * @return std::uint64_t
+	 */
+	template<class E>
+	std::uint64_t count ( const Header& h )
+		{
+		using T = typename BinaryIO::Record<E>::type;
+		const std::string expected = descr<T>();
+
+		if ( h.descr.size() < 2 || h.descr.compare ( 1, std::string::npos, expected, 1, std::string::npos ) != 0
+				|| std::string ( "<>|=" ).find ( h.descr[0] ) == std::string::npos )
+			throw std::runtime_error ( "Element type of npy array differs, " + h.descr + " instead of " + expected );
+
+		const std::vector<std::uint64_t> dims = Shape<E>::dims();
+
+		if ( dims.empty() )
+			return elements ( h.shape );
+
+		if ( h.shape == dims )
+			return 1;
+
+		if ( h.shape.size() != dims.size() + 1 || !std::equal ( dims.begin(), dims.end(), h.shape.begin() + 1 ) )
+			throw std::runtime_error ( "Shape of npy array differs" );
+
+		return h.shape[0];
+		}
+
+	/**
+	 * @brief Byte order of dtype differs from this machine
+	 */
+	inline bool swapped ( const std::string& descr )
+		{
+		const char native = BinaryIO::byteOrder() == BinaryIO::LITTLE_ENDIAN_ORDER ? '<' : '>';
+
+		return ( descr[0] == '<' || descr[0] == '>' ) && descr[0] != native;
+		}
+
+	/**
+	 * @brief Copy elements of array into C order and native byte order
+	 *
+	 * @param src pointer at first byte of data of array
+	 * @param dst pointer at first byte of output
+	 * @param size size of element in bytes
+	 * @param shape shape of array
+	 * @param fortran data are in Fortran order
+	 * @param swap byte order of data differs
+	 */
+	inline void convert ( const unsigned char* src, unsigned char* dst, std::size_t size,
+						  const std::vector<std::uint64_t>& shape, bool fortran, bool swap )
+		{
+		const std::uint64_t total = elements ( shape );
+
+		if ( !fortran )
+			std::memcpy ( dst, src, std::size_t ( total ) * size );
+		else
+			{
+			// C order walk over data in Fortran order
+			const std::size_t n = shape.size();
+			std::vector<std::uint64_t> index ( n, 0 );
+			std::vector<std::uint64_t> stride ( n, 1 );
+			std::uint64_t offset = 0;
+
+			for ( std::size_t k = 1; k < n; ++k )
+				stride[k] = stride[k - 1] * shape[k - 1];
+
+			for ( std::uint64_t i = 0; i < total; ++i )
+				{
+				std::memcpy ( dst + i * size, src + offset * size, size );
+
+				for ( std::size_t k = n; k-- > 0; )
+					{
+					offset += stride[k];
+
+					if ( ++index[k] < shape[k] )
+						break;
+
+					offset -= stride[k] * shape[k];
+					index[k] = 0;
+					}
+				}
+			}
+
+		if ( swap )
+			for ( std::uint64_t i = 0; i < total; ++i )
+				std::reverse ( dst + i * size, dst + ( i + 1 ) * size );
+		}
+
+	/**
+	 * @brief CRC-32 of bytes as used by zip, slicing by 8 bytes.
+	 * Continued by passing previous CRC as seed.
+	 *
+	 * @param data pointer at first byte
+	 * @param size number of bytes
+	 * @param seed CRC of previous bytes
+	 * @return std::uint32_t
+	 */
+	inline std::uint32_t crc32 ( const void* data, std::size_t size, std::uint32_t seed = 0 )
+		{
+		struct Table
+			{
+			std::uint32_t x[8][256];
+
+			Table()
+				{
+				for ( std::uint32_t i = 0; i < 256; ++i )
+					{
+					std::uint32_t crc = i;
+
+					for ( unsigned j = 0; j < 8; ++j )
+						crc = crc & 1 ? ( crc >> 1 ) ^ 0xEDB88320u : crc >> 1;
+
+					x[0][i] = crc;
+					}
+
+				for ( unsigned k = 1; k < 8; ++k )
+					for ( std::uint32_t i = 0; i < 256; ++i )
+						x[k][i] = ( x[k - 1][i] >> 8 ) ^ x[0][x[k - 1][i] & 0xff];
+				}
+			};
+
+		static const Table table;
+		const unsigned char* it = static_cast<const unsigned char*> ( data );
+		const unsigned char* it_end = it + size;
+		std::uint32_t crc = ~seed;
+
+		for ( ; it_end - it >= 8; it += 8 )
+			{
+			const std::uint32_t low = crc ^ ( std::uint32_t ( it[0] ) | std::uint32_t ( it[1] ) << 8 | std::uint32_t ( it[2] ) << 16 | std::uint32_t ( it[3] ) << 24 );
+			crc = table.x[7][low & 0xff] ^ table.x[6][ ( low >> 8 ) & 0xff] ^ table.x[5][ ( low >> 16 ) & 0xff] ^ table.x[4][low >> 24]
+				  ^ table.x[3][it[4]] ^ table.x[2][it[5]] ^ table.x[1][it[6]] ^ table.x[0][it[7]];
+			}
+
+		for ( ; it != it_end; ++it )
+			crc = ( crc >> 8 ) ^ table.x[0][ ( crc ^ *it ) & 0xff];
+
+		return ~crc;
+		}
+
+	/**
+	 * @brief Little endian integer of bytes bytes at data
+	 */
+	inline std::uint32_t get ( const unsigned char* data, unsigned bytes )
+		{
+		std::uint32_t value = 0;
+
+		for ( unsigned i = 0; i < bytes; ++i )
+			value |= std::uint32_t ( data[i] ) << ( 8 * i );
+
+		return value;
+		}
+
+	/**
+	 * @brief Append little endian integer of bytes bytes to text
+	 */
+	inline void put ( std::string& text, std::uint64_t value, unsigned bytes )
+		{
+		for ( unsigned i = 0; i < bytes; ++i )
+			text += char ( ( value >> ( 8 * i ) ) & 0xff );
+		}
+
+	/**
+	 * @brief Output of array into file, counts written bytes and their CRC-32
+	 * when written into npz archive
+	 */
+	struct Output
+		{
+		std::FILE* file;
+		bool checked;
+		std::uint32_t crc;
+		std::uint64_t size;
+
+		Output ( std::FILE* file, bool checked )
+			: file ( file ), checked ( checked ), crc ( 0 ), size ( 0 )
+			{
+			}
+
+		void write ( const void* data, std::size_t size )
+			{
+			BinaryIO::write ( file, data, size );
+
+			if ( checked )
+				crc = crc32 ( data, size, crc );
+
+			this->size += size;
+			}
+		};
+
+	/**
+	 * @brief Write range of records as npy array of shape ( count, dims of record )
+	 */
+	template<typename Iterator, typename ConstIterator>
+	void writeArray ( Output& out, Iterator it_beg, ConstIterator it_end )
+		{
+		using E = std::remove_const_t<Container::ret_type<Iterator>>;
+		BinaryIO::checkRecord<E>();
+		std::vector<std::uint64_t> shape = Shape<E>::dims();
+		std::uint64_t count = 0;
+
+		for ( Iterator it = it_beg; it != it_end; ++it )
+			++count;
+
+		shape.insert ( shape.begin(), count );
+		const std::string text = header ( descr<typename BinaryIO::Record<E>::type>(), shape );
+		out.write ( text.data(), text.size() );
+		auto sink = [&out] ( const void* data, std::size_t size )
+			{
+			out.write ( data, size );
+			};
+
+		BinaryIO::writeRecords<E> ( it_beg, it_end, sink,
+									std::integral_constant < bool, std::is_pointer<Iterator>::value && std::is_pointer<ConstIterator>::value > () );
+		}
+
+	/**
+	 * @brief Write contiguous elements as npy array of shape
+	 */
+	template<typename T>
+	void writeArray ( Output& out, const std::vector<std::uint64_t>& shape, const T* data )
+		{
+		const std::string text = header ( descr<T>(), shape );
+		out.write ( text.data(), text.size() );
+		out.write ( data, std::size_t ( elements ( shape ) ) * sizeof ( T ) );
+		}
+
+	/**
+	 * @brief Write elements of view of any strides as npy array of shape ( rows, cols )
+	 */
+	template<typename T, unsigned ROWS, unsigned COLS>
+	void writeArray ( Output& out, const MatrixView<T, ROWS, COLS>& m )
+		{
+		using U = std::remove_const_t<T>;
+		const std::string text = header ( descr<U>(), { m.rows(), m.cols() } );
+		std::vector<U> row ( m.cols() );
+		out.write ( text.data(), text.size() );
+
+		for ( unsigned i = 0; i < m.rows(); ++i )
+			{
+			Container::copy ( row.begin(), row.end(), m.row ( i ).begin() );
+			out.write ( row.data(), row.size() * sizeof ( U ) );
+			}
+		}
+	}
+
+/**
+ * @brief Write range of records, scalars, Vectors or Matrices of the same type,
+ * into npy array at path of shape ( count, dims of record ).
+ * Throw runtime_error on failure.
+ *
+ * @tparam Iterator Forward Iterator
+ * @tparam ConstIterator Const Forward Iterator
+ * @param path path of file
+ * @param it_beg iterator at first record
+ * @param it_end iterator after last record
+ */
+template<typename Iterator, typename ConstIterator>
+void writeNpy ( const std::string& path, Iterator it_beg, ConstIterator it_end )
+	{
+	BinaryIO::File file ( path, "wb" );
+	Npy::Output out ( file.file, false );
+	Npy::writeArray ( out, it_beg, it_end );
+	file.close();
+	}
+
+/**
+ * @brief Write Vector into npy array at path of shape ( SIZE, ).
+ * Throw runtime_error on failure.
+ */
+template<typename T, unsigned SIZE>
+void writeNpy ( const std::string& path, const Vector<T, SIZE>& v )
+	{
+	BinaryIO::File file ( path, "wb" );
+	Npy::Output out ( file.file, false );
+	Npy::writeArray ( out, { SIZE }, v.x );
+	file.close();
+	}
+
+/**
+ * @brief Write Matrix into npy array at path of shape ( ROWS, COLS ).
+ * Throw runtime_error on failure.
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+void writeNpy ( const std::string& path, const Matrix<T, ROWS, COLS>& m )
+	{
+	BinaryIO::File file ( path, "wb" );
+	Npy::Output out ( file.file, false );
+	Npy::writeArray ( out, { ROWS, COLS }, &m.x[0][0] );
+	file.close();
+	}
+
+/**
+ * @brief Write view of Matrix of static or dynamic extent into npy array
+ * at path of shape ( rows, cols ). Throw runtime_error on failure.
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+void writeNpy ( const std::string& path, const MatrixView<T, ROWS, COLS>& m )
+	{
+	BinaryIO::File file ( path, "wb" );
+	Npy::Output out ( file.file, false );
+	Npy::writeArray ( out, m );
+	file.close();
+	}
+
+/**
+ * @brief Records of npy array, used in place of read only mapping
+ * when byte order is native, order is C and data are aligned for E,
+ * otherwise converted into own memory on load. Move only.
+ *
+ * @tparam E type of record, scalar, Vector or Matrix
+ */
+template<class E>
+class NpyArray
+	{
+	public:
+		using value_type = E;
+		using iterator = const E*;
+
+	private:
+		std::shared_ptr<const BinaryIO::MappedFile> file;
+		Npy::Header h;
+		std::vector<E> converted;
+		const E* records;
+		std::size_t count;
+
+	public:
+		/**
+		 * @brief Load npy array at path.
+		 * Throw runtime_error when file cannot be mapped or dtype or shape does not match E.
+		 *
+		 * @param path path of file
+		 */
+		explicit NpyArray ( const std::string& path )
+			: NpyArray ( std::make_shared<const BinaryIO::MappedFile> ( path ), 0, std::size_t ( -1 ) )
+			{
+			}
+
+		/**
+		 * @brief Load npy array stored at offset of mapped file, as entry of npz archive
+		 *
+		 * @param file mapped file shared by arrays
+		 * @param offset offset of npy array in file
+		 * @param size size of npy array in bytes, clamped to end of file
+		 */
+		NpyArray ( std::shared_ptr<const BinaryIO::MappedFile> file, std::size_t offset, std::size_t size )
+			: file ( std::move ( file ) )
+			{
+			using T = typename BinaryIO::Record<E>::type;
+			BinaryIO::checkRecord<E>();
+
+			if ( offset > this->file->size() )
+				throw std::runtime_error ( "Npy array is truncated" );
+
+			size = std::min ( size, this->file->size() - offset );
+			const unsigned char* npy = this->file->data() + offset;
+			h = Npy::parseHeader ( npy, size );
+			const std::uint64_t records_count = Npy::count<E> ( h );
+
+			if ( h.data_offset > size || records_count > ( size - h.data_offset ) / sizeof ( E ) )
+				throw std::runtime_error ( "Npy array is truncated" );
+
+			count = std::size_t ( records_count );
+			const unsigned char* data = npy + h.data_offset;
+			const bool swap = sizeof ( T ) > 1 && Npy::swapped ( h.descr );
+			const bool fortran = h.fortran_order && h.shape.size() > 1;
+
+			if ( !swap && !fortran && reinterpret_cast<std::uintptr_t> ( data ) % alignof ( E ) == 0 )
+				records = reinterpret_cast<const E*> ( data );
+			else
+				{
+				converted.resize ( count );
+				Npy::convert ( data, reinterpret_cast<unsigned char*> ( converted.data() ), sizeof ( T ), h.shape, fortran, swap );
+				records = converted.data();
+				}
+			}
+
+		NpyArray ( NpyArray&& ) = default;
+		NpyArray& operator= ( NpyArray&& ) = default;
+		NpyArray ( const NpyArray& ) = delete;
+		NpyArray& operator= ( const NpyArray& ) = delete;
+
+		/**
+		 * @brief Number of records
+		 *
+		 * @return std::size_t
+		 */
+		inline std::size_t size() const
+			{
+			return count;
+			}
+
+		inline const E* begin() const
+			{
+			return records;
+			}
+
+		inline const E* end() const
+			{
+			return records + count;
+			}
+
+		/**
+		 * @brief Record at position idx, not checked
+		 *
+		 * @param idx position index
+		 * @return const E&
+		 */
+		inline const E& operator[] ( std::size_t idx ) const
+			{
+			return records[idx];
+			}
+
+		/**
+		 * @brief Shape of array as stored in file
+		 *
+		 * @return const std::vector<std::uint64_t>&
+		 */
+		inline const std::vector<std::uint64_t>& shape() const
+			{
+			return h.shape;
+			}
+
+		/**
+		 * @brief Records are used in place of mapping
+		 *
+		 * @return true when array was loaded without copy
+		 */
+		inline bool mapped() const
+			{
+			return converted.empty();
+			}
+
+		/**
+		 * @brief Array of two dimensions as Matrix view of dynamic extent, for scalar records.
+		 * Throw runtime_error when array has not two dimensions.
+		 *
+		 * @return MatrixView<const E>
+		 */
+		template<typename U = E, std::enable_if_t<std::is_arithmetic<U>::value, int> = 0>
+		MatrixView<const U> matrix() const
+			{
+			if ( h.shape.size() != 2 )
+				throw std::runtime_error ( "Npy array has not two dimensions" );
+
+			return MatrixView<const U> ( records, unsigned ( h.shape[0] ), unsigned ( h.shape[1] ) );
+			}
+	};
+
+/**
+ * @brief Writer of uncompressed npz archive of named npy arrays, loadable
+ * by numpy.load. Entries are padded so that data of arrays are aligned
+ * to 64 bytes. Archive is completed by close.
+ */
+class NpzWriter
+	{
+	private:
+		struct Entry
+			{
+			std::string name;
+			std::uint32_t crc;
+			std::uint64_t size;
+			std::uint64_t offset;
+			};
+
+		BinaryIO::File file;
+		std::vector<Entry> entries;
+		std::uint64_t offset;
+
+	public:
+		/**
+		 * @brief Create npz archive at path
+		 *
+		 * @param path path of file
+		 */
+		explicit NpzWriter ( const std::string& path )
+			: file ( path, "wb" ), offset ( 0 )
+			{
+			}
+
+		NpzWriter ( const NpzWriter& ) = delete;
+		NpzWriter& operator= ( const NpzWriter& ) = delete;
+
+		/**
+		 * @brief Close archive when close was not called, errors are lost
+		 */
+		~NpzWriter()
+			{
+			if ( file.file )
+				{
+				try
+					{
+					close();
+					}
+				catch ( ... )
+					{
+					}
+				}
+			}
+
+		/**
+		 * @brief Add range of records as array of shape ( count, dims of record )
+		 *
+		 * @tparam Iterator Forward Iterator
+		 * @tparam ConstIterator Const Forward Iterator
+		 * @param name name of array without .npy
+		 * @param it_beg iterator at first record
+		 * @param it_end iterator after last record
+		 */
+		template<typename Iterator, typename ConstIterator>
+		void add ( const std::string& name, Iterator it_beg, ConstIterator it_end )
+			{
+			Npy::Output out = open ( name );
+			Npy::writeArray ( out, it_beg, it_end );
+			finish ( out );
+			}
+
+		/**
+		 * @brief Add Vector as array of shape ( SIZE, )
+		 */
+		template<typename T, unsigned SIZE>
+		void add ( const std::string& name, const Vector<T, SIZE>& v )
+			{
+			Npy::Output out = open ( name );
+			Npy::writeArray ( out, { SIZE }, v.x );
+			finish ( out );
+			}
+
+		/**
+		 * @brief Add Matrix as array of shape ( ROWS, COLS )
+		 */
+		template<typename T, unsigned ROWS, unsigned COLS>
+		void add ( const std::string& name, const Matrix<T, ROWS, COLS>& m )
+			{
+			Npy::Output out = open ( name );
+			Npy::writeArray ( out, { ROWS, COLS }, &m.x[0][0] );
+			finish ( out );
+			}
+
+		/**
+		 * @brief Add view of Matrix of static or dynamic extent as array of shape ( rows, cols )
+		 */
+		template<typename T, unsigned ROWS, unsigned COLS>
+		void add ( const std::string& name, const MatrixView<T, ROWS, COLS>& m )
+			{
+			Npy::Output out = open ( name );
+			Npy::writeArray ( out, m );
+			finish ( out );
+			}
+
+		/**
+		 * @brief Write central directory of archive.
+		 * Throw runtime_error on failure.
+		 */
+		void close()
+			{
+			std::string directory;
+
+			for ( const Entry& entry : entries )
+				{
+				Npy::put ( directory, 0x02014b50, 4 );
+				// versions, flags, method, time and date
+				Npy::put ( directory, 20, 2 );
+				Npy::put ( directory, 20, 2 );
+				Npy::put ( directory, 0, 4 );
+				Npy::put ( directory, 0, 2 );
+				Npy::put ( directory, 0x21, 2 );
+				Npy::put ( directory, entry.crc, 4 );
+				Npy::put ( directory, entry.size, 4 );
+				Npy::put ( directory, entry.size, 4 );
+				Npy::put ( directory, entry.name.size(), 2 );
+				// extra, comment, disk, attributes
+				Npy::put ( directory, 0, 2 );
+				Npy::put ( directory, 0, 2 );
+				Npy::put ( directory, 0, 2 );
+				Npy::put ( directory, 0, 2 );
+				Npy::put ( directory, 0, 4 );
+				Npy::put ( directory, entry.offset, 4 );
+				directory += entry.name;
+				}
+
+			checkSize ( offset + directory.size() );
+			Npy::put ( directory, 0x06054b50, 4 );
+			Npy::put ( directory, 0, 4 );
+			Npy::put ( directory, entries.size(), 2 );
+			Npy::put ( directory, entries.size(), 2 );
+			Npy::put ( directory, directory.size() - 12, 4 );
+			Npy::put ( directory, offset, 4 );
+			Npy::put ( directory, 0, 2 );
+
+			BinaryIO::write ( file.file, directory.data(), directory.size() );
+			file.close();
+			}
+
+	private:
+		// zip64 is not written
+		static void checkSize ( std::uint64_t size )
+			{
+			if ( size > 0xffffffffu )
+				throw std::runtime_error ( "Npz archive exceeds 4 GB" );
+			}
+
+		// write local header of entry, padded by extra field to align data
+		Npy::Output open ( const std::string& name )
+			{
+			if ( entries.size() == 0xffff )
+				throw std::runtime_error ( "Npz archive has too many entries" );
+
+			const std::string entry_name = name + ".npy";
+			std::size_t padding = std::size_t ( ( 64 - ( offset + 30 + entry_name.size() ) % 64 ) % 64 );
+
+			// extra field has 4 bytes of id and size at least
+			if ( padding != 0 && padding < 4 )
+				padding += 64;
+
+			std::string local;
+			Npy::put ( local, 0x04034b50, 4 );
+			Npy::put ( local, 20, 2 );
+			Npy::put ( local, 0, 4 );
+			Npy::put ( local, 0, 2 );
+			Npy::put ( local, 0x21, 2 );
+			// CRC and sizes are written by finish
+			Npy::put ( local, 0, 4 );
+			Npy::put ( local, 0, 4 );
+			Npy::put ( local, 0, 4 );
+			Npy::put ( local, entry_name.size(), 2 );
+			Npy::put ( local, padding, 2 );
+			local += entry_name;
+
+			if ( padding != 0 )
+				{
+				Npy::put ( local, 0x564d, 2 );
+				Npy::put ( local, padding - 4, 2 );
+				local.append ( padding - 4, '\0' );
+				}
+
+			BinaryIO::write ( file.file, local.data(), local.size() );
+			entries.push_back ( Entry { entry_name, 0, 0, offset } );
+			offset += local.size();
+
+			return Npy::Output ( file.file, true );
+			}
+
+		// write CRC and sizes into local header of last entry
+		void finish ( const Npy::Output& out )
+			{
+			Entry& entry = entries.back();
+			entry.crc = out.crc;
+			entry.size = out.size;
+			offset += out.size;
+			checkSize ( offset );
+
+			std::string sizes;
+			Npy::put ( sizes, entry.crc, 4 );
+			Npy::put ( sizes, entry.size, 4 );
+			Npy::put ( sizes, entry.size, 4 );
+			BinaryIO::seek ( file.file, entry.offset + 14 );
+			BinaryIO::write ( file.file, sizes.data(), sizes.size() );
+			BinaryIO::seek ( file.file, offset );
+			}
+	};
+
+/**
+ * @brief Uncompressed npz archive mapped into memory, arrays are loaded
+ * by name and share the mapping. Arrays aligned and in native byte order
+ * are used without copy. Throw runtime_error for compressed archives.
+ */
+class NpzFile
+	{
+	private:
+		struct Entry
+			{
+			std::string name;
+			std::size_t offset;
+			std::size_t size;
+			};
+
+		std::shared_ptr<const BinaryIO::MappedFile> file;
+		std::vector<Entry> entries;
+
+	public:
+		/**
+		 * @brief Map npz archive at path and read its directory.
+		 * Throw runtime_error when file is not uncompressed zip archive.
+		 *
+		 * @param path path of file
+		 */
+		explicit NpzFile ( const std::string& path )
+			: file ( std::make_shared<const BinaryIO::MappedFile> ( path ) )
+			{
+			const unsigned char* data = file->data();
+			const std::size_t size = file->size();
+
+			// end of central directory is followed by comment of up to 65535 bytes
+			const unsigned char* end_record = nullptr;
+
+			for ( std::size_t position = size < 22 ? 0 : size - 22 + 1; position-- > 0 && size - position <= 22 + 65535; )
+				{
+				if ( Npy::get ( data + position, 4 ) == 0x06054b50 )
+					{
+					end_record = data + position;
+					break;
+					}
+				}
+
+			if ( end_record == nullptr )
+				throw std::runtime_error ( "Not a npz archive" );
+
+			const std::size_t count = Npy::get ( end_record + 10, 2 );
+			const std::size_t directory_offset = Npy::get ( end_record + 16, 4 );
+
+			if ( count == 0xffff || directory_offset == 0xffffffffu )
+				throw std::runtime_error ( "Zip64 npz archive is not supported" );
+
+			const unsigned char* it = data + std::min ( directory_offset, size );
+			const unsigned char* it_end = end_record;
+
+			for ( std::size_t i = 0; i < count; ++i )
+				{
+				if ( it_end - it < 46 || Npy::get ( it, 4 ) != 0x02014b50 )
+					throw std::runtime_error ( "Directory of npz archive is damaged" );
+
+				const std::size_t name_size = Npy::get ( it + 28, 2 );
+				const std::size_t skipped = name_size + Npy::get ( it + 30, 2 ) + Npy::get ( it + 32, 2 );
+
+				if ( std::size_t ( it_end - it ) < 46 + skipped )
+					throw std::runtime_error ( "Directory of npz archive is damaged" );
+
+				if ( Npy::get ( it + 10, 2 ) != 0 )
+					throw std::runtime_error ( "Compressed npz archive is not supported, save it by numpy.savez" );
+
+				Entry entry;
+				entry.name.assign ( reinterpret_cast<const char*> ( it ) + 46, name_size );
+				entry.size = Npy::get ( it + 24, 4 );
+				const std::size_t local = Npy::get ( it + 42, 4 );
+
+				if ( local > size || size - local < 30 || Npy::get ( data + local, 4 ) != 0x04034b50 )
+					throw std::runtime_error ( "Entry of npz archive is damaged" );
+
+				entry.offset = local + 30 + Npy::get ( data + local + 26, 2 ) + Npy::get ( data + local + 28, 2 );
+
+				if ( entry.offset > size || entry.size > size - entry.offset )
+					throw std::runtime_error ( "Npz archive is truncated" );
+
+				// numpy stores arrays as name.npy
+				if ( entry.name.size() > 4 && entry.name.compare ( entry.name.size() - 4, 4, ".npy" ) == 0 )
+					entry.name.resize ( entry.name.size() - 4 );
+
+				entries.push_back ( entry );
+				it += 46 + skipped;
+				}
+			}
+
+		/**
+		 * @brief Names of arrays in archive
+		 *
+		 * @return std::vector<std::string>
+		 */
+		std::vector<std::string> names() const
+			{
+			std::vector<std::string> result;
+
+			for ( const Entry& entry : entries )
+				result.push_back ( entry.name );
+
+			return result;
+			}
+
+		/**
+		 * @brief Load array of name as records E.
+		 * Throw runtime_error when there is no such array or it does not match E.
+		 *
+		 * @tparam E type of record, scalar, Vector or Matrix
+		 * @param name name of array
+		 * @return NpyArray<E>
+		 */
+		template<class E>
+		NpyArray<E> get ( const std::string& name ) const
+			{
+			for ( const Entry& entry : entries )
+				if ( entry.name == name )
+					return NpyArray<E> ( file, entry.offset, entry.size );
+
+			throw std::runtime_error ( "No array " + name + " in npz archive" );
+			}
+	};
+
+#endif // NPY_HPP
@@ -0,0 +1,540 @@
+#ifndef QR_HPP
+#define QR_HPP
+
+#include <type_traits>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+
+/**
+ * @brief Householder QR decomposition of Matrix with ROWS >= COLS: A = Q*R.
+ * Q is product of COLS Householder reflectors H(k) = I - tau(k)*v(k)*transpose(v(k)),
+ * which are stored below diagonal of decomposed Matrix and never formed explicitly.
+ *
+ * Matrices with at least 32 columns are decomposed by panels of 16 columns,
+ * reflectors of panel are accumulated to compact WY form I - V*T*transpose(V)
+ * and applied to trailing columns by Matrix products streaming whole rows.
+ *
+ * Rank deficient Matrix does not throw, it is reported by isRankDeficient()
+ * and solving with it throws runtime_error.
+ *
+ * @tparam T floating point type
+ * @tparam ROWS number of rows of Matrix
+ * @tparam COLS number of cols of Matrix
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+class QRDecomposition
+	{
+		static_assert ( std::is_floating_point<T>::value, "QR decomposition requires floating point type." );
+		static_assert ( ROWS >= COLS, "QR decomposition requires ROWS >= COLS." );
+
+	public:
+		static const unsigned NARROW_SIZE = 8;
+		static const unsigned BLOCKED_SIZE = 32;
+		static const unsigned BLOCK = 16;
+
+	public:
+		// R on and above diagonal, Householder vectors below diagonal (unit leading element is not stored)
+		Matrix<T, ROWS, COLS> qr;
+		// scales of Householder reflectors
+		Vector<T, COLS> tau;
+		// some diagonal element of R is negligible
+		bool rank_deficient;
+
+	public:
+		/**
+		 * @brief Decompose Matrix
+		 *
+		 * @tparam U type of decomposed Matrix
+		 * @param m Matrix to decompose
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		explicit QRDecomposition ( const Matrix<U, ROWS, COLS>& m )
+			: tau ( T ( 0 ) ), rank_deficient ( false )
+			{
+			qr = m;
+
+			if ( COLS < BLOCKED_SIZE )
+				decompose ( COLS );
+			else
+				decompose ( BLOCK );
+
+			// |r(k, k)| relative to largest diagonal element of R
+			T max_abs = T ( 0 );
+
+			for ( unsigned k = 0; k < COLS; ++k )
+				max_abs = std::max ( max_abs, std::abs ( qr.x[k][k] ) );
+
+			const T tolerance = T ( ROWS ) * std::numeric_limits<T>::epsilon() * max_abs;
+
+			for ( unsigned k = 0; k < COLS; ++k )
+				if ( ! ( std::abs ( qr.x[k][k] ) > tolerance ) )
+					rank_deficient = true;
+			}
+
+		/**
+		 * @brief Check if decomposed Matrix has not full column rank
+		 *
+		 * @return bool
+		 */
+		inline bool isRankDeficient() const
+			{
+			return rank_deficient;
+			}
+
+		/**
+		 * @brief Upper triangular factor R
+		 *
+		 * @return Matrix<T, COLS, COLS>
+		 */
+		Matrix<T, COLS, COLS> r() const
+			{
+			Matrix<T, COLS, COLS> out;
+
+			for ( unsigned i = 0; i < COLS; ++i )
+				{
+				Container::fill ( out.begin ( i ), out.begin ( i ) + i, T ( 0 ) );
+				Container::copy ( out.begin ( i ) + i, out.end ( i ), qr.begin ( i ) + i );
+				}
+
+			return out;
+			}
+
+		/**
+		 * @brief Compute transpose(Q)*b without forming Q
+		 *
+		 * @tparam U type of b
+		 * @param b Vector
+		 * @return Vector<T, ROWS>
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Vector<T, ROWS> applyQTransposed ( const Vector<U, ROWS>& b ) const
+			{
+			Vector<T, ROWS> out ( b );
+
+			for ( unsigned k = 0; k < COLS; ++k )
+				applyReflector ( k, out );
+
+			return out;
+			}
+
+		/**
+		 * @brief Compute Q*b without forming Q
+		 *
+		 * @tparam U type of b
+		 * @param b Vector
+		 * @return Vector<T, ROWS>
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Vector<T, ROWS> applyQ ( const Vector<U, ROWS>& b ) const
+			{
+			Vector<T, ROWS> out ( b );
+
+			for ( unsigned k = COLS; k-- > 0; )
+				applyReflector ( k, out );
+
+			return out;
+			}
+
+		/**
+		 * @brief Solve least squares problem min ||A*x - b||
+		 * as R*x = first COLS elements of transpose(Q)*b.
+		 * Throw runtime_error when A is rank deficient.
+		 *
+		 * @tparam U type of b
+		 * @param b right hand side
+		 * @return Vector<T, COLS> x
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		Vector<T, COLS> leastSquares ( const Vector<U, ROWS>& b ) const
+			{
+			checkRankDeficient();
+
+			const Vector<T, ROWS> c = applyQTransposed ( b );
+			Vector<T, COLS> x;
+
+			Container::copy ( x.begin(), x.end(), c.begin() );
+
+			// R*x = c, rows of R are read contiguously
+			for ( unsigned i = COLS; i-- > 0; )
+				{
+				const T* it_row = qr.begin ( i );
+				T value = x.x[i];
+
+				for ( unsigned j = i+1; j < COLS; ++j )
+					value -= it_row[j] * x.x[j];
+
+				x.x[i] = value / it_row[i];
+				}
+
+			return x;
+			}
+
+		/**
+		 * @brief Norm of residual A*x - b of least squares solution,
+		 * norm of last ROWS - COLS elements of transpose(Q)*b.
+		 *
+		 * @tparam U type of b
+		 * @param b right hand side
+		 * @return T
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		T residualNorm ( const Vector<U, ROWS>& b ) const
+			{
+			const Vector<T, ROWS> c = applyQTransposed ( b );
+			T value = T ( 0 );
+
+			for ( unsigned i = COLS; i < ROWS; ++i )
+				value += c.x[i] * c.x[i];
+
+			return std::sqrt ( value );
+			}
+
+	private:
+		inline void checkRankDeficient() const
+			{
+			if ( rank_deficient )
+				throw std::runtime_error ( "Rank deficient matrix" );
+			}
+
+		/**
+		 * @brief Apply H(k) to Vector
+		 *
+		 * @param k number of reflector
+		 * @param b Vector
+		 */
+		inline void applyReflector ( unsigned k, Vector<T, ROWS>& b ) const
+			{
+			if ( tau.x[k] == T ( 0 ) )
+				return;
+
+			T partial[4] = {};
+			unsigned i = k+1;
+
+			for ( ; i + 4 <= ROWS; i += 4 )
+				for ( unsigned p = 0; p < 4; ++p )
+					partial[p] += qr.x[i+p][k] * b.x[i+p];
+
+			for ( ; i < ROWS; ++i )
+				partial[0] += qr.x[i][k] * b.x[i];
+
+			const T value = tau.x[k] * ( b.x[k] + ( partial[0] + partial[1] ) + ( partial[2] + partial[3] ) );
+			b.x[k] -= value;
+
+			for ( i = k+1; i < ROWS; ++i )
+				b.x[i] -= qr.x[i][k] * value;
+			}
+
+		/**
+		 * @brief Compute reflector H(k) annihilating qr(k+1:, k)
+		 *
+		 * @param k number of column
+		 */
+		void householder ( unsigned k )
+			{
+			const T alpha = qr.x[k][k];
+			T partial[4] = {};
+			unsigned i = k+1;
+
+			for ( ; i + 4 <= ROWS; i += 4 )
+				for ( unsigned p = 0; p < 4; ++p )
+					partial[p] += qr.x[i+p][k] * qr.x[i+p][k];
+
+			for ( ; i < ROWS; ++i )
+				partial[0] += qr.x[i][k] * qr.x[i][k];
+
+			const T norm2 = ( partial[0] + partial[1] ) + ( partial[2] + partial[3] );
+
+			if ( norm2 == T ( 0 ) )
+				{
+				tau.x[k] = T ( 0 );
+				return;
+				}
+
+			const T beta = -std::copysign ( std::sqrt ( alpha*alpha + norm2 ), alpha );
+			const T scale = T ( 1 ) / ( alpha - beta );
+
+			tau.x[k] = ( beta - alpha ) / beta;
+			qr.x[k][k] = beta;
+
+			for ( i = k+1; i < ROWS; ++i )
+				qr.x[i][k] *= scale;
+			}
+
+		/**
+		 * @brief Apply H(k) to columns j0:j1, streaming rows
+		 *
+		 * @param k number of reflector
+		 * @param j0 first column
+		 * @param j1 end column
+		 * @param w work row of at least j1 elements
+		 */
+		void applyReflector ( unsigned k, unsigned j0, unsigned j1, T* w )
+			{
+			if ( tau.x[k] == T ( 0 ) )
+				return;
+
+			// w = tau*transpose(v)*A, four rows per pass shorten dependency chains through w
+			Container::copy ( w + j0, w + j1, qr.begin ( k ) + j0 );
+
+			unsigned i = k+1;
+
+			for ( ; i + 4 <= ROWS; i += 4 )
+				{
+				const T v_0 = qr.x[i][k];
+				const T v_1 = qr.x[i+1][k];
+				const T v_2 = qr.x[i+2][k];
+				const T v_3 = qr.x[i+3][k];
+				const T* it_row_0 = qr.begin ( i );
+				const T* it_row_1 = qr.begin ( i+1 );
+				const T* it_row_2 = qr.begin ( i+2 );
+				const T* it_row_3 = qr.begin ( i+3 );
+
+				for ( unsigned j = j0; j < j1; ++j )
+					w[j] += v_0 * it_row_0[j] + v_1 * it_row_1[j] + v_2 * it_row_2[j] + v_3 * it_row_3[j];
+				}
+
+			for ( ; i < ROWS; ++i )
+				{
+				const T v_i = qr.x[i][k];
+				const T* it_row = qr.begin ( i );
+
+				for ( unsigned j = j0; j < j1; ++j )
+					w[j] += v_i * it_row[j];
+				}
+
+			Container::rangeElemetsValueOperationAssign<Multiply> ( w + j0, w + j1, tau.x[k] );
+
+			// A -= v*w
+			Container::rangeElemetsOperationAssign<Subtract> ( qr.begin ( k ) + j0, qr.begin ( k ) + j1, w + j0 );
+
+			for ( unsigned i = k+1; i < ROWS; ++i )
+				{
+				const T v_i = qr.x[i][k];
+				T* it_row = qr.begin ( i );
+
+				for ( unsigned j = j0; j < j1; ++j )
+					it_row[j] -= v_i * w[j];
+				}
+			}
+
+		/**
+		 * @brief Apply H(k) to columns k+1:COLS of narrow Matrix.
+		 * Loops run over all COLS columns, so w is kept in registers,
+		 * columns 0:k+1 are updated by zero.
+		 *
+		 * @param k number of reflector
+		 */
+		void applyReflectorNarrow ( unsigned k )
+			{
+			if ( tau.x[k] == T ( 0 ) )
+				return;
+
+			// four independent partial sums over rows, FMA latency is not serialized
+			T w[COLS];
+			T partial[4][COLS] = {};
+			unsigned i = k+1;
+
+			Container::copy ( w, w + COLS, qr.begin ( k ) );
+
+			for ( ; i + 4 <= ROWS; i += 4 )
+				for ( unsigned p = 0; p < 4; ++p )
+					{
+					const T v_i = qr.x[i+p][k];
+					const T* it_row = qr.begin ( i+p );
+
+					for ( unsigned j = 0; j < COLS; ++j )
+						partial[p][j] += v_i * it_row[j];
+					}
+
+			for ( ; i < ROWS; ++i )
+				{
+				const T v_i = qr.x[i][k];
+				const T* it_row = qr.begin ( i );
+
+				for ( unsigned j = 0; j < COLS; ++j )
+					w[j] += v_i * it_row[j];
+				}
+
+			for ( unsigned j = 0; j < COLS; ++j )
+				w[j] += ( partial[0][j] + partial[1][j] ) + ( partial[2][j] + partial[3][j] );
+
+			for ( unsigned j = 0; j < COLS; ++j )
+				w[j] = j > k ? tau.x[k] * w[j] : T ( 0 );
+
+			Container::rangeElemetsOperationAssign<Subtract> ( qr.begin ( k ), qr.end ( k ), w );
+
+			for ( unsigned i = k+1; i < ROWS; ++i )
+				{
+				const T v_i = qr.x[i][k];
+				T* it_row = qr.begin ( i );
+
+				for ( unsigned j = 0; j < COLS; ++j )
+					it_row[j] -= v_i * w[j];
+				}
+			}
+
+		/**
+		 * @brief Apply transpose(I - V*T*transpose(V)) of panel k0:k1
+		 * to trailing columns k1:COLS.
+		 *
+		 * @param k0 first column of panel
+		 * @param k1 end column of panel
+		 * @param t work Matrix of BLOCK x BLOCK elements
+		 * @param w work Matrix of BLOCK x COLS elements
+		 */
+		void applyBlockReflector ( unsigned k0, unsigned k1, T* t, T* w )
+			{
+			const unsigned nb = k1 - k0;
+			const unsigned width = COLS - k1;
+
+			// upper triangular T, column by column
+			for ( unsigned p = 0; p < nb; ++p )
+				{
+				const unsigned k = k0 + p;
+				T z[BLOCK];
+
+				// z = transpose(V(:, 0:p))*v(p)
+				for ( unsigned q = 0; q < p; ++q )
+					z[q] = qr.x[k][k0+q];
+
+				for ( unsigned i = k+1; i < ROWS; ++i )
+					{
+					const T v_i = qr.x[i][k];
+					const T* it_row = qr.begin ( i ) + k0;
+
+					for ( unsigned q = 0; q < p; ++q )
+						z[q] += it_row[q] * v_i;
+					}
+
+				// T(0:p, p) = -tau(p)*T(0:p, 0:p)*z
+				for ( unsigned q = 0; q < p; ++q )
+					{
+					T value = T ( 0 );
+
+					for ( unsigned s = q; s < p; ++s )
+						value += t[q*BLOCK + s] * z[s];
+
+					t[q*BLOCK + p] = -tau.x[k] * value;
+					}
+
+				t[p*BLOCK + p] = tau.x[k];
+				}
+
+			// W = transpose(V)*A2, streaming rows of A2
+			Container::fill ( w, w + nb*width, T ( 0 ) );
+
+			for ( unsigned i = k0; i < ROWS; ++i )
+				{
+				const T* it_row = qr.begin ( i );
+				const unsigned p_end = i < k1 ? i - k0 + 1 : nb;
+
+				for ( unsigned p = 0; p < p_end; ++p )
+					{
+					const T v_i = i == k0 + p ? T ( 1 ) : it_row[k0+p];
+					T* it_w = w + p*width;
+
+					for ( unsigned j = 0; j < width; ++j )
+						it_w[j] += v_i * it_row[k1+j];
+					}
+				}
+
+			// W = transpose(T)*W, from last row, so rows q < p are not modified yet
+			for ( unsigned p = nb; p-- > 0; )
+				{
+				T* it_w = w + p*width;
+
+				Container::rangeElemetsValueOperationAssign<Multiply> ( it_w, it_w + width, t[p*BLOCK + p] );
+
+				for ( unsigned q = 0; q < p; ++q )
+					{
+					const T factor = t[q*BLOCK + p];
+					const T* it_w_q = w + q*width;
+
+					for ( unsigned j = 0; j < width; ++j )
+						it_w[j] += factor * it_w_q[j];
+					}
+				}
+
+			// A2 -= V*W
+			for ( unsigned i = k0; i < ROWS; ++i )
+				{
+				T* it_row = qr.begin ( i );
+				const unsigned p_end = i < k1 ? i - k0 + 1 : nb;
+
+				for ( unsigned p = 0; p < p_end; ++p )
+					{
+					const T v_i = i == k0 + p ? T ( 1 ) : it_row[k0+p];
+					const T* it_w = w + p*width;
+
+					for ( unsigned j = 0; j < width; ++j )
+						it_row[k1+j] -= v_i * it_w[j];
+					}
+				}
+			}
+
+		/**
+		 * @brief Panels are decomposed column by column, trailing columns
+		 * are updated once per panel by block reflector.
+		 * For block == COLS it is plain unblocked Householder QR.
+		 *
+		 * @param block number of columns of panel
+		 */
+		void decompose ( unsigned block )
+			{
+			std::unique_ptr<T[]> w ( new T[block < COLS ? BLOCK*COLS : COLS] );
+			T t[BLOCK*BLOCK];
+
+			for ( unsigned k0 = 0; k0 < COLS; k0 += block )
+				{
+				const unsigned k1 = k0 + block < COLS ? k0 + block : COLS;
+
+				// decompose panel qr(k0:, k0:k1)
+				for ( unsigned k = k0; k < k1; ++k )
+					{
+					householder ( k );
+
+					if ( COLS <= NARROW_SIZE )
+						applyReflectorNarrow ( k );
+					else
+						applyReflector ( k, k+1, k1, w.get() );
+					}
+
+				if ( k1 < COLS )
+					applyBlockReflector ( k0, k1, t, w.get() );
+				}
+			}
+	};
+
+/**
+ * @brief Solve least squares problem min ||A*x - b|| by Householder QR decomposition.
+ * Throw runtime_error when Matrix is rank deficient.
+ *
+ * @tparam T type of Matrix
+ * @tparam U type of b
+ * @tparam ROWS number of rows of Matrix
+ * @tparam COLS number of cols of Matrix
+ * @param m Matrix
+ * @param b right hand side
+ * @return Vector<T, COLS> x
+ */
+template<typename T, typename U, unsigned ROWS, unsigned COLS,
+		 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+Vector<T, COLS> leastSquares ( const Matrix<T, ROWS, COLS>& m, const Vector<U, ROWS>& b )
+	{
+	return QRDecomposition<T, ROWS, COLS> ( m ).leastSquares ( b );
+	}
+
+#endif // QR_HPP
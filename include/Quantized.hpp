@@ -0,0 +1,521 @@
+#ifndef QUANTIZED_HPP
+#define QUANTIZED_HPP
+
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <type_traits>
+
+#if defined ( __AVX2__ ) || defined ( __AVX512F__ )
+#include <immintrin.h>
+#endif
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+/*
+ * Quantized products of int8 weight matrices and int8 or uint8 activations.
+ * Quantized value q of type T represents real value scale * ( q - zero_point ).
+ * Products are accumulated exactly in int32 (generic cauchyProduct multiplies
+ * in decltype ( T()*U() ) and stores in T, so int8 products overflow):
+ *   sum ( w - zw )( a - za ) = sum w*a - za*sum w - zw*sum a + n*zw*za,
+ * raw sums w*a are computed by Quantized::dot, zero points are corrected by
+ * row sums of weights and column sums of activations. Accumulator is real product
+ * divided by scale of weights and scale of activations, requantization multiplies
+ * it by ( weights scale * activations scale / output scale ) and rounds to nearest.
+ *
+ * Kernels multiply unsigned by signed bytes: AVX-512 VNNI and AVX-VNNI vpdpbusd
+ * sum 4 products into each int32 lane in one instruction. AVX2 pmaddubsw
+ * saturates pairs of products to int16 (255*127*2 > 32767), so AVX2 kernel widens
+ * bytes to int16 and sums pairs by pmaddwd instead, which is exact. int8 activations
+ * are biased by 128 to uint8 before the kernel, the bias is a zero point shift.
+ * Overflow of int32 is not possible for depth below 2^16.
+ */
+
+/**
+ * @brief Quantization of tensor or of its row, real = scale * ( q - zero_point )
+ */
+struct Quantization
+	{
+	float scale;
+	std::int32_t zero_point;
+	};
+
+namespace Quantized
+	{
+	/**
+	 * @brief Round value to nearest (even) and saturate to range of T
+	 *
+	 * @tparam T int8_t or uint8_t
+	 * @param value real value in units of quantum
+	 * @return T saturated value
+	 */
+	template<typename T>
+	inline T saturate ( float value )
+		{
+		const float rounded = std::nearbyint ( value );
+
+		return T ( std::min ( std::max ( rounded, float ( std::numeric_limits<T>::min() ) ),
+							  float ( std::numeric_limits<T>::max() ) ) );
+		}
+
+	/**
+	 * @brief Byte of activation as unsigned operand of kernel, int8 is biased by 128
+	 */
+	inline std::uint8_t unsignedByte ( std::uint8_t value )
+		{
+		return value;
+		}
+
+	inline std::uint8_t unsignedByte ( std::int8_t value )
+		{
+		return std::uint8_t ( value ) ^ 0x80;
+		}
+
+	/**
+	 * @brief Zero point of activations of type T after unsignedByte
+	 */
+	template<typename T>
+	inline std::int32_t unsignedZeroPoint ( std::int32_t zero_point )
+		{
+		return std::is_signed<T>::value ? zero_point + 128 : zero_point;
+		}
+
+	/**
+	 * @brief Quantization of row i, of whole tensor or from Vector of rows
+	 */
+	inline const Quantization& row ( const Quantization& quantization, unsigned )
+		{
+		return quantization;
+		}
+
+	template<unsigned SIZE>
+	inline const Quantization& row ( const Vector<Quantization, SIZE>& quantization, unsigned i )
+		{
+		return quantization.x[i];
+		}
+
+	/**
+	 * @brief Exact dot product of unsigned and signed bytes accumulated in int32,
+	 * by AVX-512 VNNI (64 products per instruction), AVX-VNNI (32)
+	 * or AVX2 (16 widened products) where available. Sum of signed range,
+	 * needed for zero point correction, is accumulated in the same pass by psadbw
+	 * of bytes biased to unsigned, separate pass takes longer than the products.
+	 *
+	 * @param first pointer at beginning of unsigned range
+	 * @param second pointer at beginning of signed range
+	 * @param size number of elements
+	 * @param second_sum sum of signed range
+	 * @return std::int32_t dot product
+	 */
+	inline std::int32_t dot ( const std::uint8_t* first, const std::int8_t* second, unsigned size, std::int32_t& second_sum )
+		{
+		std::int32_t value = 0;
+		unsigned j = 0;
+		second_sum = 0;
+#if defined ( __AVX512VNNI__ ) && defined ( __AVX512BW__ )
+		const __m512i bias = _mm512_set1_epi8 ( -128 );
+		__m512i sum0 = _mm512_setzero_si512();
+		__m512i sum1 = _mm512_setzero_si512();
+		__m512i biased_sum = _mm512_setzero_si512();
+
+		for ( ; j + 128 <= size; j += 128 )
+			{
+			const __m512i b0 = _mm512_loadu_si512 ( second + j );
+			const __m512i b1 = _mm512_loadu_si512 ( second + j + 64 );
+
+			sum0 = _mm512_dpbusd_epi32 ( sum0, _mm512_loadu_si512 ( first + j ), b0 );
+			sum1 = _mm512_dpbusd_epi32 ( sum1, _mm512_loadu_si512 ( first + j + 64 ), b1 );
+			biased_sum = _mm512_add_epi64 ( biased_sum, _mm512_sad_epu8 ( _mm512_xor_si512 ( b0, bias ), _mm512_setzero_si512() ) );
+			biased_sum = _mm512_add_epi64 ( biased_sum, _mm512_sad_epu8 ( _mm512_xor_si512 ( b1, bias ), _mm512_setzero_si512() ) );
+			}
+
+		// reduced through memory, reduce intrinsic reads undefined register
+		std::int32_t lanes[16];
+		std::int64_t sums[8];
+		_mm512_storeu_si512 ( lanes, _mm512_add_epi32 ( sum0, sum1 ) );
+		_mm512_storeu_si512 ( sums, biased_sum );
+		value = Container::sum ( lanes, lanes + 16 );
+		second_sum = std::int32_t ( Container::sum ( sums, sums + 8 ) ) - 128 * std::int32_t ( j );
+#elif defined ( __AVXVNNI__ )
+		const __m256i bias = _mm256_set1_epi8 ( -128 );
+		__m256i sum0 = _mm256_setzero_si256();
+		__m256i sum1 = _mm256_setzero_si256();
+		__m256i biased_sum = _mm256_setzero_si256();
+
+		for ( ; j + 64 <= size; j += 64 )
+			{
+			const __m256i b0 = _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( second + j ) );
+			const __m256i b1 = _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( second + j + 32 ) );
+
+			sum0 = _mm256_dpbusd_avx_epi32 ( sum0, _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( first + j ) ), b0 );
+			sum1 = _mm256_dpbusd_avx_epi32 ( sum1, _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( first + j + 32 ) ), b1 );
+			biased_sum = _mm256_add_epi64 ( biased_sum, _mm256_sad_epu8 ( _mm256_xor_si256 ( b0, bias ), _mm256_setzero_si256() ) );
+			biased_sum = _mm256_add_epi64 ( biased_sum, _mm256_sad_epu8 ( _mm256_xor_si256 ( b1, bias ), _mm256_setzero_si256() ) );
+			}
+
+		std::int32_t lanes[8];
+		std::int64_t sums[4];
+		_mm256_storeu_si256 ( reinterpret_cast<__m256i*> ( lanes ), _mm256_add_epi32 ( sum0, sum1 ) );
+		_mm256_storeu_si256 ( reinterpret_cast<__m256i*> ( sums ), biased_sum );
+		value = Container::sum ( lanes, lanes + 8 );
+		second_sum = std::int32_t ( Container::sum ( sums, sums + 4 ) ) - 128 * std::int32_t ( j );
+#elif defined ( __AVX2__ )
+		const __m256i bias = _mm256_set1_epi8 ( -128 );
+		__m256i sum0 = _mm256_setzero_si256();
+		__m256i sum1 = _mm256_setzero_si256();
+		__m256i biased_sum = _mm256_setzero_si256();
+
+		for ( ; j + 32 <= size; j += 32 )
+			{
+			const __m256i b = _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( second + j ) );
+			const __m256i a0 = _mm256_cvtepu8_epi16 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( first + j ) ) );
+			const __m256i a1 = _mm256_cvtepu8_epi16 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( first + j + 16 ) ) );
+
+			sum0 = _mm256_add_epi32 ( sum0, _mm256_madd_epi16 ( a0, _mm256_cvtepi8_epi16 ( _mm256_castsi256_si128 ( b ) ) ) );
+			sum1 = _mm256_add_epi32 ( sum1, _mm256_madd_epi16 ( a1, _mm256_cvtepi8_epi16 ( _mm256_extracti128_si256 ( b, 1 ) ) ) );
+			biased_sum = _mm256_add_epi64 ( biased_sum, _mm256_sad_epu8 ( _mm256_xor_si256 ( b, bias ), _mm256_setzero_si256() ) );
+			}
+
+		std::int32_t lanes[8];
+		std::int64_t sums[4];
+		_mm256_storeu_si256 ( reinterpret_cast<__m256i*> ( lanes ), _mm256_add_epi32 ( sum0, sum1 ) );
+		_mm256_storeu_si256 ( reinterpret_cast<__m256i*> ( sums ), biased_sum );
+		value = Container::sum ( lanes, lanes + 8 );
+		second_sum = std::int32_t ( Container::sum ( sums, sums + 4 ) ) - 128 * std::int32_t ( j );
+#endif
+
+		for ( ; j < size; ++j )
+			{
+			value += std::int32_t ( first[j] ) * std::int32_t ( second[j] );
+			second_sum += second[j];
+			}
+
+		return value;
+		}
+
+	/**
+	 * @brief COLUMNS exact dot products of unsigned ranges first + c*stride
+	 * with one signed range, which is loaded once for all of them by AVX-512 VNNI
+	 * kernel. Elsewhere computed by dot of each range.
+	 *
+	 * @tparam COLUMNS number of unsigned ranges
+	 * @param first pointer at beginning of first unsigned range
+	 * @param stride distance of unsigned ranges
+	 * @param second pointer at beginning of signed range
+	 * @param size number of elements
+	 * @param output pointer at COLUMNS dot products
+	 */
+	template<unsigned COLUMNS>
+	inline void dot ( const std::uint8_t* first, std::size_t stride, const std::int8_t* second, unsigned size, std::int32_t* output )
+		{
+#if defined ( __AVX512VNNI__ ) && defined ( __AVX512BW__ )
+		__m512i sum[COLUMNS];
+		unsigned j = 0;
+
+		for ( unsigned c = 0; c < COLUMNS; ++c )
+			sum[c] = _mm512_setzero_si512();
+
+		for ( ; j + 64 <= size; j += 64 )
+			{
+			const __m512i b = _mm512_loadu_si512 ( second + j );
+
+			for ( unsigned c = 0; c < COLUMNS; ++c )
+				sum[c] = _mm512_dpbusd_epi32 ( sum[c], _mm512_loadu_si512 ( first + c*stride + j ), b );
+			}
+
+		for ( unsigned c = 0; c < COLUMNS; ++c )
+			{
+			std::int32_t lanes[16];
+			_mm512_storeu_si512 ( lanes, sum[c] );
+			output[c] = Container::sum ( lanes, lanes + 16 ) + Container::dot<std::int32_t> ( first + c*stride + j, second + j, size - j );
+			}
+#else
+		std::int32_t second_sum;
+
+		for ( unsigned c = 0; c < COLUMNS; ++c )
+			output[c] = dot ( first + c*stride, second, size, second_sum );
+#endif
+		}
+
+	/**
+	 * @brief Sum of bytes in int32
+	 */
+	template<typename T>
+	inline std::int32_t sum ( const T* it_beg, const T* it_end )
+		{
+		std::int32_t value = 0;
+
+		while ( it_beg != it_end )
+			value += *it_beg++;
+
+		return value;
+		}
+	}
+
+/**
+ * @brief Quantization of type T covering range [min, max] extended to contain 0,
+ * so that 0 is represented exactly (zero padding, ReLU)
+ *
+ * @tparam T int8_t or uint8_t
+ * @param min smallest real value
+ * @param max largest real value
+ * @return Quantization scale and zero point
+ */
+template<typename T>
+inline Quantization quantizationRange ( float min, float max )
+	{
+	const float q_min = float ( std::numeric_limits<T>::min() );
+	const float q_max = float ( std::numeric_limits<T>::max() );
+	min = std::min ( min, 0.0f );
+	max = std::max ( max, 0.0f );
+
+	Quantization quantization;
+	quantization.scale = max > min ? ( max - min ) / ( q_max - q_min ) : 1.0f;
+	quantization.zero_point = std::int32_t ( Quantized::saturate<T> ( q_min - min / quantization.scale ) );
+
+	return quantization;
+	}
+
+/**
+ * @brief Quantize range of real values, rounded to nearest and saturated
+ *
+ * @tparam T int8_t or uint8_t
+ * @param it_beg pointer at beginning of range
+ * @param it_end pointer after end of range
+ * @param out_beg pointer at beginning of output range
+ * @param quantization scale and zero point of output
+ */
+template<typename T>
+inline void quantize ( const float* it_beg, const float* it_end, T* out_beg, Quantization quantization )
+	{
+	while ( it_beg != it_end )
+		*out_beg++ = Quantized::saturate<T> ( *it_beg++ / quantization.scale + float ( quantization.zero_point ) );
+	}
+
+/**
+ * @brief Real values of range of quantized values
+ *
+ * @tparam T int8_t, uint8_t or int32_t
+ * @param it_beg pointer at beginning of range
+ * @param it_end pointer after end of range
+ * @param out_beg pointer at beginning of output range
+ * @param quantization scale and zero point of input
+ */
+template<typename T>
+inline void dequantize ( const T* it_beg, const T* it_end, float* out_beg, Quantization quantization )
+	{
+	while ( it_beg != it_end )
+		*out_beg++ = quantization.scale * float ( std::int32_t ( *it_beg++ ) - quantization.zero_point );
+	}
+
+/**
+ * @brief Symmetric int8 quantization of each row of Matrix (zero point 0,
+ * largest magnitude maps to 127), usual for weights
+ *
+ * @tparam ROWS number of rows
+ * @tparam COLS number of columns
+ * @param matrix real Matrix
+ * @param output quantized Matrix
+ * @param quantization Vector of quantization of rows
+ */
+template<unsigned ROWS, unsigned COLS>
+void quantizeRows ( const Matrix<float, ROWS, COLS>& matrix,
+					Matrix<std::int8_t, ROWS, COLS>& output,
+					Vector<Quantization, ROWS>& quantization )
+	{
+	for ( unsigned i = 0; i < ROWS; ++i )
+		{
+		float magnitude = 0.0f;
+
+		for ( unsigned j = 0; j < COLS; ++j )
+			magnitude = std::max ( magnitude, std::fabs ( matrix.x[i][j] ) );
+
+		quantization.x[i].scale = magnitude > 0.0f ? magnitude / 127.0f : 1.0f;
+		quantization.x[i].zero_point = 0;
+		quantize ( matrix.x[i], matrix.x[i] + COLS, output.x[i], quantization.x[i] );
+		}
+	}
+
+/**
+ * @brief Requantize int32 accumulators to int8 or uint8 output,
+ * out = round ( multiplier * accumulator ) + zero_point saturated
+ *
+ * @tparam T int8_t or uint8_t
+ * @param it_beg pointer at beginning of accumulators
+ * @param it_end pointer after end of accumulators
+ * @param out_beg pointer at beginning of output range
+ * @param multiplier scale of first * scale of second / scale of output
+ * @param zero_point zero point of output
+ */
+template<typename T>
+inline void requantize ( const std::int32_t* it_beg, const std::int32_t* it_end, T* out_beg,
+						 float multiplier, std::int32_t zero_point )
+	{
+	while ( it_beg != it_end )
+		*out_beg++ = Quantized::saturate<T> ( multiplier * float ( *it_beg++ ) + float ( zero_point ) );
+	}
+
+/**
+ * @brief Quantized Matrix Vector product accumulated in int32,
+ * output = sum ( first - zero point ) * ( second - zero point ), which is real
+ * product divided by scales of first and second.
+ * Must be fullfill assumption COLS1 == SIZE2
+ *
+ * @tparam T int8_t or uint8_t type of second
+ * @tparam Q Quantization of whole first Matrix or Vector<Quantization, ROWS1> of its rows
+ * @param first int8 Matrix of weights
+ * @param first_quantization quantization of first
+ * @param second Vector of activations
+ * @param second_quantization quantization of second
+ * @param output Vector of accumulators
+ */
+template<typename T, typename Q, unsigned ROWS1, unsigned COLS1, unsigned SIZE2>
+void quantizedCauchyProduct ( const Matrix<std::int8_t, ROWS1, COLS1>& first,
+							  const Q& first_quantization,
+							  const Vector<T, SIZE2>& second,
+							  Quantization second_quantization,
+							  Vector<std::int32_t, ROWS1>& output )
+	{
+	static_assert ( COLS1 == SIZE2, "First matrix columns number must be equal to vector size." );
+
+	std::uint8_t packed[SIZE2];
+	const std::int32_t zero_point = Quantized::unsignedZeroPoint<T> ( second_quantization.zero_point );
+
+	for ( unsigned k = 0; k < SIZE2; ++k )
+		packed[k] = Quantized::unsignedByte ( second.x[k] );
+
+	const std::int32_t second_sum = Quantized::sum ( packed, packed + SIZE2 );
+
+	for ( unsigned i = 0; i < ROWS1; ++i )
+		{
+		const std::int32_t first_zero_point = Quantized::row ( first_quantization, i ).zero_point;
+		std::int32_t first_sum;
+
+		output.x[i] = Quantized::dot ( packed, first.x[i], COLS1, first_sum );
+		output.x[i] += std::int32_t ( COLS1 ) * first_zero_point * zero_point - zero_point * first_sum
+					   - first_zero_point * second_sum;
+		}
+	}
+
+/**
+ * @brief Quantized Matrix product accumulated in int32,
+ * output = sum ( first - zero point ) * ( second - zero point ), which is real
+ * product divided by scales of first and second. Columns of second are packed
+ * to contiguous unsigned bytes first, O(ROWS2*COLS2) temporary memory.
+ * Must be fullfill assumption COLS1 == ROWS2
+ *
+ * @tparam T int8_t or uint8_t type of second
+ * @tparam Q Quantization of whole first Matrix or Vector<Quantization, ROWS1> of its rows
+ * @param first int8 Matrix of weights
+ * @param first_quantization quantization of first
+ * @param second Matrix of activations, one column per sample
+ * @param second_quantization quantization of second
+ * @param output Matrix of accumulators
+ */
+template<typename T, typename Q, unsigned ROWS1, unsigned COLS1, unsigned ROWS2, unsigned COLS2>
+void quantizedCauchyProduct ( const Matrix<std::int8_t, ROWS1, COLS1>& first,
+							  const Q& first_quantization,
+							  const Matrix<T, ROWS2, COLS2>& second,
+							  Quantization second_quantization,
+							  Matrix<std::int32_t, ROWS1, COLS2>& output )
+	{
+	static_assert ( COLS1 == ROWS2, "First matrix columns number must be equal to second matrix rows number." );
+
+	std::vector<std::uint8_t> packed ( ROWS2 * std::size_t ( COLS2 ) );
+	std::int32_t second_sum[COLS2];
+	const std::int32_t zero_point = Quantized::unsignedZeroPoint<T> ( second_quantization.zero_point );
+
+	for ( unsigned k = 0; k < ROWS2; ++k )
+		for ( unsigned j = 0; j < COLS2; ++j )
+			packed[std::size_t ( j ) * ROWS2 + k] = Quantized::unsignedByte ( second.x[k][j] );
+
+	for ( unsigned j = 0; j < COLS2; ++j )
+		second_sum[j] = Quantized::sum ( &packed[std::size_t ( j ) * ROWS2], &packed[std::size_t ( j ) * ROWS2] + ROWS2 );
+
+	for ( unsigned i = 0; i < ROWS1; ++i )
+		{
+		const std::int32_t first_zero_point = Quantized::row ( first_quantization, i ).zero_point;
+		const std::int32_t first_sum = Quantized::sum ( first.x[i], first.x[i] + COLS1 );
+		const std::int32_t row_correction = std::int32_t ( COLS1 ) * first_zero_point * zero_point - zero_point * first_sum;
+		unsigned j = 0;
+
+		// row of first is loaded once for 4 columns of second
+		for ( ; j + 4 <= COLS2; j += 4 )
+			Quantized::dot<4> ( &packed[std::size_t ( j ) * ROWS2], ROWS2, first.x[i], COLS1, output.x[i] + j );
+
+		for ( ; j < COLS2; ++j )
+			Quantized::dot<1> ( &packed[std::size_t ( j ) * ROWS2], ROWS2, first.x[i], COLS1, output.x[i] + j );
+
+		for ( j = 0; j < COLS2; ++j )
+			output.x[i][j] += row_correction - first_zero_point * second_sum[j];
+		}
+	}
+
+/**
+ * @brief Quantized Matrix Vector product requantized to int8 or uint8 output
+ * Must be fullfill assumption COLS1 == SIZE2
+ *
+ * @tparam T int8_t or uint8_t type of second
+ * @tparam U int8_t or uint8_t type of output
+ * @tparam Q Quantization of whole first Matrix or Vector<Quantization, ROWS1> of its rows
+ * @param first int8 Matrix of weights
+ * @param first_quantization quantization of first
+ * @param second Vector of activations
+ * @param second_quantization quantization of second
+ * @param output quantized Vector result of multiplication
+ * @param output_quantization quantization of output
+ */
+template<typename T, typename U, typename Q, unsigned ROWS1, unsigned COLS1, unsigned SIZE2>
+void quantizedCauchyProduct ( const Matrix<std::int8_t, ROWS1, COLS1>& first,
+							  const Q& first_quantization,
+							  const Vector<T, SIZE2>& second,
+							  Quantization second_quantization,
+							  Vector<U, ROWS1>& output,
+							  Quantization output_quantization )
+	{
+	Vector<std::int32_t, ROWS1> accumulator;
+	quantizedCauchyProduct ( first, first_quantization, second, second_quantization, accumulator );
+
+	for ( unsigned i = 0; i < ROWS1; ++i )
+		requantize ( accumulator.x + i, accumulator.x + i + 1, output.x + i,
+					 Quantized::row ( first_quantization, i ).scale * second_quantization.scale / output_quantization.scale,
+					 output_quantization.zero_point );
+	}
+
+/**
+ * @brief Quantized Matrix product requantized to int8 or uint8 output
+ * Must be fullfill assumption COLS1 == ROWS2
+ *
+ * @tparam T int8_t or uint8_t type of second
+ * @tparam U int8_t or uint8_t type of output
+ * @tparam Q Quantization of whole first Matrix or Vector<Quantization, ROWS1> of its rows
+ * @param first int8 Matrix of weights
+ * @param first_quantization quantization of first
+ * @param second Matrix of activations, one column per sample
+ * @param second_quantization quantization of second
+ * @param output quantized Matrix result of multiplication
+ * @param output_quantization quantization of output
+ */
+template<typename T, typename U, typename Q, unsigned ROWS1, unsigned COLS1, unsigned ROWS2, unsigned COLS2>
+void quantizedCauchyProduct ( const Matrix<std::int8_t, ROWS1, COLS1>& first,
+							  const Q& first_quantization,
+							  const Matrix<T, ROWS2, COLS2>& second,
+							  Quantization second_quantization,
+							  Matrix<U, ROWS1, COLS2>& output,
+							  Quantization output_quantization )
+	{
+	std::unique_ptr<Matrix<std::int32_t, ROWS1, COLS2>> accumulator ( new Matrix<std::int32_t, ROWS1, COLS2> );
+	quantizedCauchyProduct ( first, first_quantization, second, second_quantization, *accumulator );
+
+	for ( unsigned i = 0; i < ROWS1; ++i )
+		requantize ( accumulator->x[i], accumulator->x[i] + COLS2, output.x[i],
+					 Quantized::row ( first_quantization, i ).scale * second_quantization.scale / output_quantization.scale,
+					 output_quantization.zero_point );
+	}
+
+#endif // QUANTIZED_HPP
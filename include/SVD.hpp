@@ -0,0 +1,364 @@
+#ifndef SVD_HPP
+#define SVD_HPP
+
+#include <type_traits>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "SymmetricEigen.hpp"
+
+
+/*
+ * Signed singular value decomposition of 3x3 Matrix A = U*diag(s)*transpose(V).
+ * Columns of U and V are singular vectors, U and V are rotation matrices,
+ * |s(0)| >= |s(1)| >= |s(2)|, s(0), s(1) are non negative and s(2) has sign of det(A).
+ * Rotations instead of orthogonal matrices make the decomposition directly usable
+ * for nearest rotation R = U*transpose(V).
+ */
+
+/**
+ * @brief Signed singular value decomposition of 3x3 Matrix.
+ * V is computed by fixed number of Jacobi sweeps on transpose(A)*A, U and s by Givens QR
+ * decomposition of A*V, so singular values are accurate to rounding of largest one
+ * and the only branches are selects.
+ *
+ * @tparam T floating point type
+ * @param m decomposed Matrix
+ * @param u left singular vectors in columns, rotation Matrix
+ * @param s singular values sorted by descending absolute value
+ * @param v right singular vectors in columns, rotation Matrix
+ */
+template<typename T>
+void svd ( const Matrix<T, 3, 3>& m, Matrix<T, 3, 3>& u, Vector<T, 3>& s, Matrix<T, 3, 3>& v )
+	{
+	static_assert ( std::is_floating_point<T>::value, "Singular value decomposition requires floating point type." );
+
+	// quadratic convergence, after 4 (float) or 5 (double) sweeps off-diagonal elements are below rounding
+	static const unsigned SWEEPS = sizeof ( T ) <= 4 ? 4 : 5;
+	const T tiny = std::numeric_limits<T>::min() / std::numeric_limits<T>::epsilon();
+
+	// scaling by largest element, squares do not overflow
+	T max_abs = T ( 0 );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			max_abs = std::max ( max_abs, std::abs ( m.x[i][j] ) );
+
+	const T scale = max_abs > T ( 0 ) ? max_abs : T ( 1 );
+	const T inverse_scale = T ( 1 ) / scale;
+	T b[3][3];
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			b[i][j] = m.x[i][j] * inverse_scale;
+
+	// transpose(A)*A in layout of jacobiRotationLanes, largest element is on diagonal
+	T a[6][1];
+	T w[9][1];
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = i; j < 3; ++j )
+			a[i == j ? i : 2 + i + j][0] = b[0][i]*b[0][j] + b[1][i]*b[1][j] + b[2][i]*b[2][j];
+
+	const T max_diagonal = std::max ( std::max ( a[0][0], a[1][0] ), a[2][0] );
+	const T inverse_diagonal = T ( 1 ) / ( max_diagonal > T ( 0 ) ? max_diagonal : T ( 1 ) );
+
+	for ( unsigned k = 0; k < 6; ++k )
+		a[k][0] *= inverse_diagonal;
+
+	for ( unsigned k = 0; k < 9; ++k )
+		w[k][0] = k % 4 == 0 ? T ( 1 ) : T ( 0 );
+
+	for ( unsigned sweep = 0; sweep < SWEEPS; ++sweep )
+		{
+		jacobiRotationLanes<T, 1, 0, 1> ( a, w );
+		jacobiRotationLanes<T, 1, 0, 2> ( a, w );
+		jacobiRotationLanes<T, 1, 1, 2> ( a, w );
+		}
+
+	// descending sorting network, swap of two rows negates one of them to keep orientation
+	for ( unsigned pair = 0; pair < 3; ++pair )
+		{
+		const unsigned i = pair == 1 ? 1 : 0;
+		const unsigned j = i + 1;
+		const bool swap = a[j][0] > a[i][0];
+		const T a_i = a[i][0];
+		const T a_j = a[j][0];
+
+		a[i][0] = swap ? a_j : a_i;
+		a[j][0] = swap ? a_i : a_j;
+
+		for ( unsigned k = 0; k < 3; ++k )
+			{
+			const T w_i = w[i*3 + k][0];
+			const T w_j = w[j*3 + k][0];
+
+			w[i*3 + k][0] = swap ? -w_j : w_i;
+			w[j*3 + k][0] = swap ? w_i : w_j;
+			}
+		}
+
+	// rows of w are right singular vectors, B = A*V has orthogonal columns of descending norm
+	T av[3][3];
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			{
+			v.x[i][j] = w[j*3 + i][0];
+			av[i][j] = b[i][0]*w[j*3][0] + b[i][1]*w[j*3 + 1][0] + b[i][2]*w[j*3 + 2][0];
+			}
+
+	// Givens QR decomposition of B, R is diagonal up to rounding, U is product of transposed rotations
+	T q[3][3] = { { T ( 1 ), T ( 0 ), T ( 0 ) },
+				  { T ( 0 ), T ( 1 ), T ( 0 ) },
+				  { T ( 0 ), T ( 0 ), T ( 1 ) } };
+
+	for ( unsigned pair = 0; pair < 3; ++pair )
+		{
+		const unsigned p = pair == 2 ? 1 : 0;
+		const unsigned r = pair == 0 ? 1 : 2;
+		const T x = av[p][p];
+		const T y = av[r][p];
+		const T norm = std::sqrt ( x*x + y*y );
+		// zero column is kept by identity rotation
+		const bool zero = norm <= tiny;
+		const T c = zero ? T ( 1 ) : x / norm;
+		const T sn = zero ? T ( 0 ) : y / norm;
+
+		for ( unsigned k = 0; k < 3; ++k )
+			{
+			const T av_p = av[p][k];
+			const T av_r = av[r][k];
+
+			av[p][k] = c*av_p + sn*av_r;
+			av[r][k] = c*av_r - sn*av_p;
+
+			const T q_p = q[k][p];
+			const T q_r = q[k][r];
+
+			q[k][p] = c*q_p + sn*q_r;
+			q[k][r] = c*q_r - sn*q_p;
+			}
+		}
+
+	for ( unsigned i = 0; i < 3; ++i )
+		{
+		s.x[i] = av[i][i] * scale;
+
+		for ( unsigned j = 0; j < 3; ++j )
+			u.x[i][j] = q[i][j];
+		}
+	}
+
+/**
+ * @brief Nearest rotation Matrix in Frobenius norm, R = U*transpose(V) from signed SVD
+ *
+ * @tparam T floating point type
+ * @param m Matrix
+ * @return Matrix<T, 3, 3> rotation Matrix
+ */
+template<typename T>
+Matrix<T, 3, 3> nearestRotation ( const Matrix<T, 3, 3>& m )
+	{
+	Matrix<T, 3, 3> u, v, r;
+	Vector<T, 3> s;
+	svd ( m, u, s, v );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			r.x[i][j] = u.x[i][0]*v.x[j][0] + u.x[i][1]*v.x[j][1] + u.x[i][2]*v.x[j][2];
+
+	return r;
+	}
+
+/**
+ * @brief Means, cross-covariance and source variance of corresponding point sets in single pass.
+ * Points are accumulated relative to the first pair, so sums do not lose precision
+ * for point clouds far from origin.
+ * Container pointered by target_beg must be at least the same size as container pointered by source_beg.
+ *
+ * @tparam Iterator Forward Iterator to Vector<U, 3>
+ * @tparam ConstIterator Const Forward Iterator to Vector<U, 3>
+ * @tparam Iterator2 Forward Iterator to Vector<U, 3>
+ * @tparam T floating point type of results
+ * @param source_beg iterator at beginning of source points
+ * @param source_end iterator after end of source points
+ * @param target_beg iterator at beginning of target points
+ * @param source_mean centroid of source points
+ * @param target_mean centroid of target points
+ * @param covariance mean of (target - target_mean)*transpose(source - source_mean)
+ * @return T mean of squared distances of source points from source_mean
+ */
+template<typename Iterator,
+		 typename ConstIterator,
+		 typename Iterator2,
+		 typename T>
+T crossCovariance ( Iterator source_beg,
+					ConstIterator source_end,
+					Iterator2 target_beg,
+					Vector<T, 3>& source_mean,
+					Vector<T, 3>& target_mean,
+					Matrix<T, 3, 3>& covariance )
+	{
+	static_assert ( std::is_floating_point<T>::value, "Cross-covariance requires floating point type." );
+
+	if ( source_beg == source_end )
+		throw std::runtime_error ( "Empty point set" );
+
+	const Vector<T, 3> source_origin ( *source_beg );
+	const Vector<T, 3> target_origin ( *target_beg );
+	// point pairs are loaded in blocks to structure of arrays and accumulated into independent
+	// partial sums per lane, sums[0..2] source, sums[3..5] target, sums[6 + i*3 + j] products
+	// q(i)*p(j) and sums[15] squared norm of source
+	static const unsigned LANES = 16;
+	T sums[16][LANES];
+	unsigned count = 0;
+
+	for ( unsigned k = 0; k < 16; ++k )
+		Container::fill ( sums[k], sums[k] + LANES, T ( 0 ) );
+
+	while ( source_beg != source_end )
+		{
+		// unused lanes get zero points relative to origin, they add nothing
+		T p[3][LANES], q[3][LANES];
+		unsigned lanes = 0;
+
+		for ( ; lanes < LANES && source_beg != source_end; ++lanes, ++source_beg, ++target_beg )
+			for ( unsigned i = 0; i < 3; ++i )
+				{
+				p[i][lanes] = T ( source_beg->x[i] ) - source_origin.x[i];
+				q[i][lanes] = T ( target_beg->x[i] ) - target_origin.x[i];
+				}
+
+		for ( unsigned l = lanes; l < LANES; ++l )
+			for ( unsigned i = 0; i < 3; ++i )
+				p[i][l] = q[i][l] = T ( 0 );
+
+		count += lanes;
+
+		for ( unsigned l = 0; l < LANES; ++l )
+			{
+			for ( unsigned i = 0; i < 3; ++i )
+				{
+				sums[i][l] += p[i][l];
+				sums[3 + i][l] += q[i][l];
+
+				for ( unsigned j = 0; j < 3; ++j )
+					sums[6 + i*3 + j][l] += q[i][l] * p[j][l];
+				}
+
+			sums[15][l] += p[0][l]*p[0][l] + p[1][l]*p[1][l] + p[2][l]*p[2][l];
+			}
+		}
+
+	T total[16];
+
+	for ( unsigned k = 0; k < 16; ++k )
+		total[k] = Container::sum ( sums[k], sums[k] + LANES );
+
+	const T inverse_count = T ( 1 ) / T ( count );
+	T source_shift[3], target_shift[3];
+
+	for ( unsigned i = 0; i < 3; ++i )
+		{
+		source_shift[i] = total[i] * inverse_count;
+		target_shift[i] = total[3 + i] * inverse_count;
+		source_mean.x[i] = source_origin.x[i] + source_shift[i];
+		target_mean.x[i] = target_origin.x[i] + target_shift[i];
+		}
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			covariance.x[i][j] = total[6 + i*3 + j] * inverse_count - target_shift[i] * source_shift[j];
+
+	const T variance = total[15] * inverse_count -
+					   ( source_shift[0]*source_shift[0] + source_shift[1]*source_shift[1] + source_shift[2]*source_shift[2] );
+
+	return std::max ( variance, T ( 0 ) );
+	}
+
+/**
+ * @brief Rigid alignment of corresponding point sets (Kabsch algorithm),
+ * rotation R and translation t minimize sum of |R*source + t - target|^2.
+ * Container pointered by target_beg must be at least the same size as container pointered by source_beg.
+ *
+ * @tparam Iterator Forward Iterator to Vector<U, 3>
+ * @tparam ConstIterator Const Forward Iterator to Vector<U, 3>
+ * @tparam Iterator2 Forward Iterator to Vector<U, 3>
+ * @tparam T floating point type of results
+ * @param source_beg iterator at beginning of source points
+ * @param source_end iterator after end of source points
+ * @param target_beg iterator at beginning of target points
+ * @param translation translation t
+ * @return Matrix<T, 3, 3> rotation Matrix R
+ */
+template<typename Iterator,
+		 typename ConstIterator,
+		 typename Iterator2,
+		 typename T>
+Matrix<T, 3, 3> kabsch ( Iterator source_beg, ConstIterator source_end, Iterator2 target_beg, Vector<T, 3>& translation )
+	{
+	Vector<T, 3> source_mean, target_mean;
+	Matrix<T, 3, 3> covariance;
+	crossCovariance ( source_beg, source_end, target_beg, source_mean, target_mean, covariance );
+
+	Matrix<T, 3, 3> rotation = nearestRotation ( covariance );
+	Vector<T, 3> rotated_mean = rotation * source_mean;
+
+	for ( unsigned i = 0; i < 3; ++i )
+		translation.x[i] = target_mean.x[i] - rotated_mean.x[i];
+
+	return rotation;
+	}
+
+/**
+ * @brief Similarity alignment of corresponding point sets (Umeyama algorithm),
+ * rotation R, translation t and scale c minimize sum of |c*R*source + t - target|^2.
+ * Container pointered by target_beg must be at least the same size as container pointered by source_beg.
+ *
+ * @tparam Iterator Forward Iterator to Vector<U, 3>
+ * @tparam ConstIterator Const Forward Iterator to Vector<U, 3>
+ * @tparam Iterator2 Forward Iterator to Vector<U, 3>
+ * @tparam T floating point type of results
+ * @param source_beg iterator at beginning of source points
+ * @param source_end iterator after end of source points
+ * @param target_beg iterator at beginning of target points
+ * @param translation translation t
+ * @param scale scale c, zero for source points in single location
+ * @return Matrix<T, 3, 3> rotation Matrix R
+ */
+template<typename Iterator,
+		 typename ConstIterator,
+		 typename Iterator2,
+		 typename T>
+Matrix<T, 3, 3> umeyama ( Iterator source_beg, ConstIterator source_end, Iterator2 target_beg, Vector<T, 3>& translation, T& scale )
+	{
+	Vector<T, 3> source_mean, target_mean;
+	Matrix<T, 3, 3> covariance;
+	const T variance = crossCovariance ( source_beg, source_end, target_beg, source_mean, target_mean, covariance );
+
+	Matrix<T, 3, 3> u, v, rotation;
+	Vector<T, 3> s;
+	svd ( covariance, u, s, v );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			rotation.x[i][j] = u.x[i][0]*v.x[j][0] + u.x[i][1]*v.x[j][1] + u.x[i][2]*v.x[j][2];
+
+	// signed singular values already contain the reflection correction
+	scale = variance > T ( 0 ) ? ( s.x[0] + s.x[1] + s.x[2] ) / variance : T ( 0 );
+
+	Vector<T, 3> rotated_mean = rotation * source_mean;
+
+	for ( unsigned i = 0; i < 3; ++i )
+		translation.x[i] = target_mean.x[i] - scale * rotated_mean.x[i];
+
+	return rotation;
+	}
+
+#endif // SVD_HPP
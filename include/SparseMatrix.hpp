@@ -0,0 +1,525 @@
+#ifndef SPARSEMATRIX_HPP
+#define SPARSEMATRIX_HPP
+
+#include <type_traits>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <thread>
+#include <cmath>
+#include <stdexcept>
+#include <exception>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+
+/**
+ * @brief Element of sparse Matrix given by its position
+ *
+ * @tparam T type of value
+ */
+template<typename T>
+struct Triplet
+	{
+	unsigned row;
+	unsigned col;
+	T value;
+	};
+
+/**
+ * @brief Sparse Matrix in compressed sparse row (CSR) format.
+ * Non zero elements of row i are values[row_offsets[i] : row_offsets[i+1]]
+ * with ascending column indices in columns[row_offsets[i] : row_offsets[i+1]].
+ * Dimensions are compile time constants like in Matrix, storage is allocated on heap
+ * and grows with number of non zero elements only.
+ *
+ * @tparam T type of values
+ * @tparam ROWS number of rows
+ * @tparam COLS number of cols
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+class SparseMatrix
+	{
+	public:
+		static const unsigned rows = ROWS;
+		static const unsigned cols = COLS;
+
+	public:
+		// non zero values row by row
+		std::vector<T> values;
+		// column index of each value
+		std::vector<unsigned> columns;
+		// ROWS+1 offsets of rows beginnings in values and columns
+		std::vector<unsigned> row_offsets;
+
+	public:
+		/**
+		 * @brief Empty sparse Matrix, all elements are zero
+		 *
+		 */
+		SparseMatrix() : row_offsets ( ROWS+1, 0 )
+			{
+			}
+
+		/**
+		 * @brief Sparse Matrix from range of triplets in any order,
+		 * values of duplicate positions are summed.
+		 *
+		 * @tparam Iterator Forward Iterator to Triplet<U>
+		 * @tparam ConstIterator Const Forward Iterator to Triplet<U>
+		 * @param it_beg iterator at beginning of triplets
+		 * @param it_end iterator after end of triplets
+		 */
+		template<typename Iterator,
+				 typename ConstIterator>
+		SparseMatrix ( Iterator it_beg, ConstIterator it_end ) : row_offsets ( ROWS+1, 0 )
+			{
+			// counting sort by rows
+			unsigned count = 0;
+
+			for ( Iterator it = it_beg; it != it_end; ++it, ++count )
+				{
+				if ( it->row >= ROWS || it->col >= COLS )
+					throw std::runtime_error ( "Triplet position out of Matrix." );
+
+				++row_offsets[it->row + 1];
+				}
+
+			for ( unsigned i = 0; i < ROWS; ++i )
+				row_offsets[i+1] += row_offsets[i];
+
+			std::vector<std::pair<unsigned, T>> entries ( count );
+			std::vector<unsigned> next ( row_offsets.begin(), row_offsets.end() - 1 );
+
+			for ( Iterator it = it_beg; it != it_end; ++it )
+				entries[next[it->row]++] = std::make_pair ( it->col, T ( it->value ) );
+
+			// sort each row by columns and merge duplicates
+			values.reserve ( count );
+			columns.reserve ( count );
+
+			for ( unsigned i = 0; i < ROWS; ++i )
+				{
+				auto row_beg = entries.begin() + row_offsets[i];
+				auto row_end = entries.begin() + row_offsets[i+1];
+
+				std::sort ( row_beg, row_end, [] ( const std::pair<unsigned, T>& a, const std::pair<unsigned, T>& b )
+					{
+					return a.first < b.first;
+					} );
+
+				row_offsets[i] = values.size();
+
+				for ( ; row_beg != row_end; ++row_beg )
+					{
+					if ( columns.size() > row_offsets[i] && columns.back() == row_beg->first )
+						values.back() += row_beg->second;
+					else
+						{
+						columns.push_back ( row_beg->first );
+						values.push_back ( row_beg->second );
+						}
+					}
+				}
+
+			row_offsets[ROWS] = values.size();
+			}
+
+		/**
+		 * @brief Sparse Matrix from elements of dense Matrix greater than tolerance in absolute value
+		 *
+		 * @tparam U type of dense Matrix
+		 * @param m dense Matrix
+		 * @param tolerance largest absolute value of dropped element
+		 */
+		template<typename U,
+				 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		explicit SparseMatrix ( const Matrix<U, ROWS, COLS>& m, U tolerance = U ( 0 ) ) : row_offsets ( ROWS+1, 0 )
+			{
+			for ( unsigned i = 0; i < ROWS; ++i )
+				{
+				for ( unsigned j = 0; j < COLS; ++j )
+					if ( std::abs ( m.x[i][j] ) > tolerance )
+						{
+						columns.push_back ( j );
+						values.push_back ( T ( m.x[i][j] ) );
+						}
+
+				row_offsets[i+1] = values.size();
+				}
+			}
+
+		/**
+		 * @brief Number of stored elements
+		 *
+		 * @return unsigned
+		 */
+		inline unsigned nonZeros() const
+			{
+			return values.size();
+			}
+
+		/**
+		 * @brief Element at position (i, j), zero if not stored
+		 *
+		 * @param i row
+		 * @param j col
+		 * @return T
+		 */
+		T operator() ( unsigned i, unsigned j ) const
+			{
+			const unsigned* row_beg = columns.data() + row_offsets[i];
+			const unsigned* row_end = columns.data() + row_offsets[i+1];
+			const unsigned* it = std::lower_bound ( row_beg, row_end, j );
+
+			return it != row_end && *it == j ? values[it - columns.data()] : T ( 0 );
+			}
+
+		/**
+		 * @brief Dense copy of sparse Matrix
+		 *
+		 * @tparam U type of dense Matrix
+		 * @param m dense Matrix
+		 */
+		template<typename U>
+		void toDense ( Matrix<U, ROWS, COLS>& m ) const
+			{
+			m.fill ( U ( 0 ) );
+
+			for ( unsigned i = 0; i < ROWS; ++i )
+				for ( unsigned k = row_offsets[i]; k < row_offsets[i+1]; ++k )
+					m.x[i][columns[k]] = U ( values[k] );
+			}
+
+		/**
+		 * @brief Call function ( row_beg, row_end, part ) for consecutive ranges of rows
+		 * with about the same number of non zero elements, each range in own thread.
+		 * Last range is processed by calling thread. Threads are joined before first
+		 * exception of function, or of starting thread, is rethrown in calling thread.
+		 *
+		 * @tparam Function callable with ( unsigned, unsigned, unsigned )
+		 * @param threads number of ranges
+		 * @param function called function
+		 */
+		template<typename Function>
+		void forRowRanges ( unsigned threads, Function function ) const
+			{
+			threads = std::max ( 1u, std::min ( threads, ROWS ) );
+
+			if ( threads == 1 )
+				{
+				function ( 0u, ROWS, 0u );
+				return;
+				}
+
+			std::vector<std::exception_ptr> errors ( threads );
+			std::vector<std::thread> workers;
+			unsigned row_beg = 0;
+
+			// each thread calls own copy of function
+			auto task = [&errors] ( Function function, unsigned row_beg, unsigned row_end, unsigned part )
+				{
+				try
+					{
+					function ( row_beg, row_end, part );
+					}
+				catch ( ... )
+					{
+					errors[part] = std::current_exception();
+					}
+				};
+
+			try
+				{
+				for ( unsigned part = 0; part < threads; ++part )
+					{
+					// first row whose beginning reaches part+1 shares of non zero elements
+					const unsigned long long share = ( unsigned long long ) nonZeros() * ( part+1 ) / threads;
+					const unsigned row_end = part+1 == threads ?
+											 ROWS :
+											 unsigned ( std::lower_bound ( row_offsets.begin() + row_beg, row_offsets.end(), share ) - row_offsets.begin() );
+
+					if ( part+1 == threads )
+						task ( function, row_beg, row_end, part );
+					else
+						workers.emplace_back ( task, function, row_beg, row_end, part );
+
+					row_beg = row_end;
+					}
+				}
+			catch ( ... )
+				{
+				// thread was not started, running threads are joined before rethrow
+				for ( std::thread& worker : workers )
+					worker.join();
+
+				throw;
+				}
+
+			for ( std::thread& worker : workers )
+				worker.join();
+
+			for ( const std::exception_ptr& error : errors )
+				if ( error )
+					std::rethrow_exception ( error );
+			}
+	};
+
+/**
+ * @brief Sparse Matrix Vector multiplication (SpMV), rows are split into ranges
+ * with about the same number of non zero elements processed by separate threads.
+ * Each row is reduced into four partial sums.
+ *
+ * @tparam Tt type of sparse Matrix
+ * @tparam U type of Vector
+ * @tparam T_U = ( Tt()*U() ) type of output Vector
+ * @tparam ROWS1 number of rows of sparse Matrix
+ * @tparam COLS1 number of cols of sparse Matrix
+ * @param first sparse Matrix
+ * @param second Vector
+ * @param output Vector result of multiplication
+ * @param threads number of threads
+ */
+template<typename Tt,
+		 typename U,
+		 typename T_U,
+		 unsigned ROWS1,
+		 unsigned COLS1>
+void cauchyProduct ( const SparseMatrix<Tt, ROWS1, COLS1>& first,
+					 const Vector<U, COLS1>& second,
+					 Vector<T_U, ROWS1>& output,
+					 unsigned threads = 1 )
+	{
+	first.forRowRanges ( threads, [&first, &second, &output] ( unsigned row_beg, unsigned row_end, unsigned )
+		{
+		const Tt* values = first.values.data();
+		const unsigned* columns = first.columns.data();
+
+		for ( unsigned i = row_beg; i < row_end; ++i )
+			{
+			// four partial sums, so long rows are not bound by latency of one accumulation chain
+			T_U value[4] = { T_U ( 0 ), T_U ( 0 ), T_U ( 0 ), T_U ( 0 ) };
+			unsigned k = first.row_offsets[i];
+			const unsigned k_end = first.row_offsets[i+1];
+
+			for ( ; k + 4 <= k_end; k += 4 )
+				for ( unsigned r = 0; r < 4; ++r )
+					value[r] += values[k+r] * second.x[columns[k+r]];
+
+			for ( ; k < k_end; ++k )
+				value[0] += values[k] * second.x[columns[k]];
+
+			output.x[i] = ( value[0] + value[1] ) + ( value[2] + value[3] );
+			}
+		} );
+	}
+
+/**
+ * @brief Sparse Matrix dense Matrix multiplication (SpMM), row i of output is sum
+ * of rows of second Matrix scaled by non zero elements of row i of first,
+ * so the inner loop streams contiguous rows. Rows are split among threads as in SpMV.
+ *
+ * @tparam Tt type of sparse Matrix
+ * @tparam U type of dense Matrix
+ * @tparam T_U = ( Tt()*U() ) type of output Matrix
+ * @tparam ROWS1 number of rows of sparse Matrix
+ * @tparam COLS1 number of cols of sparse Matrix
+ * @tparam COLS2 number of cols of dense Matrix
+ * @param first sparse Matrix
+ * @param second dense Matrix
+ * @param output Matrix result of multiplication
+ * @param threads number of threads
+ */
+template<typename Tt,
+		 typename U,
+		 typename T_U,
+		 unsigned ROWS1,
+		 unsigned COLS1,
+		 unsigned COLS2>
+void cauchyProduct ( const SparseMatrix<Tt, ROWS1, COLS1>& first,
+					 const Matrix<U, COLS1, COLS2>& second,
+					 Matrix<T_U, ROWS1, COLS2>& output,
+					 unsigned threads = 1 )
+	{
+	first.forRowRanges ( threads, [&first, &second, &output] ( unsigned row_beg, unsigned row_end, unsigned )
+		{
+		for ( unsigned i = row_beg; i < row_end; ++i )
+			{
+			T_U* it_output = output.x[i];
+
+			Container::fill ( it_output, it_output + COLS2, T_U ( 0 ) );
+
+			for ( unsigned k = first.row_offsets[i]; k < first.row_offsets[i+1]; ++k )
+				{
+				const Tt value = first.values[k];
+				const U* it_second = second.x[first.columns[k]];
+
+				for ( unsigned j = 0; j < COLS2; ++j )
+					it_output[j] += value * it_second[j];
+				}
+			}
+		} );
+	}
+
+/**
+ * @brief Transposed sparse Matrix Vector multiplication, output = transpose(first)*second.
+ * Rows of first are scattered into output, each thread scatters its range of rows
+ * into own partial output and partial outputs are summed.
+ *
+ * @tparam Tt type of sparse Matrix
+ * @tparam U type of Vector
+ * @tparam T_U = ( Tt()*U() ) type of output Vector
+ * @tparam ROWS1 number of rows of sparse Matrix
+ * @tparam COLS1 number of cols of sparse Matrix
+ * @param first sparse Matrix which will be calculated as transposed
+ * @param second Vector
+ * @param output Vector result of multiplication
+ * @param threads number of threads
+ */
+template<typename Tt,
+		 typename U,
+		 typename T_U,
+		 unsigned ROWS1,
+		 unsigned COLS1>
+void transposedCauchyProduct ( const SparseMatrix<Tt, ROWS1, COLS1>& first,
+							   const Vector<U, ROWS1>& second,
+							   Vector<T_U, COLS1>& output,
+							   unsigned threads = 1 )
+	{
+	threads = std::max ( 1u, std::min ( threads, ROWS1 ) );
+	// part 0 scatters directly into output
+	std::vector<Vector<T_U, COLS1>> partial ( threads - 1, Vector<T_U, COLS1> ( T_U ( 0 ) ) );
+
+	output.fill ( T_U ( 0 ) );
+
+	first.forRowRanges ( threads, [&first, &second, &output, &partial] ( unsigned row_beg, unsigned row_end, unsigned part )
+		{
+		T_U* it_output = part == 0 ? output.x : partial[part-1].x;
+
+		for ( unsigned i = row_beg; i < row_end; ++i )
+			{
+			const U x = second.x[i];
+
+			for ( unsigned k = first.row_offsets[i]; k < first.row_offsets[i+1]; ++k )
+				it_output[first.columns[k]] += first.values[k] * x;
+			}
+		} );
+
+	for ( const Vector<T_U, COLS1>& p : partial )
+		for ( unsigned j = 0; j < COLS1; ++j )
+			output.x[j] += p.x[j];
+	}
+
+/**
+ * @brief Transposed sparse Matrix dense Matrix multiplication, output = transpose(first)*second.
+ * Scaled rows of second are scattered into rows of output, with partial outputs per thread
+ * as in transposed SpMV.
+ *
+ * @tparam Tt type of sparse Matrix
+ * @tparam U type of dense Matrix
+ * @tparam T_U = ( Tt()*U() ) type of output Matrix
+ * @tparam ROWS1 number of rows of sparse Matrix
+ * @tparam COLS1 number of cols of sparse Matrix
+ * @tparam COLS2 number of cols of dense Matrix
+ * @param first sparse Matrix which will be calculated as transposed
+ * @param second dense Matrix
+ * @param output Matrix result of multiplication
+ * @param threads number of threads
+ */
+template<typename Tt,
+		 typename U,
+		 typename T_U,
+		 unsigned ROWS1,
+		 unsigned COLS1,
+		 unsigned COLS2>
+void transposedCauchyProduct ( const SparseMatrix<Tt, ROWS1, COLS1>& first,
+							   const Matrix<U, ROWS1, COLS2>& second,
+							   Matrix<T_U, COLS1, COLS2>& output,
+							   unsigned threads = 1 )
+	{
+	threads = std::max ( 1u, std::min ( threads, ROWS1 ) );
+	// part 0 scatters directly into output
+	std::vector<Matrix<T_U, COLS1, COLS2>> partial ( threads - 1, Matrix<T_U, COLS1, COLS2> ( T_U ( 0 ) ) );
+
+	output.fill ( T_U ( 0 ) );
+
+	first.forRowRanges ( threads, [&first, &second, &output, &partial] ( unsigned row_beg, unsigned row_end, unsigned part )
+		{
+		Matrix<T_U, COLS1, COLS2>& out = part == 0 ? output : partial[part-1];
+
+		for ( unsigned i = row_beg; i < row_end; ++i )
+			{
+			const U* it_second = second.x[i];
+
+			for ( unsigned k = first.row_offsets[i]; k < first.row_offsets[i+1]; ++k )
+				{
+				const Tt value = first.values[k];
+				T_U* it_output = out.x[first.columns[k]];
+
+				for ( unsigned j = 0; j < COLS2; ++j )
+					it_output[j] += value * it_second[j];
+				}
+			}
+		} );
+
+	for ( const Matrix<T_U, COLS1, COLS2>& p : partial )
+		for ( unsigned i = 0; i < COLS1; ++i )
+			for ( unsigned j = 0; j < COLS2; ++j )
+				output.x[i][j] += p.x[i][j];
+	}
+
+/**
+ * @brief Sparse Matrix Vector multiplication
+ *
+ * @tparam Tt type of sparse Matrix
+ * @tparam U type of Vector
+ * @tparam T_U = ( Tt()*U() ) type of output Vector
+ * @tparam ROWS1 number of rows of sparse Matrix
+ * @tparam COLS1 number of cols of sparse Matrix
+ * @param first sparse Matrix
+ * @param second Vector
+ * @return Vector<T_U, ROWS1>
+ */
+template<typename Tt,
+		 typename U,
+		 typename T_U = decltype ( Tt()*U() ),
+		 unsigned ROWS1,
+		 unsigned COLS1>
+inline Vector<T_U, ROWS1> operator* ( const SparseMatrix<Tt, ROWS1, COLS1>& first, const Vector<U, COLS1>& second )
+	{
+	Vector<T_U, ROWS1> ans;
+	cauchyProduct ( first, second, ans );
+
+	return ans;
+	}
+
+/**
+ * @brief Sparse Matrix dense Matrix multiplication
+ *
+ * @tparam Tt type of sparse Matrix
+ * @tparam U type of dense Matrix
+ * @tparam T_U = ( Tt()*U() ) type of output Matrix
+ * @tparam ROWS1 number of rows of sparse Matrix
+ * @tparam COLS1 number of cols of sparse Matrix
+ * @tparam COLS2 number of cols of dense Matrix
+ * @param first sparse Matrix
+ * @param second dense Matrix
+ * @return Matrix<T_U, ROWS1, COLS2>
+ */
+template<typename Tt,
+		 typename U,
+		 typename T_U = decltype ( Tt()*U() ),
+		 unsigned ROWS1,
+		 unsigned COLS1,
+		 unsigned COLS2>
+inline Matrix<T_U, ROWS1, COLS2> operator* ( const SparseMatrix<Tt, ROWS1, COLS1>& first, const Matrix<U, COLS1, COLS2>& second )
+	{
+	Matrix<T_U, ROWS1, COLS2> ans;
+	cauchyProduct ( first, second, ans );
+
+	return ans;
+	}
+
+#endif // SPARSEMATRIX_HPP
@@ -0,0 +1,250 @@
+#ifndef STRASSEN_HPP
+#define STRASSEN_HPP
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "Utility.hpp"
+#include "Matrix.hpp"
+
+/*
+ * Strassen-Winograd multiplication of large square matrices, opt-in alternative
+ * of cauchyProduct. Each level of recursion replaces 8 products of half size matrices
+ * by 7 products and 15 additions, below crossover size (or for odd size) blocked
+ * kernel is used.
+ *
+ * Error growth: the bound is norm-wise, not element-wise as for cauchyProduct,
+ *   |C - fl(C)| <= ( (n/n0)^log2(18) * (n0^2 + 6*n0) ) * u * |A| * |B|   (max norms)
+ * for crossover n0 and unit roundoff u. Each level multiplies the bound by about 9,
+ * so small elements of product computed from large elements of inputs lose
+ * relative accuracy. Keep the number of levels low (large crossover) for float.
+ *
+ * Workspace: 2*(n/2)^2 elements for the first level, 2*(n/4)^2 for the second etc.,
+ * less than 2/3*n^2 in total, see strassenWorkspaceSize. It is provided by caller,
+ * so repeated products do not allocate.
+ */
+
+#ifndef STRASSEN_CROSSOVER
+// size of matrices multiplied by blocked kernel, located by BM_StrassenProduct
+#define STRASSEN_CROSSOVER 256
+#endif
+
+namespace Strassen
+	{
+	/**
+	 * @brief Product of rows x width tile of c = a*b with accumulators in registers.
+	 * Matrices are stored by rows with leading dimensions lda, ldb, ldc.
+	 *
+	 * @tparam T type of elements
+	 * @tparam ROWS number of rows of tile
+	 * @tparam WIDTH number of columns of tile
+	 * @param depth number of columns of a and rows of b
+	 */
+	template<typename T, unsigned ROWS, unsigned WIDTH>
+	inline void productTile ( const T* a, unsigned lda, const T* b, unsigned ldb, T* c, unsigned ldc, unsigned depth )
+		{
+		T accumulator[ROWS][WIDTH] = {};
+
+		for ( unsigned k = 0; k < depth; ++k )
+			{
+			const T* it_b = b + k*ldb;
+
+			for ( unsigned r = 0; r < ROWS; ++r )
+				{
+				const T a_rk = a[r*lda + k];
+
+				for ( unsigned w = 0; w < WIDTH; ++w )
+					accumulator[r][w] += a_rk * it_b[w];
+				}
+			}
+
+		for ( unsigned r = 0; r < ROWS; ++r )
+			Container::copy ( c + r*ldc, c + r*ldc + WIDTH, accumulator[r] );
+		}
+
+	/**
+	 * @brief Product of rows x cols part of c = a*b streaming rows of b,
+	 * used for edges not covered by tiles.
+	 */
+	template<typename T>
+	inline void productEdge ( const T* a, unsigned lda, const T* b, unsigned ldb, T* c, unsigned ldc,
+							  unsigned rows, unsigned cols, unsigned depth )
+		{
+		for ( unsigned i = 0; i < rows; ++i )
+			{
+			T* it_c = c + i*ldc;
+
+			Container::fill ( it_c, it_c + cols, T ( 0 ) );
+
+			for ( unsigned k = 0; k < depth; ++k )
+				{
+				const T a_ik = a[i*lda + k];
+				const T* it_b = b + k*ldb;
+
+				for ( unsigned j = 0; j < cols; ++j )
+					it_c[j] += a_ik * it_b[j];
+				}
+			}
+		}
+
+	/**
+	 * @brief Blocked product c = a*b of n x n matrices by register tiles
+	 * of 4 rows and 32 columns. Narrower tiles are fully unrolled by compiler
+	 * before vectorization and end up as scalar code.
+	 */
+	template<typename T>
+	inline void blockedProduct ( const T* a, unsigned lda, const T* b, unsigned ldb, T* c, unsigned ldc, unsigned n )
+		{
+		const unsigned ROWS = 4;
+		const unsigned WIDTH = 32;
+		const unsigned tiled_rows = n - n % ROWS;
+		const unsigned tiled_cols = n - n % WIDTH;
+
+		for ( unsigned i = 0; i < tiled_rows; i += ROWS )
+			{
+			for ( unsigned j = 0; j < tiled_cols; j += WIDTH )
+				productTile<T, ROWS, WIDTH> ( a + i*lda, lda, b + j, ldb, c + i*ldc + j, ldc, n );
+
+			productEdge ( a + i*lda, lda, b + tiled_cols, ldb, c + i*ldc + tiled_cols, ldc, ROWS, n - tiled_cols, n );
+			}
+
+		productEdge ( a + tiled_rows*lda, lda, b, ldb, c + tiled_rows*ldc, ldc, n - tiled_rows, n, n );
+		}
+
+	/**
+	 * @brief out = first + second for n x n matrices with leading dimensions
+	 */
+	template<typename T>
+	inline void add ( const T* first, unsigned ld1, const T* second, unsigned ld2, T* out, unsigned ldo, unsigned n )
+		{
+		for ( unsigned i = 0; i < n; ++i )
+			for ( unsigned j = 0; j < n; ++j )
+				out[i*ldo + j] = first[i*ld1 + j] + second[i*ld2 + j];
+		}
+
+	/**
+	 * @brief out = first - second for n x n matrices with leading dimensions
+	 */
+	template<typename T>
+	inline void subtract ( const T* first, unsigned ld1, const T* second, unsigned ld2, T* out, unsigned ldo, unsigned n )
+		{
+		for ( unsigned i = 0; i < n; ++i )
+			for ( unsigned j = 0; j < n; ++j )
+				out[i*ldo + j] = first[i*ld1 + j] - second[i*ld2 + j];
+		}
+
+	/**
+	 * @brief Winograd variant of Strassen recursion c = a*b,
+	 * schedule of Douglas et al. with two temporaries x, y per level.
+	 * Output must not overlap inputs.
+	 *
+	 * @param n size of matrices
+	 * @param crossover largest size multiplied by blocked kernel
+	 * @param workspace at least strassenWorkspaceSize(n, crossover) elements
+	 */
+	template<typename T>
+	void winogradProduct ( const T* a, unsigned lda, const T* b, unsigned ldb, T* c, unsigned ldc,
+						   unsigned n, unsigned crossover, T* workspace )
+		{
+		if ( n <= crossover || n % 2 != 0 )
+			{
+			blockedProduct ( a, lda, b, ldb, c, ldc, n );
+			return;
+			}
+
+		const unsigned h = n / 2;
+		const T* a11 = a;
+		const T* a12 = a + h;
+		const T* a21 = a + h*lda;
+		const T* a22 = a21 + h;
+		const T* b11 = b;
+		const T* b12 = b + h;
+		const T* b21 = b + h*ldb;
+		const T* b22 = b21 + h;
+		T* c11 = c;
+		T* c12 = c + h;
+		T* c21 = c + h*ldc;
+		T* c22 = c21 + h;
+		T* x = workspace;
+		T* y = x + std::size_t ( h ) * h;
+		T* next = y + std::size_t ( h ) * h;
+
+		subtract ( a11, lda, a21, lda, x, h, h );                   // S3 = A11 - A21
+		subtract ( b22, ldb, b12, ldb, y, h, h );                   // T3 = B22 - B12
+		winogradProduct ( x, h, y, h, c21, ldc, h, crossover, next ); // P7 = S3*T3
+		add ( a21, lda, a22, lda, x, h, h );                        // S1 = A21 + A22
+		subtract ( b12, ldb, b11, ldb, y, h, h );                   // T1 = B12 - B11
+		winogradProduct ( x, h, y, h, c22, ldc, h, crossover, next ); // P5 = S1*T1
+		subtract ( x, h, a11, lda, x, h, h );                       // S2 = S1 - A11
+		subtract ( b22, ldb, y, h, y, h, h );                       // T2 = B22 - T1
+		winogradProduct ( x, h, y, h, c12, ldc, h, crossover, next ); // P6 = S2*T2
+		subtract ( a12, lda, x, h, x, h, h );                       // S4 = A12 - S2
+		winogradProduct ( x, h, b22, ldb, c11, ldc, h, crossover, next ); // P3 = S4*B22
+		winogradProduct ( a11, lda, b11, ldb, x, h, h, crossover, next ); // P1 = A11*B11
+		add ( x, h, c12, ldc, c12, ldc, h );                        // U2 = P1 + P6
+		add ( c12, ldc, c21, ldc, c21, ldc, h );                    // U3 = U2 + P7
+		add ( c12, ldc, c22, ldc, c12, ldc, h );                    // U4 = U2 + P5
+		add ( c21, ldc, c22, ldc, c22, ldc, h );                    // C22 = U3 + P5
+		add ( c12, ldc, c11, ldc, c12, ldc, h );                    // C12 = U4 + P3
+		subtract ( y, h, b21, ldb, y, h, h );                       // T4 = T2 - B21
+		winogradProduct ( a22, lda, y, h, c11, ldc, h, crossover, next ); // P4 = A22*T4
+		subtract ( c21, ldc, c11, ldc, c21, ldc, h );               // C21 = U3 - P4
+		winogradProduct ( a12, lda, b21, ldb, c11, ldc, h, crossover, next ); // P2 = A12*B21
+		add ( x, h, c11, ldc, c11, ldc, h );                        // C11 = P1 + P2
+		}
+	}
+
+/**
+ * @brief Number of workspace elements required by strassenProduct
+ *
+ * @param size size of square matrices
+ * @param crossover largest size multiplied by blocked kernel
+ * @return std::size_t number of elements
+ */
+constexpr std::size_t strassenWorkspaceSize ( unsigned size, unsigned crossover = STRASSEN_CROSSOVER )
+	{
+	std::size_t elements = 0;
+
+	while ( size > crossover && size % 2 == 0 )
+		{
+		size /= 2;
+		elements += 2 * std::size_t ( size ) * size;
+		}
+
+	return elements;
+	}
+
+/**
+ * @brief Strassen-Winograd product of square matrices, output = first*second.
+ * Sizes are halved while they are even and above crossover, so the speedup
+ * is largest for sizes with power of two factor like 1024 or 1536.
+ * Sizes not above crossover are multiplied by blocked kernel only.
+ * See error bound at top of file.
+ *
+ * @tparam T floating point type of matrices
+ * @tparam SIZE size of matrices
+ * @param first first Matrix
+ * @param second second Matrix
+ * @param output Matrix result of multiplication, must not be first or second
+ * @param workspace buffer provided by caller
+ * @param workspace_size number of elements of workspace, at least strassenWorkspaceSize(SIZE, crossover)
+ * @param crossover largest size multiplied by blocked kernel
+ */
+template<typename T, unsigned SIZE>
+void strassenProduct ( const Matrix<T, SIZE, SIZE>& first,
+					   const Matrix<T, SIZE, SIZE>& second,
+					   Matrix<T, SIZE, SIZE>& output,
+					   T* workspace,
+					   std::size_t workspace_size,
+					   unsigned crossover = STRASSEN_CROSSOVER )
+	{
+	if ( &output == &first || &output == &second )
+		throw std::runtime_error ( "Output of Strassen product overlaps input" );
+
+	if ( workspace_size < strassenWorkspaceSize ( SIZE, crossover ) )
+		throw std::runtime_error ( "Strassen workspace too small" );
+
+	Strassen::winogradProduct ( *first.x, SIZE, *second.x, SIZE, *output.x, SIZE, SIZE, crossover, workspace );
+	}
+
+#endif // STRASSEN_HPP
@@ -0,0 +1,428 @@
+#ifndef STREAMIO_HPP
+#define STREAMIO_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <future>
+#include <utility>
+
+#include "BinaryIO.hpp"
+
+/*
+ * Streaming of binary containers (BinaryIO.hpp) larger than memory in chunks
+ * of fixed number of records. Reader prefetches next chunk by background task
+ * while current one is processed, writer writes full chunk by background task
+ * while next one is filled, so memory is bounded by two chunks and I/O
+ * is overlapped with compute. Checksum is updated by the same tasks.
+ * Chunks are rounded up to multiple of 8 records, so reader checksums whole
+ * words, records reserved by writer may split words between chunks.
+ */
+
+namespace StreamIO
+	{
+	// default number of records in chunk
+	const std::size_t CHUNK = 1 << 16;
+
+	/**
+	 * @brief Number of records in chunk rounded up to multiple of 8
+	 */
+	inline std::size_t chunkSize ( std::size_t chunk )
+		{
+		return chunk == 0 ? 8 : ( chunk + 7 ) / 8 * 8;
+		}
+	}
+
+/**
+ * @brief Sequential reader of binary container by chunks with prefetch
+ *
+ * @tparam E type of record, scalar, Vector or Matrix
+ */
+template<class E>
+class StreamReader
+	{
+	private:
+		BinaryIO::File file;
+		BinaryIO::Header h;
+		std::size_t chunk;
+		std::uint64_t remaining;
+		std::uint64_t hash;
+		std::vector<E> buffers[2];
+		unsigned current;
+		std::future<std::size_t> pending;
+
+	public:
+		/**
+		 * @brief Open binary container at path and start prefetch of first chunk.
+		 * Throw runtime_error when header does not match E.
+		 *
+		 * @param path path of file
+		 * @param chunk number of records in chunk
+		 */
+		explicit StreamReader ( const std::string& path, std::size_t chunk = StreamIO::CHUNK )
+			: file ( path, "rb" ), chunk ( StreamIO::chunkSize ( chunk ) ), hash ( BinaryIO::checksum ( nullptr, 0 ) ), current ( 0 )
+			{
+			BinaryIO::checkRecord<E>();
+			const std::uint64_t file_size = BinaryIO::fileSize ( file.file );
+			BinaryIO::seek ( file.file, 0 );
+
+			if ( std::fread ( &h, 1, sizeof ( BinaryIO::Header ), file.file ) != sizeof ( BinaryIO::Header ) )
+				throw std::runtime_error ( "Not a binary container" );
+
+			BinaryIO::validate<E> ( h, file_size );
+			BinaryIO::seek ( file.file, h.data_offset );
+			remaining = h.count;
+			buffers[0].resize ( this->chunk );
+			buffers[1].resize ( this->chunk );
+			prefetch();
+			}
+
+		StreamReader ( const StreamReader& ) = delete;
+		StreamReader& operator= ( const StreamReader& ) = delete;
+
+		~StreamReader()
+			{
+			if ( pending.valid() )
+				pending.wait();
+			}
+
+		/**
+		 * @brief Next chunk of records, valid until following call of next.
+		 * Throw runtime_error when file is shorter than its header says.
+		 *
+		 * @param it_beg pointer at first record of chunk
+		 * @param it_end pointer after last record of chunk
+		 * @return true while chunk is returned, false at end of container
+		 */
+		bool next ( const E*& it_beg, const E*& it_end )
+			{
+			if ( !pending.valid() )
+				return false;
+
+			const std::size_t count = pending.get();
+			current ^= 1;
+			prefetch();
+
+			it_beg = buffers[current].data();
+			it_end = it_beg + count;
+
+			return true;
+			}
+
+		/**
+		 * @brief Header of container
+		 *
+		 * @return const BinaryIO::Header&
+		 */
+		inline const BinaryIO::Header& header() const
+			{
+			return h;
+			}
+
+		/**
+		 * @brief Compare checksum of read records with checksum in header,
+		 * meaningful after all chunks are read
+		 *
+		 * @return true data are intact
+		 */
+		inline bool intact() const
+			{
+			return remaining == 0 && !pending.valid() && hash == h.checksum;
+			}
+
+	private:
+		// read chunk into buffer not used by caller
+		void prefetch()
+			{
+			if ( remaining == 0 )
+				return;
+
+			const std::size_t count = remaining < chunk ? std::size_t ( remaining ) : chunk;
+			E* buffer = buffers[current ^ 1].data();
+			remaining -= count;
+
+			pending = std::async ( std::launch::async, [this, buffer, count]()
+				{
+				if ( std::fread ( buffer, sizeof ( E ), count, file.file ) != count )
+					throw std::runtime_error ( "Binary container is truncated" );
+
+				hash = BinaryIO::checksum ( buffer, count * sizeof ( E ), hash );
+
+				return count;
+				} );
+			}
+	};
+
+/**
+ * @brief Sequential writer of binary container by chunks, full chunk is written
+ * by background task. Header is completed by close only, container which is not
+ * closed (error of input or of caller while writing) is removed on destruction,
+ * so partial output is never left as intact container.
+ *
+ * @tparam E type of record, scalar, Vector or Matrix
+ */
+template<class E>
+class StreamWriter
+	{
+	private:
+		std::string path;
+		BinaryIO::File file;
+		std::size_t chunk;
+		std::size_t filled;
+		std::uint64_t count;
+		BinaryIO::Hasher hasher;
+		std::vector<E> buffers[2];
+		unsigned current;
+		std::future<void> pending;
+
+	public:
+		/**
+		 * @brief Create binary container at path
+		 *
+		 * @param path path of file
+		 * @param chunk number of records in chunk
+		 */
+		explicit StreamWriter ( const std::string& path, std::size_t chunk = StreamIO::CHUNK )
+			: path ( path ), file ( path, "wb" ), chunk ( StreamIO::chunkSize ( chunk ) ), filled ( 0 ), count ( 0 ), current ( 0 )
+			{
+			BinaryIO::checkRecord<E>();
+			const BinaryIO::Header h = BinaryIO::header<E> ( 0, 0 );
+			const std::vector<char> padding ( h.data_offset - sizeof ( BinaryIO::Header ), 0 );
+
+			// header is written again by close
+			BinaryIO::write ( file.file, &h, sizeof ( BinaryIO::Header ) );
+			BinaryIO::write ( file.file, padding.data(), padding.size() );
+			buffers[0].resize ( this->chunk );
+			buffers[1].resize ( this->chunk );
+			}
+
+		StreamWriter ( const StreamWriter& ) = delete;
+		StreamWriter& operator= ( const StreamWriter& ) = delete;
+
+		/**
+		 * @brief Remove container when close was not called or failed
+		 */
+		~StreamWriter()
+			{
+			if ( file.file )
+				abandon();
+			}
+
+		/**
+		 * @brief Append record
+		 *
+		 * @param record
+		 */
+		inline void write ( const E& record )
+			{
+			buffers[current][filled++] = record;
+
+			if ( filled == chunk )
+				flush();
+			}
+
+		/**
+		 * @brief Append range of records
+		 *
+		 * @tparam Iterator Forward Iterator
+		 * @tparam ConstIterator Const Forward Iterator
+		 * @param it_beg iterator at first record
+		 * @param it_end iterator after last record
+		 */
+		template<typename Iterator, typename ConstIterator>
+		void write ( Iterator it_beg, ConstIterator it_end )
+			{
+			while ( it_beg != it_end )
+				{
+				E* it_buffer = buffers[current].data() + filled;
+				E* const it_buffer_end = buffers[current].data() + chunk;
+
+				// fill rest of chunk
+				while ( it_beg != it_end && it_buffer != it_buffer_end )
+					*it_buffer++ = *it_beg++;
+
+				filled = std::size_t ( it_buffer - buffers[current].data() );
+
+				if ( filled == chunk )
+					flush();
+				}
+			}
+
+		/**
+		 * @brief Space for size records in current chunk, filled by caller in place
+		 * and appended by commit, so output is not copied.
+		 * Throw runtime_error when size exceeds chunk.
+		 *
+		 * @param size number of records
+		 * @return E* pointer at first free record
+		 */
+		E* reserve ( std::size_t size )
+			{
+			if ( size > chunk )
+				throw std::runtime_error ( "Reserved records exceed chunk!" );
+
+			if ( filled + size > chunk )
+				flush();
+
+			return buffers[current].data() + filled;
+			}
+
+		/**
+		 * @brief Append size records filled in space returned by reserve
+		 *
+		 * @param size number of records
+		 */
+		inline void commit ( std::size_t size )
+			{
+			filled += size;
+
+			if ( filled == chunk )
+				flush();
+			}
+
+		/**
+		 * @brief Number of appended records
+		 *
+		 * @return std::uint64_t
+		 */
+		inline std::uint64_t size() const
+			{
+			return count + filled;
+			}
+
+		/**
+		 * @brief Write remaining records and header with number of records and checksum.
+		 * Throw runtime_error on failure.
+		 */
+		void close()
+			{
+			flush();
+			wait();
+
+			const BinaryIO::Header h = BinaryIO::header<E> ( count, hasher.value() );
+			BinaryIO::seek ( file.file, 0 );
+			BinaryIO::write ( file.file, &h, sizeof ( BinaryIO::Header ) );
+			file.close();
+			}
+
+	private:
+		// wait for background write and remove incomplete container, errors are lost
+		void abandon()
+			{
+			try
+				{
+				wait();
+				}
+			catch ( ... )
+				{
+				}
+
+			std::fclose ( file.file );
+			file.file = nullptr;
+			std::remove ( path.c_str() );
+			}
+
+		// wait for background write, rethrow its error
+		void wait()
+			{
+			if ( pending.valid() )
+				pending.get();
+			}
+
+		// write filled buffer by background task and continue in other one
+		void flush()
+			{
+			wait();
+
+			if ( filled == 0 )
+				return;
+
+			const E* buffer = buffers[current].data();
+			const std::size_t size = filled;
+			count += filled;
+			filled = 0;
+			current ^= 1;
+
+			pending = std::async ( std::launch::async, [this, buffer, size]()
+				{
+				hasher.update ( buffer, size * sizeof ( E ) );
+				BinaryIO::write ( file.file, buffer, size * sizeof ( E ) );
+				} );
+			}
+	};
+
+/**
+ * @brief Call function on each chunk of records of binary container,
+ * next chunk is read while function runs
+ *
+ * @tparam E type of record, scalar, Vector or Matrix
+ * @tparam F function void ( const E* it_beg, const E* it_end )
+ * @param path path of file
+ * @param function called on chunks in order
+ * @param chunk number of records in chunk
+ * @return std::uint64_t number of records
+ */
+template<class E, class F>
+std::uint64_t forEachChunk ( const std::string& path, F&& function, std::size_t chunk = StreamIO::CHUNK )
+	{
+	StreamReader<E> reader ( path, chunk );
+	const E* it_beg;
+	const E* it_end;
+	std::uint64_t count = 0;
+
+	while ( reader.next ( it_beg, it_end ) )
+		{
+		function ( it_beg, it_end );
+		count += std::uint64_t ( it_end - it_beg );
+		}
+
+	return count;
+	}
+
+/**
+ * @brief Transform binary container of records E into binary container
+ * of records R chunk by chunk, as batch functions over ranges do.
+ * Reading, transformation and writing overlap, memory is bounded by chunks.
+ * Throw runtime_error when input is damaged or on failure of I/O or of function,
+ * output container is removed then.
+ *
+ * @tparam E type of input record
+ * @tparam R type of output record
+ * @tparam F function void ( const E* it_beg, const E* it_end, R* out_beg )
+ * @param input_path path of input file
+ * @param output_path path of output file
+ * @param function called on chunks in order
+ * @param chunk number of records in chunk
+ * @return std::uint64_t number of records
+ */
+template<class E, class R = E, class F>
+std::uint64_t transformStream ( const std::string& input_path,
+								const std::string& output_path,
+								F&& function,
+								std::size_t chunk = StreamIO::CHUNK )
+	{
+	StreamReader<E> reader ( input_path, chunk );
+	StreamWriter<R> writer ( output_path, chunk );
+	const E* it_beg;
+	const E* it_end;
+
+	// output is written in place to chunk of writer
+	while ( reader.next ( it_beg, it_end ) )
+		{
+		const std::size_t size = std::size_t ( it_end - it_beg );
+		function ( it_beg, it_end, writer.reserve ( size ) );
+		writer.commit ( size );
+		}
+
+	if ( !reader.intact() )
+		throw std::runtime_error ( "Checksum of binary container differs" );
+
+	writer.close();
+
+	return writer.size();
+	}
+
+#endif // STREAMIO_HPP
@@ -0,0 +1,513 @@
+#ifndef SYMMETRICEIGEN_HPP
+#define SYMMETRICEIGEN_HPP
+
+#include <type_traits>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+
+/*
+ * Eigen decomposition of symmetric 3x3 Matrix A = transpose(V)*diag(values)*V.
+ * Eigenvalues are sorted ascending, row i of V is unit eigenvector of values(i)
+ * and rows of V form right handed orthonormal basis, so V is rotation Matrix.
+ * Only upper triangle of A is read.
+ */
+
+/**
+ * @brief Eigen decomposition of symmetric 3x3 Matrix by cyclic Jacobi rotations
+ * Slower than symmetricEigen, but accurate for any eigenvalue spacing.
+ *
+ * @tparam T floating point type
+ * @param m symmetric Matrix
+ * @param values ascending eigenvalues
+ * @param vectors eigenvectors in rows
+ * @param max_sweeps maximal number of sweeps over off-diagonal elements
+ * @return unsigned number of executed sweeps
+ */
+template<typename T>
+unsigned symmetricEigenJacobi ( const Matrix<T, 3, 3>& m,
+								Vector<T, 3>& values,
+								Matrix<T, 3, 3>& vectors,
+								unsigned max_sweeps = 16 )
+	{
+	static_assert ( std::is_floating_point<T>::value, "Eigen decomposition requires floating point type." );
+
+	// symmetric working copy, a[i][j] for i < j is read
+	T a[3][3] = { { m.x[0][0], m.x[0][1], m.x[0][2] },
+				  { m.x[0][1], m.x[1][1], m.x[1][2] },
+				  { m.x[0][2], m.x[1][2], m.x[2][2] } };
+	T v[3][3] = { { T ( 1 ), T ( 0 ), T ( 0 ) },
+				  { T ( 0 ), T ( 1 ), T ( 0 ) },
+				  { T ( 0 ), T ( 0 ), T ( 1 ) } };
+	const T diagonal2 = a[0][0]*a[0][0] + a[1][1]*a[1][1] + a[2][2]*a[2][2];
+	const T off2 = a[0][1]*a[0][1] + a[0][2]*a[0][2] + a[1][2]*a[1][2];
+	const T tolerance2 = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon() * ( diagonal2 + T ( 2 ) * off2 );
+	unsigned sweep = 0;
+
+	for ( ; sweep < max_sweeps; ++sweep )
+		{
+		if ( a[0][1]*a[0][1] + a[0][2]*a[0][2] + a[1][2]*a[1][2] <= tolerance2 )
+			break;
+
+		for ( unsigned p = 0; p < 2; ++p )
+			for ( unsigned q = p+1; q < 3; ++q )
+				{
+				const T a_pq = a[p][q];
+
+				if ( a_pq == T ( 0 ) )
+					continue;
+
+				const unsigned r = 3 - p - q;
+				const T theta = ( a[q][q] - a[p][p] ) / ( T ( 2 ) * a_pq );
+				const T t = std::copysign ( T ( 1 ), theta ) / ( std::abs ( theta ) + std::sqrt ( theta*theta + T ( 1 ) ) );
+				const T c = T ( 1 ) / std::sqrt ( t*t + T ( 1 ) );
+				const T s = t * c;
+				const T a_rp = a[std::min ( r, p )][std::max ( r, p )];
+				const T a_rq = a[std::min ( r, q )][std::max ( r, q )];
+
+				a[p][p] -= t * a_pq;
+				a[q][q] += t * a_pq;
+				a[p][q] = a[q][p] = T ( 0 );
+				a[std::min ( r, p )][std::max ( r, p )] = c*a_rp - s*a_rq;
+				a[std::min ( r, q )][std::max ( r, q )] = s*a_rp + c*a_rq;
+
+				for ( unsigned k = 0; k < 3; ++k )
+					{
+					const T v_p = v[p][k];
+					const T v_q = v[q][k];
+
+					v[p][k] = c*v_p - s*v_q;
+					v[q][k] = s*v_p + c*v_q;
+					}
+				}
+		}
+
+	// sort ascending, swap of two rows changes orientation, so one of them is negated
+	unsigned order[3] = { 0, 1, 2 };
+	T sign = T ( 1 );
+
+	for ( unsigned i = 0; i < 2; ++i )
+		for ( unsigned j = 0; j < 2 - i; ++j )
+			if ( a[order[j+1]][order[j+1]] < a[order[j]][order[j]] )
+				{
+				std::swap ( order[j], order[j+1] );
+				sign = -sign;
+				}
+
+	for ( unsigned i = 0; i < 3; ++i )
+		{
+		values.x[i] = a[order[i]][order[i]];
+
+		for ( unsigned k = 0; k < 3; ++k )
+			vectors.x[i][k] = v[order[i]][k];
+		}
+
+	if ( sign < T ( 0 ) )
+		Container::rangeElemetsValueOperationAssign<Multiply> ( vectors.begin ( 0 ), vectors.end ( 0 ), T ( -1 ) );
+
+	return sweep;
+	}
+
+/**
+ * @brief Unit Vectors u, v orthogonal to unit Vector w, with w x u = v
+ */
+template<typename T>
+inline void orthogonalComplement ( const Vector<T, 3>& w, Vector<T, 3>& u, Vector<T, 3>& v )
+	{
+	if ( std::abs ( w.x[0] ) > std::abs ( w.x[1] ) )
+		{
+		const T inverse_length = T ( 1 ) / std::sqrt ( w.x[0]*w.x[0] + w.x[2]*w.x[2] );
+
+		u = Vector<T, 3> { -w.x[2] * inverse_length, T ( 0 ), w.x[0] * inverse_length };
+		}
+	else
+		{
+		const T inverse_length = T ( 1 ) / std::sqrt ( w.x[1]*w.x[1] + w.x[2]*w.x[2] );
+
+		u = Vector<T, 3> { T ( 0 ), w.x[2] * inverse_length, -w.x[1] * inverse_length };
+		}
+
+	crossProduct ( w, u, v );
+	}
+
+/**
+ * @brief Eigenvector of simple eigenvalue, the longest cross product
+ * of rows of A - value*I
+ */
+template<typename T>
+inline void simpleEigenvector ( const T ( &a ) [3][3], T value, Vector<T, 3>& out )
+	{
+	const Vector<T, 3> row0 { a[0][0] - value, a[0][1], a[0][2] };
+	const Vector<T, 3> row1 { a[0][1], a[1][1] - value, a[1][2] };
+	const Vector<T, 3> row2 { a[0][2], a[1][2], a[2][2] - value };
+	Vector<T, 3> cross[3];
+
+	crossProduct ( row0, row1, cross[0] );
+	crossProduct ( row0, row2, cross[1] );
+	crossProduct ( row1, row2, cross[2] );
+
+	const T d[3] = { cross[0].dot ( cross[0] ), cross[1].dot ( cross[1] ), cross[2].dot ( cross[2] ) };
+	const unsigned i_max = d[0] >= d[1] ? ( d[0] >= d[2] ? 0 : 2 ) : ( d[1] >= d[2] ? 1 : 2 );
+
+	if ( d[i_max] > T ( 0 ) )
+		out = cross[i_max] * ( T ( 1 ) / std::sqrt ( d[i_max] ) );
+	else
+		out = Vector<T, 3> { T ( 1 ), T ( 0 ), T ( 0 ) };
+	}
+
+/**
+ * @brief Eigenvector of value orthogonal to eigenvector w,
+ * computed from 2x2 restriction of A - value*I to complement of w
+ */
+template<typename T>
+inline void orthogonalEigenvector ( const T ( &a ) [3][3], const Vector<T, 3>& w, T value, Vector<T, 3>& out )
+	{
+	Vector<T, 3> u;
+	Vector<T, 3> v;
+
+	orthogonalComplement ( w, u, v );
+
+	const Vector<T, 3> au { a[0][0]*u.x[0] + a[0][1]*u.x[1] + a[0][2]*u.x[2],
+							a[0][1]*u.x[0] + a[1][1]*u.x[1] + a[1][2]*u.x[2],
+							a[0][2]*u.x[0] + a[1][2]*u.x[1] + a[2][2]*u.x[2] };
+	const Vector<T, 3> av { a[0][0]*v.x[0] + a[0][1]*v.x[1] + a[0][2]*v.x[2],
+							a[0][1]*v.x[0] + a[1][1]*v.x[1] + a[1][2]*v.x[2],
+							a[0][2]*v.x[0] + a[1][2]*v.x[1] + a[2][2]*v.x[2] };
+	T m00 = u.dot ( au ) - value;
+	T m01 = u.dot ( av );
+	T m11 = v.dot ( av ) - value;
+	const T abs_m00 = std::abs ( m00 );
+	const T abs_m01 = std::abs ( m01 );
+	const T abs_m11 = std::abs ( m11 );
+
+	// null vector of [m00 m01; m01 m11] from its larger row
+	if ( abs_m00 >= abs_m11 )
+		{
+		if ( std::max ( abs_m00, abs_m01 ) > T ( 0 ) )
+			{
+			if ( abs_m00 >= abs_m01 )
+				{
+				m01 /= m00;
+				m00 = T ( 1 ) / std::sqrt ( T ( 1 ) + m01*m01 );
+				m01 *= m00;
+				}
+			else
+				{
+				m00 /= m01;
+				m01 = T ( 1 ) / std::sqrt ( T ( 1 ) + m00*m00 );
+				m00 *= m01;
+				}
+
+			out = u*m01 - v*m00;
+			}
+		else
+			out = u;
+		}
+	else
+		{
+		if ( std::max ( abs_m11, abs_m01 ) > T ( 0 ) )
+			{
+			if ( abs_m11 >= abs_m01 )
+				{
+				m01 /= m11;
+				m11 = T ( 1 ) / std::sqrt ( T ( 1 ) + m01*m01 );
+				m01 *= m11;
+				}
+			else
+				{
+				m11 /= m01;
+				m01 = T ( 1 ) / std::sqrt ( T ( 1 ) + m11*m11 );
+				m11 *= m01;
+				}
+
+			out = u*m11 - v*m01;
+			}
+		else
+			out = u;
+		}
+	}
+
+/**
+ * @brief Eigen decomposition of symmetric 3x3 Matrix.
+ * Eigenvalues are computed in closed form from characteristic polynomial
+ * of scaled Matrix, eigenvector of simple eigenvalue from cross products
+ * of rows of A - value*I, second one in its orthogonal complement
+ * and third one as cross product of them.
+ * When residual of closed form result is larger than 64*eps*max|A|,
+ * which happens for nearly multiple eigenvalues, symmetricEigenJacobi is used.
+ *
+ * @tparam T floating point type
+ * @param m symmetric Matrix
+ * @param values ascending eigenvalues
+ * @param vectors eigenvectors in rows
+ */
+template<typename T>
+void symmetricEigen ( const Matrix<T, 3, 3>& m, Vector<T, 3>& values, Matrix<T, 3, 3>& vectors )
+	{
+	static_assert ( std::is_floating_point<T>::value, "Eigen decomposition requires floating point type." );
+
+	const T max_abs = std::max ( { std::abs ( m.x[0][0] ), std::abs ( m.x[0][1] ), std::abs ( m.x[0][2] ),
+								   std::abs ( m.x[1][1] ), std::abs ( m.x[1][2] ), std::abs ( m.x[2][2] ) } );
+
+	if ( ! ( max_abs > T ( 0 ) ) || ! std::isfinite ( max_abs ) )
+		{
+		symmetricEigenJacobi ( m, values, vectors );
+		return;
+		}
+
+	// scaled Matrix does not overflow in characteristic polynomial
+	const T inverse_max = T ( 1 ) / max_abs;
+	const T a[3][3] = { { m.x[0][0] * inverse_max, m.x[0][1] * inverse_max, m.x[0][2] * inverse_max },
+						{ m.x[0][1] * inverse_max, m.x[1][1] * inverse_max, m.x[1][2] * inverse_max },
+						{ m.x[0][2] * inverse_max, m.x[1][2] * inverse_max, m.x[2][2] * inverse_max } };
+	const T off2 = a[0][1]*a[0][1] + a[0][2]*a[0][2] + a[1][2]*a[1][2];
+
+	if ( off2 == T ( 0 ) )
+		{
+		symmetricEigenJacobi ( m, values, vectors );
+		return;
+		}
+
+	const T q = ( a[0][0] + a[1][1] + a[2][2] ) / T ( 3 );
+	const T b00 = a[0][0] - q;
+	const T b11 = a[1][1] - q;
+	const T b22 = a[2][2] - q;
+	const T p = std::sqrt ( ( b00*b00 + b11*b11 + b22*b22 + T ( 2 ) * off2 ) / T ( 6 ) );
+	const T c00 = b11*b22 - a[1][2]*a[1][2];
+	const T c01 = a[0][1]*b22 - a[1][2]*a[0][2];
+	const T c02 = a[0][1]*a[1][2] - b11*a[0][2];
+	const T half_det = std::min ( std::max ( ( b00*c00 - a[0][1]*c01 + a[0][2]*c02 ) / ( T ( 2 )*p*p*p ), T ( -1 ) ), T ( 1 ) );
+	const T angle = std::acos ( half_det ) / T ( 3 );
+	const T beta2 = T ( 2 ) * std::cos ( angle );
+	const T beta0 = T ( 2 ) * std::cos ( angle + T ( 2.09439510239319549 ) );
+	const T beta1 = -( beta0 + beta2 );
+	Vector<T, 3> e[3];
+
+	values = Vector<T, 3> { q + p*beta0, q + p*beta1, q + p*beta2 };
+
+	// eigenvector of simple eigenvalue first, it is the farther one from middle one
+	if ( half_det >= T ( 0 ) )
+		{
+		simpleEigenvector ( a, values.x[2], e[2] );
+		orthogonalEigenvector ( a, e[2], values.x[1], e[1] );
+		crossProduct ( e[1], e[2], e[0] );
+		}
+	else
+		{
+		simpleEigenvector ( a, values.x[0], e[0] );
+		orthogonalEigenvector ( a, e[0], values.x[1], e[1] );
+		crossProduct ( e[0], e[1], e[2] );
+		}
+
+	// residual of scaled Matrix
+	const T tolerance = T ( 64 ) * std::numeric_limits<T>::epsilon();
+
+	for ( unsigned i = 0; i < 3; ++i )
+		{
+		const Vector<T, 3>& v = e[i];
+		const T r0 = a[0][0]*v.x[0] + a[0][1]*v.x[1] + a[0][2]*v.x[2] - values.x[i]*v.x[0];
+		const T r1 = a[0][1]*v.x[0] + a[1][1]*v.x[1] + a[1][2]*v.x[2] - values.x[i]*v.x[1];
+		const T r2 = a[0][2]*v.x[0] + a[1][2]*v.x[1] + a[2][2]*v.x[2] - values.x[i]*v.x[2];
+
+		if ( ! ( std::max ( { std::abs ( r0 ), std::abs ( r1 ), std::abs ( r2 ) } ) <= tolerance ) )
+			{
+			symmetricEigenJacobi ( m, values, vectors );
+			return;
+			}
+		}
+
+	values *= max_abs;
+
+	for ( unsigned i = 0; i < 3; ++i )
+		Container::copy ( vectors.begin ( i ), vectors.end ( i ), e[i].begin() );
+	}
+
+/**
+ * @brief Jacobi rotation annihilating element (P, Q) of LANES symmetric 3x3 matrices
+ * scaled to largest element 1 and stored as structure of arrays. Loop over lanes is branch free, it is vectorized
+ * when sqrt does not set errno (-fno-math-errno, included in -ffast-math).
+ *
+ * @tparam T floating point type
+ * @tparam LANES number of matrices
+ * @tparam P row of annihilated element
+ * @tparam Q col of annihilated element
+ * @param a diagonal elements a[0..2] and off-diagonal elements (0, 1), (0, 2), (1, 2) in a[3..5]
+ * @param v rows of accumulated rotations, element (i, k) in v[i*3 + k]
+ */
+template<typename T, unsigned LANES, unsigned P, unsigned Q>
+inline void jacobiRotationLanes ( T ( &a ) [6][LANES], T ( &v ) [9][LANES] )
+	{
+	// off-diagonal element (i, j) is stored in a[2 + i + j]
+	const unsigned R = 3 - P - Q;
+	const unsigned PQ = 2 + P + Q;
+	const unsigned RP = 2 + R + P;
+	const unsigned RQ = 2 + R + Q;
+	// off-diagonal elements negligible against Matrix scaled to 1 are flushed to zero,
+	// otherwise converged elements underflow to denormals and arithmetic becomes very slow
+	const T tiny = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+
+	for ( unsigned l = 0; l < LANES; ++l )
+		{
+		// t = tan of rotation angle, smaller root of t^2 + 2*t*d/(2*a_pq) - 1 = 0,
+		// written without division by a_pq, smallest normal number keeps t = 0 for zero Matrix
+		const T a_pq = a[PQ][l];
+		const T d = a[Q][l] - a[P][l];
+		const T t = std::copysign ( T ( 2 ), d ) * a_pq /
+					( std::abs ( d ) + std::sqrt ( d*d + T ( 4 ) * a_pq*a_pq ) + std::numeric_limits<T>::min() );
+		const T c = T ( 1 ) / std::sqrt ( t*t + T ( 1 ) );
+		const T s = t * c;
+		const T a_rp = a[RP][l];
+		const T a_rq = a[RQ][l];
+
+		a[P][l] -= t * a_pq;
+		a[Q][l] += t * a_pq;
+		a[PQ][l] = T ( 0 );
+		const T a_rp_new = c*a_rp - s*a_rq;
+		const T a_rq_new = s*a_rp + c*a_rq;
+
+		a[RP][l] = std::abs ( a_rp_new ) < tiny ? T ( 0 ) : a_rp_new;
+		a[RQ][l] = std::abs ( a_rq_new ) < tiny ? T ( 0 ) : a_rq_new;
+
+		for ( unsigned k = 0; k < 3; ++k )
+			{
+			const T v_p = v[P*3 + k][l];
+			const T v_q = v[Q*3 + k][l];
+
+			v[P*3 + k][l] = c*v_p - s*v_q;
+			v[Q*3 + k][l] = s*v_p + c*v_q;
+			}
+		}
+	}
+
+/**
+ * @brief Eigen decompositions of range of symmetric 3x3 matrices.
+ * Matrices are processed in groups of 32, transposed to structure of arrays,
+ * so fixed number of branch free Jacobi sweeps is vectorized over matrices.
+ * Containers pointered by values_beg and vectors_beg must be the same size
+ * as container pointered by it_beg.
+ *
+ * @tparam Iterator Forward Iterator to Matrix<T, 3, 3>
+ * @tparam ConstIterator Const Forward Iterator to Matrix<T, 3, 3>
+ * @tparam Iterator2 Forward Iterator to Vector<T, 3>
+ * @tparam Iterator3 Forward Iterator to Matrix<T, 3, 3>
+ * @param it_beg iterator at beginning of range of matrices
+ * @param it_end iterator after end of range of matrices
+ * @param values_beg iterator at beginning of range of ascending eigenvalues
+ * @param vectors_beg iterator at beginning of range of eigenvectors in rows
+ */
+template<typename Iterator,
+		 typename ConstIterator,
+		 typename Iterator2,
+		 typename Iterator3>
+void symmetricEigenBatch ( Iterator it_beg, ConstIterator it_end, Iterator2 values_beg, Iterator3 vectors_beg )
+	{
+	using T = std::remove_cv_t<std::remove_reference_t<decltype ( it_beg->x[0][0] )>>;
+	static_assert ( std::is_floating_point<T>::value, "Eigen decomposition requires floating point type." );
+
+	static const unsigned LANES = 32;
+	// quadratic convergence, after 4 (float) or 5 (double) sweeps off-diagonal elements are below rounding
+	static const unsigned SWEEPS = sizeof ( T ) <= 4 ? 4 : 5;
+
+	while ( it_beg != it_end )
+		{
+		// a[0..2] diagonal, a[3 + pair] off-diagonal element of pair, v[row*3 + col]
+		T a[6][LANES];
+		T v[9][LANES];
+		unsigned count = 0;
+
+		for ( ; count < LANES && it_beg != it_end; ++count, ++it_beg )
+			{
+			const Matrix<T, 3, 3>& m = *it_beg;
+
+			a[0][count] = m.x[0][0];
+			a[1][count] = m.x[1][1];
+			a[2][count] = m.x[2][2];
+			a[3][count] = m.x[0][1];
+			a[4][count] = m.x[0][2];
+			a[5][count] = m.x[1][2];
+			}
+
+		// unused lanes get identity
+		for ( unsigned l = count; l < LANES; ++l )
+			{
+			a[0][l] = a[1][l] = a[2][l] = T ( 1 );
+			a[3][l] = a[4][l] = a[5][l] = T ( 0 );
+			}
+
+		// scaling by largest element, squares in rotations do not overflow
+		T scale[LANES];
+
+		for ( unsigned l = 0; l < LANES; ++l )
+			{
+			T max_abs = std::abs ( a[0][l] );
+
+			for ( unsigned k = 1; k < 6; ++k )
+				max_abs = std::max ( max_abs, std::abs ( a[k][l] ) );
+
+			scale[l] = max_abs > T ( 0 ) ? max_abs : T ( 1 );
+
+			const T inverse_scale = T ( 1 ) / scale[l];
+
+			for ( unsigned k = 0; k < 6; ++k )
+				a[k][l] *= inverse_scale;
+			}
+
+		for ( unsigned k = 0; k < 9; ++k )
+			for ( unsigned l = 0; l < LANES; ++l )
+				v[k][l] = k % 4 == 0 ? T ( 1 ) : T ( 0 );
+
+		for ( unsigned sweep = 0; sweep < SWEEPS; ++sweep )
+			{
+			jacobiRotationLanes<T, LANES, 0, 1> ( a, v );
+			jacobiRotationLanes<T, LANES, 0, 2> ( a, v );
+			jacobiRotationLanes<T, LANES, 1, 2> ( a, v );
+			}
+
+		// sorting network, swap of two rows negates one of them to keep orientation
+		for ( unsigned pair = 0; pair < 3; ++pair )
+			{
+			const unsigned i = pair == 1 ? 1 : 0;
+			const unsigned j = i + 1;
+
+			for ( unsigned l = 0; l < LANES; ++l )
+				{
+				const bool swap = a[j][l] < a[i][l];
+				const T a_i = a[i][l];
+				const T a_j = a[j][l];
+
+				a[i][l] = swap ? a_j : a_i;
+				a[j][l] = swap ? a_i : a_j;
+
+				for ( unsigned k = 0; k < 3; ++k )
+					{
+					const T v_i = v[i*3 + k][l];
+					const T v_j = v[j*3 + k][l];
+
+					v[i*3 + k][l] = swap ? -v_j : v_i;
+					v[j*3 + k][l] = swap ? v_i : v_j;
+					}
+				}
+			}
+
+		for ( unsigned l = 0; l < count; ++l )
+			{
+			Vector<T, 3>& values = *values_beg++;
+			Matrix<T, 3, 3>& vectors = *vectors_beg++;
+
+			for ( unsigned i = 0; i < 3; ++i )
+				{
+				values.x[i] = a[i][l] * scale[l];
+
+				for ( unsigned k = 0; k < 3; ++k )
+					vectors.x[i][k] = v[i*3 + k][l];
+				}
+			}
+		}
+	}
+
+#endif // SYMMETRICEIGEN_HPP
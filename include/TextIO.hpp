@@ -0,0 +1,920 @@
+#ifndef TEXTIO_HPP
+#define TEXTIO_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// std::to_chars of floating point is signalled by __cpp_lib_to_chars,
+// some standard libraries provide it also before C++17
+#if defined ( __has_include )
+#if __has_include ( <charconv> )
+#include <charconv>
+#endif
+#endif
+
+#include "Utility.hpp"
+
+/*
+ * Text formatting of elements, Vector and Matrix records directly into caller
+ * buffer, without iostream state and locale. Floating point numbers are written
+ * by std::to_chars when standard library provides it, otherwise by snprintf
+ * with search of fewest digits. Default precision is shortest text read back
+ * to the same value.
+ *
+ * Records are rows of elements separated by delimiter of mode, Matrix
+ * records are rows of Matrix separated by new lines or, as lines of
+ * batch text (writeText), single row of elements in row major order.
+ *
+ * Parsing reads numbers by std::from_chars or strtod family in the same way
+ * and accepts text of any mode. Errors are reported by ParseError with line
+ * and column of malformed text. Batch text is parsed in parts by threads.
+ */
+
+namespace TextIO
+	{
+	// precision of shortest text read back to the same value
+	const int SHORTEST = -1;
+
+	// size of buffer of Writer
+	const std::size_t BUFFER = 1 << 16;
+
+	/**
+	 * @brief Delimiter of elements, PLAIN uses space
+	 */
+	enum Mode : std::uint8_t
+		{
+		PLAIN, CSV, TSV
+		};
+
+	/**
+	 * @brief Format of elements, precision is number of significant digits
+	 * or SHORTEST
+	 */
+	struct Format
+		{
+		Mode mode;
+		int precision;
+
+		Format ( Mode mode = PLAIN, int precision = SHORTEST )
+			: mode ( mode ), precision ( precision )
+			{
+			}
+		};
+
+	/**
+	 * @brief Delimiter of elements in mode
+	 */
+	inline char delimiter ( Mode mode )
+		{
+		return mode == CSV ? ',' : mode == TSV ? '\t' : ' ';
+		}
+
+	/**
+	 * @brief Upper bound of number of characters of element written with precision
+	 *
+	 * @tparam T type of element
+	 * @param precision number of significant digits or SHORTEST
+	 * @return std::size_t
+	 */
+	template<typename T, std::enable_if_t<std::is_floating_point<T>::value, int> = 0>
+	inline std::size_t maxChars ( int precision )
+		{
+		const int digits = std::max ( precision, int ( std::numeric_limits<T>::max_digits10 ) );
+
+		// sign, leading zeros of fixed format or exponent
+		return std::size_t ( digits ) + 10;
+		}
+
+	template<typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+	inline std::size_t maxChars ( int )
+		{
+		return std::size_t ( std::numeric_limits<T>::digits10 ) + 3;
+		}
+
+	template<typename T, std::enable_if_t<!std::is_arithmetic<T>::value, int> = 0>
+	inline std::size_t maxChars ( int precision )
+		{
+		return maxChars<float> ( precision );
+		}
+
+	/**
+	 * @brief Parse number of null terminated text by strtod family
+	 */
+	inline float parseNumber ( const char* text, char** it_end, float )
+		{
+		return std::strtof ( text, it_end );
+		}
+
+	inline double parseNumber ( const char* text, char** it_end, double )
+		{
+		return std::strtod ( text, it_end );
+		}
+
+	inline long double parseNumber ( const char* text, char** it_end, long double )
+		{
+		return std::strtold ( text, it_end );
+		}
+
+	/**
+	 * @brief Write floating point value into [first, last)
+	 *
+	 * @param first pointer at first character
+	 * @param last pointer after last character
+	 * @param value
+	 * @param precision number of significant digits or SHORTEST
+	 * @return char* pointer after written text, nullptr when text does not fit
+	 */
+	template<typename T, std::enable_if_t<std::is_floating_point<T>::value, int> = 0>
+	inline char* formatValue ( char* first, char* last, T value, int precision = SHORTEST )
+		{
+#if defined ( __cpp_lib_to_chars )
+		const std::to_chars_result result = precision < 0 ?
+											std::to_chars ( first, last, value ) :
+											std::to_chars ( first, last, value, std::chars_format::general, precision );
+
+		return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+		char text[64];
+		const char* pattern = std::is_same<T, long double>::value ? "%.*Lg" : "%.*g";
+		int size;
+
+		if ( precision >= 0 )
+			size = std::snprintf ( text, sizeof ( text ), pattern, std::min ( std::max ( precision, 1 ), 40 ), value );
+		else
+			{
+			// fewest digits read back to the same value
+			for ( int digits = std::numeric_limits<T>::digits10; ; ++digits )
+				{
+				size = std::snprintf ( text, sizeof ( text ), pattern, digits, value );
+
+				if ( digits >= std::numeric_limits<T>::max_digits10 || parseNumber ( text, nullptr, value ) == value )
+					break;
+				}
+			}
+
+		if ( size < 0 || std::size_t ( size ) > std::size_t ( last - first ) )
+			return nullptr;
+
+		std::memcpy ( first, text, std::size_t ( size ) );
+
+		return first + size;
+#endif
+		}
+
+	/**
+	 * @brief Write integer value into [first, last), precision is ignored
+	 *
+	 * @return char* pointer after written text, nullptr when text does not fit
+	 */
+	template<typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+	inline char* formatValue ( char* first, char* last, T value, int = SHORTEST )
+		{
+		const bool negative = value < T ( 0 );
+		std::uint64_t magnitude = negative ? std::uint64_t ( 0 ) - std::uint64_t ( value ) : std::uint64_t ( value );
+		char digits[20];
+		char* it = digits + 20;
+
+		do
+			{
+			*--it = char ( '0' + magnitude % 10 );
+			magnitude /= 10;
+			}
+		while ( magnitude != 0 );
+
+		if ( std::size_t ( digits + 20 - it ) + ( negative ? 1 : 0 ) > std::size_t ( last - first ) )
+			return nullptr;
+
+		if ( negative )
+			*first++ = '-';
+
+		return std::copy ( it, digits + 20, first );
+		}
+
+	/**
+	 * @brief Write element convertible to float, as Half, into [first, last)
+	 *
+	 * @return char* pointer after written text, nullptr when text does not fit
+	 */
+	template<typename T, std::enable_if_t<!std::is_arithmetic<T>::value, int> = 0>
+	inline char* formatValue ( char* first, char* last, const T& value, int precision = SHORTEST )
+		{
+		return formatValue ( first, last, static_cast<float> ( value ), precision );
+		}
+
+	/**
+	 * @brief Write range of elements separated by delimiter into [first, last)
+	 *
+	 * @tparam Iterator Forward Iterator
+	 * @tparam ConstIterator Const Forward Iterator
+	 * @param first pointer at first character
+	 * @param last pointer after last character
+	 * @param it_beg iterator at first element
+	 * @param it_end iterator after last element
+	 * @param format
+	 * @return char* pointer after written text, nullptr when text does not fit
+	 */
+	template<typename Iterator, typename ConstIterator>
+	char* formatRow ( char* first, char* last, Iterator it_beg, ConstIterator it_end, const Format& format = Format() )
+		{
+		const char separator = delimiter ( format.mode );
+
+		if ( it_beg == it_end )
+			return first;
+
+		first = formatValue ( first, last, *it_beg++, format.precision );
+
+		while ( first != nullptr && it_beg != it_end )
+			{
+			if ( first == last )
+				return nullptr;
+
+			*first++ = separator;
+			first = formatValue ( first, last, *it_beg++, format.precision );
+			}
+
+		return first;
+		}
+
+	/**
+	 * @brief Record as row of elements, Matrix in row major order
+	 */
+	template<typename T>
+	struct Row
+		{
+		using type = T;
+		static const unsigned size = 1;
+
+		static inline const T* begin ( const T& record )
+			{
+			return &record;
+			}
+
+		static inline T* begin ( T& record )
+			{
+			return &record;
+			}
+		};
+
+	template<typename T, unsigned SIZE>
+	struct Row<Vector<T, SIZE>>
+		{
+		using type = T;
+		static const unsigned size = SIZE;
+
+		static inline const T* begin ( const Vector<T, SIZE>& record )
+			{
+			return record.x;
+			}
+
+		static inline T* begin ( Vector<T, SIZE>& record )
+			{
+			return record.x;
+			}
+		};
+
+	template<typename T, unsigned ROWS, unsigned COLS>
+	struct Row<Matrix<T, ROWS, COLS>>
+		{
+		using type = T;
+		static const unsigned size = ROWS * COLS;
+
+		static inline const T* begin ( const Matrix<T, ROWS, COLS>& record )
+			{
+			return &record.x[0][0];
+			}
+
+		static inline T* begin ( Matrix<T, ROWS, COLS>& record )
+			{
+			return &record.x[0][0];
+			}
+		};
+
+	/**
+	 * @brief Buffered writer of text to std::ostream, numbers are formatted
+	 * in place in buffer, which is passed to stream by single write when full.
+	 * Buffer is owned or given by caller, e.g. on stack of short output.
+	 */
+	class Writer
+		{
+		private:
+			std::ostream& out;
+			std::vector<char> storage;
+			char* first;
+			char* last;
+			char* it;
+
+		public:
+			/**
+			 * @brief Writer to stream with own buffer
+			 *
+			 * @param out output stream
+			 * @param size size of buffer
+			 */
+			explicit Writer ( std::ostream& out, std::size_t size = BUFFER )
+				: out ( out ), storage ( std::max<std::size_t> ( size, 64 ) ),
+				  first ( storage.data() ), last ( storage.data() + storage.size() ), it ( first )
+				{
+				}
+
+			/**
+			 * @brief Writer to stream with buffer [first, last) of caller,
+			 * own buffer is allocated only for text longer than it
+			 *
+			 * @param out output stream
+			 * @param first pointer at first character of buffer
+			 * @param last pointer after last character of buffer
+			 */
+			Writer ( std::ostream& out, char* first, char* last )
+				: out ( out ), first ( first ), last ( last ), it ( first )
+				{
+				}
+
+			Writer ( const Writer& ) = delete;
+			Writer& operator= ( const Writer& ) = delete;
+
+			/**
+			 * @brief Flush buffer, errors are lost, call flush to catch them
+			 */
+			~Writer()
+				{
+				try
+					{
+					flush();
+					}
+				catch ( ... )
+					{
+					}
+				}
+
+			/**
+			 * @brief Write text
+			 *
+			 * @param text pointer at first character
+			 * @param size number of characters
+			 */
+			void write ( const char* text, std::size_t size )
+				{
+				std::memcpy ( reserve ( size ), text, size );
+				it += size;
+				}
+
+			/**
+			 * @brief Write character
+			 */
+			inline void put ( char c )
+				{
+				*reserve ( 1 ) = c;
+				++it;
+				}
+
+			/**
+			 * @brief Write range of elements separated by delimiter
+			 *
+			 * @tparam Iterator Forward Iterator
+			 * @tparam ConstIterator Const Forward Iterator
+			 * @param it_beg iterator at first element
+			 * @param it_end iterator after last element
+			 * @param format
+			 */
+			template<typename Iterator, typename ConstIterator>
+			void row ( Iterator it_beg, ConstIterator it_end, const Format& format = Format() )
+				{
+				using T = std::decay_t<decltype ( *it_beg )>;
+				const std::size_t bound = maxChars<T> ( format.precision ) + 1;
+				const char separator = delimiter ( format.mode );
+				bool first = true;
+
+				for ( ; it_beg != it_end; ++it_beg )
+					{
+					char* it_text = reserve ( bound );
+
+					if ( !first )
+						*it_text++ = separator;
+
+					it = formatValue ( it_text, it_text + bound, *it_beg, format.precision );
+					first = false;
+					}
+				}
+
+			/**
+			 * @brief Write record, scalar, Vector or Matrix, as single row
+			 */
+			template<class E>
+			inline void record ( const E& value, const Format& format = Format() )
+				{
+				const typename Row<E>::type* it_beg = Row<E>::begin ( value );
+
+				row ( it_beg, it_beg + Row<E>::size, format );
+				}
+
+			/**
+			 * @brief Pass buffer to stream.
+			 * Throw runtime_error when stream fails.
+			 */
+			void flush()
+				{
+				if ( it != first )
+					{
+					out.write ( first, std::streamsize ( it - first ) );
+					it = first;
+					}
+
+				if ( !out )
+					throw std::runtime_error ( "Text output failed" );
+				}
+
+		private:
+			// space for size characters at it
+			char* reserve ( std::size_t size )
+				{
+				if ( std::size_t ( last - it ) < size )
+					{
+					flush();
+
+					if ( std::size_t ( last - first ) < size )
+						{
+						storage.resize ( size );
+						first = storage.data();
+						last = first + size;
+						it = first;
+						}
+					}
+
+				return it;
+				}
+		};
+
+	/**
+	 * @brief Error of parsing text with position of malformed text
+	 */
+	class ParseError : public std::runtime_error
+		{
+		public:
+			// offset from beginning of text, line and column counted from 1
+			std::size_t offset;
+			std::size_t line;
+			std::size_t column;
+
+			ParseError ( const std::string& message, std::size_t offset, std::size_t line, std::size_t column )
+				: std::runtime_error ( message + " at line " + std::to_string ( line ) + ", column " + std::to_string ( column ) ),
+				  offset ( offset ), line ( line ), column ( column )
+				{
+				}
+		};
+
+	/**
+	 * @brief Throw ParseError at position it of text beginning at text
+	 */
+	[[noreturn]] inline void parseError ( const char* message, const char* text, const char* it )
+		{
+		std::size_t line = 1;
+		const char* line_beg = text;
+
+		for ( const char* it_text = text; it_text != it; ++it_text )
+			{
+			if ( *it_text == '\n' )
+				{
+				++line;
+				line_beg = it_text + 1;
+				}
+			}
+
+		throw ParseError ( message, std::size_t ( it - text ), line, std::size_t ( it - line_beg ) + 1 );
+		}
+
+	/**
+	 * @brief Delimiter of elements inside line, any mode is accepted
+	 */
+	inline bool isBlank ( char c )
+		{
+		return c == ' ' || c == ',' || c == '\t' || c == ';' || c == '\r';
+		}
+
+	/**
+	 * @brief Parse floating point value from [first, last), text need not be terminated
+	 *
+	 * @param first pointer at first character
+	 * @param last pointer after last character
+	 * @param value parsed value
+	 * @return const char* pointer after number, nullptr when there is no valid number
+	 */
+	template<typename T, std::enable_if_t<std::is_floating_point<T>::value, int> = 0>
+	inline const char* parseValue ( const char* first, const char* last, T& value )
+		{
+		// plus sign is not accepted by from_chars
+		if ( last - first > 1 && *first == '+' && first[1] != '-' )
+			++first;
+
+#if defined ( __cpp_lib_to_chars )
+		const std::from_chars_result result = std::from_chars ( first, last, value );
+
+		return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+		// token is copied to be terminated
+		char text[64];
+		std::size_t size = 0;
+
+		while ( first + size != last && size + 1 < sizeof ( text ) && !isBlank ( first[size] ) && first[size] != '\n' )
+			{
+			text[size] = first[size];
+			++size;
+			}
+
+		text[size] = '\0';
+		char* it_end;
+		value = parseNumber ( text, &it_end, value );
+
+		return it_end == text ? nullptr : first + ( it_end - text );
+#endif
+		}
+
+	/**
+	 * @brief Parse integer value from [first, last), overflow is invalid number
+	 *
+	 * @return const char* pointer after number, nullptr when there is no valid number
+	 */
+	template<typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+	inline const char* parseValue ( const char* first, const char* last, T& value )
+		{
+		const bool negative = first != last && *first == '-';
+
+		if ( first != last && ( *first == '-' || *first == '+' ) )
+			++first;
+
+		if ( negative && !std::is_signed<T>::value )
+			return nullptr;
+
+		const std::uint64_t limit = std::uint64_t ( std::numeric_limits<T>::max() ) + ( negative ? 1 : 0 );
+		std::uint64_t magnitude = 0;
+		const char* it = first;
+
+		for ( ; it != last && unsigned ( *it - '0' ) < 10; ++it )
+			{
+			const unsigned digit = unsigned ( *it - '0' );
+
+			if ( magnitude > ( limit - digit ) / 10 )
+				return nullptr;
+
+			magnitude = magnitude * 10 + digit;
+			}
+
+		if ( it == first )
+			return nullptr;
+
+		value = T ( negative ? std::uint64_t ( 0 ) - magnitude : magnitude );
+
+		return it;
+		}
+
+	/**
+	 * @brief Parse element constructible from float, as Half, from [first, last)
+	 *
+	 * @return const char* pointer after number, nullptr when there is no valid number
+	 */
+	template<typename T, std::enable_if_t<!std::is_arithmetic<T>::value, int> = 0>
+	inline const char* parseValue ( const char* first, const char* last, T& value )
+		{
+		float number;
+		first = parseValue ( first, last, number );
+
+		if ( first != nullptr )
+			value = T ( number );
+
+		return first;
+		}
+
+	/**
+	 * @brief Parse count elements separated by delimiters, new lines separate
+	 * elements too unless single_line. Throw ParseError with position in text.
+	 *
+	 * @param first pointer at first character
+	 * @param last pointer after last character
+	 * @param text beginning of whole text, for position of error
+	 * @param out pointer at first parsed element
+	 * @param count number of elements
+	 * @param single_line elements must be on single line
+	 * @return const char* pointer after last element
+	 */
+	template<typename T>
+	const char* parseRow ( const char* first, const char* last, const char* text, T* out, std::size_t count, bool single_line )
+		{
+		for ( std::size_t i = 0; i < count; ++i )
+			{
+			while ( first != last && ( isBlank ( *first ) || ( !single_line && *first == '\n' ) ) )
+				++first;
+
+			if ( first == last || *first == '\n' )
+				parseError ( "Too few elements", text, first );
+
+			const char* it_next = parseValue ( first, last, out[i] );
+
+			if ( it_next == nullptr || ( it_next != last && !isBlank ( *it_next ) && *it_next != '\n' ) )
+				parseError ( "Invalid number", text, first );
+
+			first = it_next;
+			}
+
+		return first;
+		}
+
+	/**
+	 * @brief Parse lines of [first, last) as records appended to records,
+	 * empty lines and lines starting by '#' are skipped.
+	 * Throw ParseError with position in text.
+	 *
+	 * @tparam E type of record, scalar, Vector or Matrix
+	 * @param first pointer at beginning of line
+	 * @param last pointer after last character
+	 * @param text beginning of whole text, for position of error
+	 * @param records parsed records
+	 */
+	template<class E>
+	void parseLines ( const char* first, const char* last, const char* text, std::vector<E>& records )
+		{
+		while ( first != last )
+			{
+			const char* it = first;
+
+			while ( it != last && isBlank ( *it ) )
+				++it;
+
+			if ( it != last && *it != '\n' && *it != '#' )
+				{
+				records.emplace_back();
+				it = parseRow ( it, last, text, Row<E>::begin ( records.back() ), Row<E>::size, true );
+
+				while ( it != last && isBlank ( *it ) )
+					++it;
+
+				if ( it != last && *it != '\n' )
+					parseError ( "Too many elements", text, it );
+				}
+			else if ( it != last )
+				{
+				// rest of skipped line
+				it = static_cast<const char*> ( std::memchr ( it, '\n', std::size_t ( last - it ) ) );
+				}
+
+			first = it == nullptr || it == last ? last : it + 1;
+			}
+		}
+
+	// size of stack buffer of print
+	const std::size_t PRINT_BUFFER = 512;
+
+	/**
+	 * @brief Write range of elements as "[ x y z ]" by writer
+	 *
+	 * @param writer writer of stream
+	 * @param it_beg iterator at first element
+	 * @param it_end iterator after last element
+	 * @param precision number of significant digits
+	 */
+	template<typename Iterator, typename ConstIterator>
+	inline void printRow ( Writer& writer, Iterator it_beg, ConstIterator it_end, int precision )
+		{
+		writer.write ( "[ ", 2 );
+		writer.row ( it_beg, it_end, Format ( PLAIN, precision ) );
+		writer.write ( " ]", 2 );
+		}
+
+	/**
+	 * @brief Write range of elements as "[ x y z ]" to stream through buffer
+	 * on stack, used by operator<< of Vector and views. Precision of stream
+	 * is number of significant digits, other flags of stream (width, fixed,
+	 * scientific) are ignored.
+	 */
+	template<typename Iterator, typename ConstIterator>
+	std::ostream& print ( std::ostream& out, Iterator it_beg, ConstIterator it_end )
+		{
+		char text[PRINT_BUFFER];
+		Writer writer ( out, text, text + PRINT_BUFFER );
+
+		printRow ( writer, it_beg, it_end, int ( out.precision() ) );
+		writer.flush();
+
+		return out;
+		}
+	}
+
+/**
+ * @brief Write Vector as row of elements into [first, last)
+ *
+ * @tparam T type of Vector
+ * @tparam SIZE size of Vector
+ * @param first pointer at first character
+ * @param last pointer after last character
+ * @param v Vector
+ * @param format mode and precision
+ * @return char* pointer after written text, nullptr when text does not fit
+ */
+template<typename T, unsigned SIZE>
+inline char* format ( char* first, char* last, const Vector<T, SIZE>& v, const TextIO::Format& format = TextIO::Format() )
+	{
+	return TextIO::formatRow ( first, last, v.x, v.x + SIZE, format );
+	}
+
+/**
+ * @brief Write Matrix as rows of elements separated by new lines into [first, last)
+ *
+ * @tparam T type of Matrix
+ * @tparam ROWS number of rows in Matrix
+ * @tparam COLS number of columns in Matrix
+ * @param first pointer at first character
+ * @param last pointer after last character
+ * @param m Matrix
+ * @param format mode and precision
+ * @return char* pointer after written text, nullptr when text does not fit
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+char* format ( char* first, char* last, const Matrix<T, ROWS, COLS>& m, const TextIO::Format& format = TextIO::Format() )
+	{
+	for ( unsigned i = 0; i < ROWS && first != nullptr; ++i )
+		{
+		if ( i != 0 )
+			{
+			if ( first == last )
+				return nullptr;
+
+			*first++ = '\n';
+			}
+
+		first = TextIO::formatRow ( first, last, m.x[i], m.x[i] + COLS, format );
+		}
+
+	return first;
+	}
+
+/**
+ * @brief Write records, scalars, Vectors or Matrices, to stream as lines
+ * of text, CSV or TSV by format. Matrix is single line in row major order.
+ * Throw runtime_error when stream fails.
+ *
+ * @tparam Iterator Forward Iterator
+ * @tparam ConstIterator Const Forward Iterator
+ * @param out output stream
+ * @param it_beg iterator at first record
+ * @param it_end iterator after last record
+ * @param format mode and precision
+ * @return std::size_t number of records
+ */
+template<typename Iterator, typename ConstIterator>
+std::size_t writeText ( std::ostream& out, Iterator it_beg, ConstIterator it_end, const TextIO::Format& format = TextIO::Format() )
+	{
+	TextIO::Writer writer ( out );
+	std::size_t count = 0;
+
+	for ( ; it_beg != it_end; ++it_beg, ++count )
+		{
+		writer.record ( *it_beg, format );
+		writer.put ( '\n' );
+		}
+
+	writer.flush();
+
+	return count;
+	}
+
+/**
+ * @brief Parse Vector from elements separated by spaces, tabs, commas
+ * or new lines. Throw TextIO::ParseError with position of malformed text.
+ *
+ * @tparam T type of Vector
+ * @tparam SIZE size of Vector
+ * @param first pointer at first character
+ * @param last pointer after last character
+ * @param v parsed Vector
+ * @return const char* pointer after last element
+ */
+template<typename T, unsigned SIZE>
+inline const char* parse ( const char* first, const char* last, Vector<T, SIZE>& v )
+	{
+	return TextIO::parseRow ( first, last, first, v.x, SIZE, false );
+	}
+
+/**
+ * @brief Parse Matrix from elements in row major order separated by spaces,
+ * tabs, commas or new lines. Throw TextIO::ParseError with position of malformed text.
+ *
+ * @tparam T type of Matrix
+ * @tparam ROWS number of rows in Matrix
+ * @tparam COLS number of columns in Matrix
+ * @param first pointer at first character
+ * @param last pointer after last character
+ * @param m parsed Matrix
+ * @return const char* pointer after last element
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+inline const char* parse ( const char* first, const char* last, Matrix<T, ROWS, COLS>& m )
+	{
+	return TextIO::parseRow ( first, last, first, &m.x[0][0], ROWS * COLS, false );
+	}
+
+/**
+ * @brief Parse text of records, scalars, Vectors or Matrices, one record per line
+ * as written by writeText, in any mode. Empty lines and lines starting by '#'
+ * are skipped. Text is split at lines into consecutive parts parsed by own
+ * threads, last part is parsed by calling thread.
+ * Throw TextIO::ParseError with line and column of first malformed text,
+ * errors of parts and of starting threads are rethrown after threads are joined.
+ *
+ * @tparam E type of record
+ * @param first pointer at first character
+ * @param last pointer after last character
+ * @param threads number of threads
+ * @return std::vector<E> records
+ */
+template<class E>
+std::vector<E> parseText ( const char* first, const char* last, unsigned threads = 1 )
+	{
+	const std::size_t size = std::size_t ( last - first );
+
+	// part of text is at least size of buffer
+	threads = unsigned ( std::max<std::size_t> ( 1, std::min<std::size_t> ( threads, size / TextIO::BUFFER + 1 ) ) );
+
+	std::vector<std::vector<E>> parts ( threads );
+	std::vector<std::exception_ptr> errors ( threads );
+	std::vector<std::thread> workers;
+	const char* part_beg = first;
+
+	try
+		{
+		for ( unsigned part = 0; part < threads; ++part )
+			{
+			// part ends by new line following its share of text
+			const char* part_end = last;
+
+			if ( part + 1 < threads )
+				{
+				const char* it = std::max ( first + size * ( part + 1 ) / threads, part_beg );
+				const void* it_line = std::memchr ( it, '\n', std::size_t ( last - it ) );
+				part_end = it_line == nullptr ? last : static_cast<const char*> ( it_line ) + 1;
+				}
+
+			auto function = [part_beg, part_end, first, part, &parts, &errors]()
+				{
+				try
+					{
+					TextIO::parseLines ( part_beg, part_end, first, parts[part] );
+					}
+				catch ( ... )
+					{
+					errors[part] = std::current_exception();
+					}
+				};
+
+			if ( part + 1 == threads )
+				function();
+			else
+				workers.emplace_back ( function );
+
+			part_beg = part_end;
+			}
+		}
+	catch ( ... )
+		{
+		// thread was not started, running threads are joined before rethrow
+		for ( std::thread& worker : workers )
+			worker.join();
+
+		throw;
+		}
+
+	for ( std::thread& worker : workers )
+		worker.join();
+
+	for ( const std::exception_ptr& error : errors )
+		if ( error )
+			std::rethrow_exception ( error );
+
+	if ( threads == 1 )
+		return std::move ( parts[0] );
+
+	std::size_t count = 0;
+	std::vector<E> records;
+
+	for ( const std::vector<E>& records_part : parts )
+		count += records_part.size();
+
+	records.reserve ( count );
+
+	for ( const std::vector<E>& records_part : parts )
+		records.insert ( records.end(), records_part.begin(), records_part.end() );
+
+	return records;
+	}
+
+#endif // TEXTIO_HPP
@@ -3,6 +3,9 @@
 
 #include <exception>
 #include <type_traits>
+#include <cstdint>
+
+#include "Instrument.hpp"
 
 #define M_PI       3.14159265358979323846
 #define M_PI_2     1.57079632679489661923
@@ -14,6 +17,15 @@ class Matrix;
 template<typename T, unsigned SIZE>
 struct Vector;
 
+// extent of view given at run time
+const unsigned DYNAMIC_EXTENT = 0;
+
+template<typename T, unsigned SIZE = DYNAMIC_EXTENT>
+class VectorView;
+
+template<typename T, unsigned ROWS = DYNAMIC_EXTENT, unsigned COLS = DYNAMIC_EXTENT>
+class MatrixView;
+
 template<typename T, typename U, typename T_U = decltype ( T() + U() )>
 using operator_T_U = T_U ( * ) ( T, U );
 
@@ -116,6 +128,70 @@ struct SubtractInverse
 		}
 	};
 
+/**
+ * @brief Accumulator type of sums of products of T, wide enough not to lose
+ * precision (float -> double) or overflow (int8, int16 -> int32, int32 -> int64).
+ *
+ * @tparam T type of elements
+ */
+template<typename T>
+struct WideAccumulator
+	{
+	using type = decltype ( T()*T() );
+	};
+
+template<>
+struct WideAccumulator<float>
+	{
+	using type = double;
+	};
+
+template<>
+struct WideAccumulator<std::int8_t>
+	{
+	using type = std::int32_t;
+	};
+
+template<>
+struct WideAccumulator<std::uint8_t>
+	{
+	using type = std::int32_t;
+	};
+
+template<>
+struct WideAccumulator<std::int16_t>
+	{
+	using type = std::int32_t;
+	};
+
+template<>
+struct WideAccumulator<std::uint16_t>
+	{
+	using type = std::uint32_t;
+	};
+
+template<>
+struct WideAccumulator<std::int32_t>
+	{
+	using type = std::int64_t;
+	};
+
+template<>
+struct WideAccumulator<std::uint32_t>
+	{
+	using type = std::uint64_t;
+	};
+
+template<typename T>
+using wide_type = typename WideAccumulator<T>::type;
+
+// ACC if it is given (not void), wide accumulator of common type of T and U otherwise,
+// selected before promotion of narrow integers by multiplication
+template<typename ACC, typename T, typename U>
+using accumulator_type = typename std::conditional<std::is_void<ACC>::value,
+	  wide_type<std::common_type_t<T, U>>,
+	  ACC>::type;
+
 namespace Container
 	{
 	// type pointed by Iterator
@@ -165,6 +241,44 @@ namespace Container
 		return aux;
 		}
 
+	/**
+	 * @brief Dot product of ranges accumulated in type ACC.
+	 * Elements are converted to ACC before multiplication. Integer sums are
+	 * reordered by compiler, floating point products are summed into two vectors
+	 * of partial sums, so the reduction is vectorized including conversion.
+	 *
+	 * @tparam ACC accumulator type
+	 * @tparam T type of first range
+	 * @tparam U type of second range
+	 * @param first pointer at beginning of first range
+	 * @param second pointer at beginning of second range
+	 * @param size number of elements
+	 * @return ACC dot product
+	 */
+	template<typename ACC,
+			 typename T,
+			 typename U>
+	inline ACC dot ( const T* first, const U* second, unsigned size )
+		{
+		// partial sums in one 64 byte vector, wider arrays are not vectorized
+		const unsigned LANES = sizeof ( ACC ) < 64 ? 64 / sizeof ( ACC ) : 1;
+		const unsigned size_lanes = std::is_integral<ACC>::value ? 0 : size - size % ( 2*LANES );
+		ACC partial[2][LANES] = {};
+		unsigned j = 0;
+
+		for ( ; j < size_lanes; j += 2*LANES )
+			for ( unsigned r = 0; r < 2; ++r )
+				for ( unsigned k = 0; k < LANES; ++k )
+					partial[r][k] += ACC ( first[j + r*LANES + k] ) * ACC ( second[j + r*LANES + k] );
+
+		ACC value = sum ( *partial, *partial + 2*LANES );
+
+		for ( ; j < size; ++j )
+			value += ACC ( first[j] ) * ACC ( second[j] );
+
+		return value;
+		}
+
 	template<class C>
 	inline auto sum ( const C& container )
 	-> decltype ( sum ( container.begin(), container.end() ) )
@@ -235,10 +349,19 @@ namespace Container
 										Iterator2 second_beg,
 										Iterator3 out_beg  )
 		{
+		// number of elements, unused without instrumentation
+		std::uint64_t count = 0;
+
 		// iterate over all fields and execute operation on each corresponding fields
 		while ( first_beg != first_end )
+			{
 			*out_beg++ = operation<ret_type<Iterator1>, ret_type<Iterator2>, ret_type<Iterator3>>::operation
 						 ( *first_beg++, *second_beg++ );
+			++count;
+			}
+
+		Instrument::record ( Instrument::ELEMENTS_OPERATION, count,
+							 count * ( sizeof ( ret_type<Iterator1> ) + sizeof ( ret_type<Iterator2> ) + sizeof ( ret_type<Iterator3> ) ) );
 		}
 
 	/**
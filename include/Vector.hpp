@@ -9,6 +9,7 @@
 #include <exception>
 
 #include "Utility.hpp"
+#include "TextIO.hpp"
 
 
 template<typename T, unsigned SIZE>
@@ -75,7 +76,8 @@ struct Vector
 			}
 
 		/**
-		 * @brief Create Vector from matrix
+		 * @brief Create Vector from matrix, elements are copied.
+		 * Matrix::asVector views the same elements without copy.
 		 *
 		 * @tparam U matrix type
 		 * @param m matrix with one column
@@ -201,6 +203,36 @@ struct Vector
 			return SIZE;
 			}
 
+		/**
+		 * @brief View of Vector as SIZE x 1 Matrix, elements are not copied
+		 *
+		 * @return MatrixView<T, SIZE, 1>
+		 */
+		inline MatrixView<T, SIZE, 1> asColumn()
+			{
+			return MatrixView<T, SIZE, 1> ( x, 1, 1 );
+			}
+
+		inline MatrixView<const T, SIZE, 1> asColumn() const
+			{
+			return MatrixView<const T, SIZE, 1> ( x, 1, 1 );
+			}
+
+		/**
+		 * @brief View of Vector as 1 x SIZE Matrix, elements are not copied
+		 *
+		 * @return MatrixView<T, 1, SIZE>
+		 */
+		inline MatrixView<T, 1, SIZE> asRow()
+			{
+			return MatrixView<T, 1, SIZE> ( x, SIZE, 1 );
+			}
+
+		inline MatrixView<const T, 1, SIZE> asRow() const
+			{
+			return MatrixView<const T, 1, SIZE> ( x, SIZE, 1 );
+			}
+
 		/**
 		 * @brief Fill all vector fields by value
 		 *
@@ -229,9 +261,11 @@ struct Vector
 			const U* it_other = other.x;
 			T const* it_end = x+SIZE;
 
-			// iterate over all fields and sum each
+			Instrument::record ( Instrument::DOT, 2 * SIZE, SIZE * ( sizeof ( T ) + sizeof ( U ) ) );
+
+			// iterate over all fields and sum each, products are computed in T_U
 			while ( it != it_end )
-				sum += ( *it++ )* ( *it_other++ );
+				sum += T_U ( *it++ ) * T_U ( *it_other++ );
 
 			return sum;
 			}
@@ -598,19 +632,45 @@ struct Vector
  */
 template<typename T,
 		 typename U,
-		 typename T_U = decltype ( T()*U() ),
-		 std::enable_if_t<std::is_convertible<U, T>::value, int> = 0>
+		 typename T_U,
+		 std::enable_if_t<std::is_convertible<U, T>::value, int>>
 void crossProduct ( const Vector<T, 3>& first,
 					const Vector<U, 3>& second,
 					Vector<T_U, 3>& out )
 	{
 	T_U* it_out = out.begin();
 
+	Instrument::record ( Instrument::CROSS_PRODUCT, 9, 3 * ( sizeof ( T ) + sizeof ( U ) + sizeof ( T_U ) ) );
+
 	*it_out++ = first.x[1]*second.x[2] - first.x[2]*second.x[1];
 	*it_out++ = first.x[2]*second.x[0] - first.x[0]*second.x[2];
 	*it_out = first.x[0]*second.x[1] - first.x[1]*second.x[0];
 	}
 
+/**
+ * @brief Dot product of Vectors accumulated in type independent of storage,
+ * e.g. float Vectors in double or int32 Vectors in int64.
+ *
+ * @tparam ACC accumulator type, void for wide_type of product
+ * @tparam T first Vector type
+ * @tparam U second Vector type
+ * @tparam SIZE Vector size
+ * @param first const Vector&
+ * @param second const Vector&
+ * @return accumulator_type<ACC, T, U> dot product
+ */
+template<typename ACC = void,
+		 typename T,
+		 typename U,
+		 unsigned SIZE,
+		 typename A = accumulator_type<ACC, T, U>>
+inline A wideDot ( const Vector<T, SIZE>& first, const Vector<U, SIZE>& second )
+	{
+	Instrument::record ( Instrument::DOT, 2 * SIZE, SIZE * ( sizeof ( T ) + sizeof ( U ) ) );
+
+	return Container::dot<A> ( first.x, second.x, SIZE );
+	}
+
 /**
  * @brief Add value to Vector
  *
@@ -707,6 +767,7 @@ inline Vector<T_U, SIZE> operator* ( U value, const Vector<T, SIZE>& v )
 template<typename T>
 Vector<T, 3> sphericalToCartesian ( const Vector<T, 3>& v )
 	{
+	Instrument::record ( Instrument::CONVERSION, 8, 6 * sizeof ( T ) );
 	// references to vector components
 	const T& fi = v.x[0], &theta = v.x[1], &r = v.x[2];
 	// length of v's projection on XY plane
@@ -733,6 +794,7 @@ Vector<T, 3> sphericalToCartesian ( const Vector<T, 3>& v )
 template<typename T>
 Vector<T, 3> cartesianToSpherical ( const Vector<T, 3>& v )
 	{
+	Instrument::record ( Instrument::CONVERSION, 9, 6 * sizeof ( T ) );
 	// angle between v and OX on XY plane
 	T fi = atan2 ( v.x[1], v.x[0] );
 	// sum of squares of projection's coordinates on XY plane
@@ -760,6 +822,7 @@ Vector<T, 3> cartesianToSpherical ( const Vector<T, 3>& v )
 template<typename T>
 Vector<T, 3> cartesianToAngles ( const Vector<T>& v )
 	{
+	Instrument::record ( Instrument::CONVERSION, 3, 6 * sizeof ( T ) );
 	T fi = atan2 ( v.x[1], v.x[2] );
 	T theta = atan2 ( v.x[2], v.x[0] );
 	T ksi = atan2 ( v.x[0], v.x[1] );
@@ -782,6 +845,7 @@ Vector<T, 3> cartesianToAngles ( const Vector<T>& v )
 template<typename T>
 Vector<T, 3> cylindricalToCartesian ( const Vector<T, 3>& v )
 	{
+	Instrument::record ( Instrument::CONVERSION, 4, 6 * sizeof ( T ) );
 	const T& r = v.x[0], &fi = v.x[1], & z = v.x[2];
 
 	return Vector<T> {T ( r*cos ( fi ) ),
@@ -805,6 +869,7 @@ Vector<T, 3> cylindricalToCartesian ( const Vector<T, 3>& v )
 template<typename T>
 Vector<T, 3> cartesianToCylindrical ( const Vector<T, 3>& v )
 	{
+	Instrument::record ( Instrument::CONVERSION, 5, 6 * sizeof ( T ) );
 	// angle between v and OX on XY plane
 	T fi = atan2 ( v.x[1], v.x[0] );
 	// norm of XY projection
@@ -816,6 +881,7 @@ Vector<T, 3> cartesianToCylindrical ( const Vector<T, 3>& v )
 template<typename T, unsigned SIZE>
 Vector<T, SIZE> radToDeg ( const Vector<T, SIZE>& v )
 	{
+	Instrument::record ( Instrument::CONVERSION, SIZE + 1, 2 * SIZE * sizeof ( T ) );
 	Vector<T, SIZE> ans =  v* ( T ( 180 )/T ( M_PI ) );
 
 	return ans;
@@ -824,7 +890,9 @@ Vector<T, SIZE> radToDeg ( const Vector<T, SIZE>& v )
 
 
 /**
- * @brief Display Vector
+ * @brief Display Vector as "[ x y z ]" formatted by TextIO,
+ * precision of stream is number of significant digits,
+ * other flags of stream (width, fixed, scientific) are ignored
  *
  * @tparam Tt type of Vector
  * @tparam U size of Vector
@@ -835,12 +903,10 @@ Vector<T, SIZE> radToDeg ( const Vector<T, SIZE>& v )
 template <typename Tt, unsigned U>
 std::ostream& operator<< ( std::ostream& out, const Vector<Tt, U>& v )
 	{
-	out << "[ ";
-	for ( Tt x : v.x )
-		out << x << " ";
-	out << "]";
-
-	return out;
+	return TextIO::print ( out, v.x, v.x + U );
 	}
 
+// views returned by asColumn and asRow
+#include "View.hpp"
+
 #endif //VECTOR_HPP
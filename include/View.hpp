@@ -0,0 +1,1590 @@
+#ifndef VIEW_HPP
+#define VIEW_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <ostream>
+
+#include "Utility.hpp"
+#include "Vector.hpp"
+#include "Matrix.hpp"
+
+/*
+ * Non-owning views of vectors and matrices stored in external buffers (DMA
+ * buffers, network frames) or in Vector and Matrix. View is a pointer with strides,
+ * extents are static as for Vector and Matrix, or given at run time for
+ * DYNAMIC_EXTENT. Copy of view refers the same elements, assignment to view
+ * writes elements, so results are written into buffers without copies.
+ * Constness is shallow as for pointers, VectorView<const T> is read only.
+ *
+ * Views and Vector/Matrix are mixed freely in operations, at least one operand
+ * must be view. Element-wise operators return owning Vector or Matrix (views of
+ * static extents), compound assignments, cauchyProduct, transposedCauchyProduct
+ * and crossProduct write through views.
+ * Extents are checked at compile time, dynamic extents at run time
+ * (std::runtime_error). Output must not overlap inputs of cauchyProduct.
+ * Matrix::block, Matrix::row and Matrix::col return views of Matrix elements.
+ */
+
+namespace View
+	{
+	/**
+	 * @brief Forward iterator over elements with constant stride.
+	 * Position is kept as offset, so end of view is not pointer out of buffer.
+	 *
+	 * @tparam T type of elements
+	 */
+	template<typename T>
+	class StridedIterator
+		{
+		public:
+			T* data;
+			std::size_t offset;
+			unsigned stride;
+
+		public:
+			StridedIterator ( T* data = nullptr, std::size_t offset = 0, unsigned stride = 1 )
+				: data ( data ), offset ( offset ), stride ( stride )
+				{
+				}
+
+			inline T& operator*() const
+				{
+				return data[offset];
+				}
+
+			inline StridedIterator& operator++()
+				{
+				offset += stride;
+
+				return *this;
+				}
+
+			inline StridedIterator operator++ ( int )
+				{
+				StridedIterator it = *this;
+				offset += stride;
+
+				return it;
+				}
+
+			inline bool operator== ( const StridedIterator& other ) const
+				{
+				return offset == other.offset;
+				}
+
+			inline bool operator!= ( const StridedIterator& other ) const
+				{
+				return offset != other.offset;
+				}
+		};
+
+	/**
+	 * @brief Forward iterator over elements of strided Matrix by rows.
+	 * End of row r is beginning of row r+1, offset rows*row_stride is end of view.
+	 *
+	 * @tparam T type of elements
+	 */
+	template<typename T>
+	class MatrixIterator
+		{
+		public:
+			T* data;
+			std::size_t offset;
+			unsigned col;
+			unsigned cols;
+			unsigned col_stride;
+			std::size_t row_step;
+
+		public:
+			MatrixIterator ( T* data = nullptr, std::size_t offset = 0, unsigned cols = 0, unsigned row_stride = 0, unsigned col_stride = 1 )
+				: data ( data ), offset ( offset ), col ( 0 ), cols ( cols ), col_stride ( col_stride ),
+				  row_step ( std::size_t ( row_stride ) - std::size_t ( cols ) * col_stride )
+				{
+				}
+
+			inline T& operator*() const
+				{
+				return data[offset];
+				}
+
+			inline MatrixIterator& operator++()
+				{
+				offset += col_stride;
+
+				// unsigned wrap around for transposed views, row_step is negative
+				if ( ++col == cols )
+					{
+					col = 0;
+					offset += row_step;
+					}
+
+				return *this;
+				}
+
+			inline MatrixIterator operator++ ( int )
+				{
+				MatrixIterator it = *this;
+				++*this;
+
+				return it;
+				}
+
+			inline bool operator== ( const MatrixIterator& other ) const
+				{
+				return offset == other.offset && col == other.col;
+				}
+
+			inline bool operator!= ( const MatrixIterator& other ) const
+				{
+				return ! ( *this == other );
+				}
+		};
+
+	/**
+	 * @brief Kind, element type and extents of operands of view operations
+	 */
+	template<class X>
+	struct Traits
+		{
+		static const bool vector = false;
+		static const bool matrix = false;
+		static const bool view = false;
+		};
+
+	template<typename T, unsigned SIZE>
+	struct Traits<Vector<T, SIZE>>
+		{
+		using type = T;
+		static const bool vector = true;
+		static const bool matrix = false;
+		static const bool view = false;
+		static const unsigned size = SIZE;
+		};
+
+	template<typename T, unsigned SIZE>
+	struct Traits<VectorView<T, SIZE>>
+		{
+		using type = std::remove_const_t<T>;
+		static const bool vector = true;
+		static const bool matrix = false;
+		static const bool view = true;
+		static const unsigned size = SIZE;
+		};
+
+	template<typename T, unsigned ROWS, unsigned COLS>
+	struct Traits<Matrix<T, ROWS, COLS>>
+		{
+		using type = T;
+		static const bool vector = false;
+		static const bool matrix = true;
+		static const bool view = false;
+		static const unsigned rows = ROWS;
+		static const unsigned cols = COLS;
+		};
+
+	template<typename T, unsigned ROWS, unsigned COLS>
+	struct Traits<MatrixView<T, ROWS, COLS>>
+		{
+		using type = std::remove_const_t<T>;
+		static const bool vector = false;
+		static const bool matrix = true;
+		static const bool view = true;
+		static const unsigned rows = ROWS;
+		static const unsigned cols = COLS;
+		};
+
+	template<class X>
+	using traits = Traits<std::decay_t<X>>;
+
+	// operands of Vector operation, at least one of them is view
+	template<class A, class B>
+	using enable_vectors = std::enable_if_t < traits<A>::vector && traits<B>::vector
+						   && ( traits<A>::view || traits<B>::view ), int >;
+
+	// operands of Matrix operation, at least one of them is view
+	template<class A, class B>
+	using enable_matrices = std::enable_if_t < traits<A>::matrix && traits<B>::matrix
+							&& ( traits<A>::view || traits<B>::view ), int >;
+
+	// operands of Matrix Vector operation, at least one of them is view
+	template<class A, class B>
+	using enable_matrix_vector = std::enable_if_t < traits<A>::matrix && traits<B>::vector
+								 && ( traits<A>::view || traits<B>::view ), int >;
+
+	// operands of Vector Matrix outer product, at least one of them is view
+	template<class A, class B>
+	using enable_vector_matrix = std::enable_if_t < traits<A>::vector && traits<B>::matrix
+								 && ( traits<A>::view || traits<B>::view ), int >;
+
+	// view and value convertible to its elements
+	template<class A, typename U>
+	using enable_value = std::enable_if_t < traits<A>::view
+						 && std::is_convertible<U, typename traits<A>::type>::value, int >;
+
+	/**
+	 * @brief Extent of result of operands with extents FIRST and SECOND
+	 */
+	template<unsigned FIRST, unsigned SECOND>
+	struct Extent
+		{
+		static_assert ( FIRST == DYNAMIC_EXTENT || SECOND == DYNAMIC_EXTENT || FIRST == SECOND,
+						"Extents of operands must be equal." );
+
+		static const unsigned value = FIRST != DYNAMIC_EXTENT ? FIRST : SECOND;
+		};
+
+	/**
+	 * @brief Check equality of extents, at compile time when both are static
+	 *
+	 * @tparam FIRST static extent of first operand or DYNAMIC_EXTENT
+	 * @tparam SECOND static extent of second operand or DYNAMIC_EXTENT
+	 * @param first extent of first operand
+	 * @param second extent of second operand
+	 */
+	template<unsigned FIRST, unsigned SECOND>
+	inline void checkExtent ( unsigned first, unsigned second )
+		{
+		static_assert ( Extent<FIRST, SECOND>::value == Extent<SECOND, FIRST>::value, "Extents of operands must be equal." );
+
+		if ( first != second )
+			throw std::runtime_error ( "Extents of views differ" );
+		}
+
+	/**
+	 * @brief Check equality of extents of two Vector views or two Matrix views
+	 */
+	template<typename T, unsigned SIZE, typename U, unsigned SIZE_U>
+	inline void checkSameExtents ( const VectorView<T, SIZE>& first, const VectorView<U, SIZE_U>& second )
+		{
+		checkExtent<SIZE, SIZE_U> ( first.size(), second.size() );
+		}
+
+	template<typename T, unsigned ROWS, unsigned COLS, typename U, unsigned ROWS_U, unsigned COLS_U>
+	inline void checkSameExtents ( const MatrixView<T, ROWS, COLS>& first, const MatrixView<U, ROWS_U, COLS_U>& second )
+		{
+		checkExtent<ROWS, ROWS_U> ( first.rows(), second.rows() );
+		checkExtent<COLS, COLS_U> ( first.cols(), second.cols() );
+		}
+
+	/**
+	 * @brief View of Vector, Matrix or the view itself
+	 */
+	template<typename T, unsigned SIZE>
+	inline VectorView<T, SIZE> of ( Vector<T, SIZE>& v )
+		{
+		return VectorView<T, SIZE> ( v );
+		}
+
+	template<typename T, unsigned SIZE>
+	inline VectorView<const T, SIZE> of ( const Vector<T, SIZE>& v )
+		{
+		return VectorView<const T, SIZE> ( v );
+		}
+
+	template<typename T, unsigned SIZE>
+	inline VectorView<T, SIZE> of ( const VectorView<T, SIZE>& v )
+		{
+		return v;
+		}
+
+	template<typename T, unsigned ROWS, unsigned COLS>
+	inline MatrixView<T, ROWS, COLS> of ( Matrix<T, ROWS, COLS>& m )
+		{
+		return MatrixView<T, ROWS, COLS> ( m );
+		}
+
+	template<typename T, unsigned ROWS, unsigned COLS>
+	inline MatrixView<const T, ROWS, COLS> of ( const Matrix<T, ROWS, COLS>& m )
+		{
+		return MatrixView<const T, ROWS, COLS> ( m );
+		}
+
+	template<typename T, unsigned ROWS, unsigned COLS>
+	inline MatrixView<T, ROWS, COLS> of ( const MatrixView<T, ROWS, COLS>& m )
+		{
+		return m;
+		}
+
+	/**
+	 * @brief Element-wise operation of two Vectors or two Matrices written to output,
+	 * all of them Vector, Matrix or view
+	 *
+	 * @tparam operation structure with static method operation ( T, U ) as Add
+	 * @param first first operand
+	 * @param second second operand
+	 * @param output result
+	 */
+	template<template<typename, typename, typename> class operation, class A, class B, class C>
+	inline void elementwise ( const A& first, const B& second, C&& output )
+		{
+		const auto first_view = of ( first );
+		const auto second_view = of ( second );
+		const auto output_view = of ( output );
+
+		checkSameExtents ( first_view, second_view );
+		checkSameExtents ( first_view, output_view );
+		Container::rangeElemetsOperation<operation> ( first_view.begin(), first_view.end(),
+				second_view.begin(), output_view.begin() );
+		}
+
+	/**
+	 * @brief Element-wise operation of Vector or Matrix and value written to output
+	 *
+	 * @tparam operation structure with static method operation ( T, U ) as Add
+	 * @param first Vector, Matrix or view
+	 * @param value second operand
+	 * @param output result
+	 */
+	template<template<typename, typename, typename> class operation, class A, typename U, class C>
+	inline void elementwiseValue ( const A& first, U value, C&& output )
+		{
+		const auto first_view = of ( first );
+		const auto output_view = of ( output );
+
+		checkSameExtents ( first_view, output_view );
+		Container::rangeElemetsValueOperation<operation> ( first_view.begin(), first_view.end(),
+				value, output_view.begin() );
+		}
+	}
+
+/**
+ * @brief Non-owning view of SIZE elements at data, data + stride, ...
+ *
+ * @tparam T type of elements, const T for read only view
+ * @tparam SIZE number of elements or DYNAMIC_EXTENT
+ */
+template<typename T, unsigned SIZE>
+class VectorView
+	{
+	public:
+		static const unsigned length = SIZE;
+
+		using value_type = std::remove_const_t<T>;
+		using iterator = View::StridedIterator<T>;
+
+	public:
+		T* data;
+		unsigned stride;
+		unsigned extent;
+
+	public:
+		/**
+		 * @brief View of SIZE elements with stride
+		 *
+		 * @param data pointer at first element
+		 * @param stride distance of elements
+		 */
+		template<unsigned S = SIZE, std::enable_if_t<S != DYNAMIC_EXTENT, int> = 0>
+		VectorView ( T* data, unsigned stride = 1 )
+			: data ( data ), stride ( stride ), extent ( SIZE )
+			{
+			}
+
+		/**
+		 * @brief View of size elements with stride, size must be SIZE for static extent
+		 *
+		 * @param data pointer at first element
+		 * @param size number of elements
+		 * @param stride distance of elements
+		 */
+		VectorView ( T* data, unsigned size, unsigned stride )
+			: data ( data ), stride ( stride ), extent ( size )
+			{
+			View::checkExtent<SIZE, DYNAMIC_EXTENT> ( SIZE == DYNAMIC_EXTENT ? size : SIZE, size );
+			}
+
+		/**
+		 * @brief View of size contiguous elements
+		 *
+		 * @param data pointer at first element
+		 * @param size number of elements
+		 */
+		template<unsigned S = SIZE, std::enable_if_t<S == DYNAMIC_EXTENT, int> = 0>
+		VectorView ( T* data, unsigned size )
+			: data ( data ), stride ( 1 ), extent ( size )
+			{
+			}
+
+		/**
+		 * @brief View of Vector, const Vector for view of const elements only
+		 *
+		 * @tparam U type of Vector
+		 * @tparam SIZE_U size of Vector
+		 * @param v Vector
+		 */
+		template<typename U,
+				 unsigned SIZE_U,
+				 std::enable_if_t<std::is_convertible<U*, T*>::value
+								  && ( SIZE == DYNAMIC_EXTENT || SIZE == SIZE_U ), int> = 0>
+		VectorView ( Vector<U, SIZE_U>& v )
+			: data ( v.x ), stride ( 1 ), extent ( SIZE_U )
+			{
+			}
+
+		template<typename U,
+				 unsigned SIZE_U,
+				 std::enable_if_t<std::is_convertible<const U*, T*>::value
+								  && ( SIZE == DYNAMIC_EXTENT || SIZE == SIZE_U ), int> = 0>
+		VectorView ( const Vector<U, SIZE_U>& v )
+			: data ( v.x ), stride ( 1 ), extent ( SIZE_U )
+			{
+			}
+
+		/**
+		 * @brief View of the same elements as other, read only or of dynamic extent
+		 *
+		 * @tparam U type of other view
+		 * @tparam SIZE_U size of other view
+		 * @param other view
+		 */
+		template<typename U,
+				 unsigned SIZE_U,
+				 std::enable_if_t<std::is_convertible<U*, T*>::value
+								  && ( SIZE == DYNAMIC_EXTENT || SIZE == SIZE_U ), int> = 0>
+		VectorView ( const VectorView<U, SIZE_U>& other )
+			: data ( other.data ), stride ( other.stride ), extent ( other.size() )
+			{
+			}
+
+		VectorView ( const VectorView& other ) = default;
+
+		/**
+		 * @brief Copy elements of other view into elements of this view,
+		 * view is not rebound
+		 *
+		 * @param other view of the same size
+		 * @return VectorView&
+		 */
+		VectorView& operator= ( const VectorView& other )
+			{
+			return assign ( other );
+			}
+
+		/**
+		 * @brief Copy elements of Vector or view into elements of this view
+		 *
+		 * @tparam V Vector or view
+		 * @param other Vector or view of the same size
+		 * @return VectorView&
+		 */
+		template<class V, std::enable_if_t<View::traits<V>::vector, int> = 0>
+		VectorView& operator= ( const V& other )
+			{
+			return assign ( other );
+			}
+
+		/**
+		 * @brief Number of elements
+		 *
+		 * @return unsigned
+		 */
+		inline unsigned size() const
+			{
+			return SIZE != DYNAMIC_EXTENT ? SIZE : extent;
+			}
+
+		inline iterator begin() const
+			{
+			return iterator ( data, 0, stride );
+			}
+
+		inline iterator end() const
+			{
+			return iterator ( data, std::size_t ( size() ) * stride, stride );
+			}
+
+		/**
+		 * @brief Element at position idx, not checked
+		 *
+		 * @param idx position index
+		 * @return T&
+		 */
+		inline T& operator() ( unsigned idx ) const
+			{
+			return data[std::size_t ( idx ) * stride];
+			}
+
+		/**
+		 * @brief Element at position idx
+		 * Throw runtime_error while out of range.
+		 *
+		 * @param idx position index
+		 * @return T&
+		 */
+		T& operator[] ( unsigned idx ) const
+			{
+			if ( ! ( idx < size() ) )
+				throw std::runtime_error ( "Out of range!" );
+
+			return ( *this ) ( idx );
+			}
+
+		/**
+		 * @brief Fill all elements by value
+		 *
+		 * @param value
+		 */
+		void fill ( value_type value ) const
+			{
+			Container::fill ( begin(), end(), value );
+			}
+
+		/**
+		 * @brief Sum of elements
+		 *
+		 * @return value_type
+		 */
+		value_type sum() const
+			{
+			value_type value = value_type ( 0 );
+
+			for ( const value_type x : *this )
+				value += x;
+
+			return value;
+			}
+
+		/**
+		 * @brief Dot product with Vector or view
+		 *
+		 * @tparam V Vector or view
+		 * @param other Vector or view of the same size
+		 * @return T_U
+		 */
+		template<class V,
+				 typename T_U = decltype ( value_type() * typename View::traits<V>::type() ),
+				 std::enable_if_t<View::traits<V>::vector, int> = 0>
+		T_U dot ( const V& other ) const
+			{
+			const auto other_view = View::of ( other );
+			View::checkExtent<SIZE, View::traits<V>::size> ( size(), other_view.size() );
+
+			if ( stride == 1 && other_view.stride == 1 )
+				return Container::dot<T_U> ( data, other_view.data, size() );
+
+			T_U value = T_U ( 0 );
+			auto it_other = other_view.begin();
+
+			for ( const value_type x : *this )
+				value += T_U ( x ) * T_U ( *it_other++ );
+
+			return value;
+			}
+
+		/**
+		 * @brief Euclidian norm
+		 *
+		 * @return value_type
+		 */
+		inline value_type norm() const
+			{
+			return std::sqrt ( dot ( *this ) );
+			}
+
+		/**
+		 * @brief Normalization of viewed elements by dividing them by norm,
+		 * executed only when norm is != 0
+		 *
+		 * @return bool if elements were normalized
+		 */
+		inline bool normalize() const
+			{
+			const value_type n = norm();
+			const bool condition = n != value_type ( 0 );
+
+			if ( condition )
+				*this /= n;
+
+			return condition;
+			}
+
+		/**
+		 * @brief Cross product with Vector or view of 3 elements
+		 *
+		 * @tparam V Vector or view
+		 * @param other Vector or view of 3 elements
+		 * @return Vector<T_U, 3>
+		 */
+		template<class V,
+				 typename T_U = decltype ( value_type() * typename View::traits<V>::type() ),
+				 std::enable_if_t<View::traits<V>::vector, int> = 0>
+		Vector<T_U, 3> cross ( const V& other ) const
+			{
+			Vector<T_U, 3> ans;
+			crossProduct ( *this, other, ans );
+
+			return ans;
+			}
+
+		template<class V, std::enable_if_t<View::traits<V>::vector, int> = 0>
+		const VectorView& operator+= ( const V& other ) const
+			{
+			return assignOperation<Add> ( other );
+			}
+
+		template<class V, std::enable_if_t<View::traits<V>::vector, int> = 0>
+		const VectorView& operator-= ( const V& other ) const
+			{
+			return assignOperation<Subtract> ( other );
+			}
+
+		template<class V, std::enable_if_t<View::traits<V>::vector, int> = 0>
+		const VectorView& operator*= ( const V& other ) const
+			{
+			return assignOperation<Multiply> ( other );
+			}
+
+		template<typename U, std::enable_if_t<std::is_convertible<U, value_type>::value, int> = 0>
+		const VectorView& operator+= ( U value ) const
+			{
+			Container::rangeElemetsValueOperationAssign<Add> ( begin(), end(), value );
+
+			return *this;
+			}
+
+		template<typename U, std::enable_if_t<std::is_convertible<U, value_type>::value, int> = 0>
+		const VectorView& operator-= ( U value ) const
+			{
+			Container::rangeElemetsValueOperationAssign<Subtract> ( begin(), end(), value );
+
+			return *this;
+			}
+
+		template<typename U, std::enable_if_t<std::is_convertible<U, value_type>::value, int> = 0>
+		const VectorView& operator*= ( U value ) const
+			{
+			Container::rangeElemetsValueOperationAssign<Multiply> ( begin(), end(), value );
+
+			return *this;
+			}
+
+		template<typename U, std::enable_if_t<std::is_convertible<U, value_type>::value, int> = 0>
+		const VectorView& operator/= ( U value ) const
+			{
+			Container::rangeElemetsValueOperationAssign<Divide> ( begin(), end(), value );
+
+			return *this;
+			}
+
+	private:
+		template<class V>
+		VectorView& assign ( const V& other )
+			{
+			const auto other_view = View::of ( other );
+			View::checkExtent<SIZE, View::traits<V>::size> ( size(), other_view.size() );
+			Container::copy ( begin(), end(), other_view.begin() );
+
+			return *this;
+			}
+
+		template<template<typename, typename, typename> class operation, class V>
+		const VectorView& assignOperation ( const V& other ) const
+			{
+			const auto other_view = View::of ( other );
+			View::checkExtent<SIZE, View::traits<V>::size> ( size(), other_view.size() );
+			Container::rangeElemetsOperationAssign<operation> ( begin(), end(), other_view.begin() );
+
+			return *this;
+			}
+	};
+
+/**
+ * @brief Non-owning view of ROWS x COLS elements, element (i, j) is at
+ * data + i*row_stride + j*col_stride. Transposed view swaps strides.
+ *
+ * @tparam T type of elements, const T for read only view
+ * @tparam ROWS number of rows or DYNAMIC_EXTENT
+ * @tparam COLS number of cols or DYNAMIC_EXTENT
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+class MatrixView
+	{
+	public:
+		using value_type = std::remove_const_t<T>;
+		using iterator = View::MatrixIterator<T>;
+
+	public:
+		T* data;
+		unsigned row_stride;
+		unsigned col_stride;
+		unsigned row_extent;
+		unsigned col_extent;
+
+	public:
+		/**
+		 * @brief View of ROWS x COLS elements with strides
+		 *
+		 * @param data pointer at first element
+		 * @param row_stride distance of rows
+		 * @param col_stride distance of cols
+		 */
+		template<unsigned R = ROWS,
+				 unsigned C = COLS,
+				 std::enable_if_t<R != DYNAMIC_EXTENT && C != DYNAMIC_EXTENT, int> = 0>
+		MatrixView ( T* data, unsigned row_stride = COLS, unsigned col_stride = 1 )
+			: data ( data ), row_stride ( row_stride ), col_stride ( col_stride ), row_extent ( ROWS ), col_extent ( COLS )
+			{
+			}
+
+		/**
+		 * @brief View of rows x cols elements with strides,
+		 * rows and cols must be equal to static extents
+		 *
+		 * @param data pointer at first element
+		 * @param rows number of rows
+		 * @param cols number of cols
+		 * @param row_stride distance of rows
+		 * @param col_stride distance of cols
+		 */
+		MatrixView ( T* data, unsigned rows, unsigned cols, unsigned row_stride, unsigned col_stride )
+			: data ( data ), row_stride ( row_stride ), col_stride ( col_stride ), row_extent ( rows ), col_extent ( cols )
+			{
+			View::checkExtent<ROWS, DYNAMIC_EXTENT> ( ROWS == DYNAMIC_EXTENT ? rows : ROWS, rows );
+			View::checkExtent<COLS, DYNAMIC_EXTENT> ( COLS == DYNAMIC_EXTENT ? cols : COLS, cols );
+			}
+
+		/**
+		 * @brief View of rows x cols elements stored contiguously by rows
+		 *
+		 * @param data pointer at first element
+		 * @param rows number of rows
+		 * @param cols number of cols
+		 */
+		template<unsigned R = ROWS,
+				 unsigned C = COLS,
+				 std::enable_if_t<R == DYNAMIC_EXTENT || C == DYNAMIC_EXTENT, int> = 0>
+		MatrixView ( T* data, unsigned rows, unsigned cols )
+			: MatrixView ( data, rows, cols, cols, 1 )
+			{
+			}
+
+		/**
+		 * @brief View of Matrix, const Matrix for view of const elements only
+		 *
+		 * @tparam U type of Matrix
+		 * @tparam ROWS_U number of rows of Matrix
+		 * @tparam COLS_U number of cols of Matrix
+		 * @param m Matrix
+		 */
+		template<typename U,
+				 unsigned ROWS_U,
+				 unsigned COLS_U,
+				 std::enable_if_t<std::is_convertible<U*, T*>::value
+								  && ( ROWS == DYNAMIC_EXTENT || ROWS == ROWS_U )
+								  && ( COLS == DYNAMIC_EXTENT || COLS == COLS_U ), int> = 0>
+		MatrixView ( Matrix<U, ROWS_U, COLS_U>& m )
+			: data ( *m.x ), row_stride ( COLS_U ), col_stride ( 1 ), row_extent ( ROWS_U ), col_extent ( COLS_U )
+			{
+			}
+
+		template<typename U,
+				 unsigned ROWS_U,
+				 unsigned COLS_U,
+				 std::enable_if_t<std::is_convertible<const U*, T*>::value
+								  && ( ROWS == DYNAMIC_EXTENT || ROWS == ROWS_U )
+								  && ( COLS == DYNAMIC_EXTENT || COLS == COLS_U ), int> = 0>
+		MatrixView ( const Matrix<U, ROWS_U, COLS_U>& m )
+			: data ( *m.x ), row_stride ( COLS_U ), col_stride ( 1 ), row_extent ( ROWS_U ), col_extent ( COLS_U )
+			{
+			}
+
+		/**
+		 * @brief View of the same elements as other, read only or of dynamic extent
+		 *
+		 * @tparam U type of other view
+		 * @tparam ROWS_U number of rows of other view
+		 * @tparam COLS_U number of cols of other view
+		 * @param other view
+		 */
+		template<typename U,
+				 unsigned ROWS_U,
+				 unsigned COLS_U,
+				 std::enable_if_t<std::is_convertible<U*, T*>::value
+								  && ( ROWS == DYNAMIC_EXTENT || ROWS == ROWS_U )
+								  && ( COLS == DYNAMIC_EXTENT || COLS == COLS_U ), int> = 0>
+		MatrixView ( const MatrixView<U, ROWS_U, COLS_U>& other )
+			: data ( other.data ), row_stride ( other.row_stride ), col_stride ( other.col_stride ),
+			  row_extent ( other.rows() ), col_extent ( other.cols() )
+			{
+			}
+
+		MatrixView ( const MatrixView& other ) = default;
+
+		/**
+		 * @brief Copy elements of other view into elements of this view,
+		 * view is not rebound
+		 *
+		 * @param other view of the same size
+		 * @return MatrixView&
+		 */
+		MatrixView& operator= ( const MatrixView& other )
+			{
+			return assign ( other );
+			}
+
+		/**
+		 * @brief Copy elements of Matrix or view into elements of this view
+		 *
+		 * @tparam M Matrix or view
+		 * @param other Matrix or view of the same size
+		 * @return MatrixView&
+		 */
+		template<class M, std::enable_if_t<View::traits<M>::matrix, int> = 0>
+		MatrixView& operator= ( const M& other )
+			{
+			return assign ( other );
+			}
+
+		/**
+		 * @brief Number of rows
+		 *
+		 * @return unsigned
+		 */
+		inline unsigned rows() const
+			{
+			return ROWS != DYNAMIC_EXTENT ? ROWS : row_extent;
+			}
+
+		/**
+		 * @brief Number of cols
+		 *
+		 * @return unsigned
+		 */
+		inline unsigned cols() const
+			{
+			return COLS != DYNAMIC_EXTENT ? COLS : col_extent;
+			}
+
+		/**
+		 * @brief Number of elements
+		 *
+		 * @return unsigned
+		 */
+		inline unsigned size() const
+			{
+			return rows() * cols();
+			}
+
+		inline iterator begin() const
+			{
+			return iterator ( data, 0, cols(), row_stride, col_stride );
+			}
+
+		inline iterator end() const
+			{
+			return iterator ( data, std::size_t ( rows() ) * row_stride, cols(), row_stride, col_stride );
+			}
+
+		/**
+		 * @brief Element at position (row, col), not checked
+		 *
+		 * @param row row index
+		 * @param col col index
+		 * @return T&
+		 */
+		inline T& operator() ( unsigned row, unsigned col ) const
+			{
+			return data[std::size_t ( row ) * row_stride + std::size_t ( col ) * col_stride];
+			}
+
+		/**
+		 * @brief View of row
+		 *
+		 * @param i row index
+		 * @return VectorView<T, COLS>
+		 */
+		inline VectorView<T, COLS> row ( unsigned i ) const
+			{
+			return VectorView<T, COLS> ( data + std::size_t ( i ) * row_stride, cols(), col_stride );
+			}
+
+		/**
+		 * @brief View of col
+		 *
+		 * @param j col index
+		 * @return VectorView<T, ROWS>
+		 */
+		inline VectorView<T, ROWS> col ( unsigned j ) const
+			{
+			return VectorView<T, ROWS> ( data + std::size_t ( j ) * col_stride, rows(), row_stride );
+			}
+
+		/**
+		 * @brief Transposed view of the same elements
+		 *
+		 * @return MatrixView<T, COLS, ROWS>
+		 */
+		inline MatrixView<T, COLS, ROWS> transpose() const
+			{
+			return MatrixView<T, COLS, ROWS> ( data, cols(), rows(), col_stride, row_stride );
+			}
+
+		/**
+		 * @brief Fill all elements by value
+		 *
+		 * @param value
+		 */
+		void fill ( value_type value ) const
+			{
+			Container::fill ( begin(), end(), value );
+			}
+
+		/**
+		 * @brief Sum of elements
+		 *
+		 * @return value_type
+		 */
+		value_type sum() const
+			{
+			value_type value = value_type ( 0 );
+
+			for ( const value_type x : *this )
+				value += x;
+
+			return value;
+			}
+
+		/**
+		 * @brief Multiply corresponding elements with Matrix or view
+		 *
+		 * @tparam M Matrix or view
+		 * @param other Matrix or view of the same extents
+		 * @return owning Matrix result
+		 */
+		template<class M,
+				 typename T_U = decltype ( value_type() * typename View::traits<M>::type() ),
+				 unsigned ROWS_ANS = View::Extent<ROWS, View::traits<M>::rows>::value,
+				 unsigned COLS_ANS = View::Extent<COLS, View::traits<M>::cols>::value,
+				 std::enable_if_t<View::traits<M>::matrix, int> = 0>
+		Matrix<T_U, ROWS_ANS, COLS_ANS> hadamardProduct ( const M& other ) const
+			{
+			static_assert ( ROWS_ANS != DYNAMIC_EXTENT && COLS_ANS != DYNAMIC_EXTENT,
+							"Result of views of dynamic extent must be written to view." );
+
+			Matrix<T_U, ROWS_ANS, COLS_ANS> ans;
+			View::elementwise<Multiply> ( *this, other, ans );
+
+			return ans;
+			}
+
+		template<class M, std::enable_if_t<View::traits<M>::matrix, int> = 0>
+		const MatrixView& operator+= ( const M& other ) const
+			{
+			return assignOperation<Add> ( other );
+			}
+
+		template<class M, std::enable_if_t<View::traits<M>::matrix, int> = 0>
+		const MatrixView& operator-= ( const M& other ) const
+			{
+			return assignOperation<Subtract> ( other );
+			}
+
+		template<class M, std::enable_if_t<View::traits<M>::matrix, int> = 0>
+		const MatrixView& hadamardProductAssign ( const M& other ) const
+			{
+			return assignOperation<Multiply> ( other );
+			}
+
+		template<typename U, std::enable_if_t<std::is_convertible<U, value_type>::value, int> = 0>
+		const MatrixView& operator+= ( U value ) const
+			{
+			Container::rangeElemetsValueOperationAssign<Add> ( begin(), end(), value );
+
+			return *this;
+			}
+
+		template<typename U, std::enable_if_t<std::is_convertible<U, value_type>::value, int> = 0>
+		const MatrixView& operator-= ( U value ) const
+			{
+			Container::rangeElemetsValueOperationAssign<Subtract> ( begin(), end(), value );
+
+			return *this;
+			}
+
+		template<typename U, std::enable_if_t<std::is_convertible<U, value_type>::value, int> = 0>
+		const MatrixView& operator*= ( U value ) const
+			{
+			Container::rangeElemetsValueOperationAssign<Multiply> ( begin(), end(), value );
+
+			return *this;
+			}
+
+		template<typename U, std::enable_if_t<std::is_convertible<U, value_type>::value, int> = 0>
+		const MatrixView& operator/= ( U value ) const
+			{
+			Container::rangeElemetsValueOperationAssign<Divide> ( begin(), end(), value );
+
+			return *this;
+			}
+
+	private:
+		// rows of contiguous views are processed by pointers, so loops are vectorized
+		template<class M>
+		MatrixView& assign ( const M& other )
+			{
+			const auto other_view = View::of ( other );
+			View::checkSameExtents ( *this, other_view );
+
+			for ( unsigned i = 0; i < rows(); ++i )
+				if ( col_stride == 1 && other_view.col_stride == 1 )
+					Container::copy ( &( *this ) ( i, 0 ), &( *this ) ( i, 0 ) + cols(), &other_view ( i, 0 ) );
+				else
+					Container::copy ( row ( i ).begin(), row ( i ).end(), other_view.row ( i ).begin() );
+
+			return *this;
+			}
+
+		template<template<typename, typename, typename> class operation, class M>
+		const MatrixView& assignOperation ( const M& other ) const
+			{
+			const auto other_view = View::of ( other );
+			View::checkSameExtents ( *this, other_view );
+
+			for ( unsigned i = 0; i < rows(); ++i )
+				if ( col_stride == 1 && other_view.col_stride == 1 )
+					Container::rangeElemetsOperationAssign<operation> ( &( *this ) ( i, 0 ), &( *this ) ( i, 0 ) + cols(),
+							&other_view ( i, 0 ) );
+				else
+					Container::rangeElemetsOperationAssign<operation> ( row ( i ).begin(), row ( i ).end(),
+							other_view.row ( i ).begin() );
+
+			return *this;
+			}
+	};
+
+namespace View
+	{
+	// owning result of element-wise operation, results of dynamic extent are written to views
+	template<typename T_U, unsigned SIZE>
+	struct VectorResult
+		{
+		using type = Vector<T_U, SIZE>;
+		};
+
+	template<typename T_U>
+	struct VectorResult<T_U, DYNAMIC_EXTENT>
+		{
+		};
+
+	template<typename T_U, unsigned ROWS, unsigned COLS, bool STATIC = ROWS != DYNAMIC_EXTENT && COLS != DYNAMIC_EXTENT>
+	struct MatrixResult
+		{
+		using type = Matrix<T_U, ROWS, COLS>;
+		};
+
+	template<typename T_U, unsigned ROWS, unsigned COLS>
+	struct MatrixResult<T_U, ROWS, COLS, false>
+		{
+		};
+
+	template<class A, class B, typename T_U, bool MATRIX = traits<A>::matrix>
+	struct Result
+		: VectorResult<T_U, Extent<traits<A>::size, traits<B>::size>::value>
+		{
+		};
+
+	template<class A, class B, typename T_U>
+	struct Result<A, B, T_U, true>
+		: MatrixResult<T_U, Extent<traits<A>::rows, traits<B>::rows>::value, Extent<traits<A>::cols, traits<B>::cols>::value>
+		{
+		};
+
+	template<class A, class B, typename T_U>
+	using result_type = typename Result<A, B, T_U>::type;
+
+	template<class A, class B>
+	using sum_type = decltype ( typename traits<A>::type() + typename traits<B>::type() );
+
+	template<class A, class B>
+	using product_type = decltype ( typename traits<A>::type() * typename traits<B>::type() );
+	}
+
+/* ELEMENT-WISE OPERATORS */
+
+/**
+ * @brief Add corresponding elements of Vectors or Matrices, at least one of them view
+ *
+ * @tparam A Vector, Matrix or view
+ * @tparam B Vector, Matrix or view
+ * @param first first argument
+ * @param second second argument
+ * @return owning Vector or Matrix result
+ */
+template<class A,
+		 class B,
+		 std::enable_if_t < ( View::traits<A>::vector && View::traits<B>::vector )
+						  || ( View::traits<A>::matrix && View::traits<B>::matrix ), int> = 0,
+		 std::enable_if_t<View::traits<A>::view || View::traits<B>::view, int> = 0>
+inline View::result_type<A, B, View::sum_type<A, B>> operator+ ( const A& first, const B& second )
+	{
+	View::result_type<A, B, View::sum_type<A, B>> ans;
+	View::elementwise<Add> ( first, second, ans );
+
+	return ans;
+	}
+
+/**
+ * @brief Subtract corresponding elements of Vectors or Matrices, at least one of them view
+ *
+ * @tparam A Vector, Matrix or view
+ * @tparam B Vector, Matrix or view
+ * @param first first argument
+ * @param second second argument
+ * @return owning Vector or Matrix result
+ */
+template<class A,
+		 class B,
+		 std::enable_if_t < ( View::traits<A>::vector && View::traits<B>::vector )
+						  || ( View::traits<A>::matrix && View::traits<B>::matrix ), int> = 0,
+		 std::enable_if_t<View::traits<A>::view || View::traits<B>::view, int> = 0>
+inline View::result_type<A, B, View::sum_type<A, B>> operator- ( const A& first, const B& second )
+	{
+	View::result_type<A, B, View::sum_type<A, B>> ans;
+	View::elementwise<Subtract> ( first, second, ans );
+
+	return ans;
+	}
+
+/**
+ * @brief Multiply corresponding elements of Vectors, at least one of them view
+ *
+ * @tparam A Vector or view
+ * @tparam B Vector or view
+ * @param first first argument
+ * @param second second argument
+ * @return owning Vector result
+ */
+template<class A, class B, View::enable_vectors<A, B> = 0>
+inline View::result_type<A, B, View::product_type<A, B>> operator* ( const A& first, const B& second )
+	{
+	View::result_type<A, B, View::product_type<A, B>> ans;
+	View::elementwise<Multiply> ( first, second, ans );
+
+	return ans;
+	}
+
+/**
+ * @brief Operation of elements of view and value
+ *
+ * @tparam A view
+ * @tparam U type of value
+ * @param first view
+ * @param value value
+ * @return owning Vector or Matrix result
+ */
+template<class A, typename U, View::enable_value<A, U> = 0>
+inline View::result_type<A, A, decltype ( typename View::traits<A>::type() + U() )> operator+ ( const A& first, U value )
+	{
+	View::result_type<A, A, decltype ( typename View::traits<A>::type() + U() )> ans;
+	View::elementwiseValue<Add> ( first, value, ans );
+
+	return ans;
+	}
+
+template<class A, typename U, View::enable_value<A, U> = 0>
+inline View::result_type<A, A, decltype ( typename View::traits<A>::type() - U() )> operator- ( const A& first, U value )
+	{
+	View::result_type<A, A, decltype ( typename View::traits<A>::type() - U() )> ans;
+	View::elementwiseValue<Subtract> ( first, value, ans );
+
+	return ans;
+	}
+
+template<class A, typename U, View::enable_value<A, U> = 0>
+inline View::result_type<A, A, decltype ( typename View::traits<A>::type() * U() )> operator* ( const A& first, U value )
+	{
+	View::result_type<A, A, decltype ( typename View::traits<A>::type() * U() )> ans;
+	View::elementwiseValue<Multiply> ( first, value, ans );
+
+	return ans;
+	}
+
+template<class A, typename U, View::enable_value<A, U> = 0>
+inline View::result_type<A, A, decltype ( typename View::traits<A>::type() / U() )> operator/ ( const A& first, U value )
+	{
+	View::result_type<A, A, decltype ( typename View::traits<A>::type() / U() )> ans;
+	View::elementwiseValue<Divide> ( first, value, ans );
+
+	return ans;
+	}
+
+template<class A, typename U, View::enable_value<A, U> = 0>
+inline View::result_type<A, A, decltype ( U() + typename View::traits<A>::type() )> operator+ ( U value, const A& first )
+	{
+	return first + value;
+	}
+
+template<class A, typename U, View::enable_value<A, U> = 0>
+inline View::result_type<A, A, decltype ( U() - typename View::traits<A>::type() )> operator- ( U value, const A& first )
+	{
+	View::result_type<A, A, decltype ( U() - typename View::traits<A>::type() )> ans;
+	View::elementwiseValue<SubtractInverse> ( first, value, ans );
+
+	return ans;
+	}
+
+template<class A, typename U, View::enable_value<A, U> = 0>
+inline View::result_type<A, A, decltype ( U() * typename View::traits<A>::type() )> operator* ( U value, const A& first )
+	{
+	return first * value;
+	}
+
+/* PRODUCTS */
+
+/**
+* @brief Computing Matrix Vector multiplication of views, or of views
+* and Matrix or Vector, written to output Vector or view.
+* Contiguous rows are reduced by vectorized Container::dot.
+* Output must not overlap inputs.
+*
+* @tparam A Matrix or view
+* @tparam B Vector or view
+* @tparam C Vector or view
+* @param first first Matrix
+* @param second second Vector
+* @param output Vector result of multiplication
+*/
+template<class A, class B, class C, View::enable_matrix_vector<A, B> = 0, std::enable_if_t<View::traits<C>::vector, int> = 0>
+void cauchyProduct ( const A& first, const B& second, C&& output )
+	{
+	using T_U = View::product_type<A, B>;
+
+	const auto first_view = View::of ( first );
+	const auto second_view = View::of ( second );
+	const auto output_view = View::of ( output );
+
+	View::checkExtent<View::traits<A>::cols, View::traits<B>::size> ( first_view.cols(), second_view.size() );
+	View::checkExtent<View::traits<A>::rows, View::traits<C>::size> ( first_view.rows(), output_view.size() );
+	Instrument::record ( Instrument::CAUCHY_PRODUCT, std::uint64_t ( 2 ) * first_view.rows() * first_view.cols(),
+						 std::uint64_t ( first_view.rows() ) * first_view.cols() * sizeof ( typename View::traits<A>::type )
+						 + second_view.size() * sizeof ( typename View::traits<B>::type )
+						 + output_view.size() * sizeof ( typename View::traits<C>::type ) );
+
+	for ( unsigned i = 0; i < first_view.rows(); ++i )
+		if ( first_view.col_stride == 1 && second_view.stride == 1 )
+			output_view ( i ) = Container::dot<T_U> ( &first_view ( i, 0 ), second_view.data, first_view.cols() );
+		else
+			output_view ( i ) = first_view.row ( i ).dot ( second_view );
+	}
+
+/**
+* @brief Computing Matrix multiplication of views, or of views and Matrix,
+* written to output Matrix or view. Rows of second are streamed into accumulator
+* row of 64 columns at most as in wideCauchyProduct, so the inner loop is
+* vectorized for contiguous rows. Output must not overlap inputs.
+*
+* @tparam A Matrix or view
+* @tparam B Matrix or view
+* @tparam C Matrix or view
+* @param first first Matrix
+* @param second second Matrix
+* @param output Matrix result of multiplication
+*/
+template<class A, class B, class C, View::enable_matrices<A, B> = 0, std::enable_if_t<View::traits<C>::matrix, int> = 0>
+void cauchyProduct ( const A& first, const B& second, C&& output )
+	{
+	using T_U = View::product_type<A, B>;
+	using T_O = typename View::traits<C>::type;
+
+	const auto first_view = View::of ( first );
+	const auto second_view = View::of ( second );
+	const auto output_view = View::of ( output );
+
+	View::checkExtent<View::traits<A>::cols, View::traits<B>::rows> ( first_view.cols(), second_view.rows() );
+	View::checkExtent<View::traits<A>::rows, View::traits<C>::rows> ( first_view.rows(), output_view.rows() );
+	View::checkExtent<View::traits<B>::cols, View::traits<C>::cols> ( second_view.cols(), output_view.cols() );
+	Instrument::record ( Instrument::CAUCHY_PRODUCT, std::uint64_t ( 2 ) * first_view.rows() * first_view.cols() * second_view.cols(),
+						 std::uint64_t ( first_view.rows() ) * first_view.cols() * sizeof ( typename View::traits<A>::type )
+						 + std::uint64_t ( second_view.rows() ) * second_view.cols() * sizeof ( typename View::traits<B>::type )
+						 + std::uint64_t ( output_view.rows() ) * output_view.cols() * sizeof ( T_O ) );
+
+	// number of output elements accumulated in local block
+	const unsigned BLOCK = 64;
+	const unsigned cols = output_view.cols();
+	const unsigned depth = first_view.cols();
+	const unsigned second_stride = second_view.col_stride;
+
+	// for each block of output columns
+	for ( unsigned j = 0; j < cols; j += BLOCK )
+		{
+		const unsigned width = cols - j < BLOCK ? cols - j : BLOCK;
+
+		for ( unsigned i = 0; i < first_view.rows(); ++i )
+			{
+			T_U accumulator[BLOCK] = {};
+
+			auto it_first = first_view.row ( i ).begin();
+			const auto* it_second = &second_view ( 0, j );
+
+			// accumulate first(i, k) * second(k, j:j+width), row pointer is formed for rows of view only
+			if ( second_stride == 1 )
+				for ( unsigned k = 0; k < depth; ++k, ++it_first )
+					{
+					const auto* it_row = it_second + std::size_t ( k ) * second_view.row_stride;
+					const T_U a_ik = T_U ( *it_first );
+
+					for ( unsigned w = 0; w < width; ++w )
+						accumulator[w] += a_ik * it_row[w];
+					}
+			else
+				for ( unsigned k = 0; k < depth; ++k, ++it_first )
+					{
+					const auto* it_row = it_second + std::size_t ( k ) * second_view.row_stride;
+					const T_U a_ik = T_U ( *it_first );
+
+					for ( unsigned w = 0; w < width; ++w )
+						accumulator[w] += a_ik * it_row[std::size_t ( w ) * second_stride];
+					}
+
+			T_O* it_output = &output_view ( i, j );
+
+			if ( output_view.col_stride == 1 )
+				for ( unsigned w = 0; w < width; ++w )
+					it_output[w] = T_O ( accumulator[w] );
+			else
+				for ( unsigned w = 0; w < width; ++w )
+					it_output[std::size_t ( w ) * output_view.col_stride] = T_O ( accumulator[w] );
+			}
+		}
+	}
+
+/**
+* @brief Computing outer product of Vector and single row Matrix, of views
+* or of views and Vector or Matrix, written to output Matrix or view.
+* Vector viewed by Vector::asColumn is multiplied as Matrix.
+* Output must not overlap inputs.
+*
+* @tparam A Vector or view
+* @tparam B Matrix or view of single row
+* @tparam C Matrix or view
+* @param first first Vector
+* @param second second Matrix
+* @param output Matrix result of multiplication
+*/
+template<class A, class B, class C, View::enable_vector_matrix<A, B> = 0, std::enable_if_t<View::traits<C>::matrix, int> = 0>
+void cauchyProduct ( const A& first, const B& second, C&& output )
+	{
+	using T_U = View::product_type<A, B>;
+	using T_O = typename View::traits<C>::type;
+
+	const auto first_view = View::of ( first );
+	const auto second_view = View::of ( second );
+	const auto output_view = View::of ( output );
+
+	View::checkExtent<View::traits<B>::rows, 1> ( second_view.rows(), 1 );
+	View::checkExtent<View::traits<A>::size, View::traits<C>::rows> ( first_view.size(), output_view.rows() );
+	View::checkExtent<View::traits<B>::cols, View::traits<C>::cols> ( second_view.cols(), output_view.cols() );
+	Instrument::record ( Instrument::CAUCHY_PRODUCT, std::uint64_t ( first_view.size() ) * second_view.cols(),
+						 first_view.size() * sizeof ( typename View::traits<A>::type )
+						 + second_view.cols() * sizeof ( typename View::traits<B>::type )
+						 + std::uint64_t ( output_view.rows() ) * output_view.cols() * sizeof ( T_O ) );
+
+	const unsigned cols = output_view.cols();
+	const auto* it_second = second_view.data;
+
+	for ( unsigned i = 0; i < first_view.size(); ++i )
+		{
+		const T_U a_i = T_U ( first_view ( i ) );
+		T_O* it_output = &output_view ( i, 0 );
+
+		if ( second_view.col_stride == 1 && output_view.col_stride == 1 )
+			for ( unsigned j = 0; j < cols; ++j )
+				it_output[j] = T_O ( a_i * it_second[j] );
+		else
+			for ( unsigned j = 0; j < cols; ++j )
+				it_output[std::size_t ( j ) * output_view.col_stride] = T_O ( a_i * it_second[std::size_t ( j ) * second_view.col_stride] );
+		}
+	}
+
+/**
+* @brief Computing transposed Matrix Vector multiplication of views, or of views
+* and Matrix or Vector, written to output Vector or view. Output is accumulated
+* row by row as in transposedCauchyProduct of Matrix, in blocks of 64 elements,
+* so each row of first is streamed once. Output must not overlap inputs.
+*
+* @tparam A Matrix or view which is multiplied as transposed
+* @tparam B Vector or view
+* @tparam C Vector or view
+* @param first first Matrix
+* @param second second Vector
+* @param output Vector result of multiplication
+*/
+template<class A, class B, class C, View::enable_matrix_vector<A, B> = 0, std::enable_if_t<View::traits<C>::vector, int> = 0>
+void transposedCauchyProduct ( const A& first, const B& second, C&& output )
+	{
+	using T_U = View::product_type<A, B>;
+	using T_O = typename View::traits<C>::type;
+
+	const auto first_view = View::of ( first );
+	const auto second_view = View::of ( second );
+	const auto output_view = View::of ( output );
+
+	View::checkExtent<View::traits<A>::rows, View::traits<B>::size> ( first_view.rows(), second_view.size() );
+	View::checkExtent<View::traits<A>::cols, View::traits<C>::size> ( first_view.cols(), output_view.size() );
+	Instrument::record ( Instrument::TRANSPOSED_CAUCHY_PRODUCT, std::uint64_t ( 2 ) * first_view.rows() * first_view.cols(),
+						 std::uint64_t ( first_view.rows() ) * first_view.cols() * sizeof ( typename View::traits<A>::type )
+						 + second_view.size() * sizeof ( typename View::traits<B>::type )
+						 + output_view.size() * sizeof ( T_O ) );
+
+	// number of output elements accumulated in local block
+	const unsigned BLOCK = 64;
+	const unsigned cols = first_view.cols();
+	const unsigned first_stride = first_view.col_stride;
+
+	// for each block of output elements
+	for ( unsigned j = 0; j < cols; j += BLOCK )
+		{
+		const unsigned width = cols - j < BLOCK ? cols - j : BLOCK;
+		T_U accumulator[BLOCK] = {};
+
+		// accumulate first(i, j:j+width) * second(i)
+		for ( unsigned i = 0; i < first_view.rows(); ++i )
+			{
+			const T_U value = T_U ( second_view ( i ) );
+			const auto* it_row = &first_view ( i, j );
+
+			if ( first_stride == 1 )
+				for ( unsigned w = 0; w < width; ++w )
+					accumulator[w] += it_row[w] * value;
+			else
+				for ( unsigned w = 0; w < width; ++w )
+					accumulator[w] += it_row[std::size_t ( w ) * first_stride] * value;
+			}
+
+		for ( unsigned w = 0; w < width; ++w )
+			output_view ( j + w ) = T_O ( accumulator[w] );
+		}
+	}
+
+/**
+* @brief Computing cross product of Vectors of 3 elements, at least one of them view,
+* written to output Vector or view. Operands are read before output is written,
+* so output may be one of them.
+*
+* @tparam A Vector or view
+* @tparam B Vector or view
+* @tparam C Vector or view
+* @param first first Vector
+* @param second second Vector
+* @param output Vector result of cross product
+*/
+template<class A, class B, class C, View::enable_vectors<A, B> = 0, std::enable_if_t<View::traits<C>::vector, int> = 0>
+void crossProduct ( const A& first, const B& second, C&& output )
+	{
+	using T_U = View::product_type<A, B>;
+	using T_O = typename View::traits<C>::type;
+
+	const auto first_view = View::of ( first );
+	const auto second_view = View::of ( second );
+	const auto output_view = View::of ( output );
+
+	View::checkExtent<View::traits<A>::size, 3> ( first_view.size(), 3 );
+	View::checkExtent<View::traits<B>::size, 3> ( second_view.size(), 3 );
+	View::checkExtent<View::traits<C>::size, 3> ( output_view.size(), 3 );
+	Instrument::record ( Instrument::CROSS_PRODUCT, 9, 3 * ( sizeof ( typename View::traits<A>::type )
+						 + sizeof ( typename View::traits<B>::type ) + sizeof ( T_O ) ) );
+
+	const T_U a0 = first_view ( 0 ), a1 = first_view ( 1 ), a2 = first_view ( 2 );
+	const T_U b0 = second_view ( 0 ), b1 = second_view ( 1 ), b2 = second_view ( 2 );
+
+	output_view ( 0 ) = T_O ( a1*b2 - a2*b1 );
+	output_view ( 1 ) = T_O ( a2*b0 - a0*b2 );
+	output_view ( 2 ) = T_O ( a0*b1 - a1*b0 );
+	}
+
+/**
+ * @brief Vector Matrix outer product of views, or of views and Vector or Matrix
+ *
+ * @tparam A Vector or view of static size
+ * @tparam B Matrix or view of single row
+ * @param first first Vector
+ * @param second second Matrix
+ * @return owning Matrix result
+ */
+template<class A, class B, View::enable_vector_matrix<A, B> = 0>
+inline Matrix<View::product_type<A, B>, View::traits<A>::size, View::traits<B>::cols> operator* ( const A& first, const B& second )
+	{
+	static_assert ( View::traits<A>::size != DYNAMIC_EXTENT && View::traits<B>::cols != DYNAMIC_EXTENT,
+					"Result of views of dynamic extent must be written to view." );
+
+	Matrix<View::product_type<A, B>, View::traits<A>::size, View::traits<B>::cols> ans;
+	cauchyProduct ( first, second, ans );
+
+	return ans;
+	}
+
+/**
+ * @brief Matrix Vector multiplication of views, or of views and Matrix or Vector
+ *
+ * @tparam A Matrix or view of static rows
+ * @tparam B Vector or view
+ * @param first first Matrix
+ * @param second second Vector
+ * @return owning Vector result
+ */
+template<class A, class B, View::enable_matrix_vector<A, B> = 0>
+inline Vector<View::product_type<A, B>, View::traits<A>::rows> operator* ( const A& first, const B& second )
+	{
+	static_assert ( View::traits<A>::rows != DYNAMIC_EXTENT, "Result of views of dynamic extent must be written to view." );
+
+	Vector<View::product_type<A, B>, View::traits<A>::rows> ans;
+	cauchyProduct ( first, second, ans );
+
+	return ans;
+	}
+
+/**
+ * @brief Matrix multiplication of views, or of views and Matrix
+ *
+ * @tparam A Matrix or view of static rows
+ * @tparam B Matrix or view of static cols
+ * @param first first Matrix
+ * @param second second Matrix
+ * @return owning Matrix result
+ */
+template<class A, class B, View::enable_matrices<A, B> = 0>
+inline Matrix<View::product_type<A, B>, View::traits<A>::rows, View::traits<B>::cols> operator* ( const A& first, const B& second )
+	{
+	static_assert ( View::traits<A>::rows != DYNAMIC_EXTENT && View::traits<B>::cols != DYNAMIC_EXTENT,
+					"Result of views of dynamic extent must be written to view." );
+
+	Matrix<View::product_type<A, B>, View::traits<A>::rows, View::traits<B>::cols> ans;
+	cauchyProduct ( first, second, ans );
+
+	return ans;
+	}
+
+/**
+ * @brief Display view of Vector
+ */
+template<typename T, unsigned SIZE>
+std::ostream& operator<< ( std::ostream& out, const VectorView<T, SIZE>& v )
+	{
+	return TextIO::print ( out, v.begin(), v.end() );
+	}
+
+/**
+ * @brief Display view of Matrix by rows through one buffer on stack
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+std::ostream& operator<< ( std::ostream& out, const MatrixView<T, ROWS, COLS>& m )
+	{
+	char text[TextIO::PRINT_BUFFER];
+	TextIO::Writer writer ( out, text, text + TextIO::PRINT_BUFFER );
+
+	for ( unsigned i = 0; i < m.rows(); ++i )
+		{
+		const VectorView<T, COLS> row = m.row ( i );
+		TextIO::printRow ( writer, row.begin(), row.end(), int ( out.precision() ) );
+		writer.put ( '\n' );
+		}
+
+	writer.flush();
+
+	return out;
+	}
+
+#endif // VIEW_HPP
@@ -0,0 +1,132 @@
+#ifndef BANDEDTEST_HPP
+#define BANDEDTEST_HPP
+
+#include <vector>
+#include <gtest/gtest.h>
+#include "Matrix.hpp"
+#include "LU.hpp"
+#include "Banded.hpp"
+
+TEST ( BandedTest, Tridiagonal_TestCase1 )
+	{
+	using type = double;
+	const unsigned SIZE = 10;
+	// 1D Laplacian, determinant SIZE+1
+	TridiagonalMatrix<type, SIZE> T ( -1, 2, -1 );
+	Matrix<type, SIZE, SIZE> D;
+	Vector<type, SIZE> x;
+	T.toDense ( D );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		x.x[i] = type ( i*i % 7 ) - 3;
+
+	Vector<type, SIZE> b = T * x;
+	Vector<type, SIZE> c = D * x;
+	Vector<type, SIZE> y;
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		{
+		EXPECT_DOUBLE_EQ ( b.x[i], c.x[i] ) << "Error product at " << i;
+
+		for ( unsigned j = 0; j < SIZE; ++j )
+			EXPECT_DOUBLE_EQ ( T ( i, j ), D ( i, j ) ) << "Error element at " << i << ", " << j;
+		}
+
+	ASSERT_TRUE ( tridiagonalSolve ( T, b, y ) ) << "Error regular system reported singular";
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		EXPECT_NEAR ( y.x[i], x.x[i], 1e-12 ) << "Error solve at " << i;
+
+	// zero pivot
+	T.diagonal.x[0] = 0;
+	EXPECT_FALSE ( tridiagonalSolve ( T, b, y ) ) << "Error zero pivot not detected";
+	}
+
+TEST ( BandedTest, TridiagonalBatch_TestCase2 )
+	{
+	using type = float;
+	const unsigned SIZE = 12;
+	const unsigned COUNT = 37;
+	std::vector<TridiagonalMatrix<type, SIZE>> matrices ( COUNT );
+	std::vector<Vector<type, SIZE>> rhs ( COUNT );
+	std::vector<Vector<type, SIZE>> out ( COUNT );
+	std::vector<bool> regular ( COUNT );
+
+	for ( unsigned n = 0; n < COUNT; ++n )
+		for ( unsigned i = 0; i < SIZE; ++i )
+			{
+			// diagonally dominant systems
+			matrices[n].lower.x[i] = type ( ( n + i ) % 5 ) * 0.25f - 0.5f;
+			matrices[n].upper.x[i] = type ( ( n*3 + i ) % 7 ) * 0.125f - 0.375f;
+			matrices[n].diagonal.x[i] = 2.0f + type ( ( n + 2*i ) % 3 );
+			rhs[n].x[i] = type ( ( n*i ) % 11 ) - 5.0f;
+			}
+
+	matrices[20].diagonal.x[0] = 0.0f;
+
+	EXPECT_EQ ( tridiagonalSolveBatch ( matrices.begin(), matrices.end(), rhs.begin(), out.begin(), regular.begin() ), 1u )
+			<< "Error number of singular systems";
+
+	for ( unsigned n = 0; n < COUNT; ++n )
+		{
+		Vector<type, SIZE> x;
+		const bool single_regular = tridiagonalSolve ( matrices[n], rhs[n], x );
+
+		EXPECT_EQ ( regular[n], single_regular ) << "Error regular flag of system " << n;
+
+		if ( ! single_regular )
+			continue;
+
+		for ( unsigned i = 0; i < SIZE; ++i )
+			EXPECT_NEAR ( out[n].x[i], x.x[i], 1e-5f ) << "Error batch solve of system " << n << " at " << i;
+		}
+	}
+
+TEST ( BandedTest, Banded_TestCase3 )
+	{
+	using type = double;
+	const unsigned SIZE = 20;
+	Matrix<type, SIZE, SIZE> D ( type ( 0 ) );
+	Vector<type, SIZE> x;
+
+	// band of 2 lower and 3 upper diagonals, diagonally dominant
+	for ( unsigned i = 0; i < SIZE; ++i )
+		{
+		x.x[i] = type ( i % 6 ) - 2.5;
+
+		for ( unsigned j = i > 2 ? i-2 : 0; j < std::min ( i+4, SIZE ); ++j )
+			D ( i, j ) = i == j ? type ( 8 ) : type ( ( i*3 + j ) % 5 ) * 0.5 - 1;
+		}
+
+	BandedMatrix<type, SIZE, 2, 3> B ( D );
+	Vector<type, SIZE> b = B * x;
+	Vector<type, SIZE> c = D * x;
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		{
+		EXPECT_NEAR ( b.x[i], c.x[i], 1e-12 ) << "Error product at " << i;
+
+		for ( unsigned j = 0; j < SIZE; ++j )
+			EXPECT_DOUBLE_EQ ( B ( i, j ), D ( i, j ) ) << "Error element at " << i << ", " << j;
+		}
+
+	BandedLUDecomposition<type, SIZE, 2, 3> lu ( B );
+	ASSERT_FALSE ( lu.isSingular() ) << "Error regular Matrix reported singular";
+
+	Vector<type, SIZE> y = lu.solve ( b );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		EXPECT_NEAR ( y.x[i], x.x[i], 1e-12 ) << "Error solve at " << i;
+
+	const type determinant = LUDecomposition<type, SIZE> ( D ).determinant();
+
+	EXPECT_NEAR ( lu.determinant() / determinant, 1.0, 1e-12 ) << "Error determinant";
+
+	BandedMatrix<type, SIZE, 2, 3> Z;
+	BandedLUDecomposition<type, SIZE, 2, 3> lu_zero ( Z );
+
+	EXPECT_TRUE ( lu_zero.isSingular() ) << "Error zero Matrix not singular";
+	EXPECT_THROW ( lu_zero.solve ( b ), std::runtime_error );
+	}
+
+#endif // BANDEDTEST_HPP
@@ -0,0 +1,132 @@
+#ifndef BINARYIOTEST_HPP
+#define BINARYIOTEST_HPP
+
+#include <cstdio>
+#include <list>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "BinaryIO.hpp"
+
+/**
+ * @brief Path of temporary file used by tests
+ */
+inline std::string binaryTestPath ( const char* name )
+	{
+	return ::testing::TempDir() + name;
+	}
+
+TEST ( BinaryIOTest, RoundTrip_TestCase1 )
+	{
+	const std::string path = binaryTestPath ( "vecmatlib_points.vmlb" );
+	std::vector<Vector<float, 3>> points ( 10001 );
+
+	for ( unsigned i = 0; i < points.size(); ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			points[i].x[j] = float ( i ) * 0.5f - float ( j );
+
+	writeBinary ( path, points.data(), points.data() + points.size() );
+
+		{
+		MappedArray<Vector<float, 3>> mapped ( path );
+
+		ASSERT_EQ ( mapped.size(), points.size() ) << "Error number of records";
+		EXPECT_EQ ( mapped.header().rows, 3u ) << "Error rows in header";
+		EXPECT_EQ ( mapped.header().data_offset % BinaryIO::ALIGNMENT, 0u ) << "Error alignment of data";
+		EXPECT_TRUE ( mapped.verify() ) << "Error checksum";
+
+		for ( unsigned i = 0; i < points.size(); ++i )
+			for ( unsigned j = 0; j < 3; ++j )
+				EXPECT_EQ ( mapped[i].x[j], points[i].x[j] ) << "Error record " << i << " at " << j;
+
+		// records are used in place by Vector operations
+		EXPECT_EQ ( mapped[7].dot ( mapped[7] ), points[7].dot ( points[7] ) ) << "Error operation on mapped record";
+		}
+
+	// range of any forward iterators crossing write buffer
+	const std::string matrices_path = binaryTestPath ( "vecmatlib_matrices.vmlb" );
+	std::list<Matrix<double, 6, 6>> matrices;
+
+	for ( unsigned i = 0; i < 5000; ++i )
+		{
+		matrices.push_back ( Matrix<double, 6, 6> ( double ( i ) ) );
+		matrices.back().x[i % 6][ ( i / 6 ) % 6] = -1.0;
+		}
+
+	writeBinary ( matrices_path, matrices.begin(), matrices.end() );
+	const std::vector<Matrix<double, 6, 6>> contiguous ( matrices.begin(), matrices.end() );
+	writeBinary ( path, contiguous.data(), contiguous.data() + contiguous.size() );
+
+	MappedArray<Matrix<double, 6, 6>> mapped ( matrices_path );
+	MappedArray<Matrix<double, 6, 6>> mapped_contiguous ( path );
+
+	ASSERT_EQ ( mapped.size(), 5000u ) << "Error number of Matrix records";
+	EXPECT_TRUE ( mapped.verify() ) << "Error checksum of buffered write";
+	EXPECT_EQ ( mapped.header().checksum, mapped_contiguous.header().checksum ) << "Error checksum differs by write";
+
+	unsigned i = 0;
+
+	for ( const Matrix<double, 6, 6>& m : mapped )
+		{
+		EXPECT_EQ ( m.x[i % 6][ ( i / 6 ) % 6], -1.0 ) << "Error Matrix record " << i;
+		EXPECT_EQ ( m.x[5][5] + m.x[0][0], ( i % 6 == 0 && ( i / 6 ) % 6 == 0 ) || ( i % 6 == 5 && ( i / 6 ) % 6 == 5 ) ? double ( i ) - 1.0 : 2.0 * i )
+				<< "Error Matrix record " << i;
+		++i;
+		}
+
+	std::remove ( path.c_str() );
+	std::remove ( matrices_path.c_str() );
+	}
+
+TEST ( BinaryIOTest, Validation_TestCase2 )
+	{
+	const std::string path = binaryTestPath ( "vecmatlib_validation.vmlb" );
+	using Mapped = MappedArray<Vector<double, 4>>;
+	using MappedFloat = MappedArray<Vector<float, 4>>;
+	using MappedShort = MappedArray<Vector<double, 3>>;
+	using MappedColumn = MappedArray<Matrix<double, 4, 1>>;
+	using MappedRow = MappedArray<Matrix<double, 1, 4>>;
+	std::vector<Vector<double, 4>> vectors ( 100, Vector<double, 4> ( 1.5 ) );
+	writeBinary ( path, vectors.data(), vectors.data() + vectors.size() );
+
+	EXPECT_THROW ( MappedFloat m ( path ), std::runtime_error ) << "Error element type check";
+	EXPECT_THROW ( MappedShort m ( path ), std::runtime_error ) << "Error dimensions check";
+	EXPECT_THROW ( MappedRow m ( path ), std::runtime_error ) << "Error dimensions of Matrix check";
+	// Vector has layout of single col Matrix
+	EXPECT_EQ ( MappedColumn ( path ) [99].x[3][0], 1.5 ) << "Error Vector mapped as Matrix";
+	EXPECT_THROW ( MappedArray<double> m ( binaryTestPath ( "vecmatlib_missing.vmlb" ) ), std::runtime_error ) << "Error missing file";
+
+	// corrupted record
+	std::FILE* file = std::fopen ( path.c_str(), "r+b" );
+	ASSERT_TRUE ( file != nullptr );
+	std::fseek ( file, 64 + 8*17, SEEK_SET );
+	std::fputc ( 0x7f, file );
+	std::fclose ( file );
+	EXPECT_FALSE ( Mapped ( path ).verify() ) << "Error corruption not detected";
+
+	// truncated data, count in header exceeds file
+	BinaryIO::Header h = BinaryIO::header<Vector<double, 4>> ( 101, 0 );
+	file = std::fopen ( path.c_str(), "r+b" );
+	ASSERT_TRUE ( file != nullptr );
+	std::fwrite ( &h, sizeof ( h ), 1, file );
+	std::fclose ( file );
+	EXPECT_THROW ( Mapped m ( path ), std::runtime_error ) << "Error truncation check";
+
+	// not a container
+	file = std::fopen ( path.c_str(), "wb" );
+	ASSERT_TRUE ( file != nullptr );
+	std::fputs ( "1.0 2.0 3.0 4.0\n", file );
+	std::fclose ( file );
+	EXPECT_THROW ( Mapped m ( path ), std::runtime_error ) << "Error magic check";
+
+	// empty range
+	writeBinary ( path, vectors.data(), vectors.data() );
+	EXPECT_EQ ( Mapped ( path ).size(), 0u ) << "Error empty container";
+
+	std::remove ( path.c_str() );
+	}
+
+#endif // BINARYIOTEST_HPP
@@ -0,0 +1,170 @@
+#ifndef CHOLESKYTEST_HPP
+#define CHOLESKYTEST_HPP
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include "Matrix.hpp"
+#include "Cholesky.hpp"
+
+/**
+ * @brief Fill symmetric positive definite Matrix by deterministic values
+ */
+template<typename T, unsigned SIZE>
+void fillSymmetricPositiveDefinite ( Matrix<T, SIZE, SIZE>& m )
+	{
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j <= i; ++j )
+			m ( i, j ) = m ( j, i ) = T ( ( i*13 + j*7 ) % 19 ) / T ( 19 ) - T ( 0.5 );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		m ( i, i ) += T ( SIZE );
+	}
+
+TEST ( CholeskyTest, Decomposition_TestCase1 )
+	{
+	using type = double;
+	Matrix<type, 3, 3> M{4, 12, -16,
+						 12, 37, -43,
+						 -16, -43, 98};
+	Matrix<type, 3, 3> L{2, 0, 0,
+						 6, 1, 0,
+						 -8, 5, 3};
+	CholeskyDecomposition<type, 3> llt ( M );
+
+	EXPECT_TRUE ( llt.isPositiveDefinite() ) << "Error positive definite matrix not detected";
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			EXPECT_NEAR ( llt.l ( i, j ), L ( i, j ), 1e-12 ) << "Error L at " << i << ", " << j;
+
+	EXPECT_NEAR ( llt.determinant(), 36.0, 1e-10 ) << "Error determinant";
+	EXPECT_NEAR ( llt.logDeterminant(), std::log ( 36.0 ), 1e-12 ) << "Error log determinant";
+	}
+
+TEST ( CholeskyTest, Solve_TestCase2 )
+	{
+	using type = double;
+	Matrix<type, 3, 3> M{4, 12, -16,
+						 12, 37, -43,
+						 -16, -43, 98};
+	Vector<type, 3> x{1, -2, 3};
+	Vector<type, 3> b = M*x;
+	CholeskyDecomposition<type, 3> llt ( M );
+	Vector<type, 3> y = llt.solve ( b );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		EXPECT_NEAR ( y.x[i], x.x[i], 1e-10 ) << "Error solve at " << i;
+
+	// transpose(L)*x = inverse(L)*b
+	Vector<type, 3> z = llt.solveLower ( b );
+	Vector<type, 3> c = llt.l.transposedMul ( y );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		EXPECT_NEAR ( c.x[i], z.x[i], 1e-12 ) << "Error solveLower at " << i;
+	}
+
+TEST ( CholeskyTest, NotPositiveDefinite_TestCase3 )
+	{
+	using type = float;
+	Matrix<type, 3, 3> M{1, 2, 0,
+						 2, 1, 0,
+						 0, 0, 1};
+	CholeskyDecomposition<type, 3> llt ( M );
+
+	EXPECT_FALSE ( llt.isPositiveDefinite() ) << "Error indefinite matrix not detected";
+	EXPECT_THROW ( llt.solve ( Vector<type, 3> ( 1.0f ) ), std::runtime_error );
+
+	// LDLT works for indefinite matrix with non zero leading minors
+	LDLTDecomposition<type, 3> ldlt ( M );
+
+	EXPECT_FALSE ( ldlt.isSingular() ) << "Error LDLT singular";
+	EXPECT_FALSE ( ldlt.isPositiveDefinite() ) << "Error LDLT positive definite";
+	EXPECT_NEAR ( ldlt.determinant(), -3.0f, 1e-5f ) << "Error LDLT determinant";
+
+	Vector<type, 3> x{1, -2, 3};
+	Vector<type, 3> y = ldlt.solve ( M*x );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		EXPECT_NEAR ( y.x[i], x.x[i], 1e-5f ) << "Error LDLT solve at " << i;
+	}
+
+TEST ( CholeskyTest, LargeMatrix_TestCase4 )
+	{
+	using type = double;
+	const unsigned SIZE = 20;
+	Matrix<type, SIZE, SIZE> M;
+	Matrix<type, SIZE, 3> X;
+	fillSymmetricPositiveDefinite ( M );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			X ( i, j ) = type ( i ) - type ( j*SIZE/2 );
+
+	CholeskyDecomposition<type, SIZE> llt ( M );
+	LDLTDecomposition<type, SIZE> ldlt ( M );
+
+	ASSERT_TRUE ( llt.isPositiveDefinite() ) << "Error positive definite matrix not detected";
+	ASSERT_TRUE ( ldlt.isPositiveDefinite() ) << "Error LDLT positive definite matrix not detected";
+	EXPECT_NEAR ( llt.logDeterminant(), ldlt.logDeterminant(), 1e-10 ) << "Error log determinant";
+
+	// L*transpose(L) = M
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < SIZE; ++j )
+			{
+			type value = 0;
+
+			for ( unsigned k = 0; k < SIZE; ++k )
+				value += llt.l ( i, k ) * llt.l ( j, k );
+
+			EXPECT_NEAR ( value, M ( i, j ), 1e-12 ) << "Error L*transpose(L) at " << i << ", " << j;
+			}
+
+	Matrix<type, SIZE, 3> B = M*X;
+	Matrix<type, SIZE, 3> Y = llt.solve ( B );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			EXPECT_NEAR ( Y ( i, j ), X ( i, j ), 1e-10 ) << "Error solve at " << i << ", " << j;
+	}
+
+TEST ( CholeskyTest, RankOneUpdate_TestCase5 )
+	{
+	using type = double;
+	const unsigned SIZE = 5;
+	Matrix<type, SIZE, SIZE> M;
+	Vector<type, SIZE> v{1, -2, 0.5, 3, -1};
+	fillSymmetricPositiveDefinite ( M );
+
+	Matrix<type, SIZE, SIZE> M_updated ( M );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < SIZE; ++j )
+			M_updated ( i, j ) += 0.5 * v.x[i] * v.x[j];
+
+	CholeskyDecomposition<type, SIZE> llt ( M );
+	CholeskyDecomposition<type, SIZE> llt_updated ( M_updated );
+
+	ASSERT_TRUE ( llt.rankOneUpdate ( v, 0.5 ) ) << "Error update";
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < SIZE; ++j )
+			EXPECT_NEAR ( llt.l ( i, j ), llt_updated.l ( i, j ), 1e-12 ) << "Error update at " << i << ", " << j;
+
+	ASSERT_TRUE ( llt.rankOneUpdate ( v, -0.5 ) ) << "Error downdate";
+
+	CholeskyDecomposition<type, SIZE> llt_original ( M );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < SIZE; ++j )
+			EXPECT_NEAR ( llt.l ( i, j ), llt_original.l ( i, j ), 1e-12 ) << "Error downdate at " << i << ", " << j;
+
+	// downdate to indefinite Matrix fails and keeps decomposition
+	Matrix<type, SIZE, SIZE> L ( llt.l );
+	EXPECT_FALSE ( llt.rankOneUpdate ( v, -100.0 ) ) << "Error indefinite downdate not detected";
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < SIZE; ++j )
+			EXPECT_DOUBLE_EQ ( llt.l ( i, j ), L ( i, j ) ) << "Error failed downdate modified L at " << i << ", " << j;
+	}
+
+#endif // CHOLESKYTEST_HPP
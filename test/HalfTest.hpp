@@ -0,0 +1,164 @@
+#ifndef HALFTEST_HPP
+#define HALFTEST_HPP
+
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Matrix.hpp"
+#include "Half.hpp"
+
+TEST ( HalfTest, HalfConversion_TestCase1 )
+	{
+	// all binary16 numbers
+	for ( unsigned bits = 0; bits < 0x10000u; ++bits )
+		{
+		const Half h = Half::fromBits ( std::uint16_t ( bits ) );
+		const unsigned exponent = ( bits >> 10 ) & 0x1Fu;
+		const unsigned mantissa = bits & 0x3FFu;
+		const float sign = bits & 0x8000u ? -1.0f : 1.0f;
+		const float value = float ( h );
+
+		if ( exponent == 0x1Fu )
+			{
+			EXPECT_TRUE ( mantissa == 0 ? std::isinf ( value ) : std::isnan ( value ) ) << "Error special value " << bits;
+			continue;
+			}
+
+		const float reference = exponent == 0 ?
+								sign * std::ldexp ( float ( mantissa ), -24 ) :
+								sign * std::ldexp ( float ( mantissa + 0x400u ), int ( exponent ) - 25 );
+
+		ASSERT_EQ ( value, reference ) << "Error value of " << bits;
+		ASSERT_EQ ( Half ( value ).bits, bits ) << "Error float round trip of " << bits;
+		ASSERT_EQ ( Half ( double ( value ) ).bits, bits ) << "Error double round trip of " << bits;
+		}
+
+	// ties to even, overflow, subnormals
+	EXPECT_EQ ( Half ( 1.0f + std::ldexp ( 1.0f, -11 ) ).bits, 0x3C00u ) << "Error tie to even down";
+	EXPECT_EQ ( Half ( 1.0f + 3*std::ldexp ( 1.0f, -11 ) ).bits, 0x3C02u ) << "Error tie to even up";
+	EXPECT_EQ ( Half ( 65519.0f ).bits, 0x7BFFu ) << "Error largest finite";
+	EXPECT_EQ ( Half ( 65520.0f ).bits, 0x7C00u ) << "Error overflow to infinity";
+	EXPECT_EQ ( Half ( -std::ldexp ( 1.0f, -24 ) ).bits, 0x8001u ) << "Error smallest subnormal";
+	EXPECT_EQ ( Half ( std::ldexp ( 1.0f, -25 ) ).bits, 0x0000u ) << "Error subnormal tie to zero";
+	EXPECT_EQ ( Half ( 1.5f * std::ldexp ( 1.0f, -25 ) ).bits, 0x0001u ) << "Error subnormal rounding";
+	EXPECT_EQ ( Half ( std::ldexp ( 1023.5f, -24 ) ).bits, 0x0400u ) << "Error subnormal rounding to normal";
+	EXPECT_TRUE ( std::isnan ( float ( Half ( std::nan ( "" ) ) ) ) ) << "Error NaN";
+
+	// above midpoint in double, rounded to the midpoint in float
+	EXPECT_EQ ( Half ( 1.0 + std::ldexp ( 1.0, -11 ) + std::ldexp ( 1.0, -40 ) ).bits, 0x3C01u ) << "Error double rounding";
+	EXPECT_EQ ( Half ( 2 ).bits, 0x4000u ) << "Error integer conversion";
+	}
+
+TEST ( HalfTest, BFloat16Conversion_TestCase2 )
+	{
+	for ( unsigned bits = 0; bits < 0x10000u; ++bits )
+		{
+		const BFloat16 b = BFloat16::fromBits ( std::uint16_t ( bits ) );
+		const float value = float ( b );
+
+		if ( std::isnan ( value ) )
+			{
+			EXPECT_TRUE ( std::isnan ( float ( BFloat16 ( value ) ) ) ) << "Error NaN " << bits;
+			continue;
+			}
+
+		ASSERT_EQ ( BFloat16 ( value ).bits, bits ) << "Error float round trip of " << bits;
+		ASSERT_EQ ( BFloat16 ( double ( value ) ).bits, bits ) << "Error double round trip of " << bits;
+		}
+
+	EXPECT_EQ ( BFloat16 ( 1.0f + std::ldexp ( 1.0f, -8 ) ).bits, 0x3F80u ) << "Error tie to even down";
+	EXPECT_EQ ( BFloat16 ( 1.0f + 3*std::ldexp ( 1.0f, -8 ) ).bits, 0x3F82u ) << "Error tie to even up";
+	EXPECT_EQ ( BFloat16 ( 1.0 + std::ldexp ( 1.0, -8 ) + std::ldexp ( 1.0, -30 ) ).bits, 0x3F81u ) << "Error double rounding";
+	EXPECT_TRUE ( std::isinf ( float ( BFloat16 ( 3.4e38f ) ) ) ) << "Error overflow to infinity";
+	}
+
+TEST ( HalfTest, BulkConversion_TestCase3 )
+	{
+	const unsigned size = 1003;
+	std::vector<float> values ( size );
+	std::vector<float> out ( size );
+	std::vector<double> out_double ( size );
+	std::vector<Half> halfs ( size );
+	std::vector<BFloat16> bfloats ( size );
+
+	// normal numbers of both formats, AVX-512 BF16 flushes subnormals
+	for ( unsigned i = 0; i < size; ++i )
+		values[i] = std::ldexp ( 1.0f + float ( i * 37 % 1000 ) * 1.234567e-3f, int ( i % 20 ) - 10 ) * ( i % 2 ? -1.0f : 1.0f );
+
+	convert ( values.data(), values.data() + size, halfs.data() );
+	convert ( values.data(), values.data() + size, bfloats.data() );
+
+	for ( unsigned i = 0; i < size; ++i )
+		{
+		ASSERT_EQ ( halfs[i].bits, Half ( values[i] ).bits ) << "Error bulk float to Half at " << i;
+		ASSERT_EQ ( bfloats[i].bits, BFloat16 ( values[i] ).bits ) << "Error bulk float to BFloat16 at " << i;
+		}
+
+	convert ( halfs.data(), halfs.data() + size, out.data() );
+	convert ( bfloats.data(), bfloats.data() + size, out_double.data() );
+
+	for ( unsigned i = 0; i < size; ++i )
+		{
+		ASSERT_EQ ( out[i], float ( halfs[i] ) ) << "Error bulk Half to float at " << i;
+		ASSERT_EQ ( out_double[i], double ( float ( bfloats[i] ) ) ) << "Error bulk BFloat16 to double at " << i;
+		EXPECT_NEAR ( out[i], values[i], std::abs ( values[i] ) * 0.5f / 1024 ) << "Error Half precision at " << i;
+		}
+
+	convert ( out_double.data(), out_double.data() + size, halfs.data() );
+
+	for ( unsigned i = 0; i < size; ++i )
+		ASSERT_EQ ( halfs[i].bits, Half ( out_double[i] ).bits ) << "Error bulk double to Half at " << i;
+	}
+
+TEST ( HalfTest, Products_TestCase4 )
+	{
+	const unsigned rows = 8;
+	const unsigned cols = 40;
+	Matrix<Half, rows, cols> H;
+	Matrix<BFloat16, rows, cols> B;
+	Matrix<float, rows, cols> F;
+	Vector<Half, cols> v;
+	Vector<float, cols> w;
+
+	for ( unsigned j = 0; j < cols; ++j )
+		{
+		v.x[j] = Half ( 0.125f * float ( j % 9 ) - 0.5f );
+		w.x[j] = v.x[j];
+
+		for ( unsigned i = 0; i < rows; ++i )
+			{
+			H ( i, j ) = Half ( float ( ( i*3 + j ) % 11 ) - 5.0f );
+			B ( i, j ) = BFloat16 ( float ( H ( i, j ) ) );
+			F ( i, j ) = H ( i, j );
+			}
+		}
+
+	// products are computed and accumulated in float
+	Vector<float, rows> reference = F * w;
+	Vector<float, rows> half_product = H * v;
+	Vector<float, rows> bfloat_product;
+	Vector<double, rows> wide_product;
+	cauchyProduct ( B, w, bfloat_product );
+	wideCauchyProduct ( H, v, wide_product );
+
+	for ( unsigned i = 0; i < rows; ++i )
+		{
+		EXPECT_EQ ( half_product.x[i], reference.x[i] ) << "Error Half product at " << i;
+		EXPECT_EQ ( bfloat_product.x[i], reference.x[i] ) << "Error BFloat16 product at " << i;
+		EXPECT_DOUBLE_EQ ( wide_product.x[i], double ( reference.x[i] ) ) << "Error wide Half product at " << i;
+		}
+
+	// Container kernels
+	EXPECT_FLOAT_EQ ( float ( Container::sum ( v.begin(), v.end() ) ), Container::sum ( w.begin(), w.end() ) ) << "Error sum";
+	EXPECT_FLOAT_EQ ( v.dot ( v ), w.dot ( w ) ) << "Error dot";
+
+	Half h ( 1.5f );
+	h *= 2;
+	h += Half ( 0.5f );
+
+	EXPECT_EQ ( float ( h ), 3.5f ) << "Error compound assignment";
+	EXPECT_EQ ( float ( -h ), -3.5f ) << "Error negation";
+	EXPECT_TRUE ( Half ( 1.0f ) < BFloat16 ( 2.0f ) ) << "Error comparison";
+	}
+
+#endif // HALFTEST_HPP
@@ -0,0 +1,78 @@
+#ifndef INSTRUMENTTEST_HPP
+#define INSTRUMENTTEST_HPP
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "Instrument.hpp"
+
+TEST ( InstrumentTest, Counters_TestCase1 )
+	{
+	Instrument::reset();
+
+	Matrix<double, 3, 4> M ( 1.0 );
+	Vector<double, 4> v ( 2.0 );
+	Vector<double, 3> out;
+	Vector<float, 3> a { 1.0f, 0.0f, 0.0f }, b { 0.0f, 1.0f, 0.0f };
+	cauchyProduct ( M, v, out );
+	transposedCauchyProduct ( M, out, v );
+	const Vector<float, 3> c = a + b;
+	const float d = a.dot ( c );
+	const Vector<float, 3> e = a.cross ( b );
+	const Vector<float, 3> s = cartesianToSpherical ( e );
+
+	EXPECT_EQ ( d + e.x[2] + s.x[2], 3.0f ) << "Error results of instrumented kernels";
+
+	const Instrument::Snapshot snapshot = Instrument::snapshot();
+
+#if defined ( VECMATLIB_INSTRUMENT )
+	EXPECT_EQ ( snapshot[Instrument::CAUCHY_PRODUCT].calls, 1u ) << "Error calls of cauchyProduct";
+	EXPECT_EQ ( snapshot[Instrument::CAUCHY_PRODUCT].flops, 24u ) << "Error flops of cauchyProduct";
+	EXPECT_EQ ( snapshot[Instrument::CAUCHY_PRODUCT].bytes, ( 12u + 4u + 3u ) * sizeof ( double ) ) << "Error bytes of cauchyProduct";
+	EXPECT_EQ ( snapshot[Instrument::TRANSPOSED_CAUCHY_PRODUCT].calls, 1u ) << "Error calls of transposedCauchyProduct";
+	EXPECT_EQ ( snapshot[Instrument::ELEMENTS_OPERATION].flops, 3u ) << "Error flops of rangeElemetsOperation";
+	EXPECT_EQ ( snapshot[Instrument::DOT].calls, 1u ) << "Error calls of dot";
+	EXPECT_EQ ( snapshot[Instrument::CROSS_PRODUCT].calls, 1u ) << "Error calls of crossProduct";
+	EXPECT_EQ ( snapshot[Instrument::CONVERSION].calls, 1u ) << "Error calls of conversion";
+	EXPECT_EQ ( snapshot.total().calls, 6u ) << "Error total calls";
+	EXPECT_EQ ( Instrument::threadSnapshot().total().calls, 6u ) << "Error calls of thread";
+
+	// counts of other threads are aggregated, also after they finished
+	std::vector<std::thread> threads;
+
+	for ( unsigned t = 0; t < 3; ++t )
+		threads.emplace_back ( [] ()
+			{
+			Vector<int, 8> x ( 1 );
+
+			for ( unsigned i = 0; i < 1000; ++i )
+				x.x[0] = x.dot ( x ) % 7;
+			} );
+
+	for ( std::thread& thread : threads )
+		thread.join();
+
+	EXPECT_EQ ( Instrument::snapshot()[Instrument::DOT].calls, 3001u ) << "Error aggregated calls of threads";
+	EXPECT_EQ ( Instrument::snapshot()[Instrument::DOT].flops, 2u * 3 + 3000u * 16 ) << "Error aggregated flops of threads";
+	EXPECT_EQ ( Instrument::threadSnapshot()[Instrument::DOT].calls, 1u ) << "Error calls of thread";
+
+	std::ostringstream json;
+	Instrument::writeJson ( json, Instrument::snapshot() );
+	EXPECT_NE ( json.str().find ( "\"cauchyProduct\": { \"calls\": 1, \"flops\": 24, \"bytes\": 152 }" ), std::string::npos ) << "Error JSON " << json.str();
+	EXPECT_NE ( json.str().find ( "\"total\": { \"calls\": 3006," ), std::string::npos ) << "Error JSON " << json.str();
+#else
+	// disabled policy counts nothing
+	EXPECT_EQ ( snapshot.total().calls, 0u ) << "Error calls counted without instrumentation";
+	EXPECT_EQ ( snapshot.total().bytes, 0u ) << "Error bytes counted without instrumentation";
+#endif
+
+	Instrument::reset();
+	EXPECT_EQ ( Instrument::snapshot().total().calls, 0u ) << "Error reset";
+	EXPECT_EQ ( Instrument::threadSnapshot().total().flops, 0u ) << "Error reset of thread";
+	}
+
+#endif // INSTRUMENTTEST_HPP
@@ -0,0 +1,149 @@
+#ifndef LUTEST_HPP
+#define LUTEST_HPP
+
+#include <memory>
+#include <gtest/gtest.h>
+#include "Matrix.hpp"
+#include "LU.hpp"
+
+/**
+ * @brief Fill Matrix by deterministic values with dominant diagonal
+ */
+template<typename T, unsigned SIZE>
+void fillDiagonallyDominant ( Matrix<T, SIZE, SIZE>& m )
+	{
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < SIZE; ++j )
+			m ( i, j ) = T ( ( i*13 + j*7 ) % 19 ) / T ( 19 ) - T ( 0.5 );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		m ( i, i ) += T ( SIZE );
+	}
+
+/**
+ * @brief Check if m1*m2 is identity Matrix
+ */
+template<typename T, unsigned SIZE>
+void expectIdentityProduct ( const Matrix<T, SIZE, SIZE>& m1, const Matrix<T, SIZE, SIZE>& m2, T tolerance )
+	{
+	Matrix<T, SIZE, SIZE> product = m1*m2;
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < SIZE; ++j )
+			EXPECT_NEAR ( product ( i, j ), i == j ? T ( 1 ) : T ( 0 ), tolerance ) << "Error m*inverse(m) at " << i << ", " << j;
+	}
+
+TEST ( LUTest, Determinant_TestCase1 )
+	{
+	using type = double;
+	// requires row exchange at first column
+	Matrix<type, 3, 3> M{0, 2, 1,
+						 1, 1, 1,
+						 2, 1, 3};
+
+	EXPECT_DOUBLE_EQ ( determinant ( M ), -3.0 ) << "Error determinant";
+	LUDecomposition<type, 3> lu ( M );
+
+	EXPECT_DOUBLE_EQ ( lu.determinant(), -3.0 ) << "Error LU determinant";
+	}
+
+TEST ( LUTest, Solve_TestCase2 )
+	{
+	using type = double;
+	Matrix<type, 3, 3> M{0, 2, 1,
+						 1, 1, 1,
+						 2, 1, 3};
+	Vector<type, 3> x{1, -2, 3};
+	Vector<type, 3> b = M*x;
+	Vector<type, 3> y = solve ( M, b );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		EXPECT_NEAR ( y.x[i], x.x[i], 1e-12 ) << "Error solve at " << i;
+
+	Vector<type, 3> z = LUDecomposition<type, 3> ( M ).solveTransposed ( x );
+	Vector<type, 3> c = M.transposedMul ( z );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		EXPECT_NEAR ( c.x[i], x.x[i], 1e-12 ) << "Error solveTransposed at " << i;
+	}
+
+TEST ( LUTest, Singular_TestCase3 )
+	{
+	using type = float;
+	Matrix<type, 3, 3> M{1, 2, 3,
+						 2, 4, 6,
+						 1, 0, 1};
+	LUDecomposition<type, 3> lu ( M );
+
+	EXPECT_TRUE ( lu.isSingular() ) << "Error singular matrix not detected";
+	EXPECT_FLOAT_EQ ( lu.determinant(), 0.0f ) << "Error singular matrix determinant";
+	EXPECT_FLOAT_EQ ( lu.rcond(), 0.0f ) << "Error singular matrix rcond";
+	EXPECT_THROW ( lu.solve ( Vector<type, 3> ( 1.0f ) ), std::runtime_error ) << "Error solve with singular matrix";
+	EXPECT_THROW ( inverse ( M ), std::runtime_error ) << "Error inverse of singular matrix";
+	}
+
+TEST ( LUTest, Inverse_TestCase4 )
+	{
+	using type = double;
+	const unsigned size = 12;
+	Matrix<type, size, size> M;
+	fillDiagonallyDominant ( M );
+
+	expectIdentityProduct ( M, inverse ( M ), 1e-12 );
+	}
+
+TEST ( LUTest, BlockedInverse_TestCase5 )
+	{
+	using type = double;
+	// larger than LUDecomposition::BLOCKED_SIZE and not multiple of block
+	const unsigned size = 70;
+	std::unique_ptr<Matrix<type, size, size>> M ( new Matrix<type, size, size> );
+	fillDiagonallyDominant ( *M );
+	// force pivoting across blocks
+	std::swap_ranges ( M->begin ( 3 ), M->end ( 3 ), M->begin ( 66 ) );
+
+	LUDecomposition<type, size> lu ( *M );
+	std::unique_ptr<Matrix<type, size, size>> inv ( new Matrix<type, size, size> ( lu.inverse() ) );
+
+	EXPECT_FALSE ( lu.isSingular() ) << "Error regular matrix reported singular";
+	EXPECT_EQ ( lu.sign, -1 ) << "Error permutation sign";
+	expectIdentityProduct ( *M, *inv, 1e-12 );
+	}
+
+TEST ( LUTest, ConditionNumber_TestCase6 )
+	{
+	using type = double;
+	const unsigned size = 6;
+	Matrix<type, size, size> I;
+	Matrix<type, size, size> H;
+	eye ( I );
+
+	// Hilbert matrix, condition number in 1-norm ~ 2.9e7
+	for ( unsigned i = 0; i < size; ++i )
+		for ( unsigned j = 0; j < size; ++j )
+			H ( i, j ) = 1.0 / ( i + j + 1 );
+
+	LUDecomposition<type, size> lu_i ( I );
+	LUDecomposition<type, size> lu_h ( H );
+
+	EXPECT_DOUBLE_EQ ( lu_i.rcond(), 1.0 ) << "Error rcond of identity";
+	EXPECT_DOUBLE_EQ ( lu_i.pivotGrowth(), 1.0 ) << "Error pivot growth of identity";
+	EXPECT_GT ( lu_h.rcond(), 1.0 / 3e8 ) << "Error rcond of Hilbert matrix";
+	EXPECT_LT ( lu_h.rcond(), 1.0 / 3e6 ) << "Error rcond of Hilbert matrix";
+	}
+
+TEST ( LUTest, ClosedFormMatchesLU_TestCase7 )
+	{
+	using type = double;
+	Matrix<type, 4, 4> M;
+	fillDiagonallyDominant ( M );
+	LUDecomposition<type, 4> lu ( M );
+	Matrix<type, 4, 4> inv_lu = lu.inverse();
+	Matrix<type, 4, 4> inv = inverse ( M );
+
+	EXPECT_NEAR ( determinant ( M ), lu.determinant(), 1e-12 ) << "Error closed form determinant";
+	for ( unsigned i = 0; i < M.size(); ++i )
+		EXPECT_NEAR ( inv ( i ), inv_lu ( i ), 1e-14 ) << "Error closed form inverse at " << i;
+	}
+
+#endif // LUTEST_HPP
@@ -245,4 +245,170 @@ TEST ( MatrixTest, Eye_TestCase14 )
 	}
 
 
+TEST ( MatrixTest, Determinant_TestCase15 )
+	{
+	using type = double;
+	Matrix<type, 2, 2> M2{1, 2,
+						  3, 4};
+	Matrix<type, 3, 3> M3{2, 0, 1,
+						  1, 3, 2,
+						  1, 1, 2};
+	Matrix<type, 4, 4> M4{1, 0, 2, -1,
+						  3, 0, 0, 5,
+						  2, 1, 4, -3,
+						  1, 0, 5, 0};
+
+	EXPECT_DOUBLE_EQ ( determinant ( M2 ), -2.0 ) << "Error determinant 2x2";
+	EXPECT_DOUBLE_EQ ( determinant ( M3 ), 6.0 ) << "Error determinant 3x3";
+	EXPECT_DOUBLE_EQ ( determinant ( M4 ), 30.0 ) << "Error determinant 4x4";
+	}
+
+TEST ( MatrixTest, Inverse_TestCase16 )
+	{
+	using type = double;
+	Matrix<type, 2, 2> M2{1, 2,
+						  3, 4};
+	Matrix<type, 3, 3> M3{2, 0, 1,
+						  1, 3, 2,
+						  1, 1, 2};
+	Matrix<type, 4, 4> M4{1, 0, 2, -1,
+						  3, 0, 0, 5,
+						  2, 1, 4, -3,
+						  1, 0, 5, 0};
+	Matrix<type, 2, 2> I2, inv2;
+	Matrix<type, 3, 3> I3, inv3;
+	Matrix<type, 4, 4> I4, inv4;
+
+	ASSERT_TRUE ( inverse ( M2, inv2 ) ) << "Error inverse 2x2";
+	ASSERT_TRUE ( inverse ( M3, inv3 ) ) << "Error inverse 3x3";
+	ASSERT_TRUE ( inverse ( M4, inv4 ) ) << "Error inverse 4x4";
+
+	I2 = M2*inv2;
+	I3 = M3*inv3;
+	I4 = M4*inv4;
+
+	for ( unsigned i = 0; i < 2; ++i )
+		for ( unsigned j = 0; j < 2; ++j )
+			EXPECT_NEAR ( I2 ( i, j ), i == j ? 1.0 : 0.0, 1e-14 ) << "Error M2*inverse(M2)";
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			EXPECT_NEAR ( I3 ( i, j ), i == j ? 1.0 : 0.0, 1e-14 ) << "Error M3*inverse(M3)";
+
+	for ( unsigned i = 0; i < 4; ++i )
+		for ( unsigned j = 0; j < 4; ++j )
+			EXPECT_NEAR ( I4 ( i, j ), i == j ? 1.0 : 0.0, 1e-14 ) << "Error M4*inverse(M4)";
+
+	// inverse in place
+	ASSERT_TRUE ( inverse ( M3, M3 ) ) << "Error inverse 3x3 in place";
+	for ( unsigned i = 0; i < 9; ++i )
+		EXPECT_DOUBLE_EQ ( M3 ( i ), inv3 ( i ) ) << "Error inverse 3x3 in place";
+	}
+
+TEST ( MatrixTest, SingularInverse_TestCase17 )
+	{
+	using type = float;
+	Matrix<type, 3, 3> M{1, 2, 3,
+						 2, 4, 6,
+						 1, 0, 1};
+	Matrix<type, 3, 3> out ( 7.0f );
+
+	EXPECT_FALSE ( inverse ( M, out ) ) << "Error singular matrix not reported";
+	for ( type v : out )
+		EXPECT_FLOAT_EQ ( v, 7.0f ) << "Error output modified for singular matrix";
+	}
+
+TEST ( MatrixTest, BatchInverse_TestCase18 )
+	{
+	using type = float;
+	const unsigned count = 3;
+	Matrix<type, 2, 2> M[count] = { {2, 0, 0, 4}, {1, 2, 2, 4}, {0, 1, 1, 0} };
+	Matrix<type, 2, 2> inv[count];
+	type det[count];
+	bool regular[count];
+
+	determinantBatch ( M, M + count, det );
+	unsigned singular = inverseBatch ( M, M + count, inv, regular );
+
+	EXPECT_FLOAT_EQ ( det[0], 8.0f ) << "Error batch determinant";
+	EXPECT_FLOAT_EQ ( det[1], 0.0f ) << "Error batch determinant";
+	EXPECT_FLOAT_EQ ( det[2], -1.0f ) << "Error batch determinant";
+	EXPECT_EQ ( singular, 1u ) << "Error number of singular matrices";
+	EXPECT_TRUE ( regular[0] && ! regular[1] && regular[2] ) << "Error batch singularity flags";
+	EXPECT_FLOAT_EQ ( inv[0] ( 1, 1 ), 0.25f ) << "Error batch inverse";
+	EXPECT_FLOAT_EQ ( inv[2] ( 0, 1 ), 1.0f ) << "Error batch inverse";
+	}
+
+TEST ( MatrixTest, ExpLogSO3_TestCase19 )
+	{
+	using type = double;
+	// rotation about single axis equals rotationX/Y/Z
+	Matrix<type, 3, 3> rx = expSO3 ( Vector<type, 3>{0.7, 0, 0} );
+	Matrix<type, 3, 3> rz = expSO3 ( Vector<type, 3>{0, 0, -2.1} );
+	Matrix<type, 3, 3> rx_ref = rotationX ( 0.7 );
+	Matrix<type, 3, 3> rz_ref = rotationZ ( -2.1 );
+
+	for ( unsigned i = 0; i < 9; ++i )
+		{
+		EXPECT_NEAR ( rx ( i ), rx_ref ( i ), 1e-15 ) << "Error expSO3 about x";
+		EXPECT_NEAR ( rz ( i ), rz_ref ( i ), 1e-15 ) << "Error expSO3 about z";
+		}
+
+	// small, general and near pi angles round trip
+	const type angles[] = { 0.0, 1e-9, 1e-4, 0.02, 1.0, 2.5, M_PI - 1e-7, M_PI };
+
+	for ( type angle : angles )
+		{
+		Vector<type, 3> axis{0.48, -0.6, 0.64};
+		Vector<type, 3> omega = axis * Vector<type, 3> ( angle );
+		Matrix<type, 3, 3> r = expSO3 ( omega );
+		Vector<type, 3> log = logSO3 ( r );
+		Matrix<type, 3, 3> r_log = expSO3 ( log );
+
+		EXPECT_NEAR ( determinant ( r ), 1.0, 1e-14 ) << "Error determinant at angle " << angle;
+
+		for ( unsigned i = 0; i < 3; ++i )
+			for ( unsigned j = 0; j < 3; ++j )
+				{
+				type dot = 0;
+
+				for ( unsigned k = 0; k < 3; ++k )
+					dot += r ( i, k ) * r ( j, k );
+
+				EXPECT_NEAR ( dot, i == j ? 1.0 : 0.0, 1e-14 ) << "Error orthogonality at angle " << angle;
+				EXPECT_NEAR ( r_log ( i, j ), r ( i, j ), 1e-14 ) << "Error expSO3 of logSO3 at angle " << angle;
+				}
+
+		// at pi both axis signs are valid
+		if ( angle == type ( M_PI ) )
+			continue;
+
+		for ( unsigned i = 0; i < 3; ++i )
+			EXPECT_NEAR ( log.x[i], omega.x[i], 1e-8 * angle + 1e-15 ) << "Error logSO3 at angle " << angle << ", " << i;
+		}
+	}
+
+TEST ( MatrixTest, BatchExpLogSO3_TestCase20 )
+	{
+	using type = float;
+	const unsigned count = 4;
+	Vector<type, 3> omega[count] = { {0, 0, 0}, {1e-3f, -2e-3f, 5e-4f}, {0.3f, 0.2f, -0.1f}, {-1.5f, 2.0f, 0.5f} };
+	Matrix<type, 3, 3> r[count];
+	Vector<type, 3> log[count];
+
+	expSO3Batch ( omega, omega + count, r );
+	logSO3Batch ( r, r + count, log );
+
+	for ( unsigned n = 0; n < count; ++n )
+		{
+		Matrix<type, 3, 3> single = expSO3 ( omega[n] );
+
+		for ( unsigned i = 0; i < 9; ++i )
+			EXPECT_FLOAT_EQ ( r[n] ( i ), single ( i ) ) << "Error batch expSO3 of " << n;
+
+		for ( unsigned i = 0; i < 3; ++i )
+			EXPECT_NEAR ( log[n].x[i], omega[n].x[i], 1e-5f ) << "Error batch logSO3 of " << n << ", " << i;
+		}
+	}
+
 #endif // MATRIXTEST_HPP
\ No newline at end of file
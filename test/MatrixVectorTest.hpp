@@ -95,7 +95,7 @@ TEST ( MatrixVectorTest, VectorMatrixMultiplication_TransposedCauchyProduct_Test
 	Matrix<type, rows, cols> M1{1, 2, 3, 4};
 	Vector<type, rows> v2 {1, 2};
 	Vector<type, cols> v3;
-	Vector<type, cols> v4 {8, 5};
+	Vector<type, cols> v4 {7, 10};
 
 	auto it3_beg = v3.begin();
 	auto it3_end = v3.end();
@@ -107,6 +107,109 @@ TEST ( MatrixVectorTest, VectorMatrixMultiplication_TransposedCauchyProduct_Test
 		EXPECT_EQ ( *it3_beg++, *it4_beg++ ) << "Error in v3 = M1.transposedMul(v2)";
 	}
 
+TEST ( MatrixVectorTest, TallMatrixVectorMultiplication_TransposedCauchyProduct_TestCase8 )
+	{
+	using type = float;
+	const unsigned rows = 4;
+	const unsigned cols = 2;
+	Matrix<type, rows, cols> M1{1, 2,
+								3, 4,
+								5, 6,
+								7, 8};
+	Vector<type, rows> v2 {1, -1, 2, 0.5f};
+	Vector<type, cols> v3;
+	Vector<type, cols> v4 {1-3+10+3.5f, 2-4+12+4};
+
+	auto it3_beg = v3.begin();
+	auto it3_end = v3.end();
+	auto it4_beg = v4.begin();
+
+	v3 = M1.transposedMul ( v2 );
+
+	while ( it3_beg != it3_end )
+		EXPECT_FLOAT_EQ ( *it3_beg++, *it4_beg++ ) << "Error in v3 = M1.transposedMul(v2) for tall M1";
+	}
+
+TEST ( MatrixVectorTest, WideMatrixVectorMultiplication_TransposedCauchyProduct_TestCase9 )
+	{
+	using type = double;
+	const unsigned rows = 2;
+	const unsigned cols = 5;
+	Matrix<type, rows, cols> M1{1, 2, 3, 4, 5,
+								6, 7, 8, 9, 10};
+	Vector<int, rows> v2 {2, -1};
+	Vector<type, cols> v3;
+	Vector<type, cols> v4 {2-6, 4-7, 6-8, 8-9, 10-10};
+
+	auto it3_beg = v3.begin();
+	auto it3_end = v3.end();
+	auto it4_beg = v4.begin();
+
+	v3 = M1.transposedMul ( v2 );
+
+	while ( it3_beg != it3_end )
+		EXPECT_DOUBLE_EQ ( *it3_beg++, *it4_beg++ ) << "Error in v3 = M1.transposedMul(v2) for wide M1";
+	}
+
+TEST ( MatrixVectorTest, ScaledMatrixVectorMultiplication_TestCase10 )
+	{
+	using type = float;
+	const unsigned rows = 3;
+	const unsigned cols = 2;
+	Matrix<type, rows, cols> M1{1, 2,
+								3, 4,
+								5, 6};
+	Vector<type, cols> v2 {1, -1};
+	Vector<type, rows> v3 {1, 2, 3};
+	Vector<type, rows> v4 {2*-1 + 0.5f*1, 2*-1 + 0.5f*2, 2*-1 + 0.5f*3};
+
+	auto it3_beg = v3.begin();
+	auto it3_end = v3.end();
+	auto it4_beg = v4.begin();
+
+	scaledCauchyProduct ( 2.0f, M1, v2, 0.5f, v3 );
+
+	while ( it3_beg != it3_end )
+		EXPECT_FLOAT_EQ ( *it3_beg++, *it4_beg++ ) << "Error in v3 = 2*M1*v2 + 0.5*v3";
+
+	// with beta == 0 output is not read
+	v3.fill ( NAN );
+	scaledCauchyProduct ( 1.0f, M1, v2, 0.0f, v3 );
+
+	for ( type v : v3.x )
+		EXPECT_FLOAT_EQ ( v, -1.0f ) << "Error in v3 = M1*v2 + 0*NAN";
+	}
+
+TEST ( MatrixVectorTest, LargeMatrixVectorMultiplication_CauchyProduct_TestCase11 )
+	{
+	using type = double;
+	// not multiple of rows per pass and partial sums width
+	const unsigned rows = 37;
+	const unsigned cols = 45;
+	Matrix<type, rows, cols> M1;
+	Vector<type, cols> v2;
+	Vector<type, rows> v3;
+
+	for ( unsigned i = 0; i < rows; ++i )
+		for ( unsigned j = 0; j < cols; ++j )
+			M1 ( i, j ) = type ( ( i*7 + j*3 ) % 11 ) - 5;
+
+	for ( unsigned j = 0; j < cols; ++j )
+		v2.x[j] = type ( j % 5 ) - 2;
+
+	v3 = M1*v2;
+
+	for ( unsigned i = 0; i < rows; ++i )
+		{
+		type value = 0;
+
+		for ( unsigned j = 0; j < cols; ++j )
+			value += M1 ( i, j ) * v2.x[j];
+
+		EXPECT_DOUBLE_EQ ( v3.x[i], value ) << "Error in v3 = M1*v2 at row " << i;
+		}
+	}
+
 TEST ( MatrixVectorTest, Rotation_TestCase6 )
 	{
 	using type = float;
@@ -159,4 +262,85 @@ TEST ( MatrixVectorTest, RotationZ_TestCase7 )
 
 	}
 
+TEST ( MatrixVectorTest, WideDot_TestCase12 )
+	{
+	const unsigned size = 100;
+	Vector<float, size> a;
+	Vector<float, size> b ( 1.0f );
+	Vector<std::int32_t, size> c;
+	double reference = 0;
+	std::int64_t int_reference = 0;
+
+	// large first element hides the small ones in float accumulator
+	for ( unsigned i = 0; i < size; ++i )
+		{
+		a.x[i] = i == 0 ? 1e8f : 0.75f + 0.01f * float ( i % 3 );
+		c.x[i] = 100000 + std::int32_t ( i );
+		reference += double ( a.x[i] );
+		int_reference += std::int64_t ( c.x[i] ) * c.x[i];
+		}
+
+	EXPECT_DOUBLE_EQ ( wideDot ( a, b ), reference ) << "Error float Vectors accumulated in double";
+	EXPECT_DOUBLE_EQ ( ( a.dot<float, double> ( b ) ), reference ) << "Error dot with double result";
+	EXPECT_NE ( double ( a.dot ( b ) ), reference ) << "Error float accumulator did not lose precision";
+	EXPECT_EQ ( wideDot ( c, c ), int_reference ) << "Error int32 Vectors accumulated in int64";
+	EXPECT_FLOAT_EQ ( wideDot<float> ( b, b ), float ( size ) ) << "Error explicit accumulator";
+	}
+
+TEST ( MatrixVectorTest, WideCauchyProduct_TestCase13 )
+	{
+	// int16 is accumulated in int32, not in int64 of promoted product
+	static_assert ( std::is_same<accumulator_type<void, std::int16_t, std::int16_t>, std::int32_t>::value, "Error accumulator of int16" );
+	static_assert ( std::is_same<accumulator_type<void, std::uint8_t, std::uint8_t>, std::int32_t>::value, "Error accumulator of uint8" );
+	const unsigned rows = 5;
+	const unsigned cols = 70;
+	Matrix<std::int16_t, rows, cols> M;
+	Matrix<std::int16_t, cols, 3> N;
+	Vector<std::int16_t, cols> v;
+	Vector<std::int32_t, rows> out;
+	Matrix<std::int64_t, rows, 3> out_matrix;
+
+	for ( unsigned j = 0; j < cols; ++j )
+		{
+		v.x[j] = std::int16_t ( 30000 - 7*j );
+
+		for ( unsigned i = 0; i < rows; ++i )
+			M ( i, j ) = std::int16_t ( ( i + j ) % 2 ? 300 : -200 );
+
+		for ( unsigned k = 0; k < 3; ++k )
+			N ( j, k ) = std::int16_t ( 32000 - int ( k*j ) );
+		}
+
+	wideCauchyProduct ( M, v, out );
+	wideCauchyProduct<std::int64_t> ( M, N, out_matrix );
+
+	for ( unsigned i = 0; i < rows; ++i )
+		{
+		std::int64_t value = 0;
+
+		for ( unsigned j = 0; j < cols; ++j )
+			value += std::int64_t ( M ( i, j ) ) * v.x[j];
+
+		EXPECT_EQ ( out.x[i], value ) << "Error int16 product accumulated in int32 at " << i;
+
+		for ( unsigned k = 0; k < 3; ++k )
+			{
+			std::int64_t element = 0;
+
+			for ( unsigned j = 0; j < cols; ++j )
+				element += std::int64_t ( M ( i, j ) ) * N ( j, k );
+
+			EXPECT_EQ ( out_matrix ( i, k ), element ) << "Error int16 Matrix product at " << i << ", " << k;
+			}
+		}
+
+	// float storage, double accumulation and output
+	Matrix<float, 2, 2> F{1e8f, 1.0f, 1.0f, 1e8f};
+	Vector<float, 2> x{1.0f, 1.0f};
+	Vector<double, 2> y;
+	wideCauchyProduct ( F, x, y );
+
+	EXPECT_DOUBLE_EQ ( y.x[0], 1e8 + 1.0 ) << "Error float product accumulated in double";
+	}
+
 #endif // MATRIXVECTOR_HPP
\ No newline at end of file
@@ -0,0 +1,204 @@
+#ifndef NPYTEST_HPP
+#define NPYTEST_HPP
+
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "View.hpp"
+#include "Npy.hpp"
+
+/**
+ * @brief Content of file at path
+ */
+inline std::string npyTestRead ( const std::string& path )
+	{
+	std::ifstream in ( path, std::ios::binary );
+	return std::string ( std::istreambuf_iterator<char> ( in ), std::istreambuf_iterator<char>() );
+	}
+
+TEST ( NpyTest, RoundTrip_TestCase1 )
+	{
+	const std::string path = ::testing::TempDir() + "vecmatlib_points.npy";
+	std::vector<Vector<double, 3>> points ( 1000 );
+
+	for ( unsigned i = 0; i < points.size(); ++i )
+		points[i] = Vector<double, 3> { i * 0.5, -1.0 / ( i + 1 ), double ( i ) };
+
+	// header is dict of C order padded to 64 bytes
+	writeNpy ( path, points.data(), points.data() + points.size() );
+	const std::string content = npyTestRead ( path );
+	ASSERT_EQ ( content.size(), 128 + points.size() * sizeof ( Vector<double, 3> ) ) << "Error size of npy array";
+	EXPECT_EQ ( content.substr ( 0, 8 ), std::string ( "\x93NUMPY\x01\x00", 8 ) ) << "Error magic of npy array";
+	EXPECT_EQ ( content.substr ( 10, 62 ), "{'descr': '<f8', 'fortran_order': False, 'shape': (1000, 3), }" ) << "Error header";
+	EXPECT_EQ ( content[127], '\n' ) << "Error padding of header";
+
+	NpyArray<Vector<double, 3>> loaded ( path );
+	EXPECT_TRUE ( loaded.mapped() ) << "Error aligned array copied";
+	ASSERT_EQ ( loaded.size(), points.size() ) << "Error number of records";
+
+	for ( unsigned i = 0; i < points.size(); ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			EXPECT_EQ ( loaded[i].x[j], points[i].x[j] ) << "Error record " << i << " at " << j;
+
+	// scalar records and matrix of any shape
+	NpyArray<double> scalars ( path );
+	EXPECT_EQ ( scalars.size(), 3000u ) << "Error number of scalars";
+	EXPECT_EQ ( scalars.matrix() ( 999, 1 ), points[999].x[1] ) << "Error matrix view of array";
+
+	// single Matrix, strided view of dynamic extent, list of Matrices
+	Matrix<float, 2, 3> m { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+	writeNpy ( path, m );
+	NpyArray<Matrix<float, 2, 3>> single ( path );
+	ASSERT_EQ ( single.size(), 1u ) << "Error single Matrix";
+	EXPECT_EQ ( single[0].x[1][2], 6.0f ) << "Error single Matrix";
+
+	std::vector<std::int16_t> buffer { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+	writeNpy ( path, MatrixView<std::int16_t> ( buffer.data(), 3, 2, 4, 2 ) );
+	NpyArray<std::int16_t> strided ( path );
+	EXPECT_EQ ( strided.shape(), std::vector<std::uint64_t> ( { 3, 2 } ) ) << "Error shape of view";
+	EXPECT_EQ ( std::vector<std::int16_t> ( strided.begin(), strided.end() ), std::vector<std::int16_t> ( { 1, 3, 5, 7, 9, 11 } ) ) << "Error strided view";
+
+	std::vector<Matrix<float, 2, 3>> matrices ( 5, m );
+	writeNpy ( path, matrices.begin(), matrices.end() );
+	NpyArray<Matrix<float, 2, 3>> list ( path );
+	EXPECT_EQ ( list.size(), 5u ) << "Error list of Matrices";
+	EXPECT_EQ ( list.shape(), std::vector<std::uint64_t> ( { 5, 2, 3 } ) ) << "Error shape of list";
+
+	writeNpy ( path, Vector<std::uint8_t, 4> { 1, 2, 3, 4 } );
+	EXPECT_NE ( npyTestRead ( path ).find ( "'descr': '|u1'" ), std::string::npos ) << "Error dtype of bytes";
+	EXPECT_NE ( npyTestRead ( path ).find ( "'shape': (4,)" ), std::string::npos ) << "Error shape of Vector";
+
+	std::remove ( path.c_str() );
+	}
+
+TEST ( NpyTest, Validation_TestCase2 )
+	{
+	const std::string path = ::testing::TempDir() + "vecmatlib_points.npy";
+	std::vector<Vector<float, 3>> points ( 10, Vector<float, 3> ( 1.0f ) );
+	writeNpy ( path, points.begin(), points.end() );
+
+	using Point = Vector<float, 3>;
+	using PointDouble = Vector<double, 3>;
+	using Point4 = Vector<float, 4>;
+	using Matrix33 = Matrix<float, 3, 3>;
+	EXPECT_THROW ( NpyArray<Point> ( ::testing::TempDir() + "vecmatlib_missing.npy" ), std::runtime_error ) << "Error missing file";
+	EXPECT_THROW ( NpyArray<PointDouble> { path }, std::runtime_error ) << "Error dtype not detected";
+	EXPECT_THROW ( NpyArray<Point4> { path }, std::runtime_error ) << "Error shape not detected";
+	EXPECT_THROW ( NpyArray<Matrix33> { path }, std::runtime_error ) << "Error shape not detected";
+
+	// truncated data and malformed header
+	const std::string content = npyTestRead ( path );
+	std::ofstream ( path, std::ios::binary ) << content.substr ( 0, content.size() - 1 );
+	EXPECT_THROW ( NpyArray<Point> { path }, std::runtime_error ) << "Error truncated data not detected";
+	std::ofstream ( path, std::ios::binary ) << content.substr ( 0, 40 );
+	EXPECT_THROW ( NpyArray<Point> { path }, std::runtime_error ) << "Error truncated header not detected";
+	std::string structured ( "\x93NUMPY\x01\x00", 8 );
+	Npy::put ( structured, 16, 2 );
+	std::ofstream ( path, std::ios::binary ) << structured << "{'descr': [('a',";
+	EXPECT_THROW ( NpyArray<float> { path }, std::runtime_error ) << "Error structured dtype not detected";
+
+	// dimension of 2^64 + 1 would wrap to shape ( 1, 3 ) of single record
+	for ( const char* dim : { "18446744073709551615", "18446744073709551617" } )
+		{
+		std::string wrapped ( "\x93NUMPY\x01\x00", 8 );
+		const std::string wrapped_dict = std::string ( "{'descr': '<f4', 'fortran_order': False, 'shape': (" ) + dim + ", 3), }\n";
+		Npy::put ( wrapped, wrapped_dict.size(), 2 );
+		wrapped += wrapped_dict + std::string ( 12, '\0' );
+		const unsigned char* data = reinterpret_cast<const unsigned char*> ( wrapped.data() );
+
+		if ( dim[19] == '5' )
+			EXPECT_EQ ( Npy::parseHeader ( data, wrapped.size() ).shape[0], UINT64_MAX ) << "Error largest dimension";
+		else
+			{
+			EXPECT_THROW ( Npy::parseHeader ( data, wrapped.size() ), std::runtime_error ) << "Error overflow of dimension not detected";
+			std::ofstream ( path, std::ios::binary ) << wrapped;
+			EXPECT_THROW ( NpyArray<Point> { path }, std::runtime_error ) << "Error wrapped dimension loaded";
+			}
+		}
+
+	// big endian array of Fortran order of version 2.0 is converted
+	std::string big ( "\x93NUMPY\x02\x00", 8 );
+	const std::string dict = "{\"descr\": \">i4\", \"fortran_order\": True, \"shape\": (2, 3)}\n";
+	Npy::put ( big, dict.size(), 4 );
+	big += dict;
+
+	// columns in order, element ( i, j ) is 10 * i + j
+	for ( unsigned j = 0; j < 3; ++j )
+		for ( unsigned i = 0; i < 2; ++i )
+			{
+			const std::uint32_t value = 10 * i + j;
+			big += char ( value >> 24 );
+			big += char ( ( value >> 16 ) & 0xff );
+			big += char ( ( value >> 8 ) & 0xff );
+			big += char ( value & 0xff );
+			}
+
+	std::ofstream ( path, std::ios::binary ) << big;
+	NpyArray<Matrix<std::int32_t, 2, 3>> converted ( path );
+	EXPECT_FALSE ( converted.mapped() ) << "Error converted array mapped";
+	ASSERT_EQ ( converted.size(), 1u ) << "Error number of records";
+
+	for ( unsigned i = 0; i < 2; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			EXPECT_EQ ( converted[0].x[i][j], std::int32_t ( 10 * i + j ) ) << "Error element " << i << ", " << j;
+
+	std::remove ( path.c_str() );
+	}
+
+TEST ( NpyTest, Npz_TestCase3 )
+	{
+	EXPECT_EQ ( Npy::crc32 ( "123456789", 9 ), 0xCBF43926u ) << "Error CRC-32";
+	EXPECT_EQ ( Npy::crc32 ( "56789", 5, Npy::crc32 ( "1234", 4 ) ), 0xCBF43926u ) << "Error continued CRC-32";
+
+	const std::string path = ::testing::TempDir() + "vecmatlib_arrays.npz";
+	std::vector<Vector<double, 3>> points ( 100 );
+
+	for ( unsigned i = 0; i < points.size(); ++i )
+		points[i] = Vector<double, 3> { double ( i ), i * 2.0, i * 3.0 };
+
+	Matrix<double, 3, 3> R { 0.0, -1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0 };
+	std::vector<float> weights { 0.5f, 0.25f, 0.125f, 0.125f };
+
+		{
+		NpzWriter npz ( path );
+		npz.add ( "points", points.begin(), points.end() );
+		npz.add ( "rotation", R );
+		npz.add ( "w", MatrixView<float> ( weights.data(), 2, 2 ) );
+		npz.close();
+		}
+
+	const NpzFile npz ( path );
+	EXPECT_EQ ( npz.names(), std::vector<std::string> ( { "points", "rotation", "w" } ) ) << "Error names of arrays";
+
+	const NpyArray<Vector<double, 3>> loaded = npz.get<Vector<double, 3>> ( "points" );
+	EXPECT_TRUE ( loaded.mapped() ) << "Error entry of archive not aligned";
+	ASSERT_EQ ( loaded.size(), points.size() ) << "Error number of records";
+	EXPECT_EQ ( loaded[99].x[2], 297.0 ) << "Error record of archive";
+
+	const NpyArray<Matrix<double, 3, 3>> rotation = npz.get<Matrix<double, 3, 3>> ( "rotation" );
+	EXPECT_EQ ( rotation[0].x[0][1], -1.0 ) << "Error Matrix of archive";
+	EXPECT_EQ ( npz.get<float> ( "w" ).matrix() ( 1, 0 ), 0.125f ) << "Error view of archive";
+
+	using Point = Vector<double, 3>;
+	EXPECT_THROW ( npz.get<Point> ( "missing" ), std::runtime_error ) << "Error missing array";
+	EXPECT_THROW ( npz.get<float> ( "points" ), std::runtime_error ) << "Error dtype not detected";
+
+	// CRC of stored entry equals CRC of its npy array
+	const std::string content = npyTestRead ( path );
+	const unsigned char* local = reinterpret_cast<const unsigned char*> ( content.data() );
+	const std::size_t offset = 30 + Npy::get ( local + 26, 2 ) + Npy::get ( local + 28, 2 );
+	EXPECT_EQ ( offset % 64, 0u ) << "Error alignment of entry";
+	EXPECT_EQ ( Npy::crc32 ( local + offset, Npy::get ( local + 18, 4 ) ), Npy::get ( local + 14, 4 ) ) << "Error CRC of entry";
+
+	std::ofstream ( path, std::ios::binary ) << "not a zip archive";
+	EXPECT_THROW ( NpzFile { path }, std::runtime_error ) << "Error malformed archive not detected";
+
+	std::remove ( path.c_str() );
+	}
+
+#endif // NPYTEST_HPP
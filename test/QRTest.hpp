@@ -0,0 +1,118 @@
+#ifndef QRTEST_HPP
+#define QRTEST_HPP
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include "Matrix.hpp"
+#include "QR.hpp"
+
+TEST ( QRTest, LeastSquares_TestCase1 )
+	{
+	using type = double;
+	// line fit y = a + b*t of four noisy points
+	Matrix<type, 4, 2> A{1, 0,
+						 1, 1,
+						 1, 2,
+						 1, 3};
+	Vector<type, 4> b{1.5, 2.5, 5.5, 6.5};
+	Vector<type, 2> x = leastSquares ( A, b );
+
+	EXPECT_NEAR ( x.x[0], 1.3, 1e-12 ) << "Error least squares intercept";
+	EXPECT_NEAR ( x.x[1], 1.8, 1e-12 ) << "Error least squares slope";
+
+	QRDecomposition<type, 4, 2> qr ( A );
+	Vector<type, 4> r = A*x;
+	r -= b;
+
+	EXPECT_NEAR ( qr.residualNorm ( b ), r.norm(), 1e-12 ) << "Error residual norm";
+	}
+
+TEST ( QRTest, Reconstruction_TestCase2 )
+	{
+	using type = double;
+	Matrix<type, 5, 3> A{2, -1, 0,
+						 1, 3, 2,
+						 0, 1, 4,
+						 -2, 0, 1,
+						 1, 1, 1};
+	QRDecomposition<type, 5, 3> qr ( A );
+	Matrix<type, 3, 3> R = qr.r();
+
+	EXPECT_FALSE ( qr.isRankDeficient() ) << "Error full rank matrix reported rank deficient";
+
+	// Q*[R; 0] = A column by column
+	for ( unsigned j = 0; j < 3; ++j )
+		{
+		Vector<type, 5> column ( 0.0 );
+
+		for ( unsigned i = 0; i <= j; ++i )
+			column.x[i] = R ( i, j );
+
+		Vector<type, 5> a = qr.applyQ ( column );
+
+		for ( unsigned i = 0; i < 5; ++i )
+			EXPECT_NEAR ( a.x[i], A ( i, j ), 1e-12 ) << "Error Q*R at " << i << ", " << j;
+		}
+
+	// transpose(Q) is inverse of Q
+	Vector<type, 5> v{1, 2, 3, 4, 5};
+	Vector<type, 5> w = qr.applyQ ( qr.applyQTransposed ( v ) );
+
+	for ( unsigned i = 0; i < 5; ++i )
+		EXPECT_NEAR ( w.x[i], v.x[i], 1e-12 ) << "Error Q*transpose(Q) at " << i;
+	}
+
+TEST ( QRTest, RankDeficient_TestCase3 )
+	{
+	using type = float;
+	// second column is twice first column
+	Matrix<type, 4, 2> A{1, 2,
+						 2, 4,
+						 3, 6,
+						 4, 8};
+	QRDecomposition<type, 4, 2> qr ( A );
+
+	EXPECT_TRUE ( qr.isRankDeficient() ) << "Error rank deficient matrix not detected";
+	EXPECT_THROW ( qr.leastSquares ( Vector<type, 4> ( 1.0f ) ), std::runtime_error );
+	}
+
+TEST ( QRTest, BlockedLeastSquares_TestCase4 )
+	{
+	using type = double;
+	const unsigned ROWS = 90;
+	const unsigned COLS = 40;
+	std::unique_ptr<Matrix<type, ROWS, COLS>> A ( new Matrix<type, ROWS, COLS> );
+	Vector<type, COLS> x;
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		for ( unsigned j = 0; j < COLS; ++j )
+			( *A ) ( i, j ) = type ( ( i*13 + j*7 ) % 19 ) / type ( 19 ) - type ( 0.5 ) + ( i % COLS == j ? type ( 2 ) : type ( 0 ) );
+
+	for ( unsigned j = 0; j < COLS; ++j )
+		x.x[j] = type ( j ) - type ( COLS/2 );
+
+	// consistent system, solution is exact
+	Vector<type, ROWS> b = ( *A ) * x;
+	std::unique_ptr<QRDecomposition<type, ROWS, COLS>> qr ( new QRDecomposition<type, ROWS, COLS> ( *A ) );
+	Vector<type, COLS> y = qr->leastSquares ( b );
+
+	for ( unsigned j = 0; j < COLS; ++j )
+		EXPECT_NEAR ( y.x[j], x.x[j], 1e-10 ) << "Error blocked least squares at " << j;
+
+	EXPECT_NEAR ( qr->residualNorm ( b ), 0.0, 1e-10 ) << "Error blocked residual norm";
+
+	// blocked and unblocked R agree up to sign of rows
+	std::unique_ptr<Matrix<type, ROWS, 8>> A_head ( new Matrix<type, ROWS, 8> );
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		for ( unsigned j = 0; j < 8; ++j )
+			( *A_head ) ( i, j ) = ( *A ) ( i, j );
+
+	QRDecomposition<type, ROWS, 8> qr_head ( *A_head );
+
+	for ( unsigned i = 0; i < 8; ++i )
+		for ( unsigned j = i; j < 8; ++j )
+			EXPECT_NEAR ( qr_head.qr ( i, j ), qr->qr ( i, j ), 1e-10 ) << "Error blocked R at " << i << ", " << j;
+	}
+
+#endif // QRTEST_HPP
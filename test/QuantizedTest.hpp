@@ -0,0 +1,179 @@
+#ifndef QUANTIZEDTEST_HPP
+#define QUANTIZEDTEST_HPP
+
+#include <cstdint>
+#include <cmath>
+#include <memory>
+#include <gtest/gtest.h>
+#include "Matrix.hpp"
+#include "Quantized.hpp"
+
+/**
+ * @brief Compare quantized product with product of zero point shifted elements
+ * computed in int64, depth crosses kernel blocks and tails
+ */
+template<typename T, typename Q>
+void expectQuantizedProduct ( const Q& first_quantization, Quantization second_quantization )
+	{
+	const unsigned ROWS = 7;
+	const unsigned DEPTH = 301;
+	const unsigned COLS = 5;
+	Matrix<std::int8_t, ROWS, DEPTH> A;
+	Matrix<T, DEPTH, COLS> B;
+	Vector<T, DEPTH> v;
+	Matrix<std::int32_t, ROWS, COLS> C;
+	Vector<std::int32_t, ROWS> c;
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		for ( unsigned k = 0; k < DEPTH; ++k )
+			A.x[i][k] = std::int8_t ( int ( ( i*37 + k*11 ) % 256 ) - 128 );
+
+	for ( unsigned k = 0; k < DEPTH; ++k )
+		{
+		for ( unsigned j = 0; j < COLS; ++j )
+			B.x[k][j] = T ( ( k*13 + j*101 + 7 ) % 256 );
+
+		v.x[k] = B.x[k][COLS-1];
+		}
+
+	quantizedCauchyProduct ( A, first_quantization, B, second_quantization, C );
+	quantizedCauchyProduct ( A, first_quantization, v, second_quantization, c );
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		{
+		const std::int64_t first_zero_point = Quantized::row ( first_quantization, i ).zero_point;
+
+		for ( unsigned j = 0; j < COLS; ++j )
+			{
+			std::int64_t reference = 0;
+
+			for ( unsigned k = 0; k < DEPTH; ++k )
+				reference += ( A.x[i][k] - first_zero_point ) * ( B.x[k][j] - std::int64_t ( second_quantization.zero_point ) );
+
+			EXPECT_EQ ( C.x[i][j], reference ) << "Error Matrix product at " << i << ", " << j;
+			}
+
+		EXPECT_EQ ( c.x[i], C.x[i][COLS-1] ) << "Error Matrix Vector product at " << i;
+		}
+	}
+
+TEST ( QuantizedTest, Quantize_TestCase1 )
+	{
+	const float values[] = { -1.0f, -0.3f, 0.0f, 0.01f, 0.5f, 2.0f };
+	const unsigned SIZE = sizeof ( values ) / sizeof ( float );
+	std::uint8_t q_unsigned[SIZE];
+	std::int8_t q_signed[SIZE];
+	float out[SIZE];
+
+	const Quantization q = quantizationRange<std::uint8_t> ( -1.0f, 2.0f );
+	EXPECT_FLOAT_EQ ( q.scale, 3.0f / 255.0f ) << "Error scale";
+	EXPECT_EQ ( q.zero_point, 85 ) << "Error zero point";
+
+	quantize ( values, values + SIZE, q_unsigned, q );
+	dequantize ( q_unsigned, q_unsigned + SIZE, out, q );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		EXPECT_NEAR ( out[i], values[i], 0.51f * q.scale ) << "Error uint8 round trip at " << i;
+
+	EXPECT_EQ ( out[2], 0.0f ) << "Error zero not exact";
+
+	// positive range is extended to contain zero
+	const Quantization p = quantizationRange<std::int8_t> ( 0.5f, 1.0f );
+	EXPECT_EQ ( p.zero_point, -128 ) << "Error zero point of positive range";
+
+	const Quantization s = quantizationRange<std::int8_t> ( -1.0f, 1.0f );
+	quantize ( values, values + SIZE, q_signed, s );
+	dequantize ( q_signed, q_signed + SIZE, out, s );
+
+	for ( unsigned i = 0; i + 1 < SIZE; ++i )
+		EXPECT_NEAR ( out[i], values[i], 0.51f * s.scale ) << "Error int8 round trip at " << i;
+
+	EXPECT_EQ ( q_signed[SIZE-1], 127 ) << "Error saturation";
+	EXPECT_EQ ( quantizationRange<std::int8_t> ( 0.0f, 0.0f ).scale, 1.0f ) << "Error scale of empty range";
+	}
+
+TEST ( QuantizedTest, Product_TestCase2 )
+	{
+	Vector<Quantization, 7> rows;
+
+	for ( unsigned i = 0; i < 7; ++i )
+		rows.x[i] = Quantization { 0.5f, std::int32_t ( i*17 ) - 60 };
+
+	expectQuantizedProduct<std::uint8_t> ( Quantization { 0.5f, 0 }, Quantization { 0.25f, 0 } );
+	expectQuantizedProduct<std::uint8_t> ( Quantization { 0.5f, 3 }, Quantization { 0.25f, 128 } );
+	expectQuantizedProduct<std::uint8_t> ( rows, Quantization { 0.25f, 37 } );
+	expectQuantizedProduct<std::int8_t> ( Quantization { 0.5f, 0 }, Quantization { 0.25f, 0 } );
+	expectQuantizedProduct<std::int8_t> ( Quantization { 0.5f, -5 }, Quantization { 0.25f, -128 } );
+	expectQuantizedProduct<std::int8_t> ( rows, Quantization { 0.25f, 21 } );
+	}
+
+TEST ( QuantizedTest, Requantize_TestCase3 )
+	{
+	const unsigned ROWS = 10;
+	const unsigned DEPTH = 160;
+	const unsigned COLS = 3;
+	Matrix<float, ROWS, DEPTH> W;
+	Matrix<float, DEPTH, COLS> X;
+	Matrix<std::int8_t, ROWS, DEPTH> W_q;
+	Matrix<std::uint8_t, DEPTH, COLS> X_q;
+	Matrix<std::int8_t, ROWS, COLS> Y_q;
+	Vector<std::uint8_t, DEPTH> x_q;
+	Vector<std::int8_t, ROWS> y_q;
+	Vector<Quantization, ROWS> weights;
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		for ( unsigned k = 0; k < DEPTH; ++k )
+			W.x[i][k] = float ( ( i*7 + k*3 ) % 19 ) * 0.01f * float ( i + 1 ) - 0.09f * float ( i + 1 );
+
+	for ( unsigned k = 0; k < DEPTH; ++k )
+		for ( unsigned j = 0; j < COLS; ++j )
+			X.x[k][j] = float ( ( k*5 + j ) % 23 ) * 0.05f;
+
+	quantizeRows ( W, W_q, weights );
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		EXPECT_EQ ( weights.x[i].zero_point, 0 ) << "Error zero point of symmetric row " << i;
+
+	const Quantization activations = quantizationRange<std::uint8_t> ( 0.0f, 1.1f );
+	quantize ( *X.x, *X.x + DEPTH*COLS, *X_q.x, activations );
+
+	for ( unsigned k = 0; k < DEPTH; ++k )
+		x_q.x[k] = X_q.x[k][0];
+
+	const Matrix<float, ROWS, COLS> Y = W * X;
+	const Quantization output = quantizationRange<std::int8_t> ( -1.5f, 1.5f );
+	quantizedCauchyProduct ( W_q, weights, X_q, activations, Y_q, output );
+	quantizedCauchyProduct ( W_q, weights, x_q, activations, y_q, output );
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		{
+		// rounding of weights and activations
+		const float tolerance = 0.5f * DEPTH * ( weights.x[i].scale * 1.1f + activations.scale * 0.09f * float ( i + 1 ) );
+
+		for ( unsigned j = 0; j < COLS; ++j )
+			{
+			// product of quantized values in double
+			double reference = 0.0;
+
+			for ( unsigned k = 0; k < DEPTH; ++k )
+				reference += double ( weights.x[i].scale ) * W_q.x[i][k] * activations.scale * ( X_q.x[k][j] - activations.zero_point );
+
+			const float value = output.scale * float ( Y_q.x[i][j] - output.zero_point );
+
+			EXPECT_NEAR ( value, reference, 0.5f * output.scale * 1.01f ) << "Error requantization at " << i << ", " << j;
+			EXPECT_NEAR ( value, Y.x[i][j], tolerance + output.scale ) << "Error requantized product at " << i << ", " << j;
+			}
+
+		EXPECT_EQ ( y_q.x[i], Y_q.x[i][0] ) << "Error requantized Matrix Vector product at " << i;
+		}
+
+	// saturation of output
+	quantizedCauchyProduct ( W_q, weights, X_q, activations, Y_q, Quantization { 1e-3f, 0 } );
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		for ( unsigned j = 0; j < COLS; ++j )
+			EXPECT_TRUE ( std::fabs ( Y.x[i][j] ) < 0.2f || Y_q.x[i][j] == ( Y.x[i][j] > 0.0f ? 127 : -128 ) )
+					<< "Error saturation at " << i << ", " << j;
+	}
+
+#endif // QUANTIZEDTEST_HPP
@@ -0,0 +1,207 @@
+#ifndef SVDTEST_HPP
+#define SVDTEST_HPP
+
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Matrix.hpp"
+#include "SVD.hpp"
+
+/**
+ * @brief Check signed SVD: reconstruction, rotations U and V, order and signs of singular values
+ */
+template<typename T>
+void expectSVD ( const Matrix<T, 3, 3>& m, T tolerance )
+	{
+	Matrix<T, 3, 3> u, v;
+	Vector<T, 3> s;
+	svd ( m, u, s, v );
+
+	T max_abs = 0;
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			max_abs = std::max ( max_abs, std::abs ( m.x[i][j] ) );
+
+	const T scale = max_abs > 0 ? max_abs : T ( 1 );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			{
+			T value = 0;
+			T u_dot = 0;
+			T v_dot = 0;
+
+			for ( unsigned k = 0; k < 3; ++k )
+				{
+				value += u.x[i][k] * s.x[k] * v.x[j][k];
+				u_dot += u.x[k][i] * u.x[k][j];
+				v_dot += v.x[k][i] * v.x[k][j];
+				}
+
+			EXPECT_NEAR ( value, m.x[i][j], tolerance * scale ) << "Error reconstruction at " << i << ", " << j;
+			EXPECT_NEAR ( u_dot, i == j ? T ( 1 ) : T ( 0 ), tolerance ) << "Error U orthonormality at " << i << ", " << j;
+			EXPECT_NEAR ( v_dot, i == j ? T ( 1 ) : T ( 0 ), tolerance ) << "Error V orthonormality at " << i << ", " << j;
+			}
+
+	EXPECT_NEAR ( determinant ( u ), T ( 1 ), tolerance ) << "Error U is not rotation";
+	EXPECT_NEAR ( determinant ( v ), T ( 1 ), tolerance ) << "Error V is not rotation";
+	EXPECT_GE ( s.x[0], T ( 0 ) ) << "Error negative first singular value";
+	EXPECT_GE ( s.x[1], T ( 0 ) ) << "Error negative second singular value";
+	EXPECT_GE ( s.x[0], s.x[1] - tolerance * scale ) << "Error order of singular values";
+	EXPECT_GE ( s.x[1], std::abs ( s.x[2] ) - tolerance * scale ) << "Error order of singular values";
+	EXPECT_NEAR ( s.x[0] * s.x[1] * s.x[2], determinant ( m ), tolerance * scale*scale*scale * T ( 4 ) ) << "Error sign of last singular value";
+	}
+
+TEST ( SVDTest, Random_TestCase1 )
+	{
+	unsigned seed = 7;
+	auto next = [&seed] ()
+		{
+		seed = seed * 1103515245u + 12345u;
+		return double ( ( seed >> 8 ) % 2001 ) / 1000.0 - 1.0;
+		};
+
+	for ( unsigned n = 0; n < 200; ++n )
+		{
+		Matrix<double, 3, 3> md;
+		Matrix<float, 3, 3> mf;
+
+		for ( unsigned i = 0; i < 3; ++i )
+			for ( unsigned j = 0; j < 3; ++j )
+				mf.x[i][j] = float ( md.x[i][j] = next() * 100.0 );
+
+		expectSVD ( md, 1e-12 );
+		expectSVD ( mf, 2e-5f );
+		}
+	}
+
+TEST ( SVDTest, Degenerate_TestCase2 )
+	{
+	using type = double;
+	Matrix<type, 3, 3> zero ( type ( 0 ) );
+	Matrix<type, 3, 3> reflection{1, 0, 0,
+								  0, -3, 0,
+								  0, 0, 2};
+	Matrix<type, 3, 3> repeated{2, 0, 0,
+								0, 2, 0,
+								0, 0, 2};
+	Matrix<type, 3, 3> rank_one{1, 2, 3,
+								2, 4, 6,
+								-1, -2, -3};
+	Matrix<type, 3, 3> rank_two{1, 2, 3,
+								4, 5, 6,
+								7, 8, 9};
+
+	expectSVD ( zero, 1e-14 );
+	expectSVD ( reflection, 1e-14 );
+	expectSVD ( repeated, 1e-14 );
+	expectSVD ( rank_one, 1e-13 );
+	expectSVD ( rank_two, 1e-13 );
+
+	Matrix<type, 3, 3> u, v;
+	Vector<type, 3> s;
+	svd ( reflection, u, s, v );
+
+	EXPECT_NEAR ( s.x[0], 3.0, 1e-14 ) << "Error first singular value";
+	EXPECT_NEAR ( s.x[1], 2.0, 1e-14 ) << "Error second singular value";
+	EXPECT_NEAR ( s.x[2], -1.0, 1e-14 ) << "Error signed last singular value";
+
+	svd ( rank_two, u, s, v );
+
+	EXPECT_NEAR ( s.x[2], 0.0, 1e-13 ) << "Error zero singular value";
+
+	// nearest rotation of rotation is the same rotation
+	Matrix<type, 3, 3> r = rotationMatrix ( Vector<type, 3>{0.3, -1.2, 2.5} );
+	Matrix<type, 3, 3> nearest = nearestRotation ( r );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			EXPECT_NEAR ( nearest ( i, j ), r ( i, j ), 1e-14 ) << "Error nearest rotation at " << i << ", " << j;
+	}
+
+TEST ( SVDTest, Kabsch_TestCase3 )
+	{
+	using type = double;
+	Matrix<type, 3, 3> r = rotationMatrix ( Vector<type, 3>{-0.7, 0.4, 2.9} );
+	// point cloud far from origin tests the shifted single pass accumulation,
+	// tolerances follow from rounding of target coordinates around 1e6
+	Vector<type, 3> offset{1e6, -2e6, 5e5};
+	Vector<type, 3> t{10, 20, -30};
+	std::vector<Vector<type, 3>> source, target;
+
+	for ( unsigned n = 0; n < 50; ++n )
+		{
+		Vector<type, 3> p{type ( n % 7 ) - 3, type ( n % 5 ) * 0.5, type ( n % 11 ) * 0.25 - 1};
+		source.push_back ( p + offset );
+		target.push_back ( r * ( p + offset ) + t );
+		}
+
+	Vector<type, 3> translation;
+	Matrix<type, 3, 3> rotation = kabsch ( source.begin(), source.end(), target.begin(), translation );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		{
+		EXPECT_NEAR ( translation.x[i], t.x[i], 1e-3 ) << "Error translation at " << i;
+
+		for ( unsigned j = 0; j < 3; ++j )
+			EXPECT_NEAR ( rotation ( i, j ), r ( i, j ), 1e-9 ) << "Error rotation at " << i << ", " << j;
+		}
+
+	// planar point set mirrored through its plane is aligned by rotation, not reflection
+	std::vector<Vector<float, 3>> plane, mirrored;
+
+	for ( unsigned n = 0; n < 10; ++n )
+		{
+		plane.push_back ( Vector<float, 3>{float ( n % 3 ), float ( n / 3 ), 0.0f} );
+		mirrored.push_back ( Vector<float, 3>{-float ( n % 3 ), float ( n / 3 ), 0.0f} );
+		}
+
+	Vector<float, 3> translation_f;
+	Matrix<float, 3, 3> rotation_f = kabsch ( plane.begin(), plane.end(), mirrored.begin(), translation_f );
+
+	EXPECT_NEAR ( determinant ( rotation_f ), 1.0f, 1e-5f ) << "Error reflection returned";
+
+	for ( unsigned n = 0; n < plane.size(); ++n )
+		{
+		Vector<float, 3> aligned = rotation_f * plane[n] + translation_f;
+
+		for ( unsigned i = 0; i < 3; ++i )
+			EXPECT_NEAR ( aligned.x[i], mirrored[n].x[i], 1e-5f ) << "Error planar alignment of point " << n << " at " << i;
+		}
+
+	EXPECT_THROW ( kabsch ( plane.end(), plane.end(), mirrored.begin(), translation_f ), std::runtime_error );
+	}
+
+TEST ( SVDTest, Umeyama_TestCase4 )
+	{
+	using type = double;
+	Matrix<type, 3, 3> r = rotationMatrix ( Vector<type, 3>{1.1, -0.2, 0.6} );
+	Vector<type, 3> t{-1, 2, 0.5};
+	const type c = 2.5;
+	std::vector<Vector<float, 3>> source;
+	std::vector<Vector<type, 3>> target;
+
+	for ( unsigned n = 0; n < 20; ++n )
+		{
+		Vector<type, 3> p{type ( n % 4 ), type ( n % 3 ) - 1, type ( n % 5 ) * 0.5};
+		source.push_back ( Vector<float, 3> ( p ) );
+		target.push_back ( c * ( r * p ) + t );
+		}
+
+	Vector<type, 3> translation;
+	type scale;
+	Matrix<type, 3, 3> rotation = umeyama ( source.begin(), source.end(), target.begin(), translation, scale );
+
+	EXPECT_NEAR ( scale, c, 1e-12 ) << "Error scale";
+
+	for ( unsigned i = 0; i < 3; ++i )
+		{
+		EXPECT_NEAR ( translation.x[i], t.x[i], 1e-12 ) << "Error translation at " << i;
+
+		for ( unsigned j = 0; j < 3; ++j )
+			EXPECT_NEAR ( rotation ( i, j ), r ( i, j ), 1e-12 ) << "Error rotation at " << i << ", " << j;
+		}
+	}
+
+#endif // SVDTEST_HPP
@@ -0,0 +1,177 @@
+#ifndef SPARSEMATRIXTEST_HPP
+#define SPARSEMATRIXTEST_HPP
+
+#include <vector>
+#include <gtest/gtest.h>
+#include "Matrix.hpp"
+#include "SparseMatrix.hpp"
+
+/**
+ * @brief Fill dense Matrix with deterministic sparse pattern, about one of every 7 elements is non zero
+ */
+template<typename T, unsigned ROWS, unsigned COLS>
+void fillSparsePattern ( Matrix<T, ROWS, COLS>& m )
+	{
+	for ( unsigned i = 0; i < ROWS; ++i )
+		for ( unsigned j = 0; j < COLS; ++j )
+			m ( i, j ) = ( i*5 + j*3 ) % 7 == 0 ? T ( ( i + 2*j ) % 11 ) - T ( 5 ) : T ( 0 );
+	}
+
+TEST ( SparseMatrixTest, Triplets_TestCase1 )
+	{
+	using type = double;
+	// unordered triplets with duplicate position (1, 2)
+	std::vector<Triplet<type>> triplets{ {2, 0, 4.0}, {1, 2, 1.5}, {0, 1, -1.0}, {1, 0, 2.0}, {1, 2, 0.5} };
+	SparseMatrix<type, 3, 4> S ( triplets.begin(), triplets.end() );
+	Matrix<type, 3, 4> M{0, -1, 0, 0,
+						 2, 0, 2, 0,
+						 4, 0, 0, 0};
+	Matrix<type, 3, 4> D;
+	S.toDense ( D );
+
+	EXPECT_EQ ( S.nonZeros(), 4u ) << "Error duplicates not merged";
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 4; ++j )
+			{
+			EXPECT_DOUBLE_EQ ( S ( i, j ), M ( i, j ) ) << "Error element at " << i << ", " << j;
+			EXPECT_DOUBLE_EQ ( D ( i, j ), M ( i, j ) ) << "Error dense copy at " << i << ", " << j;
+			}
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned k = S.row_offsets[i] + 1; k < S.row_offsets[i+1]; ++k )
+			EXPECT_LT ( S.columns[k-1], S.columns[k] ) << "Error columns not sorted in row " << i;
+
+	std::vector<Triplet<type>> wrong{ {3, 0, 1.0} };
+	EXPECT_THROW ( ( SparseMatrix<type, 3, 4> ( wrong.begin(), wrong.end() ) ), std::runtime_error );
+	}
+
+TEST ( SparseMatrixTest, Multiplication_TestCase2 )
+	{
+	using type = double;
+	const unsigned ROWS = 50;
+	const unsigned COLS = 30;
+	Matrix<type, ROWS, COLS> M;
+	Matrix<type, COLS, 4> X;
+	Matrix<type, ROWS, 4> Y;
+	Vector<type, COLS> x;
+	Vector<type, ROWS> y;
+	fillSparsePattern ( M );
+
+	for ( unsigned i = 0; i < COLS; ++i )
+		{
+		x.x[i] = type ( i ) * 0.5 - 3;
+
+		for ( unsigned j = 0; j < 4; ++j )
+			X ( i, j ) = type ( i*j % 5 ) - 1;
+		}
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		{
+		y.x[i] = type ( i % 9 ) - 4;
+
+		for ( unsigned j = 0; j < 4; ++j )
+			Y ( i, j ) = type ( ( i + j ) % 6 ) * 0.25;
+		}
+
+	SparseMatrix<type, ROWS, COLS> S ( M );
+	Vector<type, ROWS> Mx = M * x;
+	Matrix<type, ROWS, 4> MX = M * X;
+	Vector<type, COLS> MTy = M.transposedMul ( y );
+	Matrix<type, COLS, ROWS> MT;
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		for ( unsigned j = 0; j < COLS; ++j )
+			MT ( j, i ) = M ( i, j );
+
+	Matrix<type, COLS, 4> MTY = MT * Y;
+
+	// one and more threads give the same results
+	for ( unsigned threads : { 1u, 3u } )
+		{
+		Vector<type, ROWS> Sx;
+		Matrix<type, ROWS, 4> SX;
+		Vector<type, COLS> STy;
+		Matrix<type, COLS, 4> STY;
+		cauchyProduct ( S, x, Sx, threads );
+		cauchyProduct ( S, X, SX, threads );
+		transposedCauchyProduct ( S, y, STy, threads );
+		transposedCauchyProduct ( S, Y, STY, threads );
+
+		for ( unsigned i = 0; i < ROWS; ++i )
+			{
+			EXPECT_NEAR ( Sx.x[i], Mx.x[i], 1e-12 ) << "Error SpMV at " << i << " with " << threads << " threads";
+
+			for ( unsigned j = 0; j < 4; ++j )
+				EXPECT_NEAR ( SX ( i, j ), MX ( i, j ), 1e-12 ) << "Error SpMM at " << i << ", " << j << " with " << threads << " threads";
+			}
+
+		for ( unsigned i = 0; i < COLS; ++i )
+			{
+			EXPECT_NEAR ( STy.x[i], MTy.x[i], 1e-12 ) << "Error transposed SpMV at " << i << " with " << threads << " threads";
+
+			for ( unsigned j = 0; j < 4; ++j )
+				EXPECT_NEAR ( STY ( i, j ), MTY ( i, j ), 1e-12 ) << "Error transposed SpMM at " << i << ", " << j << " with " << threads << " threads";
+			}
+		}
+
+	Vector<type, ROWS> Sx = S * x;
+
+	for ( unsigned i = 0; i < ROWS; ++i )
+		EXPECT_NEAR ( Sx.x[i], Mx.x[i], 1e-12 ) << "Error operator* at " << i;
+	}
+
+TEST ( SparseMatrixTest, EmptyRows_TestCase3 )
+	{
+	using type = float;
+	SparseMatrix<type, 8, 8> E;
+	Vector<type, 8> x ( 1.0f );
+	Vector<type, 8> y;
+	transposedCauchyProduct ( E, x, y, 4 );
+
+	EXPECT_EQ ( E.nonZeros(), 0u ) << "Error empty Matrix has elements";
+
+	for ( unsigned i = 0; i < 8; ++i )
+		EXPECT_EQ ( y.x[i], 0.0f ) << "Error product of empty Matrix at " << i;
+
+	// all elements in one row, threads with empty ranges
+	std::vector<Triplet<type>> triplets;
+
+	for ( unsigned j = 0; j < 8; ++j )
+		triplets.push_back ( Triplet<type>{5, j, type ( j )} );
+
+	SparseMatrix<type, 8, 8> S ( triplets.begin(), triplets.end() );
+	cauchyProduct ( S, x, y, 4 );
+
+	for ( unsigned i = 0; i < 8; ++i )
+		EXPECT_EQ ( y.x[i], i == 5 ? 28.0f : 0.0f ) << "Error SpMV at " << i;
+	}
+
+TEST ( SparseMatrixTest, RowRangesErrors_TestCase4 )
+	{
+	using type = double;
+	Matrix<type, 16, 16> M;
+	fillSparsePattern ( M );
+	const SparseMatrix<type, 16, 16> S ( M );
+	std::vector<unsigned> rows ( 16, 0 );
+
+	// exceptions of worker and of calling thread are rethrown after threads are joined
+	for ( unsigned failing : { 0u, 3u } )
+		{
+		const auto function = [failing, &rows] ( unsigned row_beg, unsigned row_end, unsigned part )
+			{
+			for ( unsigned i = row_beg; i < row_end; ++i )
+				++rows[i];
+
+			if ( part == failing )
+				throw std::runtime_error ( "failing part" );
+			};
+
+		EXPECT_THROW ( S.forRowRanges ( 4, function ), std::runtime_error ) << "Error exception of part " << failing;
+		}
+
+	for ( unsigned i = 0; i < 16; ++i )
+		EXPECT_EQ ( rows[i], 2u ) << "Error row not processed by joined threads " << i;
+	}
+
+#endif // SPARSEMATRIXTEST_HPP
@@ -0,0 +1,76 @@
+#ifndef STRASSENTEST_HPP
+#define STRASSENTEST_HPP
+
+#include <vector>
+#include <memory>
+#include <gtest/gtest.h>
+#include "Matrix.hpp"
+#include "Strassen.hpp"
+
+/**
+ * @brief Compare Strassen product with cauchyProduct for given crossover
+ */
+template<typename T, unsigned SIZE>
+void expectStrassenProduct ( unsigned crossover, T tolerance )
+	{
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> A ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> B ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> C ( new Matrix<T, SIZE, SIZE> );
+	std::unique_ptr<Matrix<T, SIZE, SIZE>> S ( new Matrix<T, SIZE, SIZE> );
+	std::vector<T> workspace ( strassenWorkspaceSize ( SIZE, crossover ) );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < SIZE; ++j )
+			{
+			( *A ) ( i, j ) = T ( ( i*7 + j*3 ) % 13 ) * T ( 0.25 ) - T ( 1.5 );
+			( *B ) ( i, j ) = T ( ( i*5 + j*11 ) % 17 ) * T ( 0.125 ) - T ( 1 );
+			}
+
+	cauchyProduct ( *A, *B, *C );
+	strassenProduct ( *A, *B, *S, workspace.data(), workspace.size(), crossover );
+
+	for ( unsigned i = 0; i < SIZE; ++i )
+		for ( unsigned j = 0; j < SIZE; ++j )
+			EXPECT_NEAR ( ( *S ) ( i, j ), ( *C ) ( i, j ), tolerance ) << "Error product at " << i << ", " << j
+					<< " with crossover " << crossover;
+	}
+
+TEST ( StrassenTest, Blocked_TestCase1 )
+	{
+	// crossover above size, blocked kernel only, tiles and edges
+	expectStrassenProduct<double, 37> ( 64, 1e-12 );
+	expectStrassenProduct<float, 70> ( 128, 1e-4f );
+
+	EXPECT_EQ ( strassenWorkspaceSize ( 37, 64 ), 0u ) << "Error workspace without recursion";
+	}
+
+TEST ( StrassenTest, Recursion_TestCase2 )
+	{
+	// three levels down to 8
+	expectStrassenProduct<double, 64> ( 8, 1e-11 );
+	// 180 -> 90 -> 45, recursion stops at odd size
+	expectStrassenProduct<double, 180> ( 16, 1e-11 );
+	expectStrassenProduct<float, 128> ( 32, 1e-3f );
+
+	EXPECT_EQ ( strassenWorkspaceSize ( 64, 8 ), std::size_t ( 2 * ( 32*32 + 16*16 + 8*8 ) ) ) << "Error workspace size";
+	EXPECT_EQ ( strassenWorkspaceSize ( 180, 16 ), std::size_t ( 2 * ( 90*90 + 45*45 ) ) ) << "Error workspace size";
+	}
+
+TEST ( StrassenTest, Workspace_TestCase3 )
+	{
+	using type = double;
+	Matrix<type, 16, 16> A ( 1.0 );
+	Matrix<type, 16, 16> C;
+	std::vector<type> workspace ( strassenWorkspaceSize ( 16, 4 ) - 1 );
+
+	EXPECT_THROW ( strassenProduct ( A, A, C, workspace.data(), workspace.size(), 4 ), std::runtime_error );
+	EXPECT_THROW ( strassenProduct ( A, C, C, workspace.data(), workspace.size(), 16 ), std::runtime_error );
+
+	strassenProduct ( A, A, C, workspace.data(), workspace.size(), 16 );
+
+	for ( unsigned i = 0; i < 16; ++i )
+		for ( unsigned j = 0; j < 16; ++j )
+			EXPECT_DOUBLE_EQ ( C ( i, j ), 16.0 ) << "Error product at " << i << ", " << j;
+	}
+
+#endif // STRASSENTEST_HPP
@@ -0,0 +1,221 @@
+#ifndef STREAMIOTEST_HPP
+#define STREAMIOTEST_HPP
+
+#include <cstdio>
+#include <string>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "BinaryIO.hpp"
+#include "StreamIO.hpp"
+
+TEST ( StreamIOTest, ReadWrite_TestCase1 )
+	{
+	const std::string path = ::testing::TempDir() + "vecmatlib_stream.vmlb";
+	const unsigned COUNT = 100003;
+
+		{
+		StreamWriter<Vector<float, 3>> writer ( path, 1000 );
+
+		for ( unsigned i = 0; i < COUNT; ++i )
+			writer.write ( Vector<float, 3> { float ( i ), -float ( i ), 0.5f } );
+
+		EXPECT_EQ ( writer.size(), COUNT ) << "Error number of written records";
+		writer.close();
+		}
+
+	// container is complete for mapping
+	MappedArray<Vector<float, 3>> mapped ( path );
+	ASSERT_EQ ( mapped.size(), COUNT ) << "Error number of records";
+	EXPECT_TRUE ( mapped.verify() ) << "Error checksum of streamed container";
+	EXPECT_EQ ( mapped[COUNT - 1].x[1], -float ( COUNT - 1 ) ) << "Error last record";
+
+	StreamReader<Vector<float, 3>> reader ( path, 777 );
+	const Vector<float, 3>* it_beg;
+	const Vector<float, 3>* it_end;
+	unsigned count = 0;
+	unsigned chunks = 0;
+
+	while ( reader.next ( it_beg, it_end ) )
+		{
+		EXPECT_LE ( it_end - it_beg, 784 ) << "Error chunk size";
+
+		for ( ; it_beg != it_end; ++it_beg, ++count )
+			EXPECT_EQ ( it_beg->x[0], float ( count ) ) << "Error record " << count;
+
+		++chunks;
+		}
+
+	EXPECT_EQ ( count, COUNT ) << "Error number of read records";
+	EXPECT_EQ ( chunks, ( COUNT + 783 ) / 784 ) << "Error number of chunks";
+	EXPECT_TRUE ( reader.intact() ) << "Error checksum of read records";
+	EXPECT_FALSE ( reader.next ( it_beg, it_end ) ) << "Error end of stream";
+
+	std::remove ( path.c_str() );
+	}
+
+TEST ( StreamIOTest, Transform_TestCase2 )
+	{
+	const std::string input_path = ::testing::TempDir() + "vecmatlib_stream_input.vmlb";
+	const std::string output_path = ::testing::TempDir() + "vecmatlib_stream_output.vmlb";
+	const unsigned COUNT = 5000;
+	using Points = StreamReader<Vector<double, 3>>;
+	using FloatPoints = StreamReader<Vector<float, 3>>;
+	using Projections = MappedArray<Vector<double, 2>>;
+	Matrix<double, 3, 3> R { 0.0, -1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0 };
+
+		{
+		StreamWriter<Vector<double, 3>> writer ( input_path, 64 );
+
+		for ( unsigned i = 0; i < COUNT; ++i )
+			writer.write ( Vector<double, 3> { double ( i ), 1.0, -2.0 } );
+
+		writer.close();
+		}
+
+	// rotation of stream, 2D projections as output records
+	const std::uint64_t transformed = transformStream<Vector<double, 3>, Vector<double, 2>> ( input_path, output_path,
+									  [&R] ( const Vector<double, 3>* it_beg, const Vector<double, 3>* it_end, Vector<double, 2>* out_beg )
+		{
+		while ( it_beg != it_end )
+			{
+			const Vector<double, 3> p = R * *it_beg++;
+			*out_beg++ = Vector<double, 2> { p.x[0], p.x[1] };
+			}
+		}, 100 );
+
+	EXPECT_EQ ( transformed, COUNT ) << "Error number of transformed records";
+
+	double sum = 0.0;
+	const std::uint64_t count = forEachChunk<Vector<double, 2>> ( output_path,
+								[&sum] ( const Vector<double, 2>* it_beg, const Vector<double, 2>* it_end )
+		{
+		for ( ; it_beg != it_end; ++it_beg )
+			sum += it_beg->x[1];
+		} );
+
+	EXPECT_EQ ( count, COUNT ) << "Error number of records";
+	EXPECT_EQ ( sum, COUNT * ( COUNT - 1.0 ) / 2.0 ) << "Error transformed records";
+	EXPECT_EQ ( Projections ( output_path ) [3].x[0], -1.0 ) << "Error rotated record";
+
+	// wrong type and truncated input
+	EXPECT_THROW ( FloatPoints reader ( input_path ), std::runtime_error ) << "Error type check";
+
+	std::FILE* file = std::fopen ( input_path.c_str(), "r+b" );
+	ASSERT_TRUE ( file != nullptr );
+	BinaryIO::Header h = BinaryIO::header<Vector<double, 3>> ( COUNT + 1, 0 );
+	std::fwrite ( &h, sizeof ( h ), 1, file );
+	std::fclose ( file );
+	EXPECT_THROW ( Points reader ( input_path ), std::runtime_error ) << "Error truncation check";
+
+	std::remove ( input_path.c_str() );
+	std::remove ( output_path.c_str() );
+	}
+
+TEST ( StreamIOTest, ReserveCommit_TestCase3 )
+	{
+	const std::string path = ::testing::TempDir() + "vecmatlib_stream_reserve.vmlb";
+	const unsigned SIZES[] = { 5, 8, 3, 7, 1, 8, 6 };
+	unsigned count = 0;
+
+	// parts of odd sizes flush partial chunks, words of checksum span chunks
+		{
+		StreamWriter<Vector<float, 3>> writer ( path, 8 );
+
+		for ( unsigned size : SIZES )
+			{
+			Vector<float, 3>* it_out = writer.reserve ( size );
+
+			for ( unsigned i = 0; i < size; ++i, ++count )
+				it_out[i] = Vector<float, 3> { float ( count ), 1.0f, -float ( count ) };
+
+			writer.commit ( size );
+			}
+
+		EXPECT_EQ ( writer.size(), count ) << "Error number of committed records";
+		writer.close();
+		}
+
+	MappedArray<Vector<float, 3>> mapped ( path );
+	ASSERT_EQ ( mapped.size(), count ) << "Error number of records";
+	EXPECT_TRUE ( mapped.verify() ) << "Error checksum of reserved records";
+	EXPECT_EQ ( mapped[count - 1].x[2], -float ( count - 1 ) ) << "Error last record";
+
+	StreamReader<Vector<float, 3>> reader ( path, 8 );
+	const Vector<float, 3>* it_beg;
+	const Vector<float, 3>* it_end;
+
+	while ( reader.next ( it_beg, it_end ) )
+		{
+		}
+
+	EXPECT_TRUE ( reader.intact() ) << "Error checksum of read records";
+
+	// checksum of parts equals checksum of whole
+	const char text[] = "incremental checksum of parts";
+	BinaryIO::Hasher hasher;
+	hasher.update ( text, 3 );
+	hasher.update ( text + 3, 0 );
+	hasher.update ( text + 3, 11 );
+	hasher.update ( text + 14, sizeof ( text ) - 14 );
+	EXPECT_EQ ( hasher.value(), BinaryIO::checksum ( text, sizeof ( text ) ) ) << "Error incremental checksum";
+
+	std::remove ( path.c_str() );
+	}
+
+TEST ( StreamIOTest, DamagedInput_TestCase4 )
+	{
+	const std::string input_path = ::testing::TempDir() + "vecmatlib_stream_damaged.vmlb";
+	const std::string output_path = ::testing::TempDir() + "vecmatlib_stream_damaged_output.vmlb";
+	using Points = StreamReader<Vector<float, 3>>;
+	using Point = Vector<float, 3>;
+	const auto copy = [] ( const Vector<float, 3>* it_beg, const Vector<float, 3>* it_end, Vector<float, 3>* out_beg )
+		{
+		while ( it_beg != it_end )
+			*out_beg++ = *it_beg++;
+		};
+	const auto failing = [] ( const Vector<float, 3>* it_beg, const Vector<float, 3>*, Vector<float, 3>* )
+		{
+		if ( it_beg->x[0] >= 32.0f )
+			throw std::runtime_error ( "failing transformation" );
+		};
+
+		{
+		StreamWriter<Vector<float, 3>> writer ( input_path, 16 );
+
+		for ( unsigned i = 0; i < 100; ++i )
+			writer.write ( Vector<float, 3> { float ( i ), 2.0f, 3.0f } );
+
+		writer.close();
+		}
+
+	// writer which is not closed leaves no container
+		{
+		StreamWriter<Vector<float, 3>> writer ( output_path, 16 );
+		writer.write ( Vector<float, 3> { 1.0f, 2.0f, 3.0f } );
+		}
+
+	EXPECT_THROW ( Points reader ( output_path ), std::runtime_error ) << "Error container of writer without close";
+
+	// transformation throwing in the middle of stream
+	EXPECT_THROW ( transformStream<Point> ( input_path, output_path, failing, 16 ), std::runtime_error ) << "Error failing transformation";
+	EXPECT_THROW ( Points reader ( output_path ), std::runtime_error ) << "Error output of failing transformation";
+
+	// one damaged byte of last record
+	std::FILE* file = std::fopen ( input_path.c_str(), "r+b" );
+	ASSERT_TRUE ( file != nullptr );
+	std::fseek ( file, -1, SEEK_END );
+	const int last = std::fgetc ( file );
+	std::fseek ( file, -1, SEEK_END );
+	std::fputc ( last ^ 0x10, file );
+	std::fclose ( file );
+
+	EXPECT_THROW ( transformStream<Point> ( input_path, output_path, copy, 16 ), std::runtime_error ) << "Error damaged input";
+	EXPECT_THROW ( Points reader ( output_path ), std::runtime_error ) << "Error output of damaged input";
+
+	std::remove ( input_path.c_str() );
+	std::remove ( output_path.c_str() );
+	}
+
+#endif // STREAMIOTEST_HPP
@@ -0,0 +1,229 @@
+#ifndef SYMMETRICEIGENTEST_HPP
+#define SYMMETRICEIGENTEST_HPP
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "Matrix.hpp"
+#include "SymmetricEigen.hpp"
+
+/**
+ * @brief Reference eigenvalues by classic Jacobi method in long double, ascending
+ */
+template<typename T>
+void referenceEigenvalues ( const Matrix<T, 3, 3>& m, long double ( &values ) [3] )
+	{
+	long double a[3][3];
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			a[i][j] = m.x[std::min ( i, j )][std::max ( i, j )];
+
+	for ( unsigned sweep = 0; sweep < 50; ++sweep )
+		for ( unsigned p = 0; p < 2; ++p )
+			for ( unsigned q = p+1; q < 3; ++q )
+				{
+				if ( a[p][q] == 0 )
+					continue;
+
+				const long double theta = ( a[q][q] - a[p][p] ) / ( 2 * a[p][q] );
+				const long double t = ( theta < 0 ? -1 : 1 ) / ( std::fabs ( theta ) + std::sqrt ( theta*theta + 1 ) );
+				const long double c = 1 / std::sqrt ( t*t + 1 );
+				const long double s = t * c;
+
+				// A = transpose(J)*A*J
+				for ( unsigned k = 0; k < 3; ++k )
+					{
+					const long double a_kp = a[k][p];
+					const long double a_kq = a[k][q];
+
+					a[k][p] = c*a_kp - s*a_kq;
+					a[k][q] = s*a_kp + c*a_kq;
+					}
+
+				for ( unsigned k = 0; k < 3; ++k )
+					{
+					const long double a_pk = a[p][k];
+					const long double a_qk = a[q][k];
+
+					a[p][k] = c*a_pk - s*a_qk;
+					a[q][k] = s*a_pk + c*a_qk;
+					}
+				}
+
+	for ( unsigned i = 0; i < 3; ++i )
+		values[i] = a[i][i];
+
+	std::sort ( values, values + 3 );
+	}
+
+/**
+ * @brief Check eigenvalues against reference, residuals, orthonormality and orientation of eigenvectors
+ */
+template<typename T>
+void expectEigenDecomposition ( const Matrix<T, 3, 3>& m, const Vector<T, 3>& values, const Matrix<T, 3, 3>& vectors, T tolerance )
+	{
+	long double reference[3];
+	T scale = T ( 0 );
+
+	referenceEigenvalues ( m, reference );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			scale = std::max ( scale, std::abs ( m.x[i][j] ) );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		EXPECT_NEAR ( values.x[i], T ( reference[i] ), tolerance * scale ) << "Error eigenvalue " << i;
+
+	for ( unsigned i = 0; i < 3; ++i )
+		{
+		Vector<T, 3> v;
+		Container::copy ( v.begin(), v.end(), vectors.begin ( i ) );
+		Vector<T, 3> av = m*v;
+
+		for ( unsigned k = 0; k < 3; ++k )
+			EXPECT_NEAR ( av.x[k], values.x[i] * v.x[k], tolerance * scale ) << "Error residual of eigenvector " << i;
+
+		for ( unsigned j = 0; j < 3; ++j )
+			{
+			T dot = T ( 0 );
+
+			for ( unsigned k = 0; k < 3; ++k )
+				dot += vectors.x[i][k] * vectors.x[j][k];
+
+			EXPECT_NEAR ( dot, i == j ? T ( 1 ) : T ( 0 ), tolerance ) << "Error orthonormality " << i << ", " << j;
+			}
+		}
+
+	EXPECT_NEAR ( determinant ( vectors ), T ( 1 ), tolerance ) << "Error orientation of eigenvectors";
+	}
+
+/**
+ * @brief Symmetric Matrix R*diag(d)*transpose(R) for rotation R given by angles
+ */
+template<typename T>
+Matrix<T, 3, 3> symmetricFromEigen ( T d0, T d1, T d2, const Vector<T, 3>& angles )
+	{
+	Matrix<T, 3, 3> r = rotationMatrix ( angles );
+	Matrix<T, 3, 3> m;
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			m ( i, j ) = r ( i, 0 )*d0*r ( j, 0 ) + r ( i, 1 )*d1*r ( j, 1 ) + r ( i, 2 )*d2*r ( j, 2 );
+
+	// exactly symmetric
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < i; ++j )
+			m ( i, j ) = m ( j, i );
+
+	return m;
+	}
+
+TEST ( SymmetricEigenTest, Covariance_TestCase1 )
+	{
+	using type = double;
+	Matrix<type, 3, 3> M{2, -1, 0,
+						 -1, 2, -1,
+						 0, -1, 2};
+	Vector<type, 3> values;
+	Matrix<type, 3, 3> vectors;
+
+	symmetricEigen ( M, values, vectors );
+
+	EXPECT_NEAR ( values.x[0], 2 - std::sqrt ( 2.0 ), 1e-14 ) << "Error smallest eigenvalue";
+	EXPECT_NEAR ( values.x[1], 2.0, 1e-14 ) << "Error middle eigenvalue";
+	EXPECT_NEAR ( values.x[2], 2 + std::sqrt ( 2.0 ), 1e-14 ) << "Error largest eigenvalue";
+	expectEigenDecomposition ( M, values, vectors, 1e-13 );
+	}
+
+TEST ( SymmetricEigenTest, DegenerateCases_TestCase2 )
+	{
+	using type = double;
+	const Vector<type, 3> angles{0.3, -1.1, 2.0};
+	std::vector<Matrix<type, 3, 3>> matrices
+		{
+		Matrix<type, 3, 3> ( 0.0 ),
+		Matrix<type, 3, 3> {3, 0, 0, 0, -1, 0, 0, 0, 2},
+		symmetricFromEigen<type> ( 1, 1, 1, angles ),
+		// planar patch, double eigenvalue and zero eigenvalue
+		symmetricFromEigen<type> ( 0, 1, 1, angles ),
+		// nearly double eigenvalues
+		symmetricFromEigen<type> ( 1, 1 + 1e-9, 5, angles ),
+		symmetricFromEigen<type> ( -5, 1, 1 + 1e-9, angles ),
+		// large dynamic range
+		symmetricFromEigen<type> ( 1e-12, 1e-6, 1, angles ),
+		symmetricFromEigen<type> ( 1e150, 2e150, -3e150, angles )
+		};
+
+	for ( const Matrix<type, 3, 3>& M : matrices )
+		{
+		Vector<type, 3> values;
+		Matrix<type, 3, 3> vectors;
+
+		symmetricEigen ( M, values, vectors );
+		expectEigenDecomposition ( M, values, vectors, 1e-12 );
+
+		symmetricEigenJacobi ( M, values, vectors );
+		expectEigenDecomposition ( M, values, vectors, 1e-12 );
+		}
+	}
+
+TEST ( SymmetricEigenTest, RandomAgainstReference_TestCase3 )
+	{
+	using type = float;
+	unsigned seed = 12345;
+	auto random = [&seed]()
+		{
+		seed = seed * 1664525u + 1013904223u;
+		return float ( seed >> 8 ) / float ( 1u << 24 ) * 2.0f - 1.0f;
+		};
+
+	for ( unsigned n = 0; n < 200; ++n )
+		{
+		Matrix<type, 3, 3> M;
+
+		for ( unsigned i = 0; i < 3; ++i )
+			for ( unsigned j = i; j < 3; ++j )
+				M ( i, j ) = M ( j, i ) = random();
+
+		Vector<type, 3> values;
+		Matrix<type, 3, 3> vectors;
+
+		symmetricEigen ( M, values, vectors );
+		expectEigenDecomposition ( M, values, vectors, 1e-5f );
+		}
+	}
+
+TEST ( SymmetricEigenTest, Batch_TestCase4 )
+	{
+	using type = float;
+	// not multiple of lanes
+	const unsigned count = 37;
+	const Vector<type, 3> angles{-0.7f, 0.4f, 1.3f};
+	std::vector<Matrix<type, 3, 3>> matrices ( count );
+	std::vector<Vector<type, 3>> values ( count );
+	std::vector<Matrix<type, 3, 3>> vectors ( count );
+
+	for ( unsigned n = 0; n < count; ++n )
+		matrices[n] = symmetricFromEigen<type> ( type ( n % 5 ) - 2.0f, type ( n % 3 ), 0.01f * type ( n ), angles * type ( n + 1 ) );
+
+	symmetricEigenBatch ( matrices.begin(), matrices.end(), values.begin(), vectors.begin() );
+
+	for ( unsigned n = 0; n < count; ++n )
+		expectEigenDecomposition ( matrices[n], values[n], vectors[n], 1e-5f );
+
+	std::vector<Matrix<double, 3, 3>> matrices_double ( count );
+	std::vector<Vector<double, 3>> values_double ( count );
+	std::vector<Matrix<double, 3, 3>> vectors_double ( count );
+
+	for ( unsigned n = 0; n < count; ++n )
+		matrices_double[n] = matrices[n];
+
+	symmetricEigenBatch ( matrices_double.begin(), matrices_double.end(), values_double.begin(), vectors_double.begin() );
+
+	for ( unsigned n = 0; n < count; ++n )
+		expectEigenDecomposition ( matrices_double[n], values_double[n], vectors_double[n], 1e-13 );
+	}
+
+#endif // SYMMETRICEIGENTEST_HPP
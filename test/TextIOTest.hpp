@@ -0,0 +1,213 @@
+#ifndef TEXTIOTEST_HPP
+#define TEXTIOTEST_HPP
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "TextIO.hpp"
+#include "BinaryIO.hpp"
+
+TEST ( TextIOTest, Format_TestCase1 )
+	{
+	char buffer[256];
+	Vector<double, 3> v { 0.1, -2.5, 1e300 };
+
+	// shortest text is read back to the same value
+	char* it_end = format ( buffer, buffer + sizeof ( buffer ), v );
+	ASSERT_TRUE ( it_end != nullptr ) << "Error buffer overflow";
+	EXPECT_EQ ( std::string ( buffer, it_end ), "0.1 -2.5 1e+300" ) << "Error shortest format";
+
+	it_end = format ( buffer, buffer + sizeof ( buffer ), v, TextIO::Format ( TextIO::CSV, 3 ) );
+	EXPECT_EQ ( std::string ( buffer, it_end ), "0.1,-2.5,1e+300" ) << "Error CSV format";
+
+	const Vector<double, 2> third { 1.0 / 3.0, 2.0 / 3.0 };
+	it_end = format ( buffer, buffer + sizeof ( buffer ), third, TextIO::Format ( TextIO::TSV, 4 ) );
+	EXPECT_EQ ( std::string ( buffer, it_end ), "0.3333\t0.6667" ) << "Error TSV format with precision";
+
+	it_end = format ( buffer, buffer + sizeof ( buffer ), third );
+	*it_end = '\0';
+	char* it_next;
+	EXPECT_EQ ( std::strtod ( buffer, &it_next ), third.x[0] ) << "Error round trip";
+	EXPECT_EQ ( std::strtod ( it_next, nullptr ), third.x[1] ) << "Error round trip";
+
+	const std::vector<float> floats { 0.1f, 3.0e-39f, std::numeric_limits<float>::max(), -0.0f, 16777216.0f };
+
+	for ( float f : floats )
+		{
+		it_end = TextIO::formatValue ( buffer, buffer + sizeof ( buffer ), f );
+		*it_end = '\0';
+		EXPECT_EQ ( std::strtof ( buffer, nullptr ), f ) << "Error round trip of float " << buffer;
+		EXPECT_LE ( std::size_t ( it_end - buffer ), TextIO::maxChars<float> ( TextIO::SHORTEST ) ) << "Error bound of characters";
+		}
+
+	Matrix<std::int32_t, 2, 3> m { 1, -20, 300, std::numeric_limits<std::int32_t>::min(), 0, 7 };
+	it_end = format ( buffer, buffer + sizeof ( buffer ), m, TextIO::Format ( TextIO::CSV ) );
+	EXPECT_EQ ( std::string ( buffer, it_end ), "1,-20,300\n-2147483648,0,7" ) << "Error Matrix format";
+
+	// text does not fit
+	EXPECT_TRUE ( format ( buffer, buffer + 12, m ) == nullptr ) << "Error overflow not detected";
+	EXPECT_TRUE ( format ( buffer, buffer + 14, v ) == nullptr ) << "Error overflow not detected";
+
+	// stream operators are wrappers with precision of stream
+	std::ostringstream out;
+	out << Vector<float, 3> { 1.0f, 2.5f, -3.0f } << '\n' << Matrix<double, 2, 2> { 1.0 / 3.0, 2.0, 3.0, 4.0 };
+	EXPECT_EQ ( out.str(), "[ 1 2.5 -3 ]\n[ 0.333333 2 ]\n[ 3 4 ]" ) << "Error stream operators";
+
+	// rows longer than stack buffer of print
+	Matrix<double, 2, 64> wide;
+	Vector<double, 64> first_row, second_row;
+
+	for ( unsigned j = 0; j < 64; ++j )
+		{
+		wide.x[0][j] = first_row.x[j] = 1.0 / ( j + 3.0 );
+		wide.x[1][j] = second_row.x[j] = -1.0 * j;
+		}
+
+	std::ostringstream wide_out, rows_out;
+	wide_out << std::setprecision ( 17 ) << wide;
+	rows_out << std::setprecision ( 17 ) << first_row << '\n' << second_row;
+	EXPECT_GT ( wide_out.str().size(), TextIO::PRINT_BUFFER ) << "Error size of wide Matrix text";
+	EXPECT_EQ ( wide_out.str(), rows_out.str() ) << "Error wide Matrix text";
+	}
+
+TEST ( TextIOTest, WriteText_TestCase2 )
+	{
+	const unsigned COUNT = 20000;
+	std::vector<Vector<double, 3>> points ( COUNT );
+
+	for ( unsigned i = 0; i < COUNT; ++i )
+		points[i] = Vector<double, 3> { i * 0.1, -1.0 / ( i + 1 ), i * 1e10 };
+
+	std::ostringstream out;
+	EXPECT_EQ ( writeText ( out, points.begin(), points.end(), TextIO::Format ( TextIO::CSV ) ), COUNT ) << "Error number of records";
+
+	// lines of CSV read back to the same values
+	const std::string text = out.str();
+	const char* it = text.c_str();
+	unsigned count = 0;
+
+	while ( *it != '\0' && count < COUNT )
+		{
+		char* it_next;
+
+		for ( unsigned j = 0; j < 3; ++j )
+			{
+			EXPECT_EQ ( std::strtod ( it, &it_next ), points[count].x[j] ) << "Error record " << count << " at " << j;
+			EXPECT_EQ ( *it_next, j < 2 ? ',' : '\n' ) << "Error delimiter of record " << count;
+			it = it_next + 1;
+			}
+
+		++count;
+		}
+
+	EXPECT_EQ ( count, COUNT ) << "Error number of lines";
+	EXPECT_EQ ( *it, '\0' ) << "Error end of text";
+
+	// Matrix records as single lines
+	std::vector<Matrix<int, 2, 2>> matrices ( 2, Matrix<int, 2, 2> ( 5 ) );
+	matrices[1].x[1][0] = -1;
+	std::ostringstream matrices_out;
+	writeText ( matrices_out, matrices.begin(), matrices.end(), TextIO::Format ( TextIO::TSV ) );
+	EXPECT_EQ ( matrices_out.str(), "5\t5\t5\t5\n5\t5\t-1\t5\n" ) << "Error Matrix records";
+	}
+
+TEST ( TextIOTest, Parse_TestCase3 )
+	{
+	const unsigned COUNT = 30000;
+	std::vector<Vector<double, 3>> points ( COUNT );
+
+	for ( unsigned i = 0; i < COUNT; ++i )
+		points[i] = Vector<double, 3> { i / 7.0, -1.0 / ( i + 3 ), i * 1e-300 };
+
+	// records of all modes are read back to the same values, by parts in threads
+	for ( TextIO::Mode mode : { TextIO::PLAIN, TextIO::CSV, TextIO::TSV } )
+		{
+		std::ostringstream out;
+		out << "# x, y, z\n\n";
+		writeText ( out, points.begin(), points.end(), TextIO::Format ( mode ) );
+		const std::string text = out.str();
+
+		for ( unsigned threads : { 1u, 4u } )
+			{
+			const std::vector<Vector<double, 3>> parsed = parseText<Vector<double, 3>> ( text.data(), text.data() + text.size(), threads );
+			ASSERT_EQ ( parsed.size(), COUNT ) << "Error number of records with " << threads << " threads";
+
+			for ( unsigned i = 0; i < COUNT; ++i )
+				for ( unsigned j = 0; j < 3; ++j )
+					EXPECT_EQ ( parsed[i].x[j], points[i].x[j] ) << "Error record " << i << " at " << j;
+			}
+		}
+
+	// single records, new lines separate elements
+	const std::string text = " 1, +2.5\t-3e2\n4 5 6 7";
+	Vector<float, 3> v;
+	Matrix<int, 2, 2> m;
+	const char* it = parse ( text.data(), text.data() + text.size(), v );
+	EXPECT_EQ ( v.x[0], 1.0f ) << "Error parsed Vector";
+	EXPECT_EQ ( v.x[1], 2.5f ) << "Error parsed Vector";
+	EXPECT_EQ ( v.x[2], -300.0f ) << "Error parsed Vector";
+	EXPECT_EQ ( parse ( it, text.data() + text.size(), m ), text.data() + text.size() ) << "Error end of Matrix";
+	EXPECT_EQ ( m.x[1][0], 6 ) << "Error parsed Matrix";
+	EXPECT_EQ ( m.x[1][1], 7 ) << "Error parsed Matrix";
+
+	// errors with position
+	const std::string malformed = "1,2,3\n4,x,6\n";
+
+	try
+		{
+		parseText<Vector<double, 3>> ( malformed.data(), malformed.data() + malformed.size() );
+		ADD_FAILURE() << "Error malformed number not detected";
+		}
+	catch ( const TextIO::ParseError& error )
+		{
+		EXPECT_EQ ( error.line, 2u ) << "Error line of error";
+		EXPECT_EQ ( error.column, 3u ) << "Error column of error";
+		EXPECT_EQ ( error.offset, 8u ) << "Error offset of error";
+		}
+
+	const std::string short_line = "1 2 3\n4 5\n";
+	const std::string long_line = "1 2 3\n4 5 6 7\n";
+	const std::string overflow = "1 2 300\n";
+	using Point = Vector<double, 3>;
+	using Bytes = Vector<std::uint8_t, 3>;
+	EXPECT_THROW ( parseText<Point> ( short_line.data(), short_line.data() + short_line.size() ), TextIO::ParseError ) << "Error short line";
+	EXPECT_THROW ( parseText<Point> ( long_line.data(), long_line.data() + long_line.size() ), TextIO::ParseError ) << "Error long line";
+	EXPECT_THROW ( parseText<Bytes> ( overflow.data(), overflow.data() + overflow.size() ), TextIO::ParseError ) << "Error integer overflow";
+	EXPECT_THROW ( parse ( short_line.data(), short_line.data() + 6, m ), TextIO::ParseError ) << "Error end of text";
+	}
+
+TEST ( TextIOTest, ReadText_TestCase4 )
+	{
+	const std::string path = ::testing::TempDir() + "vecmatlib_points.csv";
+	std::vector<Matrix<float, 2, 2>> matrices ( 1000, Matrix<float, 2, 2> ( 0.25f ) );
+	matrices[999].x[1][0] = -1e-7f;
+
+		{
+		std::ofstream out ( path, std::ios::binary );
+		writeText ( out, matrices.begin(), matrices.end(), TextIO::Format ( TextIO::CSV ) );
+		}
+
+	const std::vector<Matrix<float, 2, 2>> parsed = readText<Matrix<float, 2, 2>> ( path, 2 );
+	ASSERT_EQ ( parsed.size(), 1000u ) << "Error number of records";
+	EXPECT_EQ ( parsed[999].x[1][0], -1e-7f ) << "Error record of mapped text";
+	EXPECT_EQ ( parsed[0].x[0][1], 0.25f ) << "Error record of mapped text";
+
+	// empty file has no records
+	using Record = Matrix<float, 2, 2>;
+	std::ofstream ( path, std::ios::binary ).close();
+	EXPECT_EQ ( readText<Record> ( path ).size(), 0u ) << "Error empty file";
+	EXPECT_THROW ( readText<float> ( ::testing::TempDir() + "vecmatlib_missing.csv" ), std::runtime_error ) << "Error missing file";
+
+	std::remove ( path.c_str() );
+	}
+
+#endif // TEXTIOTEST_HPP
@@ -0,0 +1,314 @@
+#ifndef VIEWTEST_HPP
+#define VIEWTEST_HPP
+
+#include <vector>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include "Vector.hpp"
+#include "Matrix.hpp"
+#include "View.hpp"
+
+TEST ( ViewTest, Strides_TestCase1 )
+	{
+	// external buffer of 3 x 4 Matrix with padded rows of 6 elements
+	std::vector<double> buffer ( 18, -1.0 );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 4; ++j )
+			buffer[i*6 + j] = i*10.0 + j;
+
+	MatrixView<double, 3, 4> m ( buffer.data(), 6 );
+	MatrixView<double> d ( buffer.data(), 3, 4, 6, 1 );
+
+	EXPECT_EQ ( m.rows(), 3u ) << "Error rows";
+	EXPECT_EQ ( d.cols(), 4u ) << "Error cols";
+	EXPECT_EQ ( m ( 2, 3 ), 23.0 ) << "Error element";
+	EXPECT_EQ ( d.transpose() ( 3, 2 ), 23.0 ) << "Error transposed element";
+	EXPECT_EQ ( m.col ( 1 ) [2], 21.0 ) << "Error col";
+	EXPECT_EQ ( m.row ( 1 ).sum(), 46.0 ) << "Error row sum";
+	EXPECT_EQ ( m.sum(), 138.0 ) << "Error sum skips padding";
+	EXPECT_EQ ( d.transpose().sum(), 138.0 ) << "Error sum of transposed view";
+	EXPECT_THROW ( m.row ( 0 ) [4], std::runtime_error ) << "Error range check";
+
+	unsigned count = 0;
+
+	for ( double x : d )
+		{
+		EXPECT_EQ ( x, buffer[ ( count / 4 ) * 6 + count % 4] ) << "Error iteration at " << count;
+		++count;
+		}
+
+	EXPECT_EQ ( count, 12u ) << "Error number of iterated elements";
+
+	// write through view, padding is untouched
+	d.col ( 0 ).fill ( 5.0 );
+	m *= 2.0;
+	EXPECT_EQ ( buffer[6], 10.0 ) << "Error write through view";
+	EXPECT_EQ ( buffer[4], -1.0 ) << "Error padding";
+	EXPECT_EQ ( buffer[17], -1.0 ) << "Error padding";
+
+	EXPECT_THROW ( ( MatrixView<double, 3, 4> ( buffer.data(), 2, 4, 6, 1 ) ), std::runtime_error ) << "Error static extent";
+	EXPECT_THROW ( d.row ( 0 ) = d.col ( 0 ), std::runtime_error ) << "Error dynamic extents";
+	}
+
+TEST ( ViewTest, Arithmetic_TestCase2 )
+	{
+	float buffer[8] = { 1.0f, 0.0f, 2.0f, 0.0f, 3.0f, 0.0f, 4.0f, 0.0f };
+	Vector<float, 4> v;
+	v.x[0] = 1.0f; v.x[1] = 1.0f; v.x[2] = 2.0f; v.x[3] = 2.0f;
+
+	VectorView<float, 4> a ( buffer, 2 );
+	const Vector<float, 4> sum = a + v;
+	const Vector<float, 4> product = v * a;
+	const Vector<float, 4> scaled = 2.0f * a;
+	const Vector<float, 4> negated = 1.0f - a;
+
+	for ( unsigned i = 0; i < 4; ++i )
+		{
+		EXPECT_EQ ( sum.x[i], buffer[2*i] + v.x[i] ) << "Error sum at " << i;
+		EXPECT_EQ ( product.x[i], buffer[2*i] * v.x[i] ) << "Error product at " << i;
+		EXPECT_EQ ( scaled.x[i], 2.0f * buffer[2*i] ) << "Error scaled at " << i;
+		EXPECT_EQ ( negated.x[i], 1.0f - buffer[2*i] ) << "Error subtracted from value at " << i;
+		}
+
+	EXPECT_EQ ( a.dot ( v ), 17.0f ) << "Error dot";
+	EXPECT_EQ ( VectorView<const float> ( buffer, 4, 2 ).dot ( a ), 30.0f ) << "Error dot of dynamic view";
+	EXPECT_FLOAT_EQ ( a.norm(), std::sqrt ( 30.0f ) ) << "Error norm";
+
+	// results written into buffer
+	a -= v;
+	VectorView<float> ( buffer + 1, 4, 2 ) = v;
+	a += 1.0f;
+
+	const float expected[8] = { 1.0f, 1.0f, 2.0f, 1.0f, 2.0f, 2.0f, 3.0f, 2.0f };
+
+	for ( unsigned i = 0; i < 8; ++i )
+		EXPECT_EQ ( buffer[i], expected[i] ) << "Error buffer at " << i;
+
+	// view of Vector refers its elements
+	VectorView<float> w ( v );
+	w /= 2.0f;
+	EXPECT_EQ ( v.x[3], 1.0f ) << "Error view of Vector";
+	}
+
+TEST ( ViewTest, Product_TestCase3 )
+	{
+	Matrix<int, 3, 5> A;
+	Vector<int, 5> v;
+	int buffer[3*5];
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < 5; ++j )
+			{
+			A.x[i][j] = int ( i*5 + j ) - 4;
+			buffer[j*3 + i] = int ( j ) + 2*int ( i );
+			}
+
+	for ( unsigned j = 0; j < 5; ++j )
+		v.x[j] = int ( j ) + 1;
+
+	// buffer stored by cols is 5 x 3 Matrix transposed
+	const MatrixView<const int, 3, 5> B = MatrixView<const int, 5, 3> ( buffer ).transpose();
+	const Vector<int, 3> Av = A * v;
+	const Vector<int, 3> Bv = B * v;
+	const Matrix<int, 3, 3> AB = A * MatrixView<const int, 5, 3> ( buffer );
+	int out[2*9];
+
+	for ( unsigned i = 0; i < 3; ++i )
+		{
+		int reference = 0;
+
+		for ( unsigned k = 0; k < 5; ++k )
+			reference += B ( i, k ) * v.x[k];
+
+		EXPECT_EQ ( Bv.x[i], reference ) << "Error strided Matrix Vector product at " << i;
+		}
+
+	// products written into strided views of the output buffer
+	MatrixView<int> C ( out, 3, 3, 6, 2 );
+	cauchyProduct ( MatrixView<const int> ( A ), v, VectorView<int> ( out + 1, 3, 6 ) );
+	cauchyProduct ( A, MatrixView<const int, 5, 3> ( buffer ), C );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		{
+		EXPECT_EQ ( out[i*6 + 1], Av.x[i] ) << "Error Matrix Vector product into view at " << i;
+
+		for ( unsigned j = 0; j < 3; ++j )
+			EXPECT_EQ ( C ( i, j ), AB.x[i][j] ) << "Error Matrix product into view at " << i << ", " << j;
+		}
+
+	const Matrix<int, 3, 3> D = C - AB;
+	EXPECT_EQ ( ( MatrixView<const int, 3, 3> ( D ).sum() ), 0 ) << "Error difference of view and Matrix";
+	EXPECT_THROW ( cauchyProduct ( MatrixView<const int> ( A ), v, VectorView<int> ( out, 2 ) ), std::runtime_error ) << "Error extents of product";
+	}
+
+TEST ( ViewTest, Block_TestCase4 )
+	{
+	Matrix<double, 4, 4> M;
+
+	for ( unsigned i = 0; i < 4; ++i )
+		for ( unsigned j = 0; j < 4; ++j )
+			M.x[i][j] = ( i == j ? 6.0 : 0.0 ) + double ( ( i*3 + j*5 ) % 7 ) - 3.0;
+
+	const Matrix<double, 4, 4> N = M;
+	Matrix<double, 2, 2> A;
+	Matrix<double, 2, 2> A_inv;
+
+	// in place Schur complement D - C A^-1 B of M = [ A B; C D ]
+	A.block<2, 2> ( 0, 0 ) = M.block<2, 2> ( 0, 0 );
+	ASSERT_TRUE ( inverse ( A, A_inv ) ) << "Error singular block";
+	const Matrix<double, 2, 2> X = A_inv * M.block<2, 2> ( 0, 2 );
+	M.block<2, 2> ( 2, 2 ) -= M.block<2, 2> ( 2, 0 ) * X;
+
+	for ( unsigned i = 0; i < 4; ++i )
+		for ( unsigned j = 0; j < 4; ++j )
+			{
+			double reference = N.x[i][j];
+
+			if ( i >= 2 && j >= 2 )
+				for ( unsigned k = 0; k < 2; ++k )
+					for ( unsigned l = 0; l < 2; ++l )
+						reference -= N.x[i][k] * A_inv.x[k][l] * N.x[l][j];
+
+			EXPECT_NEAR ( M.x[i][j], reference, 1e-12 ) << "Error Schur complement at " << i << ", " << j;
+			}
+
+	// rows and cols as operands and outputs
+	Matrix<double, 3, 2> P ( 0.0 );
+	cauchyProduct ( N.block<2, 4> ( 0, 0 ), N.col ( 2 ), P.row ( 1 ) );
+	P.col ( 0 ) += N.row ( 3 ).dot ( N.col ( 1 ) );
+
+	for ( unsigned i = 0; i < 2; ++i )
+		EXPECT_DOUBLE_EQ ( P.x[1][i], N.row ( i ).dot ( N.col ( 2 ) ) + ( i == 0 ? P.x[0][0] : 0.0 ) ) << "Error product into row at " << i;
+
+	EXPECT_DOUBLE_EQ ( P.x[2][0], N.x[3][0]*N.x[0][1] + N.x[3][1]*N.x[1][1] + N.x[3][2]*N.x[2][1] + N.x[3][3]*N.x[3][1] ) << "Error col";
+	EXPECT_EQ ( P.x[2][1], 0.0 ) << "Error col stride";
+
+	EXPECT_THROW ( ( M.block<2, 2> ( 3, 0 ) ), std::runtime_error ) << "Error block range check";
+	EXPECT_THROW ( N.row ( 4 ), std::runtime_error ) << "Error row range check";
+	EXPECT_THROW ( N.col ( 4 ), std::runtime_error ) << "Error col range check";
+	}
+
+TEST ( ViewTest, Reinterpret_TestCase5 )
+	{
+	Vector<float, 3> v;
+	Vector<float, 4> w;
+	Matrix<float, 4, 3> M;
+	Matrix<float, 1, 4> r;
+
+	for ( unsigned i = 0; i < 3; ++i )
+		v.x[i] = float ( i ) + 1.0f;
+
+	for ( unsigned j = 0; j < 4; ++j )
+		{
+		w.x[j] = 0.5f * float ( j ) - 1.0f;
+		r.x[0][j] = w.x[j];
+
+		for ( unsigned i = 0; i < 3; ++i )
+			M.x[j][i] = float ( i*4 + j ) - 5.0f;
+		}
+
+	// the same elements are referred
+	EXPECT_EQ ( &v.asColumn() ( 2, 0 ), &v.x[2] ) << "Error column view";
+	EXPECT_EQ ( &v.asRow() ( 0, 2 ), &v.x[2] ) << "Error row view";
+	EXPECT_EQ ( r.asVector().data, *r.x ) << "Error Vector view of Matrix";
+
+	const Vector<float, 4> Mv = M * v;
+	const Matrix<float, 4, 1> Mv_col = M * v.asColumn();
+	const Matrix<float, 1, 4> vMt = v.asRow() * MatrixView<const float, 3, 4> ( *M.x, 1, 3 );
+	const Matrix<float, 3, 4> outer = v * r;
+	const Matrix<float, 3, 4> outer_view = v.asColumn() * w.asRow();
+	const Matrix<float, 3, 4> outer_row = v * w.asRow();
+
+	for ( unsigned j = 0; j < 4; ++j )
+		{
+		EXPECT_FLOAT_EQ ( Mv_col.x[j][0], Mv.x[j] ) << "Error product with column at " << j;
+		EXPECT_FLOAT_EQ ( vMt.x[0][j], Mv.x[j] ) << "Error product with row at " << j;
+
+		for ( unsigned i = 0; i < 3; ++i )
+			{
+			EXPECT_EQ ( outer_view.x[i][j], outer.x[i][j] ) << "Error outer product at " << i << ", " << j;
+			EXPECT_EQ ( outer_row.x[i][j], outer.x[i][j] ) << "Error outer product with row at " << i << ", " << j;
+			}
+		}
+
+	EXPECT_FLOAT_EQ ( r.asVector().dot ( w ), w.dot ( w ) ) << "Error dot of Matrix row";
+
+	// writes through reinterpreted Vector
+	v.asRow() += r.block<1, 3> ( 0, 1 );
+	r.asVector() *= 2.0f;
+	EXPECT_FLOAT_EQ ( v.x[2], 3.5f ) << "Error write through row view";
+	EXPECT_FLOAT_EQ ( r.x[0][3], 1.0f ) << "Error write through Vector view";
+	}
+
+TEST ( ViewTest, VectorMatrixOperations_TestCase6 )
+	{
+	// Vectors of 3 elements stored with stride 2
+	double buffer[6] = { 1.0, -1.0, 2.0, -1.0, 2.0, -1.0 };
+	Vector<double, 3> u { 0.0, 1.0, 0.0 };
+	VectorView<double, 3> a ( buffer, 2 );
+	const Vector<double, 3> reference = Vector<double, 3> { 1.0, 2.0, 2.0 }.cross ( u );
+	const Vector<double, 3> c = a.cross ( u );
+	Vector<double, 3> d;
+	crossProduct ( u, a, d );
+
+	for ( unsigned i = 0; i < 3; ++i )
+		{
+		EXPECT_EQ ( c.x[i], reference.x[i] ) << "Error cross of view at " << i;
+		EXPECT_EQ ( d.x[i], -reference.x[i] ) << "Error crossProduct of Vector and view at " << i;
+		}
+
+	// output may be operand
+	crossProduct ( a, u, a );
+	EXPECT_EQ ( buffer[4], reference.x[2] ) << "Error cross product into operand";
+	EXPECT_THROW ( crossProduct ( VectorView<double> ( buffer, 2, 2 ), u, d ), std::runtime_error ) << "Error extent of cross product";
+
+	VectorView<double, 3> ( buffer, 2 ) = Vector<double, 3> { 3.0, 0.0, 4.0 };
+	EXPECT_TRUE ( a.normalize() ) << "Error normalization";
+	EXPECT_DOUBLE_EQ ( buffer[4], 0.8 ) << "Error normalized element";
+	EXPECT_EQ ( buffer[1], -1.0 ) << "Error normalization outside of view";
+	a.fill ( 0.0 );
+	EXPECT_FALSE ( a.normalize() ) << "Error normalization of zero view";
+
+	// hadamard product of view and Matrix
+	Matrix<int, 2, 3> M { 1, 2, 3, 4, 5, 6 };
+	const Matrix<int, 2, 3> H = M.block<2, 3> ( 0, 0 ).hadamardProduct ( M );
+	const Matrix<int, 3, 2> Ht = MatrixView<const int, 3, 2> ( *M.x, 1, 3 ).hadamardProduct ( M.block<2, 3> ( 0, 0 ).transpose() );
+
+	for ( unsigned i = 0; i < 2; ++i )
+		for ( unsigned j = 0; j < 3; ++j )
+			{
+			EXPECT_EQ ( H.x[i][j], M.x[i][j] * M.x[i][j] ) << "Error hadamard product at " << i << ", " << j;
+			EXPECT_EQ ( Ht.x[j][i], M.x[i][j] * M.x[i][j] ) << "Error hadamard product of transposed view at " << j << ", " << i;
+			}
+
+	// transposed product of views, wider than block of accumulated elements
+	const unsigned cols = 70;
+	Matrix<float, 3, cols> A;
+	Vector<float, 3> v { 1.0f, -2.0f, 0.5f };
+	Vector<float, cols> Atv;
+	Vector<float, cols> out;
+	float transposed[cols * 3];
+
+	for ( unsigned i = 0; i < 3; ++i )
+		for ( unsigned j = 0; j < cols; ++j )
+			{
+			A.x[i][j] = float ( ( i*7 + j ) % 13 ) - 6.0f;
+			transposed[j*3 + i] = A.x[i][j];
+			}
+
+	transposedCauchyProduct ( A, v, Atv );
+	transposedCauchyProduct ( MatrixView<const float> ( *A.x, 3, cols, cols, 1 ), v, out );
+
+	for ( unsigned j = 0; j < cols; ++j )
+		EXPECT_EQ ( out.x[j], Atv.x[j] ) << "Error transposed product of view at " << j;
+
+	transposedCauchyProduct ( MatrixView<const float, cols, 3> ( transposed ).transpose(), v, VectorView<float> ( out ) );
+
+	for ( unsigned j = 0; j < cols; ++j )
+		EXPECT_EQ ( out.x[j], Atv.x[j] ) << "Error transposed product of strided view at " << j;
+
+	EXPECT_THROW ( transposedCauchyProduct ( MatrixView<const float> ( A ), v, VectorView<float> ( out.x, 3 ) ), std::runtime_error ) << "Error extents of transposed product";
+	}
+
+#endif // VIEWTEST_HPP
@@ -4,6 +4,22 @@
 #include "VectorTest.hpp"
 #include "MatrixTest.hpp"
 #include "MatrixVectorTest.hpp"
+#include "LUTest.hpp"
+#include "CholeskyTest.hpp"
+#include "QRTest.hpp"
+#include "SymmetricEigenTest.hpp"
+#include "SVDTest.hpp"
+#include "SparseMatrixTest.hpp"
+#include "BandedTest.hpp"
+#include "StrassenTest.hpp"
+#include "HalfTest.hpp"
+#include "QuantizedTest.hpp"
+#include "ViewTest.hpp"
+#include "BinaryIOTest.hpp"
+#include "StreamIOTest.hpp"
+#include "TextIOTest.hpp"
+#include "NpyTest.hpp"
+#include "InstrumentTest.hpp"
 
 int main ( int argn, char* args[] )
 	{